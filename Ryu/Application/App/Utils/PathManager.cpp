@@ -10,10 +10,18 @@ namespace Ryu::App
 		"Project root directory",
 		Config::CVarFlags::ReadOnly);
 
+	static Config::CVar<std::string> cv_cacheDir(
+		"App.CacheDir",
+		"",
+		"Derived data cache directory, can be shared between machines. Defaults to <ProjectDir>/Cache",
+		Config::CVarFlags::ReadOnly);
 
 	PathManager::PathManager()
 	{
 		m_projectDir = cv_projectDir.Get();
 		m_configDir = m_projectDir / "Config";
+
+		const std::string& cacheDir = cv_cacheDir.Get();
+		m_cacheDir = cacheDir.empty() ? m_projectDir / "Cache" : fs::path(cacheDir);
 	}
 }
@@ -13,6 +13,7 @@ namespace Ryu::App
 	public:
 		[[nodiscard]]  inline const fs::path& GetProjectDir() const { return m_projectDir; }
 		[[nodiscard]]  inline const fs::path& GetConfigDir() const { return m_configDir; }
+		[[nodiscard]]  inline const fs::path& GetCacheDir() const { return m_cacheDir; }
 
 	private:
 		PathManager();
@@ -20,5 +21,6 @@ namespace Ryu::App
 	private:
 		fs::path m_projectDir;
 		fs::path m_configDir;
+		fs::path m_cacheDir;
 	};
 }
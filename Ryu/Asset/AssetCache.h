@@ -1,7 +1,11 @@
 #pragma once
 #include "Asset/AssetHandle.h"
 #include "Asset/AssetLoader.h"
+#include "Asset/AssetSlotTable.h"
+#include "Asset/DerivedDataCache.h"
 #include "Asset/IGpuResourceFactory.h"
+#include "Threading/JobSystem.h"
+#include <condition_variable>
 #include <mutex>
 #include <shared_mutex>
 
@@ -23,10 +27,20 @@ namespace Ryu::Asset
 			AssetState                    State = AssetState::Unloaded;
 			u32                           RefCount = 0;
 			bool                          IsProcedural = false;
+			MT::JobHandle                 PendingLoad;         // Set while Loading on the job system
+			u32                           LoadGeneration = 0;  // Lets a load that was invalidated midway drop its result
+			u32                           Slot = 0;            // Mirror of State and GpuResource for lock-free readers
 		};
 
 	public:
 		explicit AssetCache(IGpuResourceFactory* gpuFactory) : m_gpuFactory(gpuFactory) {}
+		~AssetCache();
+
+		// CPU loads run here when set, otherwise on whichever thread asks for the asset. Set before loading starts
+		void SetJobSystem(MT::JobSystem* jobSystem) { m_jobSystem = jobSystem; }
+
+		// Imports go through this when set, so sources that were imported before are read cooked. Set before loading starts
+		void SetDerivedDataCache(DerivedDataCache* derivedData) { m_derivedData = derivedData; }
 
 		// Register asset from file path (lazy loading)
 		[[nodiscard]] AssetHandle<TAssetData> Register(const fs::path& path);
@@ -37,10 +51,26 @@ namespace Ryu::Asset
 		// Register procedural asset with string ID
 		[[nodiscard]] AssetHandle<TAssetData> Register(std::string_view name, std::unique_ptr<TAssetData> data);
 
-		// Get CPU/GPU data - loads on demand
+		// Get CPU/GPU data - loads on demand and blocks until the data is there
 		[[nodiscard]] TGpuResource* GetGpu(AssetHandle<TAssetData> handle);
 		[[nodiscard]] const TAssetData* GetCpu(AssetHandle<TAssetData> handle);
 
+		// Never waits on a load: returns the GPU resource if ready, creates it if the CPU data is in,
+		// otherwise starts loading and returns nullptr. Meant for the render thread.
+		// Ready assets are found without taking the lock
+		[[nodiscard]] TGpuResource* TryGetGpu(AssetHandle<TAssetData> handle);
+
+		// Lock free and never starts any work: the GPU resource if the asset is Ready, nullptr otherwise.
+		// Safe from any thread, loading is left to the other getters
+		[[nodiscard]] TGpuResource* FindReadyGpu(AssetHandle<TAssetData> handle) const
+		{
+			return handle.IsValid() ? m_slots.FindReady(handle.Id) : nullptr;
+		}
+
+		// Starts loading the CPU data (Unloaded -> Loading -> Loaded) and returns a handle to wait on.
+		// Asking again while loading returns the same handle. Empty when there is nothing to wait for
+		MT::JobHandle RequestLoad(AssetHandle<TAssetData> handle);
+
 		[[nodiscard]] const Entry* const GetEntry(AssetHandle<TAssetData> handle) const { return FindEntry(handle.Id); }
 
 		// Force load without accessing
@@ -54,6 +84,10 @@ namespace Ryu::Asset
 		void Invalidate(AssetHandle<TAssetData> handle);
 		void InvalidateAll();
 
+		// Frees GPU resources invalidated a few epochs ago. Called once per frame, pointers handed out
+		// by the getters stay valid until then even if the asset is invalidated meanwhile
+		void AdvanceEpoch();
+
 		// Func is void(AssetHandle<TAssetData> handle, const Entry& entry)
 		template<typename Func>
 		inline void ForEach(Func&& func) const
@@ -71,14 +105,31 @@ namespace Ryu::Asset
 		[[nodiscard]] Entry* FindEntry(AssetId id);
 		[[nodiscard]] const Entry* FindEntry(AssetId id) const;
 
-		bool LoadCpuData(Entry& entry);
+		using Lock = std::unique_lock<std::shared_mutex>;
+
+		// These expect lock to be held and may drop it while the file is read
+		MT::JobHandle StartLoad(AssetId id, Entry& entry, Lock& lock);
+		Entry* WaitForCpuData(AssetId id, Lock& lock);
+
+		void FinishLoad(AssetId id, u32 generation, std::unique_ptr<TAssetData> data);
+		void FinishLoad(Entry& entry, u32 generation, std::unique_ptr<TAssetData> data);
 		bool CreateGpuResource(Entry& entry, std::string_view name);
+		[[nodiscard]] std::unique_ptr<TGpuResource> MakeGpuResource(const TAssetData& data, std::string_view name);
+
+		// Every state change goes through these so the slot table stays in sync
+		void SetState(Entry& entry, AssetState state);
+		void Unload(Entry& entry);
 
 	private:
 		mutable std::shared_mutex              m_mutex;
-		std::unordered_map<AssetId, Entry>     m_entries;
+		std::condition_variable_any            m_loadFinished;
+		std::unordered_map<AssetId, Entry>     m_entries;  // Node based, entries never move or get erased
 		std::unordered_map<fs::path, AssetId>  m_pathToId;
+		AssetSlotTable<TGpuResource>           m_slots;
 		IGpuResourceFactory*                   m_gpuFactory;
+		MT::JobSystem*                         m_jobSystem = nullptr;
+		DerivedDataCache*                      m_derivedData = nullptr;
+		MT::WaitCounter                        m_loadsInFlight;
 	};
 }
 
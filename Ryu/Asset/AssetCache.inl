@@ -17,16 +17,23 @@ namespace Ryu::Asset
 		}
 
 		const AssetId id = GenerateId(path);
+		m_pathToId[path] = id;
+
+		// Another spelling of a path that is already registered
+		if (m_entries.contains(id))
+		{
+			return AssetHandle<TAssetData>{ id };
+		}
 
 		Entry entry
 		{
 			.SourcePath   = path,
 			.State        = AssetState::Unloaded,
 			.IsProcedural = false,
+			.Slot         = m_slots.Insert(id),
 		};
 
 		m_entries[id] = std::move(entry);
-		m_pathToId[path] = id;
 
 		return AssetHandle<TAssetData>{ id };
 	}
@@ -50,8 +57,10 @@ namespace Ryu::Asset
 		   .Name         = name.data(),
 		   .State        = AssetState::Loaded,  // CPU data already provided
 		   .IsProcedural = true,
+		   .Slot         = m_slots.Insert(id),
 		};
 
+		m_slots.Publish(entry.Slot, entry.State);
 		m_entries[id] = std::move(entry);
 
 		return AssetHandle<TAssetData>{ id };
@@ -65,6 +74,14 @@ namespace Ryu::Asset
 		return Register(id, std::move(data), name);
 	}
 
+	template<typename TAssetData, typename TGpuResource>
+	inline AssetCache<TAssetData, TGpuResource>::~AssetCache()
+	{
+		// Loads on the job system still point at this cache. Their Decrement is the last thing they do with
+		// it, and Wait only returns once the last one has left it
+		m_loadsInFlight.Wait();
+	}
+
 	template<typename TAssetData, typename TGpuResource>
 	inline TGpuResource* AssetCache<TAssetData, TGpuResource>::GetGpu(AssetHandle<TAssetData> handle)
 	{
@@ -75,15 +92,18 @@ namespace Ryu::Asset
 			return nullptr;
 		}
 
-		std::unique_lock lock(m_mutex);
+		if (TGpuResource* gpu = m_slots.FindReady(handle.Id))
+		{
+			return gpu;
+		}
 
-		Entry* entry = FindEntry(handle.Id);
+		Lock lock(m_mutex);
+
+		Entry* entry = WaitForCpuData(handle.Id, lock);
 		if (!entry)
 		{
 			return nullptr;
 		}
-		
-		const std::string name = entry->SourcePath.filename().string();
 
 		// Return if ready
 		if (entry->State == AssetState::Ready && entry->GpuResource)
@@ -91,26 +111,16 @@ namespace Ryu::Asset
 			return entry->GpuResource.get();
 		}
 
-		// Check we need to load the CPU side data first
-		if (entry->State == AssetState::Unloaded)
-		{
-			RYU_LOG_DEBUG("Loading CPU data for asset {}", name);
-			if (!LoadCpuData(*entry))
-			{
-				RYU_LOG_ERROR("Failed to load CPU data for asset {}", name);
-				entry->State = AssetState::Failed;
-				return nullptr;
-			}
-		}
-
 		// Create GPU resource if needed
 		if (entry->State == AssetState::Loaded && entry->CpuData)
 		{
+			const std::string name = entry->SourcePath.filename().string();
+
 			RYU_LOG_DEBUG("Creating GPU resource for asset {}", name);
 			if (!CreateGpuResource(*entry, name))
 			{
 				RYU_LOG_ERROR("Failed to create GPU resource for asset {}", name);
-				entry->State = AssetState::Failed;
+				SetState(*entry, AssetState::Failed);
 				return nullptr;
 			}
 		}
@@ -119,74 +129,103 @@ namespace Ryu::Asset
 	}
 
 	template<typename TAssetData, typename TGpuResource>
-	inline const TAssetData* AssetCache<TAssetData, TGpuResource>::GetCpu(AssetHandle<TAssetData> handle)
+	inline TGpuResource* AssetCache<TAssetData, TGpuResource>::TryGetGpu(AssetHandle<TAssetData> handle)
 	{
 		RYU_PROFILE_SCOPE();
-
 		if (!handle.IsValid())
 		{
 			return nullptr;
 		}
 
-		std::unique_lock lock(m_mutex);
-
-		Entry* entry = FindEntry(handle.Id);
-		if (!entry)
+		// Lock free for everything but the first call of an asset that still needs work
+		const auto* slot = m_slots.Find(handle.Id);
+		if (!slot)
 		{
 			return nullptr;
 		}
 
-		// Load if needed
+		switch (slot->State.load(std::memory_order_acquire))
+		{
+		case AssetState::Ready  : return slot->Gpu.load(std::memory_order_relaxed);
+		case AssetState::Loading:
+		case AssetState::Failed : return nullptr;
+		default                 : break;
+		}
+
+		Lock lock(m_mutex);
+
+		Entry* entry = FindEntry(handle.Id);
 		if (entry->State == AssetState::Unloaded)
 		{
-			RYU_LOG_DEBUG("Loading CPU data for asset {}", entry->SourcePath.filename().string());
-			
-			if (!LoadCpuData(*entry))
+			// Without a job system this loads right here, there is nowhere else to do it
+			std::ignore = StartLoad(handle.Id, *entry, lock);
+		}
+
+		if (entry->State == AssetState::Loaded && entry->CpuData)
+		{
+			const std::string name = entry->SourcePath.filename().string();
+			if (!CreateGpuResource(*entry, name))
 			{
-				RYU_LOG_ERROR("Failed to load CPU data for asset {}", entry->SourcePath.filename().string());
-				entry->State = AssetState::Failed;
-				return nullptr;
+				RYU_LOG_ERROR("Failed to create GPU resource for asset {}", name);
+				SetState(*entry, AssetState::Failed);
 			}
 		}
 
-		return entry->CpuData.get();
+		return entry->State == AssetState::Ready ? entry->GpuResource.get() : nullptr;
 	}
 
 	template<typename TAssetData, typename TGpuResource>
-	inline void AssetCache<TAssetData, TGpuResource>::EnsureCpuLoaded(AssetHandle<TAssetData> handle)
+	inline MT::JobHandle AssetCache<TAssetData, TGpuResource>::RequestLoad(AssetHandle<TAssetData> handle)
 	{
-		std::unique_lock lock(m_mutex);
+		RYU_PROFILE_SCOPE();
+		if (!handle.IsValid())
+		{
+			return {};
+		}
+
+		Lock lock(m_mutex);
 
 		Entry* entry = FindEntry(handle.Id);
-		if (!entry)
-			return;
+		return entry ? StartLoad(handle.Id, *entry, lock) : MT::JobHandle{};
+	}
 
-		if (entry->State == AssetState::Unloaded)
+	template<typename TAssetData, typename TGpuResource>
+	inline const TAssetData* AssetCache<TAssetData, TGpuResource>::GetCpu(AssetHandle<TAssetData> handle)
+	{
+		RYU_PROFILE_SCOPE();
+
+		if (!handle.IsValid())
 		{
-			LoadCpuData(*entry);
+			return nullptr;
 		}
+
+		Lock lock(m_mutex);
+
+		Entry* entry = WaitForCpuData(handle.Id, lock);
+		return entry ? entry->CpuData.get() : nullptr;
+	}
+
+	template<typename TAssetData, typename TGpuResource>
+	inline void AssetCache<TAssetData, TGpuResource>::EnsureCpuLoaded(AssetHandle<TAssetData> handle)
+	{
+		Lock lock(m_mutex);
+		std::ignore = WaitForCpuData(handle.Id, lock);
 	}
 
 	template<typename TAssetData, typename TGpuResource>
 	inline void AssetCache<TAssetData, TGpuResource>::EnsureGpuReady(AssetHandle<TAssetData> handle)
 	{
-		std::unique_lock lock(m_mutex);
+		Lock lock(m_mutex);
 
-		Entry* entry = FindEntry(handle.Id);
+		// Ensure CPU data loaded first
+		Entry* entry = WaitForCpuData(handle.Id, lock);
 		if (!entry)
 			return;
 
-		// Ensure CPU data loaded first
-		if (entry->State == AssetState::Unloaded)
-		{
-			if (!LoadCpuData(*entry)) 
-				return;
-		}
-
 		// Create GPU resource if needed
 		if (entry->State == AssetState::Loaded)
 		{
-			CreateGpuResource(*entry);
+			CreateGpuResource(*entry, entry->SourcePath.filename().string());
 		}
 	}
 
@@ -230,10 +269,8 @@ namespace Ryu::Asset
 
 		if (entry->RefCount == 0 && !entry->IsProcedural)
 		{
-			// Release GPU resource first (may have dependencies on CPU data)
-			entry->GpuResource.reset();
-			entry->CpuData.reset();
-			entry->State = AssetState::Unloaded;
+			Unload(*entry);
+			m_loadFinished.notify_all();  // Anyone waiting on a load that is now dropped
 		}
 	}
 
@@ -249,10 +286,8 @@ namespace Ryu::Asset
 			return;
 		}
 
-		// Clear GPU resource, keep CPU data option for reload
-		entry->GpuResource.reset();
-		entry->CpuData.reset();
-		entry->State = AssetState::Unloaded;
+		Unload(*entry);
+		m_loadFinished.notify_all();
 	}
 
 	template<typename TAssetData, typename TGpuResource>
@@ -265,11 +300,10 @@ namespace Ryu::Asset
 		{
 			if (!entry.IsProcedural)
 			{
-				entry.GpuResource.reset();
-				entry.CpuData.reset();
-				entry.State = AssetState::Unloaded;
+				Unload(entry);
 			}
 		}
+		m_loadFinished.notify_all();
 	}
 
 	template<typename TAssetData, typename TGpuResource>
@@ -302,53 +336,179 @@ namespace Ryu::Asset
 	}
 
 	template<typename TAssetData, typename TGpuResource>
-	inline bool AssetCache<TAssetData, TGpuResource>::LoadCpuData(Entry& entry)
+	inline MT::JobHandle AssetCache<TAssetData, TGpuResource>::StartLoad(AssetId id, Entry& entry, Lock& lock)
 	{
 		RYU_PROFILE_SCOPE();
-		if (entry.IsProcedural)
+		if (entry.State == AssetState::Loading)
 		{
-			return entry.CpuData != nullptr;
+			return entry.PendingLoad;
 		}
 
-		entry.State = AssetState::Loading;
-		entry.CpuData = LoadAsset<TAssetData>(entry.SourcePath);
+		if (entry.State != AssetState::Unloaded || entry.IsProcedural)
+		{
+			return {};
+		}
+
+		SetState(entry, AssetState::Loading);
+		const u32 generation = ++entry.LoadGeneration;
 
-		if (entry.CpuData)
+		RYU_LOG_DEBUG("Loading CPU data for asset {}", entry.SourcePath.filename().string());
+
+		const fs::path path = entry.SourcePath;
+		if (m_jobSystem)
 		{
-			entry.State = AssetState::Loaded;
-			return true;
+			// Submit runs queued jobs while the job pool is full, and those may be loads that need this lock.
+			// Until it is stored, other callers see no handle and wait on m_loadFinished instead
+			entry.PendingLoad = {};
+			m_loadsInFlight.Add();
+			lock.unlock();
+			const MT::JobHandle load = m_jobSystem->Submit([this, id, generation, path]
+			{
+				FinishLoad(id, generation, LoadAsset<TAssetData>(path, m_derivedData));
+				m_loadsInFlight.Decrement();
+			});
+			lock.lock();
+
+			// The load may have finished or been invalidated in the meantime
+			if (entry.State == AssetState::Loading && entry.LoadGeneration == generation)
+			{
+				entry.PendingLoad = load;
+			}
+			return load;
 		}
 
-		entry.State = AssetState::Failed;
-		return false;
+		// No job system, load on this thread but let other lookups through meanwhile
+		lock.unlock();
+		std::unique_ptr<TAssetData> data = LoadAsset<TAssetData>(path, m_derivedData);
+		lock.lock();
+
+		FinishLoad(entry, generation, std::move(data));
+		m_loadFinished.notify_all();
+		return {};
+	}
+
+	template<typename TAssetData, typename TGpuResource>
+	inline typename AssetCache<TAssetData, TGpuResource>::Entry* AssetCache<TAssetData, TGpuResource>::WaitForCpuData(AssetId id, Lock& lock)
+	{
+		RYU_PROFILE_SCOPE();
+		Entry* entry = FindEntry(id);
+		if (!entry)
+		{
+			return nullptr;
+		}
+
+		if (const MT::JobHandle load = StartLoad(id, *entry, lock))
+		{
+			// Waiting on the handle lets this thread help run jobs, the lock would stall the load
+			lock.unlock();
+			load.Wait();
+			lock.lock();
+		}
+
+		// Covers loads running on another thread without a job system, or still being submitted
+		m_loadFinished.wait(lock, [entry] { return entry->State != AssetState::Loading; });
+		return entry;
+	}
+
+	template<typename TAssetData, typename TGpuResource>
+	inline void AssetCache<TAssetData, TGpuResource>::FinishLoad(AssetId id, u32 generation, std::unique_ptr<TAssetData> data)
+	{
+		{
+			Lock lock(m_mutex);
+			if (Entry* entry = FindEntry(id))
+			{
+				FinishLoad(*entry, generation, std::move(data));
+			}
+		}
+		m_loadFinished.notify_all();
+	}
+
+	template<typename TAssetData, typename TGpuResource>
+	inline void AssetCache<TAssetData, TGpuResource>::FinishLoad(Entry& entry, u32 generation, std::unique_ptr<TAssetData> data)
+	{
+		// Invalidated (and maybe requested again) while this load was running
+		if (entry.State != AssetState::Loading || entry.LoadGeneration != generation)
+		{
+			return;
+		}
+
+		entry.PendingLoad = {};
+		if (data)
+		{
+			entry.CpuData = std::move(data);
+			SetState(entry, AssetState::Loaded);
+		}
+		else
+		{
+			RYU_LOG_ERROR("Failed to load CPU data for asset {}", entry.SourcePath.filename().string());
+			SetState(entry, AssetState::Failed);
+		}
 	}
 
 	template<typename TAssetData, typename TGpuResource>
 	bool AssetCache<TAssetData, TGpuResource>::CreateGpuResource(Entry& entry, std::string_view name)
 	{
 		RYU_PROFILE_SCOPE();
-		if (!m_gpuFactory || !entry.CpuData)
+		if (!entry.CpuData)
 		{
 			return false;
 		}
 
+		entry.GpuResource = MakeGpuResource(*entry.CpuData, name);
+		if (entry.GpuResource)
+		{
+			SetState(entry, AssetState::Ready);
+			return true;
+		}
+
+		return false;
+	}
+
+	template<typename TAssetData, typename TGpuResource>
+	inline std::unique_ptr<TGpuResource> AssetCache<TAssetData, TGpuResource>::MakeGpuResource(const TAssetData& data, std::string_view name)
+	{
+		if (!m_gpuFactory)
+		{
+			return nullptr;
+		}
+
 		// This requires specialization per asset type
 		// See GpuResourceFactory implementation
 		if constexpr (IsSame<TAssetData, MeshData>)
 		{
-			entry.GpuResource = m_gpuFactory->CreateMesh(*entry.CpuData, name);
+			return m_gpuFactory->CreateMesh(data, name);
 		}
 		else if constexpr (IsSame<TAssetData, TextureData>)
 		{
-			entry.GpuResource = m_gpuFactory->CreateTexture(*entry.CpuData, name);
+			return m_gpuFactory->CreateTexture(data, name);
 		}
-
-		if (entry.GpuResource)
+		else
 		{
-			entry.State = AssetState::Ready;
-			return true;
+			return nullptr;
 		}
+	}
 
-		return false;
+	template<typename TAssetData, typename TGpuResource>
+	inline void AssetCache<TAssetData, TGpuResource>::SetState(Entry& entry, AssetState state)
+	{
+		entry.State = state;
+		m_slots.Publish(entry.Slot, state, entry.GpuResource.get());
+	}
+
+	template<typename TAssetData, typename TGpuResource>
+	inline void AssetCache<TAssetData, TGpuResource>::Unload(Entry& entry)
+	{
+		// Hide it from lock-free readers first, then keep the GPU resource around for the ones that already have it
+		SetState(entry, AssetState::Unloaded);
+		m_slots.Retire(std::move(entry.GpuResource));
+		entry.CpuData.reset();
+	}
+
+	template<typename TAssetData, typename TGpuResource>
+	inline void AssetCache<TAssetData, TGpuResource>::AdvanceEpoch()
+	{
+		RYU_PROFILE_SCOPE();
+		Lock lock(m_mutex);
+		m_slots.AdvanceEpoch();
 	}
 }
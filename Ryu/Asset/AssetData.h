@@ -1,8 +1,99 @@
 #pragma once
 #include "Asset/AssetHandle.h"
+#include "Core/Utils/MappedFile.h"
+#include <algorithm>
+#include <span>
 
 namespace Ryu::Asset
 {
+	// Describes how packed vertices are stored. Position is always float3, the rest can shrink
+	struct VertexLayout
+	{
+		enum class NormalFormat : u8
+		{
+			Float3,
+			Octahedral16,  // 2x snorm16
+		};
+
+		enum class TexCoordFormat : u8
+		{
+			Float2,
+			Half2,
+		};
+
+		enum class ColorFormat : u8
+		{
+			Float4,
+			RGBA8,  // unorm
+			None,   // Constant white
+		};
+
+		NormalFormat Normal     = NormalFormat::Float3;
+		TexCoordFormat TexCoord = TexCoordFormat::Float2;
+		ColorFormat Color       = ColorFormat::Float4;
+
+		[[nodiscard]] static constexpr u32 NormalOffset() { return 12; }
+		[[nodiscard]] constexpr u32 TexCoordOffset() const { return NormalOffset() + (Normal == NormalFormat::Float3 ? 12 : 4); }
+		[[nodiscard]] constexpr u32 ColorOffset() const { return TexCoordOffset() + (TexCoord == TexCoordFormat::Float2 ? 8 : 4); }
+		[[nodiscard]] constexpr u32 Stride() const
+		{
+			return ColorOffset() + (Color == ColorFormat::Float4 ? 16 : Color == ColorFormat::RGBA8 ? 4 : 0);
+		}
+
+		constexpr bool operator==(const VertexLayout&) const = default;
+	};
+
+	// Axis aligned box and bounding sphere, in mesh space
+	struct MeshBounds
+	{
+		std::array<f32, 3> Min{};
+		std::array<f32, 3> Max{};
+		std::array<f32, 3> Center{};
+		f32 Radius = 0.0f;
+	};
+
+	// A cluster of up to MAX_VERTICES vertices and MAX_TRIANGLES triangles, see MeshClusters
+	struct Meshlet
+	{
+		static constexpr u32 MAX_VERTICES  = 64;
+		static constexpr u32 MAX_TRIANGLES = 124;
+
+		u32 VertexOffset   = 0;  // Into MeshData::MeshletVertices
+		u32 TriangleOffset = 0;  // Into MeshData::MeshletTriangles, 3 local indices per triangle
+		u32 VertexCount    = 0;
+		u32 TriangleCount  = 0;
+
+		std::array<f32, 3> Center{};
+		f32 Radius = 0.0f;
+
+		// Backface cone: the meshlet faces away from a viewer at V when dot(normalize(ConeApex - V), ConeAxis) >= ConeCutoff.
+		// ConeCutoff is 1 when the normals spread too far to ever cull
+		std::array<f32, 3> ConeApex{};
+		std::array<f32, 3> ConeAxis{};
+		f32 ConeCutoff = 1.0f;
+	};
+
+	// One level of detail, a range of MeshData indices drawn over the shared vertices. See MeshSimplifier
+	struct MeshLod
+	{
+		u32 IndexOffset = 0;
+		u32 IndexCount  = 0;
+		f32 Error       = 0.0f;  // Furthest the LOD strays from LOD 0, in mesh space
+	};
+
+	// Coarsest LOD whose error is at most maxError. LODs are ordered fine to coarse
+	[[nodiscard]] inline u32 SelectLod(std::span<const MeshLod> lods, f32 maxError)
+	{
+		for (u32 i = static_cast<u32>(lods.size()); i > 1; --i)
+		{
+			if (lods[i - 1].Error <= maxError)
+			{
+				return i - 1;
+			}
+		}
+		return 0;
+	}
+
 	// CPU-side mesh data - loadable from disk or generated procedurally
 	struct MeshData
 	{
@@ -19,6 +110,9 @@ namespace Ryu::Asset
 			u32 IndexOffset = 0;
 			u32 IndexCount = 0;
 			u32 MaterialIndex = 0;
+			u32 MeshletOffset = 0;
+			u32 MeshletCount = 0;
+			MeshBounds Bounds;
 		};
 
 		struct Material
@@ -38,12 +132,44 @@ namespace Ryu::Asset
 		std::vector<SubMesh> SubMeshes;
 		std::vector<Material> Materials;
 
+		// Filled by MeshClusters::Build, after any step that reorders vertices or indices
+		MeshBounds Bounds;
+		std::vector<Meshlet> Meshlets;
+		std::vector<u32> MeshletVertices;
+		std::vector<u8> MeshletTriangles;
+
+		// Filled by MeshSimplifier::BuildLods. LOD 0 is the original index range, the others follow it
+		// in Indices. Submeshes and meshlets only describe LOD 0
+		std::vector<MeshLod> Lods;
+
+		// Filled by VertexPacking::Pack, after any step that reorders vertices. A compact copy of the vertices in
+		// PackedLayout, what the GPU gets when there is one. Vertices stay for everything that works on the CPU
+		VertexLayout PackedLayout;
+		std::vector<byte> PackedVertices;
+
+		// Cooked meshes leave Vertices and Indices empty and point into the memory-mapped file instead
+		std::shared_ptr<const Utils::MappedFile> Mapping;
+		std::span<const Vertex> MappedVertices;
+		std::span<const u32> MappedIndices;
+		std::span<const byte> MappedPackedVertices;
+
+		// Use these to read vertex and index data, they work for both loaded and mapped meshes
+		[[nodiscard]] std::span<const Vertex> GetVertices() const { return Mapping ? MappedVertices : std::span<const Vertex>(Vertices); }
+		[[nodiscard]] std::span<const u32> GetIndices() const { return Mapping ? MappedIndices : std::span<const u32>(Indices); }
+		[[nodiscard]] std::span<const byte> GetPackedVertices() const { return Mapping ? MappedPackedVertices : std::span<const byte>(PackedVertices); }
+
 		[[nodiscard]] u32 VertexStride() const { return sizeof(Vertex); }
-        [[nodiscard]] u32 VertexBufferSize() const { return static_cast<u32>(Vertices.size() * sizeof(Vertex)); }
-        [[nodiscard]] u32 IndexBufferSize() const { return static_cast<u32>(Indices.size() * sizeof(u32)); }
-        [[nodiscard]] bool HasIndices() const { return !Indices.empty(); }
+        [[nodiscard]] u32 VertexBufferSize() const { return static_cast<u32>(GetVertices().size_bytes()); }
+        [[nodiscard]] u32 IndexBufferSize() const { return static_cast<u32>(GetIndices().size_bytes()); }
+        [[nodiscard]] bool HasIndices() const { return !GetIndices().empty(); }
+        [[nodiscard]] bool HasPackedVertices() const { return !GetPackedVertices().empty(); }
+        [[nodiscard]] bool HasMeshlets() const { return !Meshlets.empty(); }
+        [[nodiscard]] bool HasLods() const { return Lods.size() > 1; }
+        [[nodiscard]] bool Uses16BitIndices() const { return GetVertices().size() < 0x10000; }
 	};
 
+	static_assert(VertexLayout{}.Stride() == sizeof(MeshData::Vertex));
+
 	// CPU-side texture data
 	struct TextureData
 	{
@@ -58,7 +184,11 @@ namespace Ryu::Asset
 			RGBA16F,
 			R32F,
 			RG32F,
-			RGBA32F
+			RGBA32F,
+			BC1,  // RGB, 8 bytes per 4x4 block
+			BC3,  // RGBA, 16 bytes per block
+			BC5,  // RG, 16 bytes per block
+			BC7,  // RGBA, 16 bytes per block
 		};
 
 		i32 Width          = 0;
@@ -66,30 +196,77 @@ namespace Ryu::Asset
 		i32 Depth          = 1;
 		i32 MipLevels      = 1;
 		Format PixelFormat = Format::RGBA8;
-		std::vector<byte> Data;
+		bool SRGB          = false;  // Color stored gamma encoded, mips are filtered in linear space
+		std::vector<byte> Data;     // Every mip level, largest first, tightly packed
+
+		[[nodiscard]] u32 BytesPerPixel() const;  // 0 for block compressed formats
+		[[nodiscard]] u32 BytesPerBlock() const;  // 0 for uncompressed formats
+		[[nodiscard]] bool IsBlockCompressed() const { return BytesPerBlock() != 0; }
+
+		[[nodiscard]] u32 MipWidth(u32 mip) const { return std::max(static_cast<u32>(Width) >> mip, 1u); }
+		[[nodiscard]] u32 MipHeight(u32 mip) const { return std::max(static_cast<u32>(Height) >> mip, 1u); }
+		[[nodiscard]] u32 MipRowPitch(u32 mip) const;  // Bytes per row of pixels, or of 4x4 blocks
+		[[nodiscard]] u32 MipRowCount(u32 mip) const;
+		[[nodiscard]] u64 MipSize(u32 mip) const { return u64(MipRowPitch(mip)) * MipRowCount(mip); }
+		[[nodiscard]] u64 MipOffset(u32 mip) const;
 
-		[[nodiscard]] u32 BytesPerPixel() const;
-        [[nodiscard]] u32 RowPitch() const { return Width * BytesPerPixel(); }
-        [[nodiscard]] u32 DataSize() const { return static_cast<u32>(Data.size()); }
+		[[nodiscard]] u32 RowPitch() const { return MipRowPitch(0); }
+		[[nodiscard]] u32 DataSize() const { return static_cast<u32>(Data.size()); }
 	};
 
 	inline u32 TextureData::BytesPerPixel() const
-    {
-        switch (PixelFormat)
-        {
-            case Format::R8:      return 1;
-            case Format::RG8:     return 2;
-            case Format::RGB8:    return 3;
-            case Format::RGBA8:   return 4;
-            case Format::R16F:    return 2;
-            case Format::RG16F:   return 4;
-            case Format::RGBA16F: return 8;
-            case Format::R32F:    return 4;
-            case Format::RG32F:   return 8;
-            case Format::RGBA32F: return 16;
-            default:              return 4;
-        }
-    }
+	{
+		switch (PixelFormat)
+		{
+			case Format::R8:      return 1;
+			case Format::RG8:     return 2;
+			case Format::RGB8:    return 3;
+			case Format::RGBA8:   return 4;
+			case Format::R16F:    return 2;
+			case Format::RG16F:   return 4;
+			case Format::RGBA16F: return 8;
+			case Format::R32F:    return 4;
+			case Format::RG32F:   return 8;
+			case Format::RGBA32F: return 16;
+			case Format::BC1:
+			case Format::BC3:
+			case Format::BC5:
+			case Format::BC7:     return 0;
+			default:              return 4;
+		}
+	}
+
+	inline u32 TextureData::BytesPerBlock() const
+	{
+		switch (PixelFormat)
+		{
+			case Format::BC1: return 8;
+			case Format::BC3:
+			case Format::BC5:
+			case Format::BC7: return 16;
+			default:          return 0;
+		}
+	}
+
+	inline u32 TextureData::MipRowPitch(u32 mip) const
+	{
+		return IsBlockCompressed() ? (MipWidth(mip) + 3) / 4 * BytesPerBlock() : MipWidth(mip) * BytesPerPixel();
+	}
+
+	inline u32 TextureData::MipRowCount(u32 mip) const
+	{
+		return IsBlockCompressed() ? (MipHeight(mip) + 3) / 4 : MipHeight(mip);
+	}
+
+	inline u64 TextureData::MipOffset(u32 mip) const
+	{
+		u64 offset = 0;
+		for (u32 i = 0; i < mip; ++i)
+		{
+			offset += MipSize(i);
+		}
+		return offset;
+	}
 
 	using MeshHandle = AssetHandle<MeshData>;
 	using TextureHandle = AssetHandle<TextureData>;
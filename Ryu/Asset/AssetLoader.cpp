@@ -1,25 +1,128 @@
 #include "Asset/AssetLoader.h"
+#include "Asset/DerivedDataCache.h"
 #include "Asset/Loaders/OBJLoader.h"
+#include "Asset/Loaders/CookedMeshLoader.h"
+#include "Asset/Processing/MeshClusters.h"
+#include "Asset/Processing/MeshOptimizer.h"
+#include "Asset/Processing/MeshSimplifier.h"
+#include "Asset/Processing/VertexPacking.h"
 #include "Asset/Loaders/ImageLoader.h"
+#include "Asset/Loaders/CookedTextureLoader.h"
+#include "Asset/Processing/BlockCompression.h"
+#include "Asset/Processing/TextureMips.h"
+#include "Memory/New.h"
+#include "Core/Logging/Logger.h"
 
 namespace Ryu::Asset
 {
+    namespace
+    {
+        // Bump these when an importer's output changes, derived data made by the old code then stops matching
+        constexpr u32 OBJ_IMPORTER_VERSION   = 2;  // 2: material libraries are found
+        constexpr u32 IMAGE_IMPORTER_VERSION = 1;
+
+        constexpr TextureData::Format TEXTURE_COMPRESSION = TextureData::Format::BC7;
+
+        // Everything else the derived data depends on, as key bytes
+        constexpr std::array<u32, 2> OBJ_IMPORT_SETTINGS{ CookedMeshLoader::VERSION, MeshSimplifier::DEFAULT_LOD_COUNT };
+        constexpr std::array<u32, 2> IMAGE_IMPORT_SETTINGS{ CookedTextureLoader::VERSION, static_cast<u32>(TEXTURE_COMPRESSION) };
+
+        std::unique_ptr<MeshData> ImportObj(const fs::path& path)
+        {
+            auto mesh = OBJLoader::Load(path);
+            if (!mesh)
+            {
+                return nullptr;
+            }
+
+            // OBJ corners come out one vertex each, share them and order them for the GPU caches
+            MeshOptimizer::Optimize(*mesh);
+            MeshClusters::Build(*mesh);
+            MeshSimplifier::BuildLods(*mesh);
+
+            // What the GPU gets, in the smallest layout that still looks the same
+            VertexPacking::Pack(*mesh);
+            return mesh;
+        }
+
+        std::unique_ptr<TextureData> ImportImage(const fs::path& path)
+        {
+            auto texture = ImageLoader::Load(path);
+            if (!texture)
+            {
+                return nullptr;
+            }
+
+            TextureMips::ConvertToRGBA8(*texture);
+            TextureMips::Generate(*texture);
+
+            // D3D12 only takes block compressed textures made of whole blocks
+            if (texture->Width % BlockCompression::BLOCK_DIM == 0 && texture->Height % BlockCompression::BLOCK_DIM == 0)
+            {
+                BlockCompression::Compress(*texture, TEXTURE_COMPRESSION);
+            }
+            return texture;
+        }
+
+        // Through the derived data cache when there is one and the source can be hashed. Dependencies are
+        // the other files import reads, whatever they change has to change the key too
+        template <typename T, typename CookedLoader, typename Import, size_t N>
+        std::unique_ptr<T> ImportCached(const fs::path& path, std::span<const fs::path> dependencies, DerivedDataCache* derivedData,
+            u32 importerVersion, const std::array<u32, N>& settings, Import&& import)
+        {
+            if (!derivedData)
+            {
+                return import(path);
+            }
+
+            const DerivedDataCache::Key key = derivedData->MakeKey(path, dependencies, importerVersion, std::as_bytes(std::span(settings)));
+            if (key == DerivedDataCache::INVALID_KEY)
+            {
+                return import(path);
+            }
+
+            return derivedData->GetOrImport<T>(key, CookedLoader::EXTENSION,
+                [](const fs::path& cookedPath) { return CookedLoader::Load(cookedPath); },
+                [&] { return import(path); },
+                [&path](const T& data, const fs::path& cookedPath)
+                {
+                    if (!CookedLoader::Write(data, cookedPath))
+                    {
+                        RYU_LOG_WARN("Failed to store derived data of {}", path.filename().string());
+                        return false;
+                    }
+                    return true;
+                });
+        }
+    }
+
     template<>
-    std::unique_ptr<MeshData> LoadAsset(const fs::path& path)
+    std::unique_ptr<MeshData> LoadAsset(const fs::path& path, DerivedDataCache* derivedData)
     {
+        Memory::ScopedAllocationTag tag(Memory::AllocationTag::Asset);
+
         const auto ext = path.extension().string();
-        if (ext == ".obj") return OBJLoader::Load(path);
+        if (ext == CookedMeshLoader::EXTENSION) return CookedMeshLoader::Load(path);
+        if (ext == ".obj")
+        {
+            // Materials come from the .mtl files and are stored in the cooked mesh
+            const std::vector<fs::path> materialLibraries = derivedData ? OBJLoader::GetMaterialLibraries(path) : std::vector<fs::path>{};
+            return ImportCached<MeshData, CookedMeshLoader>(path, materialLibraries, derivedData, OBJ_IMPORTER_VERSION, OBJ_IMPORT_SETTINGS, ImportObj);
+        }
         // if (ext == ".gltf") return GLTFLoader::Load(path);
         return nullptr;
     }
 
     template<>
-    std::unique_ptr<TextureData> LoadAsset(const fs::path& path)
+    std::unique_ptr<TextureData> LoadAsset(const fs::path& path, DerivedDataCache* derivedData)
     {
+        Memory::ScopedAllocationTag tag(Memory::AllocationTag::Asset);
+
         const auto ext = path.extension().string();
+        if (ext == CookedTextureLoader::EXTENSION) return CookedTextureLoader::Load(path);
         if (ext == ".png" || ext == ".jpg" || ext == ".jpeg")
         {
-            return ImageLoader::Load(path);
+            return ImportCached<TextureData, CookedTextureLoader>(path, {}, derivedData, IMAGE_IMPORTER_VERSION, IMAGE_IMPORT_SETTINGS, ImportImage);
         }
         return nullptr;
     }
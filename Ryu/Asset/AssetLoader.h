@@ -6,9 +6,13 @@ namespace Ryu::Asset
 {
 	namespace fs = std::filesystem;
 
+    class DerivedDataCache;
+
+    // Imports from source files. With a derived data cache, imported results are stored there and
+    // unchanged sources are read back from it instead of being imported again
     template<typename T>
-    std::unique_ptr<T> LoadAsset(const std::filesystem::path& path);
+    std::unique_ptr<T> LoadAsset(const std::filesystem::path& path, DerivedDataCache* derivedData = nullptr);
 
-    template<> std::unique_ptr<MeshData> LoadAsset(const std::filesystem::path& path);
-    template<> std::unique_ptr<TextureData> LoadAsset(const std::filesystem::path& path);
+    template<> std::unique_ptr<MeshData> LoadAsset(const std::filesystem::path& path, DerivedDataCache* derivedData);
+    template<> std::unique_ptr<TextureData> LoadAsset(const std::filesystem::path& path, DerivedDataCache* derivedData);
 }
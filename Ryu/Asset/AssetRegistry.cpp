@@ -1,6 +1,8 @@
 #include "Asset/AssetRegistry.h"
 #include "Asset/Loaders/ImageLoader.h"
 #include "Asset/Loaders/OBJLoader.h"
+#include "Asset/Processing/MeshClusters.h"
+#include "Asset/Processing/MeshSimplifier.h"
 #include "Core/Profiling/Profiling.h"
 
 namespace Ryu::Asset
@@ -30,18 +32,48 @@ namespace Ryu::Asset
 		return m_meshCache.GetGpu(GetPrimitive(type));
 	}
 
+	void AssetRegistry::SetJobSystem(MT::JobSystem* jobSystem)
+	{
+		m_meshCache.SetJobSystem(jobSystem);
+		m_textureCache.SetJobSystem(jobSystem);
+	}
+
+	void AssetRegistry::SetCacheDirectory(const fs::path& directory)
+	{
+		m_derivedData = std::make_unique<DerivedDataCache>(directory);
+		m_meshCache.SetDerivedDataCache(m_derivedData.get());
+		m_textureCache.SetDerivedDataCache(m_derivedData.get());
+	}
+
 	void AssetRegistry::LoadAll()
 	{
 		RYU_PROFILE_SCOPE();
-		m_meshCache.ForEach([this](MeshHandle handle, const MeshCache::Entry&)
+
+		// Handles first, ForEach holds the cache lock that loading needs
+		std::vector<MeshHandle> meshes;
+		std::vector<TextureHandle> textures;
+		m_meshCache.ForEach([&meshes](MeshHandle handle, const MeshCache::Entry&) { meshes.push_back(handle); });
+		m_textureCache.ForEach([&textures](TextureHandle handle, const TextureCache::Entry&) { textures.push_back(handle); });
+
+		// Start every CPU load before waiting on any of them
+		for (MeshHandle handle : meshes)
 		{
-			std::ignore = m_meshCache.GetGpu(handle);
-		});
+			std::ignore = m_meshCache.RequestLoad(handle);
+		}
+		for (TextureHandle handle : textures)
+		{
+			std::ignore = m_textureCache.RequestLoad(handle);
+		}
 
-		m_textureCache.ForEach([this](TextureHandle handle, const TextureCache::Entry&)
+		// GPU resources are created here, on the calling thread
+		for (MeshHandle handle : meshes)
+		{
+			std::ignore = m_meshCache.GetGpu(handle);
+		}
+		for (TextureHandle handle : textures)
 		{
 			std::ignore = m_textureCache.GetGpu(handle);
-		});
+		}
 	}
 
 	void AssetRegistry::InvalidateAll()
@@ -51,15 +83,30 @@ namespace Ryu::Asset
 		m_textureCache.InvalidateAll();
 	}
 
+	void AssetRegistry::AdvanceEpoch()
+	{
+		m_meshCache.AdvanceEpoch();
+		m_textureCache.AdvanceEpoch();
+	}
+
 	void AssetRegistry::RegisterPrimitives()
 	{
 		RYU_PROFILE_SCOPE();
+
+		// Primitives skip the import pipeline, they only need their bounds, meshlets and LODs
+		auto build = [](std::unique_ptr<MeshData> mesh)
+		{
+			MeshClusters::Build(*mesh);
+			MeshSimplifier::BuildLods(*mesh);
+			return mesh;
+		};
+
 		// Register all built-in primitives
-		m_primitives[static_cast<u64>(PrimitiveType::Triangle)] = m_meshCache.Register("Primitive:Triangle", Primitives::CreateTriangle());
-		m_primitives[static_cast<u64>(PrimitiveType::Cube)]     = m_meshCache.Register("Primitive:Cube", Primitives::CreateCube());
-		m_primitives[static_cast<u64>(PrimitiveType::Plane)]    = m_meshCache.Register("Primitive:Plane", Primitives::CreatePlane());
-		m_primitives[static_cast<u64>(PrimitiveType::Sphere)]   = m_meshCache.Register("Primitive:Sphere", Primitives::CreateSphere());
-		m_primitives[static_cast<u64>(PrimitiveType::Cylinder)] = m_meshCache.Register("Primitive:Cylinder", Primitives::CreateCylinder());
-		m_primitives[static_cast<u64>(PrimitiveType::Cone)]     = m_meshCache.Register("Primitive:Cone", Primitives::CreateCone());
+		m_primitives[static_cast<u64>(PrimitiveType::Triangle)] = m_meshCache.Register("Primitive:Triangle", build(Primitives::CreateTriangle()));
+		m_primitives[static_cast<u64>(PrimitiveType::Cube)]     = m_meshCache.Register("Primitive:Cube", build(Primitives::CreateCube()));
+		m_primitives[static_cast<u64>(PrimitiveType::Plane)]    = m_meshCache.Register("Primitive:Plane", build(Primitives::CreatePlane()));
+		m_primitives[static_cast<u64>(PrimitiveType::Sphere)]   = m_meshCache.Register("Primitive:Sphere", build(Primitives::CreateSphere()));
+		m_primitives[static_cast<u64>(PrimitiveType::Cylinder)] = m_meshCache.Register("Primitive:Cylinder", build(Primitives::CreateCylinder()));
+		m_primitives[static_cast<u64>(PrimitiveType::Cone)]     = m_meshCache.Register("Primitive:Cone", build(Primitives::CreateCone()));
 	}
 }
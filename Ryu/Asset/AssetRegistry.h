@@ -23,16 +23,25 @@ namespace Ryu::Asset
 		[[nodiscard]] inline MeshCache& Meshes() { return m_meshCache; }
 		[[nodiscard]] inline TextureCache& Textures() { return m_textureCache; }
 
+		// Moves CPU loading of both caches onto the job system
+		void SetJobSystem(MT::JobSystem* jobSystem);
+
+		// Imports of both caches go through a derived data cache in this directory
+		void SetCacheDirectory(const fs::path& directory);
+		[[nodiscard]] inline DerivedDataCache* GetDerivedDataCache() const { return m_derivedData.get(); }
+
 		[[nodiscard]] MeshHandle GetPrimitive(PrimitiveType type) const;
 		[[nodiscard]] Gfx::Mesh* GetPrimitiveGpu(PrimitiveType type);
 
-		void LoadAll();  // Force load
+		void LoadAll();  // Force load, CPU loads run in parallel when a job system is set
 		void InvalidateAll();
+		void AdvanceEpoch();  // Once per frame, frees GPU resources no frame in flight can still use
 
 	private:
 		void RegisterPrimitives();
 
 	private:
+		std::unique_ptr<DerivedDataCache> m_derivedData;  // Outlives both caches, their loads may still use it
 		MeshCache m_meshCache;
 		TextureCache m_textureCache;
 		std::array<MeshHandle, static_cast<u64>(PrimitiveType::MAX_COUNT)> m_primitives{};
@@ -0,0 +1,217 @@
+#pragma once
+#include "Asset/AssetHandle.h"
+#include <atomic>
+
+namespace Ryu::Asset
+{
+	// Read side of an AssetCache: a dense array of slots (state + GPU pointer) and an AssetId -> slot index
+	// hash table, both readable without locks. Writers are serialized by the owning cache.
+	// Nothing a reader can still see is freed right away. Old index tables and retired GPU resources wait
+	// RETIRE_AFTER_EPOCHS calls to AdvanceEpoch() (once per frame), so a pointer found during a frame stays
+	// valid for the frames in flight after it
+	template <typename TGpuResource>
+	class AssetSlotTable
+	{
+		RYU_DISABLE_COPY_AND_MOVE(AssetSlotTable)
+
+	public:
+		static constexpr u64 RETIRE_AFTER_EPOCHS = 3;
+		static constexpr u32 INVALID_SLOT        = ~0u;
+
+		struct Slot
+		{
+			std::atomic<AssetState>    State{ AssetState::Unloaded };
+			std::atomic<TGpuResource*> Gpu{ nullptr };
+		};
+
+	public:
+		AssetSlotTable() : m_index(new Index(INITIAL_INDEX_CAPACITY)) {}
+
+		~AssetSlotTable()
+		{
+			CollectRetired(~0ull);
+			delete m_index.load(std::memory_order_relaxed);
+			for (std::atomic<Slot*>& chunk : m_chunks)
+			{
+				delete[] chunk.load(std::memory_order_relaxed);
+			}
+		}
+
+		// Lock free. nullptr if the id has no slot
+		[[nodiscard]] const Slot* Find(AssetId id) const noexcept
+		{
+			const Index* index = m_index.load(std::memory_order_acquire);
+			for (u64 i = Hash(id) & index->Mask;; i = (i + 1) & index->Mask)
+			{
+				const AssetId cellId = index->Cells[i].Id.load(std::memory_order_acquire);
+				if (cellId == id)
+				{
+					return &GetSlot(index->Cells[i].Slot.load(std::memory_order_relaxed));
+				}
+				if (cellId == INVALID_ASSET_ID)
+				{
+					return nullptr;
+				}
+			}
+		}
+
+		// Lock free. The GPU resource if the asset is Ready, nullptr otherwise
+		[[nodiscard]] TGpuResource* FindReady(AssetId id) const noexcept
+		{
+			const Slot* slot = Find(id);
+			if (slot && slot->State.load(std::memory_order_acquire) == AssetState::Ready)
+			{
+				return slot->Gpu.load(std::memory_order_relaxed);
+			}
+			return nullptr;
+		}
+
+		// Writer only. Ids are never removed
+		u32 Insert(AssetId id)
+		{
+			RYU_ASSERT(id != INVALID_ASSET_ID, "Invalid asset id");
+
+			if ((m_count + 1) * 2 > m_index.load(std::memory_order_relaxed)->Capacity())
+			{
+				Grow();
+			}
+
+			const u32 slotIndex = m_count++;
+			if (slotIndex % SLOTS_PER_CHUNK == 0)
+			{
+				RYU_ASSERT(slotIndex / SLOTS_PER_CHUNK < MAX_CHUNKS, "Too many assets in one cache");
+				m_chunks[slotIndex / SLOTS_PER_CHUNK].store(new Slot[SLOTS_PER_CHUNK], std::memory_order_release);
+			}
+
+			Place(*m_index.load(std::memory_order_relaxed), id, slotIndex);
+			return slotIndex;
+		}
+
+		[[nodiscard]] Slot& GetSlot(u32 index) const noexcept
+		{
+			return m_chunks[index / SLOTS_PER_CHUNK].load(std::memory_order_acquire)[index % SLOTS_PER_CHUNK];
+		}
+
+		// Writer only. Publishing the pointer before the state lets readers trust Gpu once they see Ready
+		void Publish(u32 slotIndex, AssetState state, TGpuResource* gpu = nullptr) noexcept
+		{
+			Slot& slot = GetSlot(slotIndex);
+			if (state == AssetState::Ready)
+			{
+				slot.Gpu.store(gpu, std::memory_order_relaxed);
+				slot.State.store(state, std::memory_order_release);
+			}
+			else
+			{
+				slot.State.store(state, std::memory_order_release);
+				slot.Gpu.store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		// Writer only. Keeps ptr alive until readers of the current epoch are done with it
+		template <typename T>
+		void Retire(std::unique_ptr<T> ptr)
+		{
+			if (ptr)
+			{
+				m_retired.push_back(Retired{ m_epoch, ptr.release(), [](void* p) { delete static_cast<T*>(p); } });
+			}
+		}
+
+		// Writer only. Frees what was retired RETIRE_AFTER_EPOCHS epochs ago
+		void AdvanceEpoch()
+		{
+			++m_epoch;
+			if (m_epoch >= RETIRE_AFTER_EPOCHS)
+			{
+				CollectRetired(m_epoch - RETIRE_AFTER_EPOCHS);
+			}
+		}
+
+		[[nodiscard]] u32 GetCount() const noexcept { return m_count; }
+		[[nodiscard]] size_t GetRetiredCount() const noexcept { return m_retired.size(); }
+
+	private:
+		static constexpr u32 SLOTS_PER_CHUNK        = 256;
+		static constexpr u32 MAX_CHUNKS             = 1024;
+		static constexpr u64 INITIAL_INDEX_CAPACITY = 64;
+
+		struct Cell
+		{
+			std::atomic<AssetId> Id{ INVALID_ASSET_ID };
+			std::atomic<u32>     Slot{ INVALID_SLOT };
+		};
+
+		struct Index
+		{
+			explicit Index(u64 capacity) : Mask(capacity - 1), Cells(std::make_unique<Cell[]>(capacity)) {}
+			[[nodiscard]] u64 Capacity() const noexcept { return Mask + 1; }
+
+			u64                     Mask;
+			std::unique_ptr<Cell[]> Cells;
+		};
+
+		struct Retired
+		{
+			u64   Epoch;
+			void* Ptr;
+			void  (*Deleter)(void*);
+		};
+
+		// Ids are already hashes, but procedural ones can be close together
+		static constexpr u64 Hash(AssetId id) noexcept
+		{
+			return (id * 0x9E3779B97F4A7C15ull) >> 16;
+		}
+
+		static void Place(Index& index, AssetId id, u32 slotIndex) noexcept
+		{
+			u64 i = Hash(id) & index.Mask;
+			while (index.Cells[i].Id.load(std::memory_order_relaxed) != INVALID_ASSET_ID)
+			{
+				i = (i + 1) & index.Mask;
+			}
+
+			// Slot first, readers match on the id
+			index.Cells[i].Slot.store(slotIndex, std::memory_order_relaxed);
+			index.Cells[i].Id.store(id, std::memory_order_release);
+		}
+
+		void Grow()
+		{
+			Index* old   = m_index.load(std::memory_order_relaxed);
+			Index* grown = new Index(old->Capacity() * 2);
+
+			for (u64 i = 0; i < old->Capacity(); ++i)
+			{
+				if (const AssetId id = old->Cells[i].Id.load(std::memory_order_relaxed); id != INVALID_ASSET_ID)
+				{
+					Place(*grown, id, old->Cells[i].Slot.load(std::memory_order_relaxed));
+				}
+			}
+
+			m_index.store(grown, std::memory_order_release);
+			Retire(std::unique_ptr<Index>(old));
+		}
+
+		void CollectRetired(u64 upToEpoch)
+		{
+			std::erase_if(m_retired, [upToEpoch](const Retired& retired)
+			{
+				if (retired.Epoch <= upToEpoch)
+				{
+					retired.Deleter(retired.Ptr);
+					return true;
+				}
+				return false;
+			});
+		}
+
+	private:
+		std::atomic<Index*>                        m_index;
+		std::array<std::atomic<Slot*>, MAX_CHUNKS> m_chunks{};
+		u32                                        m_count = 0;
+		u64                                        m_epoch = 0;
+		std::vector<Retired>                       m_retired;
+	};
+}
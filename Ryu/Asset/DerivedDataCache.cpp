@@ -0,0 +1,111 @@
+#include "Asset/DerivedDataCache.h"
+#include "Core/Profiling/Profiling.h"
+#include "Core/Utils/MappedFile.h"
+#include <xxhash.h>
+#include <optional>
+
+namespace Ryu::Asset
+{
+	namespace
+	{
+		// Stands in for the bytes of a dependency that is not there
+		constexpr XXH64_hash_t MISSING_FILE_HASH = 0x9E3779B97F4A7C15ull;
+
+		// Chains the file's bytes onto seed, empty if it can not be read
+		std::optional<XXH64_hash_t> HashFile(const fs::path& path, XXH64_hash_t seed, u64& hashedBytes)
+		{
+			std::error_code ec;
+			const u64 size = fs::file_size(path, ec);
+			if (ec)
+			{
+				return std::nullopt;
+			}
+
+			if (size == 0)
+			{
+				return XXH3_64bits_withSeed(nullptr, 0, seed);
+			}
+
+			const Utils::MappedFile file(path);
+			if (!file.IsValid())
+			{
+				return std::nullopt;
+			}
+
+			hashedBytes += size;
+			return XXH3_64bits_withSeed(file.GetData().data(), file.GetSize(), seed);
+		}
+	}
+
+	DerivedDataCache::DerivedDataCache(fs::path directory)
+		: m_directory(std::move(directory))
+	{
+		std::error_code ec;
+		fs::create_directories(m_directory, ec);
+	}
+
+	DerivedDataCache::Key DerivedDataCache::MakeKey(const fs::path& sourcePath, u32 importerVersion, std::span<const std::byte> settings)
+	{
+		return MakeKey(sourcePath, {}, importerVersion, settings);
+	}
+
+	DerivedDataCache::Key DerivedDataCache::MakeKey(const fs::path& sourcePath, std::span<const fs::path> dependencies, u32 importerVersion,
+		std::span<const std::byte> settings)
+	{
+		RYU_PROFILE_SCOPE();
+
+		// The version and settings seed the hash of the source, one pass over each file either way
+		const XXH64_hash_t seed = XXH3_64bits_withSeed(settings.data(), settings.size(), importerVersion);
+
+		u64 hashedBytes = 0;
+		const std::optional<XXH64_hash_t> sourceHash = HashFile(sourcePath, seed, hashedBytes);
+		if (!sourceHash)
+		{
+			return INVALID_KEY;
+		}
+
+		// In order, each one seeds the next
+		Key key = *sourceHash;
+		for (const fs::path& dependency : dependencies)
+		{
+			key = HashFile(dependency, key, hashedBytes).value_or(key ^ MISSING_FILE_HASH);
+		}
+
+		m_hashedBytes.fetch_add(hashedBytes, std::memory_order_relaxed);
+		return key != INVALID_KEY ? key : 1;  // 0 is taken by INVALID_KEY
+	}
+
+	fs::path DerivedDataCache::GetPath(Key key, std::string_view extension) const
+	{
+		static constexpr char digits[] = "0123456789abcdef";
+
+		std::string name(16, '0');
+		for (u32 i = 0; i < 16; ++i)
+		{
+			name[15 - i] = digits[(key >> (4 * i)) & 0xF];
+		}
+
+		fs::path path = m_directory / name.substr(0, 2) / name;
+		path += extension;
+		return path;
+	}
+
+	DerivedDataCache::Stats DerivedDataCache::GetStats() const noexcept
+	{
+		return Stats
+		{
+			.Hits          = m_hits.load(std::memory_order_relaxed),
+			.Misses        = m_misses.load(std::memory_order_relaxed),
+			.StoreFailures = m_storeFailures.load(std::memory_order_relaxed),
+			.HashedBytes   = m_hashedBytes.load(std::memory_order_relaxed),
+		};
+	}
+
+	void DerivedDataCache::ResetStats() noexcept
+	{
+		m_hits.store(0, std::memory_order_relaxed);
+		m_misses.store(0, std::memory_order_relaxed);
+		m_storeFailures.store(0, std::memory_order_relaxed);
+		m_hashedBytes.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Core/Common/StandardTypes.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace Ryu::Asset
+{
+	namespace fs = std::filesystem;
+
+	// Cooked asset data on disk, named after what it was made from: an xxHash3 of the source file's bytes,
+	// any other files the importer reads, the importer version and its settings. Nothing in the key depends on where the source lives or when
+	// it was written, so unchanged assets skip importing across runs, checkouts and machines that share
+	// the directory. Safe to use from several loading threads at once
+	class DerivedDataCache
+	{
+		RYU_DISABLE_COPY_AND_MOVE(DerivedDataCache)
+
+	public:
+		using Key = u64;
+		static constexpr Key INVALID_KEY = 0;
+
+		struct Stats
+		{
+			u64 Hits          = 0;
+			u64 Misses        = 0;  // Imported, then stored
+			u64 StoreFailures = 0;
+			u64 HashedBytes   = 0;  // Source bytes read to make keys
+		};
+
+	public:
+		explicit DerivedDataCache(fs::path directory);
+
+		// INVALID_KEY if the source can not be read. Bump importerVersion whenever an importer's output
+		// changes, settings are the bytes of whatever else changes it
+		[[nodiscard]] Key MakeKey(const fs::path& sourcePath, u32 importerVersion, std::span<const std::byte> settings = {});
+
+		// Also hashes the other files the importer reads, like an OBJ's material libraries. Missing ones
+		// still make a key, the importer does without them as well
+		[[nodiscard]] Key MakeKey(const fs::path& sourcePath, std::span<const fs::path> dependencies, u32 importerVersion,
+			std::span<const std::byte> settings = {});
+
+		// Files are spread over 256 folders by the first byte of their key
+		[[nodiscard]] fs::path GetPath(Key key, std::string_view extension) const;
+
+		// The cached data for key if load(path) can read it, otherwise import() and store(data, path) it
+		template <typename T, typename Load, typename Import, typename Store>
+		std::unique_ptr<T> GetOrImport(Key key, std::string_view extension, Load&& load, Import&& import, Store&& store)
+		{
+			const fs::path path = GetPath(key, extension);
+
+			std::error_code ec;
+			if (fs::exists(path, ec))
+			{
+				if (std::unique_ptr<T> data = load(path))
+				{
+					m_hits.fetch_add(1, std::memory_order_relaxed);
+					return data;
+				}
+			}
+
+			m_misses.fetch_add(1, std::memory_order_relaxed);
+			std::unique_ptr<T> data = import();
+			if (data)
+			{
+				fs::create_directories(path.parent_path(), ec);
+				if (!store(*data, path))
+				{
+					m_storeFailures.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+			return data;
+		}
+
+		[[nodiscard]] const fs::path& GetDirectory() const noexcept { return m_directory; }
+		[[nodiscard]] Stats GetStats() const noexcept;
+		void ResetStats() noexcept;
+
+	private:
+		fs::path         m_directory;
+		std::atomic<u64> m_hits{ 0 };
+		std::atomic<u64> m_misses{ 0 };
+		std::atomic<u64> m_storeFailures{ 0 };
+		std::atomic<u64> m_hashedBytes{ 0 };
+	};
+}
@@ -0,0 +1,354 @@
+#include "Asset/Loaders/CookedMeshLoader.h"
+#include "Asset/AssetData.h"
+#include "Core/Logging/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+namespace Ryu::Asset
+{
+    namespace
+    {
+        constexpr u32 MAGIC             = 'R' | ('Y' << 8) | ('U' << 16) | ('M' << 24);
+        constexpr u64 SECTION_ALIGNMENT = 64;
+
+        struct FileHeader
+        {
+            u32 Magic;
+            u32 Version;
+            u32 VertexStride;
+            u32 VertexCount;
+            u32 IndexCount;
+            u32 SubMeshCount;
+            u32 MaterialCount;
+            u32 StringBytes;
+            u32 MeshletCount;
+            u32 MeshletVertexCount;
+            u32 MeshletTriangleBytes;
+            u32 LodCount;
+            u32 PackedVertexBytes;
+            VertexLayout PackedLayout;
+            u8 Reserved;
+            MeshBounds Bounds;
+            u64 VertexOffset;
+            u64 IndexOffset;
+            u64 SubMeshOffset;
+            u64 MaterialOffset;
+            u64 StringOffset;
+            u64 MeshletOffset;
+            u64 MeshletVertexOffset;
+            u64 MeshletTriangleOffset;
+            u64 LodOffset;
+            u64 PackedVertexOffset;
+            u64 FileSize;
+        };
+
+        struct StringRef
+        {
+            u32 Offset;
+            u32 Length;
+        };
+
+        struct CookedMaterial
+        {
+            std::array<f32, 4> Albedo;
+            f32 Metallic;
+            f32 Roughness;
+            StringRef Name;
+            StringRef AlbedoTexturePath;
+            StringRef NormalTexturePath;
+            StringRef MetallicRoughnessPath;
+        };
+
+        static_assert(std::is_trivially_copyable_v<MeshData::Vertex>);
+        static_assert(std::is_trivially_copyable_v<MeshData::SubMesh>);
+        static_assert(std::is_trivially_copyable_v<Meshlet>);
+        static_assert(std::is_trivially_copyable_v<MeshLod>);
+        static_assert(sizeof(MeshData::Vertex) % alignof(u32) == 0);
+        static_assert(sizeof(VertexLayout) == 3, "FileHeader pads the layout out to 4 bytes");
+
+        constexpr u64 AlignUp(u64 value) { return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1); }
+
+        // Sections are laid out back to back, each starting on an aligned offset
+        FileHeader MakeHeader(std::span<const MeshData::Vertex> vertices, std::span<const u32> indices,
+            std::span<const byte> packedVertices, const MeshData& mesh, u32 stringBytes)
+        {
+            FileHeader header
+            {
+                .Magic                = MAGIC,
+                .Version              = CookedMeshLoader::VERSION,
+                .VertexStride         = sizeof(MeshData::Vertex),
+                .VertexCount          = static_cast<u32>(vertices.size()),
+                .IndexCount           = static_cast<u32>(indices.size()),
+                .SubMeshCount         = static_cast<u32>(mesh.SubMeshes.size()),
+                .MaterialCount        = static_cast<u32>(mesh.Materials.size()),
+                .StringBytes          = stringBytes,
+                .MeshletCount         = static_cast<u32>(mesh.Meshlets.size()),
+                .MeshletVertexCount   = static_cast<u32>(mesh.MeshletVertices.size()),
+                .MeshletTriangleBytes = static_cast<u32>(mesh.MeshletTriangles.size()),
+                .LodCount             = static_cast<u32>(mesh.Lods.size()),
+                .PackedVertexBytes    = static_cast<u32>(packedVertices.size()),
+                .PackedLayout         = mesh.PackedLayout,
+                .Bounds               = mesh.Bounds,
+            };
+
+            header.VertexOffset          = AlignUp(sizeof(FileHeader));
+            header.IndexOffset           = AlignUp(header.VertexOffset + vertices.size_bytes());
+            header.SubMeshOffset         = AlignUp(header.IndexOffset + indices.size_bytes());
+            header.MaterialOffset        = AlignUp(header.SubMeshOffset + mesh.SubMeshes.size() * sizeof(MeshData::SubMesh));
+            header.StringOffset          = AlignUp(header.MaterialOffset + mesh.Materials.size() * sizeof(CookedMaterial));
+            header.MeshletOffset         = AlignUp(header.StringOffset + stringBytes);
+            header.MeshletVertexOffset   = AlignUp(header.MeshletOffset + mesh.Meshlets.size() * sizeof(Meshlet));
+            header.MeshletTriangleOffset = AlignUp(header.MeshletVertexOffset + mesh.MeshletVertices.size() * sizeof(u32));
+            header.LodOffset             = AlignUp(header.MeshletTriangleOffset + mesh.MeshletTriangles.size());
+            header.PackedVertexOffset    = AlignUp(header.LodOffset + mesh.Lods.size() * sizeof(MeshLod));
+            header.FileSize              = header.PackedVertexOffset + packedVertices.size();
+            return header;
+        }
+
+        bool SectionFits(const FileHeader& header, u64 offset, u64 size)
+        {
+            return offset % SECTION_ALIGNMENT == 0 && offset <= header.FileSize && size <= header.FileSize - offset;
+        }
+
+        bool IsValidLayout(const VertexLayout& layout)
+        {
+            return layout.Normal <= VertexLayout::NormalFormat::Octahedral16
+                && layout.TexCoord <= VertexLayout::TexCoordFormat::Half2
+                && layout.Color <= VertexLayout::ColorFormat::None;
+        }
+
+        // Packed vertices are optional, when there are some they cover every vertex
+        bool IsValidPackedSize(const FileHeader& header)
+        {
+            return header.PackedVertexBytes == 0 || header.PackedVertexBytes == u64(header.VertexCount) * header.PackedLayout.Stride();
+        }
+
+        bool IsValidHeader(const FileHeader& header, u64 fileSize)
+        {
+            return header.Magic == MAGIC
+                && header.Version == CookedMeshLoader::VERSION
+                && header.VertexStride == sizeof(MeshData::Vertex)
+                && header.FileSize == fileSize
+                && SectionFits(header, header.VertexOffset, u64(header.VertexCount) * sizeof(MeshData::Vertex))
+                && SectionFits(header, header.IndexOffset, u64(header.IndexCount) * sizeof(u32))
+                && SectionFits(header, header.SubMeshOffset, u64(header.SubMeshCount) * sizeof(MeshData::SubMesh))
+                && SectionFits(header, header.MaterialOffset, u64(header.MaterialCount) * sizeof(CookedMaterial))
+                && SectionFits(header, header.StringOffset, header.StringBytes)
+                && SectionFits(header, header.MeshletOffset, u64(header.MeshletCount) * sizeof(Meshlet))
+                && SectionFits(header, header.MeshletVertexOffset, u64(header.MeshletVertexCount) * sizeof(u32))
+                && SectionFits(header, header.MeshletTriangleOffset, header.MeshletTriangleBytes)
+                && SectionFits(header, header.LodOffset, u64(header.LodCount) * sizeof(MeshLod))
+                && IsValidLayout(header.PackedLayout)
+                && IsValidPackedSize(header)
+                && SectionFits(header, header.PackedVertexOffset, header.PackedVertexBytes);
+        }
+
+        bool RangeFits(u64 offset, u64 count, u64 size)
+        {
+            return offset <= size && count <= size - offset;
+        }
+
+        // Every range and index has to land inside the arrays it points into, a file that fits its sections
+        // can still hand the renderer an index past the end. This reads the whole index section once
+        bool HasValidRanges(const MeshData& mesh)
+        {
+            const u64 vertexCount = mesh.GetVertices().size();
+            const std::span<const u32> indices = mesh.GetIndices();
+
+            for (const MeshData::SubMesh& submesh : mesh.SubMeshes)
+            {
+                if (!RangeFits(submesh.IndexOffset, submesh.IndexCount, indices.size())
+                    || !RangeFits(submesh.MeshletOffset, submesh.MeshletCount, mesh.Meshlets.size()))
+                {
+                    return false;
+                }
+            }
+
+            for (const MeshLod& lod : mesh.Lods)
+            {
+                if (!RangeFits(lod.IndexOffset, lod.IndexCount, indices.size()))
+                {
+                    return false;
+                }
+            }
+
+            for (const Meshlet& meshlet : mesh.Meshlets)
+            {
+                if (meshlet.VertexCount > Meshlet::MAX_VERTICES
+                    || meshlet.TriangleCount > Meshlet::MAX_TRIANGLES
+                    || !RangeFits(meshlet.VertexOffset, meshlet.VertexCount, mesh.MeshletVertices.size())
+                    || !RangeFits(meshlet.TriangleOffset, u64(meshlet.TriangleCount) * 3, mesh.MeshletTriangles.size()))
+                {
+                    return false;
+                }
+
+                const auto triangles = std::span(mesh.MeshletTriangles).subspan(meshlet.TriangleOffset, meshlet.TriangleCount * 3);
+                if (std::ranges::any_of(triangles, [&meshlet](u8 local) { return local >= meshlet.VertexCount; }))
+                {
+                    return false;
+                }
+            }
+
+            auto isOutside = [vertexCount](u32 index) { return index >= vertexCount; };
+            return std::ranges::none_of(mesh.MeshletVertices, isOutside) && std::ranges::none_of(indices, isOutside);
+        }
+    }
+
+    std::unique_ptr<MeshData> CookedMeshLoader::Load(const fs::path& path)
+    {
+        auto file = std::make_shared<Utils::MappedFile>(path);
+        if (!file->IsValid() || file->GetSize() < sizeof(FileHeader))
+        {
+            return nullptr;
+        }
+
+        const byte* base = file->GetData().data();
+
+        FileHeader header;
+        std::memcpy(&header, base, sizeof(FileHeader));
+        if (!IsValidHeader(header, file->GetSize()))
+        {
+            RYU_LOG_WARN("Cooked mesh {} is invalid or out of date", path.filename().string());
+            return nullptr;
+        }
+
+        const std::string_view strings(reinterpret_cast<const char*>(base + header.StringOffset), header.StringBytes);
+        auto getString = [strings](StringRef ref) -> std::string
+        {
+            return ref.Offset <= strings.size() ? std::string(strings.substr(ref.Offset, ref.Length)) : std::string{};
+        };
+
+        auto mesh = std::make_unique<MeshData>();
+
+        mesh->SubMeshes.resize(header.SubMeshCount);
+        std::memcpy(mesh->SubMeshes.data(), base + header.SubMeshOffset, header.SubMeshCount * sizeof(MeshData::SubMesh));
+
+        mesh->Materials.reserve(header.MaterialCount);
+        for (u32 i = 0; i < header.MaterialCount; ++i)
+        {
+            CookedMaterial cooked;
+            std::memcpy(&cooked, base + header.MaterialOffset + i * sizeof(CookedMaterial), sizeof(CookedMaterial));
+            mesh->Materials.push_back(MeshData::Material
+            {
+                .Name                  = getString(cooked.Name),
+                .Albedo                = cooked.Albedo,
+                .Metallic              = cooked.Metallic,
+                .Roughness             = cooked.Roughness,
+                .AlbedoTexturePath     = getString(cooked.AlbedoTexturePath),
+                .NormalTexturePath     = getString(cooked.NormalTexturePath),
+                .MetallicRoughnessPath = getString(cooked.MetallicRoughnessPath),
+            });
+        }
+
+        // Meshlets are small next to the vertex data and get rebuilt by tools, so they are copied out
+        auto copySection = [base]<typename T>(std::vector<T>& out, u64 offset, u32 count)
+        {
+            out.resize(count);
+            std::memcpy(out.data(), base + offset, count * sizeof(T));
+        };
+        mesh->Bounds       = header.Bounds;
+        mesh->PackedLayout = header.PackedLayout;
+        copySection(mesh->Meshlets, header.MeshletOffset, header.MeshletCount);
+        copySection(mesh->MeshletVertices, header.MeshletVertexOffset, header.MeshletVertexCount);
+        copySection(mesh->MeshletTriangles, header.MeshletTriangleOffset, header.MeshletTriangleBytes);
+        copySection(mesh->Lods, header.LodOffset, header.LodCount);
+
+        // The big arrays stay in the mapping, pages are only read when something touches them
+        mesh->MappedVertices       = { reinterpret_cast<const MeshData::Vertex*>(base + header.VertexOffset), header.VertexCount };
+        mesh->MappedIndices        = { reinterpret_cast<const u32*>(base + header.IndexOffset), header.IndexCount };
+        mesh->MappedPackedVertices = { base + header.PackedVertexOffset, header.PackedVertexBytes };
+        mesh->Mapping              = std::move(file);
+
+        if (!HasValidRanges(*mesh))
+        {
+            RYU_LOG_WARN("Cooked mesh {} has ranges outside its data", path.filename().string());
+            return nullptr;
+        }
+
+        return mesh;
+    }
+
+    bool CookedMeshLoader::Write(const MeshData& mesh, const fs::path& path)
+    {
+        const std::span<const MeshData::Vertex> vertices = mesh.GetVertices();
+        const std::span<const u32> indices = mesh.GetIndices();
+        const std::span<const byte> packedVertices = mesh.GetPackedVertices();
+
+        std::string strings;
+        auto addString = [&strings](const std::string& str)
+        {
+            const StringRef ref{ static_cast<u32>(strings.size()), static_cast<u32>(str.size()) };
+            strings += str;
+            return ref;
+        };
+
+        std::vector<CookedMaterial> materials;
+        materials.reserve(mesh.Materials.size());
+        for (const MeshData::Material& material : mesh.Materials)
+        {
+            materials.push_back(CookedMaterial
+            {
+                .Albedo                = material.Albedo,
+                .Metallic              = material.Metallic,
+                .Roughness             = material.Roughness,
+                .Name                  = addString(material.Name),
+                .AlbedoTexturePath     = addString(material.AlbedoTexturePath),
+                .NormalTexturePath     = addString(material.NormalTexturePath),
+                .MetallicRoughnessPath = addString(material.MetallicRoughnessPath),
+            });
+        }
+
+        const FileHeader header = MakeHeader(vertices, indices, packedVertices, mesh, static_cast<u32>(strings.size()));
+
+        // Written next to the destination and renamed over it, so a reader never maps a half written file.
+        // The random suffix keeps writers of the same file, other threads or machines sharing a cache, apart
+        fs::path tempPath = path;
+        tempPath += ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+
+            auto writeAt = [&file](u64 offset, const void* data, u64 size)
+            {
+                static constexpr char padding[SECTION_ALIGNMENT]{};
+                const u64 position = static_cast<u64>(file.tellp());
+                file.write(padding, static_cast<std::streamsize>(offset - position));
+                file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+
+            writeAt(0, &header, sizeof(FileHeader));
+            writeAt(header.VertexOffset, vertices.data(), vertices.size_bytes());
+            writeAt(header.IndexOffset, indices.data(), indices.size_bytes());
+            writeAt(header.SubMeshOffset, mesh.SubMeshes.data(), mesh.SubMeshes.size() * sizeof(MeshData::SubMesh));
+            writeAt(header.MaterialOffset, materials.data(), materials.size() * sizeof(CookedMaterial));
+            writeAt(header.StringOffset, strings.data(), strings.size());
+            writeAt(header.MeshletOffset, mesh.Meshlets.data(), mesh.Meshlets.size() * sizeof(Meshlet));
+            writeAt(header.MeshletVertexOffset, mesh.MeshletVertices.data(), mesh.MeshletVertices.size() * sizeof(u32));
+            writeAt(header.MeshletTriangleOffset, mesh.MeshletTriangles.data(), mesh.MeshletTriangles.size());
+            writeAt(header.LodOffset, mesh.Lods.data(), mesh.Lods.size() * sizeof(MeshLod));
+            writeAt(header.PackedVertexOffset, packedVertices.data(), packedVertices.size());
+
+            if (!file)
+            {
+                file.close();
+                std::error_code ec;
+                fs::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec)
+        {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+}
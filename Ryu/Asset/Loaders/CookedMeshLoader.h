@@ -0,0 +1,20 @@
+#pragma once
+#include "Asset/AssetLoader.h"
+
+namespace Ryu::Asset
+{
+    struct MeshData;
+
+    // Binary .ryumesh files: a header followed by 64 byte aligned sections for vertices, indices, submeshes,
+    // materials and their strings, meshlets, LODs and packed vertices. Loading maps the file and points the mesh
+    // at it, so only the small sections get copied and nothing is parsed
+    class CookedMeshLoader
+    {
+    public:
+        static constexpr std::string_view EXTENSION = ".ryumesh";
+        static constexpr u32 VERSION                = 5;  // 5: packed vertices
+
+        static std::unique_ptr<MeshData> Load(const fs::path& path);
+        static bool Write(const MeshData& mesh, const fs::path& path);
+    };
+}
@@ -0,0 +1,130 @@
+#include "Asset/Loaders/CookedTextureLoader.h"
+#include "Asset/AssetData.h"
+#include "Core/Logging/Logger.h"
+#include <bit>
+#include <fstream>
+#include <random>
+
+namespace Ryu::Asset
+{
+    namespace
+    {
+        constexpr u32 TEXTURE_MAGIC = 'R' | ('Y' << 8) | ('U' << 16) | ('T' << 24);
+
+        struct TextureFileHeader
+        {
+            u32 Magic;
+            u32 Version;
+            u32 Width;
+            u32 Height;
+            u32 MipLevels;
+            u8  PixelFormat;
+            u8  SRGB;
+            u16 Padding;
+            u64 DataSize;
+        };
+
+        bool IsValidTextureHeader(const TextureFileHeader& header, u64 fileSize)
+        {
+            if (header.Magic != TEXTURE_MAGIC
+                || header.Version != CookedTextureLoader::VERSION
+                || header.Width == 0 || header.Height == 0
+                || header.MipLevels == 0 || header.MipLevels > static_cast<u32>(std::bit_width(std::max(header.Width, header.Height)))
+                || header.PixelFormat > static_cast<u8>(TextureData::Format::BC7)
+                || fileSize != sizeof(TextureFileHeader) + header.DataSize)
+            {
+                return false;
+            }
+
+            // The data has to be exactly the mip chain the header describes
+            TextureData layout;
+            layout.Width       = static_cast<i32>(header.Width);
+            layout.Height      = static_cast<i32>(header.Height);
+            layout.PixelFormat = static_cast<TextureData::Format>(header.PixelFormat);
+            return layout.MipOffset(header.MipLevels) == header.DataSize;
+        }
+    }
+
+    std::unique_ptr<TextureData> CookedTextureLoader::Load(const fs::path& path)
+    {
+        std::error_code ec;
+        const u64 fileSize = fs::file_size(path, ec);
+
+        std::ifstream file(path, std::ios::binary);
+        if (ec || !file || fileSize < sizeof(TextureFileHeader))
+        {
+            return nullptr;
+        }
+
+        TextureFileHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(TextureFileHeader));
+        if (!file || !IsValidTextureHeader(header, fileSize))
+        {
+            RYU_LOG_WARN("Cooked texture {} is invalid or out of date", path.filename().string());
+            return nullptr;
+        }
+
+        auto texture = std::make_unique<TextureData>();
+        texture->Width       = static_cast<i32>(header.Width);
+        texture->Height      = static_cast<i32>(header.Height);
+        texture->MipLevels   = static_cast<i32>(header.MipLevels);
+        texture->PixelFormat = static_cast<TextureData::Format>(header.PixelFormat);
+        texture->SRGB        = header.SRGB != 0;
+
+        texture->Data.resize(header.DataSize);
+        file.read(reinterpret_cast<char*>(texture->Data.data()), static_cast<std::streamsize>(header.DataSize));
+        if (!file)
+        {
+            return nullptr;
+        }
+
+        return texture;
+    }
+
+    bool CookedTextureLoader::Write(const TextureData& texture, const fs::path& path)
+    {
+        const TextureFileHeader header
+        {
+            .Magic       = TEXTURE_MAGIC,
+            .Version     = VERSION,
+            .Width       = static_cast<u32>(texture.Width),
+            .Height      = static_cast<u32>(texture.Height),
+            .MipLevels   = static_cast<u32>(texture.MipLevels),
+            .PixelFormat = static_cast<u8>(texture.PixelFormat),
+            .SRGB        = static_cast<u8>(texture.SRGB),
+            .Padding     = 0,
+            .DataSize    = texture.Data.size(),
+        };
+
+        // Same as cooked meshes, written aside and renamed over the destination
+        fs::path tempPath = path;
+        tempPath += ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(TextureFileHeader));
+            file.write(reinterpret_cast<const char*>(texture.Data.data()), static_cast<std::streamsize>(texture.Data.size()));
+
+            if (!file)
+            {
+                file.close();
+                std::error_code ec;
+                fs::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec)
+        {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+}
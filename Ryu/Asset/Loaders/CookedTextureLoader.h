@@ -0,0 +1,19 @@
+#pragma once
+#include "Asset/AssetLoader.h"
+
+namespace Ryu::Asset
+{
+    struct TextureData;
+
+    // Binary .ryutex files: a header followed by every mip level, exactly as TextureData::Data holds them,
+    // so loading is one read straight into the texture
+    class CookedTextureLoader
+    {
+    public:
+        static constexpr std::string_view EXTENSION = ".ryutex";
+        static constexpr u32 VERSION                = 1;
+
+        static std::unique_ptr<TextureData> Load(const fs::path& path);
+        static bool Write(const TextureData& texture, const fs::path& path);
+    };
+}
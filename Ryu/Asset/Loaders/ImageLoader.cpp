@@ -12,13 +12,23 @@ namespace Ryu::Asset
 
         RYU_LOG_TRACE("Trying to load image {}", path.string());
 
-        if (byte* pixels = ::stbi_load(path.string().c_str(), &width, &height, &channels, 0))
+        // GPUs have no 3 byte format, have stb add the alpha while it decodes instead of widening afterwards
+        const std::string pathString = path.string();
+        i32 desiredChannels = 0;
+        if (::stbi_info(pathString.c_str(), &width, &height, &channels) && channels == 3)
         {
-            u64 dataSize = static_cast<u64>(width * height * channels);
+            desiredChannels = 4;
+        }
+
+        if (byte* pixels = ::stbi_load(pathString.c_str(), &width, &height, &channels, desiredChannels))
+        {
+            channels = desiredChannels ? desiredChannels : channels;
+            u64 dataSize = static_cast<u64>(width) * height * channels;
 
             auto texture = std::make_unique<TextureData>();
             texture->Width = width;
             texture->Height = height;
+            texture->SRGB = true;  // stb decodes 8 bit images as they are meant to be displayed
             texture->Data.assign(pixels, pixels + dataSize);
 
             // Map channels to format
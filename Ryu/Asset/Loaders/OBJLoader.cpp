@@ -2,7 +2,9 @@
 #include "Asset/AssetData.h"
 #include "Core/Logging/Logger.h"
 #include <TinyOBJ/tiny_obj_loader.h>
+#include <cctype>
 #include <fstream>
+#include <sstream>
 
 namespace Ryu::Asset
 {
@@ -19,7 +21,8 @@ namespace Ryu::Asset
         std::vector<tinyobj::material_t> materials;
         std::string err;
 
-        tinyobj::MaterialFileReader mtlReader(path.parent_path().string());
+        // The reader puts the library name straight after this, so it needs the trailing separator
+        tinyobj::MaterialFileReader mtlReader((path.parent_path() / "").string());
 
         if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &err, &ifs, &mtlReader))
         {
@@ -43,8 +46,15 @@ namespace Ryu::Asset
             mesh->Materials.push_back(m);
         }
 
-        // Build interleaved vertices (unindex the mesh for GPU)
-        //u32 indexOffset = 0;
+        size_t cornerCount = 0;
+        for (const auto& shape : shapes)
+        {
+            cornerCount += shape.mesh.indices.size();
+        }
+        mesh->Vertices.reserve(cornerCount);
+        mesh->Indices.reserve(cornerCount);
+
+        // Build interleaved vertices, one per corner. MeshOptimizer welds them afterwards
         for (const auto& shape : shapes)
         {
             MeshData::SubMesh submesh;
@@ -99,4 +109,28 @@ namespace Ryu::Asset
 
         return mesh;
     }
+
+    std::vector<fs::path> OBJLoader::GetMaterialLibraries(const fs::path& path)
+    {
+        std::vector<fs::path> libraries;
+        std::ifstream ifs(path);
+
+        // "mtllib a.mtl b.mtl", the loader takes the first one it can read
+        std::string line;
+        while (std::getline(ifs, line))
+        {
+            const size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line.compare(start, 6, "mtllib") != 0 || start + 6 >= line.size() || !std::isspace(static_cast<u8>(line[start + 6])))
+            {
+                continue;
+            }
+
+            std::istringstream names(line.substr(start + 7));
+            for (std::string name; names >> name; )
+            {
+                libraries.push_back(path.parent_path() / name);
+            }
+        }
+        return libraries;
+    }
 }
@@ -9,5 +9,8 @@ namespace Ryu::Asset
     {
     public:
         static std::unique_ptr<MeshData> Load(const fs::path& path);
+
+        // The material libraries the file names, Load reads them from next to it
+        static std::vector<fs::path> GetMaterialLibraries(const fs::path& path);
     };
 }
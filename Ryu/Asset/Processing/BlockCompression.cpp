@@ -0,0 +1,715 @@
+#include "Asset/Processing/BlockCompression.h"
+#include "Core/Profiling/Profiling.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Ryu::Asset::BlockCompression
+{
+	namespace
+	{
+		using Format = TextureData::Format;
+
+		template <u32 N>
+		using Vec = std::array<f32, N>;
+
+		constexpr u32 TEXEL_COUNT = BLOCK_DIM * BLOCK_DIM;
+
+		// How much of the first endpoint each BC1 palette entry takes: c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+		constexpr std::array<f32, 4> BC1_WEIGHTS{ 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		// BC7 4 bit index weights of the second endpoint, out of 64
+		constexpr std::array<i32, 16> BC7_WEIGHTS{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+		constexpr u32 BC7_MODE_6 = 1u << 6;
+
+		constexpr u32 ENDPOINT_REFINEMENTS = 2;
+
+		// Blocks are little endian bit streams, least significant bit first
+		struct BitStream
+		{
+			std::array<u64, 2> Bits{};
+			u32 Position = 0;
+
+			void Write(u64 value, u32 count)
+			{
+				for (u32 i = 0; i < count; ++i, ++Position)
+				{
+					Bits[Position / 64] |= ((value >> i) & 1) << (Position % 64);
+				}
+			}
+
+			u32 Read(u32 count)
+			{
+				u32 value = 0;
+				for (u32 i = 0; i < count; ++i, ++Position)
+				{
+					value |= static_cast<u32>((Bits[Position / 64] >> (Position % 64)) & 1) << i;
+				}
+				return value;
+			}
+		};
+
+		// Mean of the first N channels and the direction they spread the most along, by power iteration
+		// on their covariance. A zero axis means every texel is the same
+		template <u32 N>
+		Vec<N> PrincipalAxis(const Texels& texels, Vec<N>& mean)
+		{
+			mean = {};
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				for (u32 c = 0; c < N; ++c)
+				{
+					mean[c] += texels[i * 4 + c];
+				}
+			}
+			for (f32& m : mean)
+			{
+				m /= TEXEL_COUNT;
+			}
+
+			std::array<Vec<N>, N> covariance{};
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				for (u32 a = 0; a < N; ++a)
+				{
+					for (u32 b = 0; b < N; ++b)
+					{
+						covariance[a][b] += (texels[i * 4 + a] - mean[a]) * (texels[i * 4 + b] - mean[b]);
+					}
+				}
+			}
+
+			// Starting from the row of the widest channel is never orthogonal to the answer
+			u32 widest = 0;
+			for (u32 c = 1; c < N; ++c)
+			{
+				widest = covariance[c][c] > covariance[widest][widest] ? c : widest;
+			}
+
+			Vec<N> axis = covariance[widest];
+			for (u32 iteration = 0; iteration < 8; ++iteration)
+			{
+				Vec<N> next{};
+				f32 largest = 0.0f;
+				for (u32 a = 0; a < N; ++a)
+				{
+					for (u32 b = 0; b < N; ++b)
+					{
+						next[a] += covariance[a][b] * axis[b];
+					}
+					largest = std::max(largest, std::abs(next[a]));
+				}
+				if (largest < 1e-6f)
+				{
+					return {};
+				}
+				for (u32 c = 0; c < N; ++c)
+				{
+					axis[c] = next[c] / largest;
+				}
+			}
+
+			f32 length = 0.0f;
+			for (f32 v : axis)
+			{
+				length += v * v;
+			}
+			length = std::sqrt(length);
+			for (f32& v : axis)
+			{
+				v /= length;
+			}
+			return axis;
+		}
+
+		// The two ends of the texels projected onto the axis through their mean
+		template <u32 N>
+		void FindEndpoints(const Texels& texels, Vec<N>& e0, Vec<N>& e1, f32 inset)
+		{
+			Vec<N> mean;
+			const Vec<N> axis = PrincipalAxis<N>(texels, mean);
+
+			f32 minT = 0.0f, maxT = 0.0f;
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				f32 t = 0.0f;
+				for (u32 c = 0; c < N; ++c)
+				{
+					t += (texels[i * 4 + c] - mean[c]) * axis[c];
+				}
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+
+			const f32 pull = (maxT - minT) * inset;
+			for (u32 c = 0; c < N; ++c)
+			{
+				e0[c] = mean[c] + axis[c] * (maxT - pull);
+				e1[c] = mean[c] + axis[c] * (minT + pull);
+			}
+		}
+
+		// Least squares endpoints for fixed palette choices, texel i being weights[i] e0 + (1 - weights[i]) e1
+		template <u32 N>
+		bool SolveEndpoints(const Texels& texels, const std::array<f32, TEXEL_COUNT>& weights, Vec<N>& e0, Vec<N>& e1)
+		{
+			f32 aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			Vec<N> ax{}, bx{};
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				const f32 a = weights[i], b = 1.0f - weights[i];
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (u32 c = 0; c < N; ++c)
+				{
+					ax[c] += a * texels[i * 4 + c];
+					bx[c] += b * texels[i * 4 + c];
+				}
+			}
+
+			const f32 det = aa * bb - ab * ab;
+			if (std::abs(det) < 1e-6f)
+			{
+				return false;  // Every texel picked the same entry
+			}
+
+			for (u32 c = 0; c < N; ++c)
+			{
+				e0[c] = (ax[c] * bb - bx[c] * ab) / det;
+				e1[c] = (bx[c] * aa - ax[c] * ab) / det;
+			}
+			return true;
+		}
+
+		// BC1 color --------------------------------------------------------------------------------------------
+
+		struct ColorFit
+		{
+			u16 C0 = 0;
+			u16 C1 = 0;
+			u32 Indices = 0;  // 2 bits per texel
+			i32 Error = 0;
+		};
+
+		u16 PackRGB565(const Vec<3>& color)
+		{
+			auto quantize = [](f32 value, f32 max) { return static_cast<u16>(std::clamp(value * max / 255.0f + 0.5f, 0.0f, max)); };
+			return static_cast<u16>(quantize(color[0], 31.0f) << 11 | quantize(color[1], 63.0f) << 5 | quantize(color[2], 31.0f));
+		}
+
+		std::array<i32, 3> UnpackRGB565(u16 color)
+		{
+			const i32 r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+			return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+		}
+
+		// Four color palette. With c0 <= c1 BC1 instead has a midpoint and transparent black
+		std::array<std::array<i32, 3>, 4> ColorPalette(u16 c0, u16 c1, bool fourColors)
+		{
+			const std::array<i32, 3> p0 = UnpackRGB565(c0), p1 = UnpackRGB565(c1);
+			std::array<std::array<i32, 3>, 4> palette{ p0, p1 };
+			for (u32 c = 0; c < 3; ++c)
+			{
+				palette[2][c] = fourColors ? (2 * p0[c] + p1[c] + 1) / 3 : (p0[c] + p1[c] + 1) / 2;
+				palette[3][c] = fourColors ? (p0[c] + 2 * p1[c] + 1) / 3 : 0;
+			}
+			return palette;
+		}
+
+		ColorFit FitColor(const Texels& texels, u16 c0, u16 c1)
+		{
+			const auto palette = ColorPalette(c0, c1, true);
+
+			ColorFit fit{ .C0 = c0, .C1 = c1 };
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				i32 bestError = std::numeric_limits<i32>::max();
+				u32 best = 0;
+				for (u32 p = 0; p < 4; ++p)
+				{
+					i32 error = 0;
+					for (u32 c = 0; c < 3; ++c)
+					{
+						const i32 d = texels[i * 4 + c] - palette[p][c];
+						error += d * d;
+					}
+					if (error < bestError)
+					{
+						bestError = error;
+						best = p;
+					}
+				}
+				fit.Indices |= best << (2 * i);
+				fit.Error += bestError;
+			}
+			return fit;
+		}
+
+		void EncodeColor(const Texels& texels, byte* block)
+		{
+			// The extremes are rarely worth a palette entry of their own, pull them in a sixteenth
+			Vec<3> e0, e1;
+			FindEndpoints<3>(texels, e0, e1, 1.0f / 16.0f);
+			ColorFit best = FitColor(texels, PackRGB565(e0), PackRGB565(e1));
+
+			for (u32 iteration = 0; iteration < ENDPOINT_REFINEMENTS && best.Error > 0; ++iteration)
+			{
+				std::array<f32, TEXEL_COUNT> weights;
+				for (u32 i = 0; i < TEXEL_COUNT; ++i)
+				{
+					weights[i] = BC1_WEIGHTS[(best.Indices >> (2 * i)) & 3];
+				}
+				if (!SolveEndpoints<3>(texels, weights, e0, e1))
+				{
+					break;
+				}
+
+				const ColorFit fit = FitColor(texels, PackRGB565(e0), PackRGB565(e1));
+				if (fit.Error >= best.Error)
+				{
+					break;
+				}
+				best = fit;
+			}
+
+			// c0 > c1 selects four colors. Swapping the ends swaps entries 0 <-> 1 and 2 <-> 3
+			if (best.C0 < best.C1)
+			{
+				std::swap(best.C0, best.C1);
+				best.Indices ^= 0x55555555u;
+			}
+			else if (best.C0 == best.C1)
+			{
+				best.Indices = 0;
+			}
+
+			std::memcpy(block, &best.C0, 2);
+			std::memcpy(block + 2, &best.C1, 2);
+			std::memcpy(block + 4, &best.Indices, 4);
+		}
+
+		void DecodeColor(const byte* block, Texels& texels, bool allowThreeColors)
+		{
+			u16 c0, c1;
+			u32 indices;
+			std::memcpy(&c0, block, 2);
+			std::memcpy(&c1, block + 2, 2);
+			std::memcpy(&indices, block + 4, 4);
+
+			const bool fourColors = !allowThreeColors || c0 > c1;
+			const auto palette = ColorPalette(c0, c1, fourColors);
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				const u32 index = (indices >> (2 * i)) & 3;
+				for (u32 c = 0; c < 3; ++c)
+				{
+					texels[i * 4 + c] = static_cast<u8>(palette[index][c]);
+				}
+				texels[i * 4 + 3] = !fourColors && index == 3 ? 0 : 0xFF;
+			}
+		}
+
+		// BC4 channel, as BC3 alpha and both halves of BC5 --------------------------------------------------------
+
+		std::array<i32, 8> ChannelPalette(i32 a0, i32 a1)
+		{
+			std::array<i32, 8> palette{ a0, a1 };
+			if (a0 > a1)
+			{
+				for (i32 i = 2; i < 8; ++i)
+				{
+					palette[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+				}
+			}
+			else
+			{
+				for (i32 i = 2; i < 6; ++i)
+				{
+					palette[i] = ((6 - i) * a0 + (i - 1) * a1 + 2) / 5;
+				}
+				palette[6] = 0;
+				palette[7] = 0xFF;
+			}
+			return palette;
+		}
+
+		void EncodeChannel(const Texels& texels, u32 channel, byte* block)
+		{
+			u8 lo = 0xFF, hi = 0;
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				lo = std::min(lo, texels[i * 4 + channel]);
+				hi = std::max(hi, texels[i * 4 + channel]);
+			}
+
+			// hi > lo picks eight evenly spaced values. A flat block leaves every index on hi
+			u64 indices = 0;
+			if (hi > lo)
+			{
+				const auto palette = ChannelPalette(hi, lo);
+				for (u32 i = 0; i < TEXEL_COUNT; ++i)
+				{
+					u32 best = 0;
+					for (u32 p = 1; p < 8; ++p)
+					{
+						if (std::abs(texels[i * 4 + channel] - palette[p]) < std::abs(texels[i * 4 + channel] - palette[best]))
+						{
+							best = p;
+						}
+					}
+					indices |= u64(best) << (3 * i);
+				}
+			}
+
+			block[0] = hi;
+			block[1] = lo;
+			for (u32 b = 0; b < 6; ++b)
+			{
+				block[2 + b] = static_cast<byte>(indices >> (8 * b));
+			}
+		}
+
+		void DecodeChannel(const byte* block, Texels& texels, u32 channel)
+		{
+			u64 indices = 0;
+			for (u32 b = 0; b < 6; ++b)
+			{
+				indices |= u64(block[2 + b]) << (8 * b);
+			}
+
+			const auto palette = ChannelPalette(block[0], block[1]);
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				texels[i * 4 + channel] = static_cast<u8>(palette[(indices >> (3 * i)) & 7]);
+			}
+		}
+
+		// BC7 mode 6 ---------------------------------------------------------------------------------------------
+
+		// 7 bits per channel plus a p-bit shared by the channels, making 8 bit values
+		struct BC7Endpoint
+		{
+			std::array<u8, 4> Q{};
+			u8 P = 0;
+
+			[[nodiscard]] i32 Get(u32 c) const { return Q[c] << 1 | P; }
+		};
+
+		struct BC7Fit
+		{
+			BC7Endpoint E0;
+			BC7Endpoint E1;
+			u64 Indices = 0;  // 4 bits per texel
+			i32 Error = 0;
+		};
+
+		BC7Endpoint QuantizeBC7(const Vec<4>& value)
+		{
+			BC7Endpoint best;
+			f32 bestError = std::numeric_limits<f32>::max();
+			for (u8 p = 0; p < 2; ++p)
+			{
+				BC7Endpoint endpoint{ .P = p };
+				f32 error = 0.0f;
+				for (u32 c = 0; c < 4; ++c)
+				{
+					endpoint.Q[c] = static_cast<u8>(std::clamp((value[c] - p) * 0.5f + 0.5f, 0.0f, 127.0f));
+					const f32 d = value[c] - endpoint.Get(c);
+					error += d * d;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					best = endpoint;
+				}
+			}
+			return best;
+		}
+
+		std::array<std::array<i32, 4>, 16> BC7Palette(const BC7Endpoint& e0, const BC7Endpoint& e1)
+		{
+			std::array<std::array<i32, 4>, 16> palette;
+			for (u32 p = 0; p < 16; ++p)
+			{
+				for (u32 c = 0; c < 4; ++c)
+				{
+					palette[p][c] = ((64 - BC7_WEIGHTS[p]) * e0.Get(c) + BC7_WEIGHTS[p] * e1.Get(c) + 32) >> 6;
+				}
+			}
+			return palette;
+		}
+
+		// Nearest index for each weight out of 64
+		constexpr std::array<u8, 65> BC7_INDEX_FOR_WEIGHT = []
+		{
+			std::array<u8, 65> table{};
+			for (i32 w = 0; w <= 64; ++w)
+			{
+				for (u8 i = 1; i < 16; ++i)
+				{
+					table[w] = std::abs(BC7_WEIGHTS[i] - w) < std::abs(BC7_WEIGHTS[table[w]] - w) ? i : table[w];
+				}
+			}
+			return table;
+		}();
+
+		// The palette lies on the line between the endpoints, so projecting onto it finds the nearest
+		// entry without trying all sixteen
+		BC7Fit FitBC7(const Texels& texels, const BC7Endpoint& e0, const BC7Endpoint& e1)
+		{
+			const auto palette = BC7Palette(e0, e1);
+
+			std::array<i32, 4> direction;
+			i32 lengthSq = 0;
+			for (u32 c = 0; c < 4; ++c)
+			{
+				direction[c] = e1.Get(c) - e0.Get(c);
+				lengthSq += direction[c] * direction[c];
+			}
+
+			BC7Fit fit{ .E0 = e0, .E1 = e1 };
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				u32 index = 0;
+				if (lengthSq > 0)
+				{
+					i32 t = 0;
+					for (u32 c = 0; c < 4; ++c)
+					{
+						t += (texels[i * 4 + c] - e0.Get(c)) * direction[c];
+					}
+					index = BC7_INDEX_FOR_WEIGHT[std::clamp((t * 64 + lengthSq / 2) / lengthSq, 0, 64)];
+				}
+
+				for (u32 c = 0; c < 4; ++c)
+				{
+					const i32 d = texels[i * 4 + c] - palette[index][c];
+					fit.Error += d * d;
+				}
+				fit.Indices |= u64(index) << (4 * i);
+			}
+			return fit;
+		}
+
+		void EncodeBC7(const Texels& texels, byte* block)
+		{
+			Vec<4> e0, e1;
+			FindEndpoints<4>(texels, e0, e1, 0.0f);
+			BC7Fit best = FitBC7(texels, QuantizeBC7(e0), QuantizeBC7(e1));
+
+			for (u32 iteration = 0; iteration < ENDPOINT_REFINEMENTS && best.Error > 0; ++iteration)
+			{
+				std::array<f32, TEXEL_COUNT> weights;
+				for (u32 i = 0; i < TEXEL_COUNT; ++i)
+				{
+					weights[i] = 1.0f - BC7_WEIGHTS[(best.Indices >> (4 * i)) & 15] / 64.0f;
+				}
+				if (!SolveEndpoints<4>(texels, weights, e0, e1))
+				{
+					break;
+				}
+
+				const BC7Fit fit = FitBC7(texels, QuantizeBC7(e0), QuantizeBC7(e1));
+				if (fit.Error >= best.Error)
+				{
+					break;
+				}
+				best = fit;
+			}
+
+			// The first index is stored without its top bit. Weights are symmetric, so swapping the ends
+			// and flipping every index (15 - i) gives the same block
+			if ((best.Indices & 15) >= 8)
+			{
+				std::swap(best.E0, best.E1);
+				best.Indices = ~best.Indices;
+			}
+
+			BitStream bits;
+			bits.Write(BC7_MODE_6, 7);
+			for (u32 c = 0; c < 4; ++c)
+			{
+				bits.Write(best.E0.Q[c], 7);
+				bits.Write(best.E1.Q[c], 7);
+			}
+			bits.Write(best.E0.P, 1);
+			bits.Write(best.E1.P, 1);
+			bits.Write(best.Indices & 7, 3);
+			for (u32 i = 1; i < TEXEL_COUNT; ++i)
+			{
+				bits.Write((best.Indices >> (4 * i)) & 15, 4);
+			}
+			std::memcpy(block, bits.Bits.data(), 16);
+		}
+
+		void DecodeBC7(const byte* block, Texels& texels)
+		{
+			BitStream bits;
+			std::memcpy(bits.Bits.data(), block, 16);
+			if (bits.Read(7) != BC7_MODE_6)
+			{
+				RYU_ASSERT(false, "Only BC7 mode 6 blocks can be decoded");
+				texels.fill(0);
+				return;
+			}
+
+			BC7Endpoint e0, e1;
+			for (u32 c = 0; c < 4; ++c)
+			{
+				e0.Q[c] = static_cast<u8>(bits.Read(7));
+				e1.Q[c] = static_cast<u8>(bits.Read(7));
+			}
+			e0.P = static_cast<u8>(bits.Read(1));
+			e1.P = static_cast<u8>(bits.Read(1));
+
+			const auto palette = BC7Palette(e0, e1);
+			for (u32 i = 0; i < TEXEL_COUNT; ++i)
+			{
+				const u32 index = bits.Read(i == 0 ? 3 : 4);
+				for (u32 c = 0; c < 4; ++c)
+				{
+					texels[i * 4 + c] = static_cast<u8>(palette[index][c]);
+				}
+			}
+		}
+	}
+
+	void EncodeBlock(TextureData::Format format, const Texels& texels, byte* block)
+	{
+		switch (format)
+		{
+			case Format::BC1: EncodeColor(texels, block); break;
+			case Format::BC3: EncodeChannel(texels, 3, block); EncodeColor(texels, block + 8); break;
+			case Format::BC5: EncodeChannel(texels, 0, block); EncodeChannel(texels, 1, block + 8); break;
+			case Format::BC7: EncodeBC7(texels, block); break;
+			default: RYU_ASSERT(false, "Not a block compressed format"); break;
+		}
+	}
+
+	void DecodeBlock(TextureData::Format format, const byte* block, Texels& texels)
+	{
+		switch (format)
+		{
+			case Format::BC1:
+				DecodeColor(block, texels, true);
+				break;
+
+			case Format::BC3:
+				DecodeColor(block + 8, texels, false);
+				DecodeChannel(block, texels, 3);
+				break;
+
+			case Format::BC5:
+				DecodeChannel(block, texels, 0);
+				DecodeChannel(block + 8, texels, 1);
+				for (u32 i = 0; i < TEXEL_COUNT; ++i)
+				{
+					texels[i * 4 + 2] = 0;
+					texels[i * 4 + 3] = 0xFF;
+				}
+				break;
+
+			case Format::BC7:
+				DecodeBC7(block, texels);
+				break;
+
+			default:
+				RYU_ASSERT(false, "Not a block compressed format");
+				break;
+		}
+	}
+
+	void Compress(TextureData& texture, TextureData::Format format)
+	{
+		RYU_PROFILE_SCOPE();
+
+		TextureData compressed;
+		compressed.Width       = texture.Width;
+		compressed.Height      = texture.Height;
+		compressed.MipLevels   = texture.MipLevels;
+		compressed.PixelFormat = format;
+
+		RYU_ASSERT(texture.PixelFormat == Format::RGBA8 && compressed.IsBlockCompressed(), "Compression goes from RGBA8 to a BC format");
+		if (texture.PixelFormat != Format::RGBA8 || !compressed.IsBlockCompressed())
+		{
+			return;
+		}
+
+		compressed.Data.resize(compressed.MipOffset(compressed.MipLevels));
+		const u32 blockBytes = compressed.BytesPerBlock();
+
+		for (u32 mip = 0; mip < static_cast<u32>(texture.MipLevels); ++mip)
+		{
+			const u32 width = texture.MipWidth(mip), height = texture.MipHeight(mip);
+			const byte* src = texture.Data.data() + texture.MipOffset(mip);
+			byte* dst = compressed.Data.data() + compressed.MipOffset(mip);
+
+			Texels texels;
+			for (u32 by = 0; by < compressed.MipRowCount(mip); ++by)
+			{
+				for (u32 bx = 0; bx < (width + BLOCK_DIM - 1) / BLOCK_DIM; ++bx)
+				{
+					for (u32 y = 0; y < BLOCK_DIM; ++y)
+					{
+						const u32 sy = std::min(by * BLOCK_DIM + y, height - 1);
+						for (u32 x = 0; x < BLOCK_DIM; ++x)
+						{
+							const u32 sx = std::min(bx * BLOCK_DIM + x, width - 1);
+							std::memcpy(&texels[(y * BLOCK_DIM + x) * 4], src + (u64(sy) * width + sx) * 4, 4);
+						}
+					}
+
+					EncodeBlock(format, texels, dst);
+					dst += blockBytes;
+				}
+			}
+		}
+
+		texture.PixelFormat = format;
+		texture.Data        = std::move(compressed.Data);
+	}
+
+	void Decompress(TextureData& texture)
+	{
+		if (!texture.IsBlockCompressed())
+		{
+			return;
+		}
+
+		TextureData rgba;
+		rgba.Width     = texture.Width;
+		rgba.Height    = texture.Height;
+		rgba.MipLevels = texture.MipLevels;
+		rgba.Data.resize(rgba.MipOffset(rgba.MipLevels));
+
+		const u32 blockBytes = texture.BytesPerBlock();
+		for (u32 mip = 0; mip < static_cast<u32>(texture.MipLevels); ++mip)
+		{
+			const u32 width = texture.MipWidth(mip), height = texture.MipHeight(mip);
+			const byte* src = texture.Data.data() + texture.MipOffset(mip);
+			byte* dst = rgba.Data.data() + rgba.MipOffset(mip);
+
+			Texels texels;
+			for (u32 by = 0; by < texture.MipRowCount(mip); ++by)
+			{
+				for (u32 bx = 0; bx < (width + BLOCK_DIM - 1) / BLOCK_DIM; ++bx)
+				{
+					DecodeBlock(texture.PixelFormat, src, texels);
+					src += blockBytes;
+
+					for (u32 y = 0; y < BLOCK_DIM && by * BLOCK_DIM + y < height; ++y)
+					{
+						for (u32 x = 0; x < BLOCK_DIM && bx * BLOCK_DIM + x < width; ++x)
+						{
+							std::memcpy(dst + (u64(by * BLOCK_DIM + y) * width + bx * BLOCK_DIM + x) * 4, &texels[(y * BLOCK_DIM + x) * 4], 4);
+						}
+					}
+				}
+			}
+		}
+
+		texture.PixelFormat = Format::RGBA8;
+		texture.Data        = std::move(rgba.Data);
+	}
+}
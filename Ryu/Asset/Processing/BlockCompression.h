@@ -0,0 +1,24 @@
+#pragma once
+#include "Asset/AssetData.h"
+
+namespace Ryu::Asset::BlockCompression
+{
+	constexpr u32 BLOCK_DIM = 4;
+
+	// A 4x4 block of RGBA8 texels, row by row
+	using Texels = std::array<u8, BLOCK_DIM * BLOCK_DIM * 4>;
+
+	// Writes TextureData::BytesPerBlock() bytes. BC1 is opaque, BC5 keeps red and green, and BC7 only
+	// uses mode 6 (one RGBA endpoint pair with 4 bit indices), which suits smooth blocks best
+	void EncodeBlock(TextureData::Format format, const Texels& texels, byte* block);
+
+	// Inverse of EncodeBlock. BC7 blocks are only understood in mode 6
+	void DecodeBlock(TextureData::Format format, const byte* block, Texels& texels);
+
+	// Compresses every mip of an RGBA8 texture to format. Blocks past the edge of a level repeat its
+	// last row and column. D3D12 also needs the top level to be a whole number of blocks
+	void Compress(TextureData& texture, TextureData::Format format);
+
+	// Back to RGBA8, for tools and tests
+	void Decompress(TextureData& texture);
+}
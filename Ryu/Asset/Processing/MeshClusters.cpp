@@ -0,0 +1,270 @@
+#include "Asset/Processing/MeshClusters.h"
+#include "Core/Profiling/Profiling.h"
+#include <algorithm>
+#include <cmath>
+#include <ranges>
+
+namespace Ryu::Asset::MeshClusters
+{
+	namespace
+	{
+		using Float3 = std::array<f32, 3>;
+
+		// Normals spreading wider than this never face away all at once, not worth a cone test
+		constexpr f32 MIN_CONE_DOT   = 0.1f;
+		constexpr u8  NOT_IN_MESHLET = 0xFF;
+
+		Float3 Sub(const Float3& a, const Float3& b) { return { a[0] - b[0], a[1] - b[1], a[2] - b[2] }; }
+		f32 Dot(const Float3& a, const Float3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+		f32 Length(const Float3& v) { return std::sqrt(Dot(v, v)); }
+
+		Float3 Cross(const Float3& a, const Float3& b)
+		{
+			return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+		}
+
+		// Box in one pass, then a Ritter sphere seeded from the box's most distant pair of extreme points
+		template <typename Positions>
+		MeshBounds ComputeBoundsOf(const Positions& positions)
+		{
+			MeshBounds bounds;
+			if (std::ranges::empty(positions))
+			{
+				return bounds;
+			}
+
+			Float3 minPoint[3], maxPoint[3];
+			bounds.Min = bounds.Max = *std::ranges::begin(positions);
+			std::ranges::fill(minPoint, bounds.Min);
+			std::ranges::fill(maxPoint, bounds.Min);
+
+			for (const Float3& p : positions)
+			{
+				for (u32 axis = 0; axis < 3; ++axis)
+				{
+					if (p[axis] < bounds.Min[axis]) { bounds.Min[axis] = p[axis]; minPoint[axis] = p; }
+					if (p[axis] > bounds.Max[axis]) { bounds.Max[axis] = p[axis]; maxPoint[axis] = p; }
+				}
+			}
+
+			u32 widest = 0;
+			for (u32 axis = 1; axis < 3; ++axis)
+			{
+				const Float3 d = Sub(maxPoint[axis], minPoint[axis]);
+				const Float3 w = Sub(maxPoint[widest], minPoint[widest]);
+				widest = Dot(d, d) > Dot(w, w) ? axis : widest;
+			}
+
+			const Float3& a = minPoint[widest];
+			const Float3& b = maxPoint[widest];
+			Float3 center   = { (a[0] + b[0]) * 0.5f, (a[1] + b[1]) * 0.5f, (a[2] + b[2]) * 0.5f };
+			f32 radius      = Length(Sub(b, a)) * 0.5f;
+
+			for (const Float3& p : positions)
+			{
+				const f32 distance = Length(Sub(p, center));
+				if (distance > radius)
+				{
+					// Grow just enough to touch p, keeping the far side where it is
+					const f32 grown = (radius + distance) * 0.5f;
+					const f32 shift = (grown - radius) / distance;
+					for (u32 axis = 0; axis < 3; ++axis)
+					{
+						center[axis] += (p[axis] - center[axis]) * shift;
+					}
+					radius = grown;
+				}
+			}
+
+			bounds.Center = center;
+			bounds.Radius = radius;
+			return bounds;
+		}
+
+		void ComputeCone(Meshlet& meshlet, std::span<const MeshData::Vertex> vertices,
+			std::span<const u32> meshletVertices, std::span<const u8> meshletTriangles)
+		{
+			auto position = [&](u8 local) -> const Float3& { return vertices[meshletVertices[local]].Position; };
+
+			struct Face
+			{
+				Float3 Normal;
+				Float3 Point;
+			};
+
+			std::array<Face, Meshlet::MAX_TRIANGLES> faces;
+			u32 faceCount = 0;
+			Float3 axis{};
+
+			// Degenerate triangles have no facing, they are left out
+			for (u32 t = 0; t < meshlet.TriangleCount; ++t)
+			{
+				const Float3& p0 = position(meshletTriangles[t * 3 + 0]);
+				const Float3 normal = Cross(Sub(position(meshletTriangles[t * 3 + 1]), p0), Sub(position(meshletTriangles[t * 3 + 2]), p0));
+				const f32 length = Length(normal);
+				if (length > 0.0f)
+				{
+					Face& face = faces[faceCount++];
+					face.Normal = { normal[0] / length, normal[1] / length, normal[2] / length };
+					face.Point  = p0;
+					axis = { axis[0] + face.Normal[0], axis[1] + face.Normal[1], axis[2] + face.Normal[2] };
+				}
+			}
+
+			const f32 axisLength = Length(axis);
+			if (axisLength == 0.0f)
+			{
+				return;
+			}
+			axis = { axis[0] / axisLength, axis[1] / axisLength, axis[2] / axisLength };
+
+			f32 minDot = 1.0f;
+			for (u32 i = 0; i < faceCount; ++i)
+			{
+				minDot = std::min(minDot, Dot(faces[i].Normal, axis));
+			}
+
+			if (minDot <= MIN_CONE_DOT)
+			{
+				return;
+			}
+
+			// Move the apex back along the axis until it is behind every triangle plane
+			f32 maxT = 0.0f;
+			for (u32 i = 0; i < faceCount; ++i)
+			{
+				maxT = std::max(maxT, Dot(Sub(meshlet.Center, faces[i].Point), faces[i].Normal) / Dot(faces[i].Normal, axis));
+			}
+
+			meshlet.ConeAxis   = axis;
+			meshlet.ConeApex   = { meshlet.Center[0] - axis[0] * maxT, meshlet.Center[1] - axis[1] * maxT, meshlet.Center[2] - axis[2] * maxT };
+			meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+		}
+	}
+
+	MeshBounds ComputeBounds(std::span<const MeshData::Vertex> vertices)
+	{
+		return ComputeBoundsOf(vertices | std::views::transform(&MeshData::Vertex::Position));
+	}
+
+	MeshBounds ComputeBounds(std::span<const MeshData::Vertex> vertices, std::span<const u32> indices)
+	{
+		return ComputeBoundsOf(indices | std::views::transform([vertices](u32 index) -> const Float3& { return vertices[index].Position; }));
+	}
+
+	void ComputeBounds(MeshData& mesh)
+	{
+		RYU_PROFILE_SCOPE();
+		const std::span<const MeshData::Vertex> vertices = mesh.GetVertices();
+		const std::span<const u32> indices = mesh.GetIndices();
+
+		mesh.Bounds = ComputeBounds(vertices);
+		for (MeshData::SubMesh& subMesh : mesh.SubMeshes)
+		{
+			subMesh.Bounds = ComputeBounds(vertices, indices.subspan(subMesh.IndexOffset, subMesh.IndexCount));
+		}
+	}
+
+	void BuildMeshlets(MeshData& mesh)
+	{
+		RYU_PROFILE_SCOPE();
+		const std::span<const MeshData::Vertex> vertices = mesh.GetVertices();
+		const std::span<const u32> indices = mesh.GetIndices();
+
+		mesh.Meshlets.clear();
+		mesh.MeshletVertices.clear();
+		mesh.MeshletTriangles.clear();
+		mesh.Meshlets.reserve(indices.size() / 3 / Meshlet::MAX_TRIANGLES + mesh.SubMeshes.size() + 1);
+		mesh.MeshletVertices.reserve(indices.size() / 3);
+		mesh.MeshletTriangles.reserve(indices.size());
+
+		// Local index of each vertex in the meshlet being built
+		std::vector<u8> localIndex(vertices.size(), NOT_IN_MESHLET);
+		Meshlet current;
+
+		auto flush = [&]
+		{
+			if (current.TriangleCount == 0)
+			{
+				return;
+			}
+
+			const std::span<const u32> meshletVertices(mesh.MeshletVertices.data() + current.VertexOffset, current.VertexCount);
+			const std::span<const u8> meshletTriangles(mesh.MeshletTriangles.data() + current.TriangleOffset, current.TriangleCount * 3);
+
+			const MeshBounds bounds = ComputeBounds(vertices, meshletVertices);
+			current.Center = bounds.Center;
+			current.Radius = bounds.Radius;
+			ComputeCone(current, vertices, meshletVertices, meshletTriangles);
+
+			for (const u32 vertex : meshletVertices)
+			{
+				localIndex[vertex] = NOT_IN_MESHLET;
+			}
+
+			mesh.Meshlets.push_back(current);
+			current = Meshlet
+			{
+				.VertexOffset   = static_cast<u32>(mesh.MeshletVertices.size()),
+				.TriangleOffset = static_cast<u32>(mesh.MeshletTriangles.size()),
+			};
+		};
+
+		auto buildRange = [&](u32 offset, u32 count)
+		{
+			for (u32 i = offset; i + 2 < offset + count; i += 3)
+			{
+				const u32 triangle[3] = { indices[i], indices[i + 1], indices[i + 2] };
+
+				u32 newVertices = 0;
+				for (u32 c = 0; c < 3; ++c)
+				{
+					const bool repeated = (c > 0 && triangle[c] == triangle[0]) || (c > 1 && triangle[c] == triangle[1]);
+					newVertices += (localIndex[triangle[c]] == NOT_IN_MESHLET && !repeated) ? 1 : 0;
+				}
+
+				if (current.VertexCount + newVertices > Meshlet::MAX_VERTICES || current.TriangleCount == Meshlet::MAX_TRIANGLES)
+				{
+					flush();
+				}
+
+				for (const u32 vertex : triangle)
+				{
+					if (localIndex[vertex] == NOT_IN_MESHLET)
+					{
+						localIndex[vertex] = static_cast<u8>(current.VertexCount++);
+						mesh.MeshletVertices.push_back(vertex);
+					}
+					mesh.MeshletTriangles.push_back(localIndex[vertex]);
+				}
+				++current.TriangleCount;
+			}
+			flush();
+		};
+
+		// Meshlets never span submeshes, each one has a single material
+		if (mesh.SubMeshes.empty())
+		{
+			buildRange(0, static_cast<u32>(indices.size()));
+		}
+		for (MeshData::SubMesh& subMesh : mesh.SubMeshes)
+		{
+			subMesh.MeshletOffset = static_cast<u32>(mesh.Meshlets.size());
+			buildRange(subMesh.IndexOffset, subMesh.IndexCount);
+			subMesh.MeshletCount = static_cast<u32>(mesh.Meshlets.size()) - subMesh.MeshletOffset;
+		}
+	}
+
+	void Build(MeshData& mesh)
+	{
+		ComputeBounds(mesh);
+		BuildMeshlets(mesh);
+	}
+
+	bool IsBackfacing(const Meshlet& meshlet, const std::array<f32, 3>& viewPosition)
+	{
+		const Float3 toApex = Sub(meshlet.ConeApex, viewPosition);
+		const f32 distance  = Length(toApex);
+		return distance > 0.0f && Dot(toApex, meshlet.ConeAxis) >= meshlet.ConeCutoff * distance;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "Asset/AssetData.h"
+
+namespace Ryu::Asset::MeshClusters
+{
+	// Bounds of every vertex, or of the vertices the indices reference
+	[[nodiscard]] MeshBounds ComputeBounds(std::span<const MeshData::Vertex> vertices);
+	[[nodiscard]] MeshBounds ComputeBounds(std::span<const MeshData::Vertex> vertices, std::span<const u32> indices);
+
+	// Mesh and submesh bounds
+	void ComputeBounds(MeshData& mesh);
+
+	// Splits each submesh into meshlets, in index order. Cache optimized indices give tighter meshlets
+	void BuildMeshlets(MeshData& mesh);
+
+	// Bounds, then meshlets
+	void Build(MeshData& mesh);
+
+	// Whether every triangle of the meshlet faces away from a viewer at viewPosition (mesh space)
+	[[nodiscard]] bool IsBackfacing(const Meshlet& meshlet, const std::array<f32, 3>& viewPosition);
+}
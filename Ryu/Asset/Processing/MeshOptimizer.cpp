@@ -0,0 +1,329 @@
+#include "Asset/Processing/MeshOptimizer.h"
+#include "Core/Profiling/Profiling.h"
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+namespace Ryu::Asset::MeshOptimizer
+{
+	namespace
+	{
+		constexpr u32 INVALID_INDEX = ~0u;
+
+		// Mapped meshes are read only, anything that rewrites them works on a copy
+		void MakeOwned(MeshData& mesh)
+		{
+			if (!mesh.Mapping)
+			{
+				return;
+			}
+
+			mesh.Vertices.assign(mesh.MappedVertices.begin(), mesh.MappedVertices.end());
+			mesh.Indices.assign(mesh.MappedIndices.begin(), mesh.MappedIndices.end());
+			mesh.MappedVertices = {};
+			mesh.MappedIndices  = {};
+			mesh.Mapping.reset();
+		}
+
+		u64 HashVertex(const MeshData::Vertex& vertex)
+		{
+			static_assert(sizeof(MeshData::Vertex) % sizeof(u64) == 0);
+
+			u64 words[sizeof(MeshData::Vertex) / sizeof(u64)];
+			std::memcpy(words, &vertex, sizeof(words));
+
+			u64 hash = 0xCBF29CE484222325ull;
+			for (const u64 word : words)
+			{
+				hash = (hash ^ word) * 0x100000001B3ull;
+				hash ^= hash >> 29;
+			}
+			return hash;
+		}
+
+		// Scratch buffers shared by every submesh of one mesh
+		struct TipsifyState
+		{
+			std::vector<u32>  AdjacencyOffsets;  // Per vertex, into Adjacency
+			std::vector<u32>  Adjacency;         // Triangles using each vertex
+			std::vector<u32>  LiveTriangles;     // Per vertex, triangles not emitted yet
+			std::vector<u32>  CacheTime;
+			std::vector<bool> Emitted;
+			std::vector<u32>  DeadEnds;
+			std::vector<u32>  Candidates;
+		};
+
+		// Sander, Nehab, Barczak - "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (2007)
+		void Tipsify(std::span<const u32> in, std::span<u32> out, u32 vertexCount, u32 cacheSize, TipsifyState& state)
+		{
+			const u32 triangleCount = static_cast<u32>(in.size() / 3);
+
+			state.AdjacencyOffsets.assign(vertexCount + 1, 0);
+			for (const u32 index : in)
+			{
+				++state.AdjacencyOffsets[index + 1];
+			}
+			std::partial_sum(state.AdjacencyOffsets.begin(), state.AdjacencyOffsets.end(), state.AdjacencyOffsets.begin());
+
+			state.Adjacency.resize(in.size());
+			state.LiveTriangles.assign(vertexCount, 0);
+			for (u32 i = 0; i < in.size(); ++i)
+			{
+				const u32 vertex = in[i];
+				state.Adjacency[state.AdjacencyOffsets[vertex] + state.LiveTriangles[vertex]++] = i / 3;
+			}
+
+			state.CacheTime.assign(vertexCount, 0);
+			state.Emitted.assign(triangleCount, false);
+			state.DeadEnds.clear();
+
+			u32 time      = cacheSize + 1;
+			u32 cursor    = 0;
+			u32 outPos    = 0;
+			u32 fanVertex = in[0];
+
+			auto skipDeadEnd = [&state, &cursor, vertexCount]() -> u32
+			{
+				while (!state.DeadEnds.empty())
+				{
+					const u32 vertex = state.DeadEnds.back();
+					state.DeadEnds.pop_back();
+					if (state.LiveTriangles[vertex] > 0)
+					{
+						return vertex;
+					}
+				}
+
+				for (; cursor < vertexCount; ++cursor)
+				{
+					if (state.LiveTriangles[cursor] > 0)
+					{
+						return cursor;
+					}
+				}
+				return INVALID_INDEX;
+			};
+
+			while (fanVertex != INVALID_INDEX)
+			{
+				// Emit every remaining triangle around the fanning vertex
+				state.Candidates.clear();
+				for (u32 a = state.AdjacencyOffsets[fanVertex]; a < state.AdjacencyOffsets[fanVertex + 1]; ++a)
+				{
+					const u32 triangle = state.Adjacency[a];
+					if (state.Emitted[triangle])
+					{
+						continue;
+					}
+
+					for (u32 corner = 0; corner < 3; ++corner)
+					{
+						const u32 vertex = in[triangle * 3 + corner];
+						out[outPos++] = vertex;
+						state.DeadEnds.push_back(vertex);
+						state.Candidates.push_back(vertex);
+						--state.LiveTriangles[vertex];
+
+						if (time - state.CacheTime[vertex] > cacheSize)
+						{
+							state.CacheTime[vertex] = time++;
+						}
+					}
+					state.Emitted[triangle] = true;
+				}
+
+				// Next fan: the candidate that stays in cache longest while its triangles are emitted
+				u32 best         = INVALID_INDEX;
+				i64 bestPriority = -1;
+				for (const u32 vertex : state.Candidates)
+				{
+					if (state.LiveTriangles[vertex] == 0)
+					{
+						continue;
+					}
+
+					i64 priority = 0;
+					if (time - state.CacheTime[vertex] + 2 * state.LiveTriangles[vertex] <= cacheSize)
+					{
+						priority = time - state.CacheTime[vertex];
+					}
+
+					if (priority > bestPriority)
+					{
+						best         = vertex;
+						bestPriority = priority;
+					}
+				}
+
+				fanVertex = (best != INVALID_INDEX) ? best : skipDeadEnd();
+			}
+
+			RYU_ASSERT(outPos == in.size(), "Tipsify did not emit every triangle");
+		}
+	}
+
+	void WeldVertices(MeshData& mesh)
+	{
+		RYU_PROFILE_SCOPE();
+		MakeOwned(mesh);
+
+		const u32 vertexCount = static_cast<u32>(mesh.Vertices.size());
+		if (vertexCount == 0)
+		{
+			return;
+		}
+
+		if (mesh.Indices.empty())
+		{
+			mesh.Indices.resize(vertexCount);
+			std::iota(mesh.Indices.begin(), mesh.Indices.end(), 0u);
+		}
+
+		// Open addressing over indices into the welded array, at most half full
+		const u64 mask = std::bit_ceil(u64(vertexCount) * 2) - 1;
+		std::vector<u32> table(mask + 1, INVALID_INDEX);
+		std::vector<u32> remap(vertexCount);
+		std::vector<MeshData::Vertex> welded;
+		welded.reserve(vertexCount);
+
+		for (u32 i = 0; i < vertexCount; ++i)
+		{
+			const MeshData::Vertex& vertex = mesh.Vertices[i];
+
+			u64 slot = HashVertex(vertex) & mask;
+			while (table[slot] != INVALID_INDEX && std::memcmp(&welded[table[slot]], &vertex, sizeof(vertex)) != 0)
+			{
+				slot = (slot + 1) & mask;
+			}
+
+			if (table[slot] == INVALID_INDEX)
+			{
+				table[slot] = static_cast<u32>(welded.size());
+				welded.push_back(vertex);
+			}
+			remap[i] = table[slot];
+		}
+
+		for (u32& index : mesh.Indices)
+		{
+			index = remap[index];
+		}
+		mesh.Vertices = std::move(welded);
+	}
+
+	void OptimizeVertexCache(MeshData& mesh, u32 cacheSize)
+	{
+		RYU_PROFILE_SCOPE();
+		MakeOwned(mesh);
+
+		if (mesh.Indices.size() < 3)
+		{
+			return;
+		}
+
+		std::vector<u32> optimized(mesh.Indices.size());
+		TipsifyState state;
+
+		// Triangles never move between submeshes, their ranges stay valid
+		auto optimizeRange = [&](u32 offset, u32 count)
+		{
+			count -= count % 3;
+			if (count > 0)
+			{
+				Tipsify({ mesh.Indices.data() + offset, count }, { optimized.data() + offset, count },
+					static_cast<u32>(mesh.Vertices.size()), cacheSize, state);
+			}
+		};
+
+		std::vector<bool> covered(mesh.Indices.size(), mesh.SubMeshes.empty());
+		if (mesh.SubMeshes.empty())
+		{
+			optimizeRange(0, static_cast<u32>(mesh.Indices.size()));
+		}
+		for (const MeshData::SubMesh& subMesh : mesh.SubMeshes)
+		{
+			optimizeRange(subMesh.IndexOffset, subMesh.IndexCount);
+			std::fill_n(covered.begin() + subMesh.IndexOffset, subMesh.IndexCount - subMesh.IndexCount % 3, true);
+		}
+
+		// Indices outside any submesh are kept as they were
+		for (size_t i = 0; i < covered.size(); ++i)
+		{
+			if (!covered[i])
+			{
+				optimized[i] = mesh.Indices[i];
+			}
+		}
+
+		mesh.Indices = std::move(optimized);
+	}
+
+	void OptimizeVertexCache(std::span<u32> indices, u32 vertexCount, u32 cacheSize)
+	{
+		const size_t count = indices.size() - indices.size() % 3;
+		if (count == 0)
+		{
+			return;
+		}
+
+		const std::vector<u32> source(indices.begin(), indices.begin() + count);
+		TipsifyState state;
+		Tipsify(source, indices.first(count), vertexCount, cacheSize, state);
+	}
+
+	void OptimizeVertexFetch(MeshData& mesh)
+	{
+		RYU_PROFILE_SCOPE();
+		MakeOwned(mesh);
+
+		if (mesh.Indices.empty())
+		{
+			return;
+		}
+
+		std::vector<u32> remap(mesh.Vertices.size(), INVALID_INDEX);
+		std::vector<MeshData::Vertex> ordered;
+		ordered.reserve(mesh.Vertices.size());
+
+		for (u32& index : mesh.Indices)
+		{
+			if (remap[index] == INVALID_INDEX)
+			{
+				remap[index] = static_cast<u32>(ordered.size());
+				ordered.push_back(mesh.Vertices[index]);
+			}
+			index = remap[index];
+		}
+
+		mesh.Vertices = std::move(ordered);
+	}
+
+	void Optimize(MeshData& mesh)
+	{
+		RYU_PROFILE_SCOPE();
+		WeldVertices(mesh);
+		OptimizeVertexCache(mesh);
+		OptimizeVertexFetch(mesh);
+	}
+
+	f32 ComputeACMR(std::span<const u32> indices, u32 vertexCount, u32 cacheSize)
+	{
+		if (indices.size() < 3)
+		{
+			return 0.0f;
+		}
+
+		// A vertex is still cached while fewer than cacheSize misses happened since it was loaded
+		std::vector<u32> loadedAt(vertexCount, 0);
+		u32 misses = 0;
+		for (const u32 index : indices)
+		{
+			if (loadedAt[index] == 0 || misses - loadedAt[index] >= cacheSize)
+			{
+				loadedAt[index] = ++misses;
+			}
+		}
+
+		return static_cast<f32>(misses) / static_cast<f32>(indices.size() / 3);
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "Asset/AssetData.h"
+
+namespace Ryu::Asset::MeshOptimizer
+{
+	// Vertex cache size Tipsify optimizes for, a safe guess across GPUs
+	constexpr u32 DEFAULT_CACHE_SIZE = 16;
+
+	// Merges bitwise identical vertices and rewrites the indices to share them.
+	// Meshes without indices get one index per vertex first
+	void WeldVertices(MeshData& mesh);
+
+	// Reorders triangles inside each submesh so recently transformed vertices get reused (Tipsify)
+	void OptimizeVertexCache(MeshData& mesh, u32 cacheSize = DEFAULT_CACHE_SIZE);
+
+	// Same for a single range of triangles, in place
+	void OptimizeVertexCache(std::span<u32> indices, u32 vertexCount, u32 cacheSize = DEFAULT_CACHE_SIZE);
+
+	// Reorders vertices by first use in the index buffer and drops unreferenced ones
+	void OptimizeVertexFetch(MeshData& mesh);
+
+	// Weld, then cache, then fetch, which is the order each step expects
+	void Optimize(MeshData& mesh);
+
+	// Average cache miss ratio: transformed vertices per triangle with a FIFO cache of cacheSize.
+	// 3 for an unindexed mesh, around 0.5 - 0.7 for a well ordered one
+	[[nodiscard]] f32 ComputeACMR(std::span<const u32> indices, u32 vertexCount, u32 cacheSize = DEFAULT_CACHE_SIZE);
+}
@@ -0,0 +1,699 @@
+#include "Asset/Processing/MeshSimplifier.h"
+#include "Asset/Processing/MeshClusters.h"
+#include "Asset/Processing/MeshOptimizer.h"
+#include "Core/Profiling/Profiling.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Ryu::Asset::MeshSimplifier
+{
+	namespace
+	{
+		using Float3 = std::array<f32, 3>;
+
+		// A collapse may turn a face by less than ~85 degrees, anything more is treated as a flip
+		constexpr f32 MIN_FACE_ALIGNMENT = 0.1f;
+
+		// Each LOD has to drop at least this share of the triangles of the one before it
+		constexpr f32 MIN_LOD_REDUCTION = 0.1f;
+
+		Float3 Sub(const Float3& a, const Float3& b) { return { a[0] - b[0], a[1] - b[1], a[2] - b[2] }; }
+		Float3 Add(const Float3& a, const Float3& b) { return { a[0] + b[0], a[1] + b[1], a[2] + b[2] }; }
+		Float3 Scale(const Float3& v, f32 s) { return { v[0] * s, v[1] * s, v[2] * s }; }
+		f32 Dot(const Float3& a, const Float3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+		f32 Length(const Float3& v) { return std::sqrt(Dot(v, v)); }
+
+		Float3 Cross(const Float3& a, const Float3& b)
+		{
+			return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+		}
+
+		Float3 FaceNormal(const Float3& p0, const Float3& p1, const Float3& p2)
+		{
+			return Cross(Sub(p1, p0), Sub(p2, p0));
+		}
+
+		// Ericson - "Real-Time Collision Detection" 5.1.5
+		f32 PointTriangleDistance(const Float3& p, const Float3& a, const Float3& b, const Float3& c)
+		{
+			const Float3 ab = Sub(b, a), ac = Sub(c, a), ap = Sub(p, a);
+			const f32 d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+			if (d1 <= 0.0f && d2 <= 0.0f) { return Length(ap); }
+
+			const Float3 bp = Sub(p, b);
+			const f32 d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+			if (d3 >= 0.0f && d4 <= d3) { return Length(bp); }
+
+			const f32 vc = d1 * d4 - d3 * d2;
+			if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+			{
+				return Length(Sub(p, Add(a, Scale(ab, d1 / (d1 - d3)))));
+			}
+
+			const Float3 cp = Sub(p, c);
+			const f32 d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+			if (d6 >= 0.0f && d5 <= d6) { return Length(cp); }
+
+			const f32 vb = d5 * d2 - d1 * d6;
+			if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+			{
+				return Length(Sub(p, Add(a, Scale(ac, d2 / (d2 - d6)))));
+			}
+
+			const f32 va = d3 * d6 - d5 * d4;
+			if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+			{
+				return Length(Sub(p, Add(b, Scale(Sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))))));
+			}
+
+			const f32 denom = 1.0f / (va + vb + vc);
+			return Length(Sub(p, Add(a, Add(Scale(ab, vb * denom), Scale(ac, vc * denom)))));
+		}
+
+		// Distance from p to the plane of the triangle if p projects inside it, infinity otherwise
+		f32 ProjectedDistance(const Float3& p, const Float3& a, const Float3& b, const Float3& c)
+		{
+			const Float3 ab = Sub(b, a), ac = Sub(c, a), ap = Sub(p, a);
+			const f32 d00 = Dot(ab, ab), d01 = Dot(ab, ac), d11 = Dot(ac, ac);
+			const f32 d20 = Dot(ap, ab), d21 = Dot(ap, ac);
+			const f32 denom = d00 * d11 - d01 * d01;
+			if (denom <= 0.0f)
+			{
+				return std::numeric_limits<f32>::infinity();
+			}
+
+			constexpr f32 tolerance = -1e-4f;
+			const f32 v = (d11 * d20 - d01 * d21) / denom;
+			const f32 w = (d00 * d21 - d01 * d20) / denom;
+			if (v < tolerance || w < tolerance || 1.0f - v - w < tolerance)
+			{
+				return std::numeric_limits<f32>::infinity();
+			}
+
+			const Float3 normal = Cross(ab, ac);
+			return std::abs(Dot(ap, normal)) / Length(normal);
+		}
+
+		// Area weighted sum of squared distances to a set of planes, as the symmetric 4x4 matrix [A b; b^T c]
+		struct Quadric
+		{
+			f64 A00 = 0, A01 = 0, A02 = 0, A11 = 0, A12 = 0, A22 = 0;
+			f64 B0 = 0, B1 = 0, B2 = 0;
+			f64 C = 0;
+			f64 Weight = 0;
+
+			static Quadric FromTriangle(const Float3& p0, const Float3& p1, const Float3& p2)
+			{
+				const Float3 normal = FaceNormal(p0, p1, p2);
+				const f64 length = Length(normal);
+				if (length == 0.0)
+				{
+					return {};
+				}
+
+				const f64 x = normal[0] / length, y = normal[1] / length, z = normal[2] / length;
+				const f64 d = -(x * p0[0] + y * p0[1] + z * p0[2]);
+				const f64 w = length * 0.5;
+
+				return Quadric
+				{
+					.A00 = w * x * x, .A01 = w * x * y, .A02 = w * x * z,
+					.A11 = w * y * y, .A12 = w * y * z, .A22 = w * z * z,
+					.B0 = w * x * d, .B1 = w * y * d, .B2 = w * z * d,
+					.C = w * d * d,
+					.Weight = w
+				};
+			}
+
+			Quadric& operator+=(const Quadric& o)
+			{
+				A00 += o.A00; A01 += o.A01; A02 += o.A02; A11 += o.A11; A12 += o.A12; A22 += o.A22;
+				B0 += o.B0; B1 += o.B1; B2 += o.B2;
+				C += o.C;
+				Weight += o.Weight;
+				return *this;
+			}
+
+			// Mean squared distance from p to the planes
+			f64 Evaluate(const Float3& p) const
+			{
+				const f64 x = p[0], y = p[1], z = p[2];
+				const f64 sum = x * (A00 * x + 2 * (A01 * y + A02 * z + B0))
+					+ y * (A11 * y + 2 * (A12 * z + B1))
+					+ z * (A22 * z + 2 * B2)
+					+ C;
+				return Weight > 0.0 ? std::max(sum, 0.0) / Weight : 0.0;
+			}
+		};
+
+		struct Collapse
+		{
+			u32 From;
+			u32 To;
+			f64 Cost;
+		};
+
+		// Keeps the vertex state between runs, so every LOD of a chain is measured against the original
+		class Simplifier
+		{
+		public:
+			Simplifier(std::span<const MeshData::Vertex> vertices, std::span<const u32> indices, const Options& options)
+				: m_vertices(vertices)
+				, m_source(indices.begin(), indices.begin() + (indices.size() - indices.size() % 3))
+			{
+				const u32 vertexCount = static_cast<u32>(vertices.size());
+
+				m_collapsedTo.resize(vertexCount);
+				std::iota(m_collapsedTo.begin(), m_collapsedTo.end(), 0u);
+				m_locked.assign(vertexCount, false);
+				m_quadrics.resize(vertexCount);
+
+				const f32 radius  = MeshClusters::ComputeBounds(vertices, m_source).Radius;
+				m_normalWeight    = Square(options.NormalWeight * radius);
+				m_texCoordWeight  = Square(options.TexCoordWeight * radius);
+				m_maxErrorSquared = Square(options.MaxError);
+
+				for (size_t i = 0; i < m_source.size(); i += 3)
+				{
+					const Quadric quadric = Quadric::FromTriangle(
+						Position(m_source[i]), Position(m_source[i + 1]), Position(m_source[i + 2]));
+					for (u32 corner = 0; corner < 3; ++corner)
+					{
+						m_quadrics[m_source[i + corner]] += quadric;
+					}
+				}
+
+				// Source adjacency never changes, it is kept for measuring errors
+				BuildAdjacency(m_source);
+				m_sourceOffsets   = m_adjacencyOffsets;
+				m_sourceAdjacency = m_adjacency;
+				m_referenced.assign(vertexCount, false);
+				for (const u32 index : m_source)
+				{
+					m_referenced[index] = true;
+				}
+
+				LockSeamsAndBorders();
+			}
+
+			void Lock(u32 vertex) { m_locked[vertex] = true; }
+
+			// Collapses edges of indices until it is down to targetIndexCount or nothing else can go.
+			// Returns the error of the result
+			f32 Run(std::vector<u32>& indices, u32 targetIndexCount)
+			{
+				RYU_PROFILE_SCOPE();
+
+				std::vector<Collapse> candidates;
+				std::vector<bool> touched;
+
+				while (indices.size() > targetIndexCount)
+				{
+					BuildAdjacency(indices);
+
+					candidates.clear();
+					for (size_t i = 0; i < indices.size(); i += 3)
+					{
+						for (u32 corner = 0; corner < 3; ++corner)
+						{
+							// Interior edges show up once each way, borders are locked
+							const u32 a = indices[i + corner];
+							const u32 b = indices[i + (corner + 1) % 3];
+							if (a < b)
+							{
+								AddCandidate(candidates, a, b);
+							}
+						}
+					}
+					std::ranges::sort(candidates, {}, &Collapse::Cost);
+
+					// Collapses touching the same triangles would see stale adjacency, those wait for the next pass
+					const size_t trianglesToRemove = (indices.size() - targetIndexCount) / 3;
+					size_t removed = 0;
+					touched.assign(m_vertices.size(), false);
+
+					for (const Collapse& collapse : candidates)
+					{
+						if (removed >= trianglesToRemove)
+						{
+							break;
+						}
+
+						if (touched[collapse.From] || touched[collapse.To] || !CanCollapse(indices, collapse.From, collapse.To))
+						{
+							continue;
+						}
+
+						m_collapsedTo[collapse.From] = collapse.To;
+						m_quadrics[collapse.To] += m_quadrics[collapse.From];
+
+						for (const u32 triangle : Triangles(collapse.From))
+						{
+							u32* corners = &indices[triangle * 3];
+							for (u32 corner = 0; corner < 3; ++corner)
+							{
+								corners[corner] = corners[corner] == collapse.From ? collapse.To : corners[corner];
+								touched[corners[corner]] = true;
+							}
+							removed += IsDegenerate(corners) ? 1 : 0;
+						}
+						touched[collapse.From] = true;
+					}
+
+					if (removed == 0)
+					{
+						break;
+					}
+
+					// Compacting keeps the triangle order, so cache optimized input stays mostly ordered
+					size_t write = 0;
+					for (size_t read = 0; read < indices.size(); read += 3)
+					{
+						if (!IsDegenerate(&indices[read]))
+						{
+							std::copy_n(indices.begin() + read, 3, indices.begin() + write);
+							write += 3;
+						}
+					}
+					indices.resize(write);
+				}
+
+				return MeasureError(indices);
+			}
+
+		private:
+			static f64 Square(f64 value) { return value * value; }
+			static bool IsDegenerate(const u32* t) { return t[0] == t[1] || t[1] == t[2] || t[0] == t[2]; }
+
+			const Float3& Position(u32 vertex) const { return m_vertices[vertex].Position; }
+
+			std::span<const u32> Triangles(u32 vertex) const
+			{
+				return { m_adjacency.data() + m_adjacencyOffsets[vertex], m_adjacencyOffsets[vertex + 1] - m_adjacencyOffsets[vertex] };
+			}
+
+			std::span<const u32> SourceTriangles(u32 vertex) const
+			{
+				return { m_sourceAdjacency.data() + m_sourceOffsets[vertex], m_sourceOffsets[vertex + 1] - m_sourceOffsets[vertex] };
+			}
+
+			std::span<const u32> Members(u32 vertex) const
+			{
+				return { m_members.data() + m_memberOffsets[vertex], m_memberOffsets[vertex + 1] - m_memberOffsets[vertex] };
+			}
+
+			u32 Find(u32 vertex)
+			{
+				while (m_collapsedTo[vertex] != vertex)
+				{
+					m_collapsedTo[vertex] = m_collapsedTo[m_collapsedTo[vertex]];
+					vertex = m_collapsedTo[vertex];
+				}
+				return vertex;
+			}
+
+			// Duplicated positions are seams, their wedges would tear apart if one moved alone.
+			// Edges without a twin running the other way are open borders
+			void LockSeamsAndBorders()
+			{
+				std::vector<u32> order(m_vertices.size());
+				std::iota(order.begin(), order.end(), 0u);
+				std::ranges::sort(order, {}, [this](u32 v) -> const Float3& { return Position(v); });
+
+				std::vector<u32> canonical(m_vertices.size());
+				for (size_t i = 0; i < order.size();)
+				{
+					size_t end = i + 1;
+					while (end < order.size() && Position(order[end]) == Position(order[i]))
+					{
+						++end;
+					}
+					for (size_t j = i; j < end; ++j)
+					{
+						canonical[order[j]] = order[i];
+						m_locked[order[j]] = m_locked[order[j]] || end - i > 1;
+					}
+					i = end;
+				}
+
+				auto edgeKey = [](u32 a, u32 b) { return (u64(a) << 32) | b; };
+
+				std::vector<u64> edges;
+				edges.reserve(m_source.size());
+				for (size_t i = 0; i < m_source.size(); i += 3)
+				{
+					for (u32 corner = 0; corner < 3; ++corner)
+					{
+						const u32 a = canonical[m_source[i + corner]];
+						const u32 b = canonical[m_source[i + (corner + 1) % 3]];
+						if (a != b)
+						{
+							edges.push_back(edgeKey(a, b));
+						}
+					}
+				}
+				std::ranges::sort(edges);
+
+				for (size_t i = 0; i < m_source.size(); i += 3)
+				{
+					for (u32 corner = 0; corner < 3; ++corner)
+					{
+						const u32 a = m_source[i + corner];
+						const u32 b = m_source[i + (corner + 1) % 3];
+						if (canonical[a] != canonical[b] && !std::ranges::binary_search(edges, edgeKey(canonical[b], canonical[a])))
+						{
+							m_locked[a] = m_locked[b] = true;
+						}
+					}
+				}
+			}
+
+			void BuildAdjacency(std::span<const u32> indices)
+			{
+				m_adjacencyOffsets.assign(m_vertices.size() + 1, 0);
+				for (const u32 index : indices)
+				{
+					++m_adjacencyOffsets[index + 1];
+				}
+				std::partial_sum(m_adjacencyOffsets.begin(), m_adjacencyOffsets.end(), m_adjacencyOffsets.begin());
+
+				m_adjacency.resize(indices.size());
+				m_fill.assign(m_adjacencyOffsets.begin(), m_adjacencyOffsets.end() - 1);
+				for (u32 i = 0; i < indices.size(); ++i)
+				{
+					m_adjacency[m_fill[indices[i]]++] = i / 3;
+				}
+			}
+
+			// Cost of collapsing from onto to, negative if it may not happen
+			f64 CollapseCost(u32 from, u32 to) const
+			{
+				if (m_locked[from])
+				{
+					return -1.0;
+				}
+
+				Quadric quadric = m_quadrics[from];
+				quadric += m_quadrics[to];
+				const f64 error = quadric.Evaluate(Position(to));
+				if (error > m_maxErrorSquared)
+				{
+					return -1.0;
+				}
+
+				const MeshData::Vertex& a = m_vertices[from];
+				const MeshData::Vertex& b = m_vertices[to];
+				const Float3 normal = Sub(a.Normal, b.Normal);
+				const f32 du = a.TexCoord[0] - b.TexCoord[0], dv = a.TexCoord[1] - b.TexCoord[1];
+				return error + m_normalWeight * Dot(normal, normal) + m_texCoordWeight * (du * du + dv * dv);
+			}
+
+			// The cheaper way round of the edge
+			void AddCandidate(std::vector<Collapse>& candidates, u32 a, u32 b) const
+			{
+				const f64 ab = CollapseCost(a, b);
+				const f64 ba = CollapseCost(b, a);
+				if (ab >= 0.0 && (ba < 0.0 || ab <= ba))
+				{
+					candidates.push_back(Collapse{ .From = a, .To = b, .Cost = ab });
+				}
+				else if (ba >= 0.0)
+				{
+					candidates.push_back(Collapse{ .From = b, .To = a, .Cost = ba });
+				}
+			}
+
+			bool CanCollapse(std::span<const u32> indices, u32 from, u32 to)
+			{
+				// Link condition: an interior edge shares exactly the two vertices opposite it,
+				// more would pinch the surface into a non manifold one
+				m_ring.clear();
+				for (const u32 triangle : Triangles(from))
+				{
+					for (u32 corner = 0; corner < 3; ++corner)
+					{
+						m_ring.push_back(indices[triangle * 3 + corner]);
+					}
+				}
+				std::ranges::sort(m_ring);
+				const auto [first, last] = std::ranges::unique(m_ring);
+				m_ring.erase(first, last);
+
+				u32 shared = 0;
+				m_seen.clear();
+				for (const u32 triangle : Triangles(to))
+				{
+					for (u32 corner = 0; corner < 3; ++corner)
+					{
+						const u32 vertex = indices[triangle * 3 + corner];
+						if (vertex != from && vertex != to && std::ranges::binary_search(m_ring, vertex)
+							&& std::ranges::find(m_seen, vertex) == m_seen.end())
+						{
+							m_seen.push_back(vertex);
+							++shared;
+						}
+					}
+				}
+				if (shared != 2)
+				{
+					return false;
+				}
+
+				// No face around from may flip or collapse to a sliver once from sits on to
+				for (const u32 triangle : Triangles(from))
+				{
+					const u32* corners = &indices[triangle * 3];
+					if (corners[0] == to || corners[1] == to || corners[2] == to)
+					{
+						continue;
+					}
+
+					Float3 moved[3];
+					for (u32 corner = 0; corner < 3; ++corner)
+					{
+						moved[corner] = Position(corners[corner] == from ? to : corners[corner]);
+					}
+
+					const Float3 before = FaceNormal(Position(corners[0]), Position(corners[1]), Position(corners[2]));
+					const Float3 after  = FaceNormal(moved[0], moved[1], moved[2]);
+					if (Dot(before, after) <= MIN_FACE_ALIGNMENT * Length(before) * Length(after))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			f32 TriangleDistance(const Float3& p, std::span<const u32> indices, u32 triangle) const
+			{
+				const u32* corners = &indices[triangle * 3];
+				return PointTriangleDistance(p, Position(corners[0]), Position(corners[1]), Position(corners[2]));
+			}
+
+			f32 SourceDistance(const Float3& p, u32 triangle) const
+			{
+				const u32* corners = &m_source[triangle * 3];
+				return ProjectedDistance(p, Position(corners[0]), Position(corners[1]), Position(corners[2]));
+			}
+
+			// Hausdorff distance between the source and the result, estimated both ways. Source vertices are
+			// measured against the result triangles within two rings of where they collapsed to, and points on
+			// each result triangle against the source triangles under them, out of those whose vertices went
+			// into its corners. Points that find nothing under them are left out
+			f32 MeasureError(std::span<const u32> indices)
+			{
+				const u32 vertexCount = static_cast<u32>(m_vertices.size());
+				BuildAdjacency(indices);
+
+				m_memberOffsets.assign(vertexCount + 1, 0);
+				for (u32 vertex = 0; vertex < vertexCount; ++vertex)
+				{
+					m_memberOffsets[Find(vertex) + 1] += m_referenced[vertex] ? 1 : 0;
+				}
+				std::partial_sum(m_memberOffsets.begin(), m_memberOffsets.end(), m_memberOffsets.begin());
+				m_members.resize(m_memberOffsets.back());
+				m_fill.assign(m_memberOffsets.begin(), m_memberOffsets.end() - 1);
+
+				f32 error = 0.0f;
+				for (u32 vertex = 0; vertex < vertexCount; ++vertex)
+				{
+					if (!m_referenced[vertex])
+					{
+						continue;
+					}
+
+					const u32 target = Find(vertex);
+					m_members[m_fill[target]++] = vertex;
+					if (target == vertex)
+					{
+						continue;
+					}
+
+					// Only the largest distance matters, the search stops once it falls under the current one
+					const Float3& p = Position(vertex);
+					f32 distance = Length(Sub(p, Position(target)));
+					for (const u32 triangle : Triangles(target))
+					{
+						distance = std::min(distance, TriangleDistance(p, indices, triangle));
+					}
+					for (const u32 triangle : Triangles(target))
+					{
+						for (u32 corner = 0; corner < 3 && distance > error; ++corner)
+						{
+							for (const u32 ring : Triangles(indices[triangle * 3 + corner]))
+							{
+								distance = std::min(distance, TriangleDistance(p, indices, ring));
+							}
+						}
+					}
+					error = std::max(error, distance);
+				}
+
+				for (size_t i = 0; i < indices.size(); i += 3)
+				{
+					const Float3& a = Position(indices[i]);
+					const Float3& b = Position(indices[i + 1]);
+					const Float3& c = Position(indices[i + 2]);
+					const Float3 samples[] =
+					{
+						Scale(Add(a, Add(b, c)), 1.0f / 3.0f),
+						Scale(Add(a, b), 0.5f),
+						Scale(Add(b, c), 0.5f),
+						Scale(Add(c, a), 0.5f),
+					};
+
+					for (const Float3& p : samples)
+					{
+						f32 distance = std::numeric_limits<f32>::infinity();
+						for (u32 corner = 0; corner < 3 && distance > error; ++corner)
+						{
+							for (const u32 member : Members(indices[i + corner]))
+							{
+								for (const u32 triangle : SourceTriangles(member))
+								{
+									distance = std::min(distance, SourceDistance(p, triangle));
+								}
+								if (distance <= error)
+								{
+									break;
+								}
+							}
+						}
+						error = std::isinf(distance) ? error : std::max(error, distance);
+					}
+				}
+				return error;
+			}
+
+		private:
+			std::span<const MeshData::Vertex> m_vertices;
+			std::vector<u32>                  m_source;
+			f64                               m_normalWeight    = 0.0;
+			f64                               m_texCoordWeight  = 0.0;
+			f64                               m_maxErrorSquared = 0.0;
+
+			std::vector<u32>     m_collapsedTo;
+			std::vector<bool>    m_locked;
+			std::vector<bool>    m_referenced;
+			std::vector<Quadric> m_quadrics;
+			std::vector<u32>     m_sourceOffsets;
+			std::vector<u32>     m_sourceAdjacency;
+
+			// Scratch
+			std::vector<u32> m_adjacencyOffsets;
+			std::vector<u32> m_adjacency;
+			std::vector<u32> m_fill;
+			std::vector<u32> m_ring;
+			std::vector<u32> m_seen;
+			std::vector<u32> m_memberOffsets;
+			std::vector<u32> m_members;
+		};
+	}
+
+	Result Simplify(std::span<const MeshData::Vertex> vertices, std::span<const u32> indices,
+		u32 targetIndexCount, const Options& options)
+	{
+		RYU_PROFILE_SCOPE();
+
+		Result result{ .Indices = { indices.begin(), indices.begin() + (indices.size() - indices.size() % 3) } };
+		if (result.Indices.empty())
+		{
+			return result;
+		}
+
+		Simplifier simplifier(vertices, indices, options);
+		result.Error = simplifier.Run(result.Indices, targetIndexCount);
+		return result;
+	}
+
+	void BuildLods(MeshData& mesh, u32 lodCount, f32 reduction, const Options& options)
+	{
+		RYU_PROFILE_SCOPE();
+
+		// Cooked meshes carry their LODs already
+		if (mesh.Mapping)
+		{
+			return;
+		}
+
+		// Rebuilding starts over from LOD 0
+		if (!mesh.Lods.empty())
+		{
+			mesh.Indices.resize(mesh.Lods[0].IndexCount);
+			mesh.Lods.clear();
+		}
+
+		const u32 vertexCount = static_cast<u32>(mesh.Vertices.size());
+		const u32 indexCount  = static_cast<u32>(mesh.Indices.size() - mesh.Indices.size() % 3);
+		if (lodCount < 2 || indexCount == 0)
+		{
+			return;
+		}
+
+		Simplifier simplifier(mesh.Vertices, mesh.Indices, options);
+
+		// Vertices on the edge between two submeshes stay put, so the material ranges keep meeting
+		constexpr u32 NO_SUBMESH = ~0u;
+		std::vector<u32> owner(vertexCount, NO_SUBMESH);
+		for (u32 s = 0; s < mesh.SubMeshes.size(); ++s)
+		{
+			const MeshData::SubMesh& subMesh = mesh.SubMeshes[s];
+			for (u32 i = subMesh.IndexOffset; i < subMesh.IndexOffset + subMesh.IndexCount; ++i)
+			{
+				u32& vertexOwner = owner[mesh.Indices[i]];
+				if (vertexOwner != NO_SUBMESH && vertexOwner != s)
+				{
+					simplifier.Lock(mesh.Indices[i]);
+				}
+				vertexOwner = s;
+			}
+		}
+
+		mesh.Lods.push_back(MeshLod{ .IndexOffset = 0, .IndexCount = indexCount, .Error = 0.0f });
+
+		std::vector<u32> lod(mesh.Indices.begin(), mesh.Indices.begin() + indexCount);
+		f32 error = 0.0f;
+		for (u32 level = 1; level < lodCount; ++level)
+		{
+			const size_t previousCount = lod.size();
+			const u32 target = static_cast<u32>(static_cast<f32>(previousCount / 3) * reduction) * 3;
+
+			error = std::max(error, simplifier.Run(lod, target));
+			if (static_cast<f32>(lod.size()) > static_cast<f32>(previousCount) * (1.0f - MIN_LOD_REDUCTION))
+			{
+				break;
+			}
+
+			MeshOptimizer::OptimizeVertexCache(lod, vertexCount);
+
+			mesh.Lods.push_back(MeshLod
+			{
+				.IndexOffset = static_cast<u32>(mesh.Indices.size()),
+				.IndexCount  = static_cast<u32>(lod.size()),
+				.Error       = error
+			});
+			mesh.Indices.insert(mesh.Indices.end(), lod.begin(), lod.end());
+		}
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Asset/AssetData.h"
+#include <limits>
+
+namespace Ryu::Asset::MeshSimplifier
+{
+	constexpr u32 DEFAULT_LOD_COUNT = 4;
+
+	struct Options
+	{
+		// How much a collapse across differing normals or texture coordinates costs, as a fraction of the
+		// mesh radius per unit of difference. Only changes the order of collapses, not the reported error
+		f32 NormalWeight   = 0.05f;
+		f32 TexCoordWeight = 0.05f;
+
+		// Stop collapsing once the error would pass this, in mesh space
+		f32 MaxError = std::numeric_limits<f32>::max();
+	};
+
+	struct Result
+	{
+		std::vector<u32> Indices;
+		f32 Error = 0.0f;  // Furthest an input vertex ends up from the simplified surface
+	};
+
+	// Quadric error edge collapse (Garland, Heckbert 1997) down to about targetIndexCount indices.
+	// Vertices only collapse onto existing vertices, so the result indexes the same vertex array.
+	// Open borders, UV and normal seams and vertices shared by submeshes never move
+	[[nodiscard]] Result Simplify(std::span<const MeshData::Vertex> vertices, std::span<const u32> indices,
+		u32 targetIndexCount, const Options& options = {});
+
+	// Appends up to lodCount - 1 LODs to the index buffer, each with about reduction times the triangles
+	// of the one before it, and fills MeshData::Lods. Stops early once a mesh does not get any simpler
+	void BuildLods(MeshData& mesh, u32 lodCount = DEFAULT_LOD_COUNT, f32 reduction = 0.5f, const Options& options = {});
+}
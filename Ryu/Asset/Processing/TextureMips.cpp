@@ -0,0 +1,168 @@
+#include "Asset/Processing/TextureMips.h"
+#include "Core/Profiling/Profiling.h"
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace Ryu::Asset::TextureMips
+{
+	namespace
+	{
+		// Steps of linear light between 0 and 1. Fine enough that the darkest sRGB codes, where the curve
+		// is steepest, still round back to themselves
+		constexpr u32 LINEAR_STEPS = 8192;
+
+		struct GammaTables
+		{
+			std::array<f32, 256> ToLinear;          // sRGB code -> linear, scaled to 0..LINEAR_STEPS - 1
+			std::array<u8, LINEAR_STEPS> ToSRGB;    // Scaled linear -> sRGB code
+		};
+
+		f32 DecodeSRGB(f32 c) { return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f); }
+		f32 EncodeSRGB(f32 c) { return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f; }
+
+		const GammaTables& GetGammaTables()
+		{
+			static const GammaTables tables = []
+			{
+				constexpr f32 scale = LINEAR_STEPS - 1;
+
+				GammaTables t;
+				for (u32 i = 0; i < 256; ++i)
+				{
+					t.ToLinear[i] = DecodeSRGB(i / 255.0f) * scale;
+				}
+				for (u32 i = 0; i < LINEAR_STEPS; ++i)
+				{
+					t.ToSRGB[i] = static_cast<u8>(EncodeSRGB(i / scale) * 255.0f + 0.5f);
+				}
+				return t;
+			}();
+			return tables;
+		}
+
+		// One RGBA8 texel as floats, color through the gamma table for SRGB
+		template <bool SRGB>
+		__m128 LoadTexel(const u8* texel, const GammaTables& tables)
+		{
+			if constexpr (SRGB)
+			{
+				return _mm_setr_ps(tables.ToLinear[texel[0]], tables.ToLinear[texel[1]], tables.ToLinear[texel[2]], texel[3]);
+			}
+			else
+			{
+				u32 packed;
+				std::memcpy(&packed, texel, sizeof(packed));
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<i32>(packed)), zero), zero);
+				return _mm_cvtepi32_ps(wide);
+			}
+		}
+
+		template <bool SRGB>
+		void Downsample(const u8* src, u32 srcWidth, u32 srcHeight, u8* dst, u32 dstWidth, u32 dstHeight)
+		{
+			const GammaTables& tables = GetGammaTables();
+			const __m128 quarter = _mm_set1_ps(0.25f);
+			const __m128 half    = _mm_set1_ps(0.5f);
+
+			for (u32 y = 0; y < dstHeight; ++y)
+			{
+				const u8* row0 = src + u64(2 * y) * srcWidth * 4;
+				const u8* row1 = src + u64(std::min(2 * y + 1, srcHeight - 1)) * srcWidth * 4;
+				u8* out = dst + u64(y) * dstWidth * 4;
+
+				for (u32 x = 0; x < dstWidth; ++x)
+				{
+					const u32 x0 = 2 * x * 4;
+					const u32 x1 = std::min(2 * x + 1, srcWidth - 1) * 4;
+
+					const __m128 sum = _mm_add_ps(
+						_mm_add_ps(LoadTexel<SRGB>(row0 + x0, tables), LoadTexel<SRGB>(row0 + x1, tables)),
+						_mm_add_ps(LoadTexel<SRGB>(row1 + x0, tables), LoadTexel<SRGB>(row1 + x1, tables)));
+
+					// Rounded average, either a byte or an index into the gamma table
+					alignas(16) i32 values[4];
+					_mm_store_si128(reinterpret_cast<__m128i*>(values), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(sum, quarter), half)));
+
+					if constexpr (SRGB)
+					{
+						out[x * 4 + 0] = tables.ToSRGB[values[0]];
+						out[x * 4 + 1] = tables.ToSRGB[values[1]];
+						out[x * 4 + 2] = tables.ToSRGB[values[2]];
+					}
+					else
+					{
+						out[x * 4 + 0] = static_cast<u8>(values[0]);
+						out[x * 4 + 1] = static_cast<u8>(values[1]);
+						out[x * 4 + 2] = static_cast<u8>(values[2]);
+					}
+					out[x * 4 + 3] = static_cast<u8>(values[3]);
+				}
+			}
+		}
+	}
+
+	u32 GetFullMipCount(u32 width, u32 height)
+	{
+		return static_cast<u32>(std::bit_width(std::max({ width, height, 1u })));
+	}
+
+	void ConvertToRGBA8(TextureData& texture)
+	{
+		using Format = TextureData::Format;
+
+		const u32 channels = texture.PixelFormat == Format::R8 ? 1 : texture.PixelFormat == Format::RG8 ? 2 : texture.PixelFormat == Format::RGB8 ? 3 : 0;
+		if (channels == 0)
+		{
+			return;
+		}
+
+		const u64 texelCount = u64(texture.Width) * texture.Height;
+		std::vector<byte> rgba(texelCount * 4);
+		for (u64 i = 0; i < texelCount; ++i)
+		{
+			const byte* in = texture.Data.data() + i * channels;
+			byte* out = rgba.data() + i * 4;
+			switch (channels)
+			{
+				case 1: out[0] = out[1] = out[2] = in[0]; out[3] = 0xFF;  break;
+				case 2: out[0] = out[1] = out[2] = in[0]; out[3] = in[1]; break;
+				case 3: out[0] = in[0]; out[1] = in[1]; out[2] = in[2]; out[3] = 0xFF; break;
+			}
+		}
+
+		texture.Data        = std::move(rgba);
+		texture.PixelFormat = Format::RGBA8;
+		texture.MipLevels   = 1;
+	}
+
+	void Generate(TextureData& texture)
+	{
+		RYU_PROFILE_SCOPE();
+		RYU_ASSERT(texture.PixelFormat == TextureData::Format::RGBA8, "Mips are only generated for RGBA8 textures");
+		if (texture.PixelFormat != TextureData::Format::RGBA8 || texture.Width <= 0 || texture.Height <= 0)
+		{
+			return;
+		}
+
+		texture.MipLevels = static_cast<i32>(GetFullMipCount(texture.Width, texture.Height));
+		texture.Data.resize(texture.MipOffset(texture.MipLevels));
+
+		for (u32 mip = 1; mip < static_cast<u32>(texture.MipLevels); ++mip)
+		{
+			const u8* src = texture.Data.data() + texture.MipOffset(mip - 1);
+			u8* dst = texture.Data.data() + texture.MipOffset(mip);
+
+			if (texture.SRGB)
+			{
+				Downsample<true>(src, texture.MipWidth(mip - 1), texture.MipHeight(mip - 1), dst, texture.MipWidth(mip), texture.MipHeight(mip));
+			}
+			else
+			{
+				Downsample<false>(src, texture.MipWidth(mip - 1), texture.MipHeight(mip - 1), dst, texture.MipWidth(mip), texture.MipHeight(mip));
+			}
+		}
+	}
+}
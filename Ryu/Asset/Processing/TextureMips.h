@@ -0,0 +1,17 @@
+#pragma once
+#include "Asset/AssetData.h"
+
+namespace Ryu::Asset::TextureMips
+{
+	// Levels from width x height down to 1x1
+	[[nodiscard]] u32 GetFullMipCount(u32 width, u32 height);
+
+	// Widens R8, RG8 and RGB8 to RGBA8, keeping only the top level. One and two channel images are
+	// grey and grey + alpha, the way stb_image decodes them
+	void ConvertToRGBA8(TextureData& texture);
+
+	// Replaces the mips of an RGBA8 texture with a full chain, each level a 2x2 box filter of the one above.
+	// On odd sizes the last row and column are reused. SRGB textures average color in linear light,
+	// alpha is always averaged as is
+	void Generate(TextureData& texture);
+}
@@ -0,0 +1,254 @@
+#include "Asset/Processing/VertexPacking.h"
+#include "Core/Profiling/Profiling.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace Ryu::Asset::VertexPacking
+{
+	namespace
+	{
+		constexpr f32 UNIT_LENGTH_TOLERANCE = 1e-3f;
+
+		i16 ToSnorm16(f32 value)
+		{
+			const f32 scaled = std::clamp(value, -1.0f, 1.0f) * 32767.0f;
+			return static_cast<i16>(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+		}
+
+		u8 ToUnorm8(f32 value)
+		{
+			return static_cast<u8>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+
+		// Each attribute is written in its own pass over all vertices, the inner loops stay simple enough to vectorize
+		template <typename T, typename Func>
+		void WriteAttribute(std::span<const MeshData::Vertex> vertices, byte* out, u32 offset, u32 stride, Func&& encode)
+		{
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				const T value = encode(vertices[i]);
+				std::memcpy(out + i * stride + offset, &value, sizeof(T));
+			}
+		}
+
+		template <typename T, typename Func>
+		void ReadAttribute(std::span<MeshData::Vertex> vertices, const byte* in, u32 offset, u32 stride, Func&& decode)
+		{
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				T value;
+				std::memcpy(&value, in + i * stride + offset, sizeof(T));
+				decode(vertices[i], value);
+			}
+		}
+	}
+
+	VertexLayout ChooseLayout(std::span<const MeshData::Vertex> vertices)
+	{
+		bool unitNormals = true;
+		bool smallUVs    = true;
+		bool white       = true;
+		bool unormColors = true;
+
+		for (const MeshData::Vertex& vertex : vertices)
+		{
+			const auto& [nx, ny, nz] = vertex.Normal;
+			unitNormals &= std::abs(nx * nx + ny * ny + nz * nz - 1.0f) < UNIT_LENGTH_TOLERANCE;
+			smallUVs    &= std::abs(vertex.TexCoord[0]) <= MAX_HALF_TEXCOORD && std::abs(vertex.TexCoord[1]) <= MAX_HALF_TEXCOORD;
+
+			for (const f32 channel : vertex.Color)
+			{
+				white       &= channel == 1.0f;
+				unormColors &= channel >= 0.0f && channel <= 1.0f;
+			}
+		}
+
+		using ColorFormat = VertexLayout::ColorFormat;
+		return VertexLayout
+		{
+			.Normal   = unitNormals ? VertexLayout::NormalFormat::Octahedral16 : VertexLayout::NormalFormat::Float3,
+			.TexCoord = smallUVs ? VertexLayout::TexCoordFormat::Half2 : VertexLayout::TexCoordFormat::Float2,
+			.Color    = white ? ColorFormat::None : unormColors ? ColorFormat::RGBA8 : ColorFormat::Float4,
+		};
+	}
+
+	void Encode(std::span<const MeshData::Vertex> vertices, const VertexLayout& layout, std::span<byte> out)
+	{
+		RYU_PROFILE_SCOPE();
+		const u32 stride = layout.Stride();
+		RYU_ASSERT(out.size() >= vertices.size() * stride, "Packed vertex buffer is too small");
+
+		byte* dst = out.data();
+		WriteAttribute<std::array<f32, 3>>(vertices, dst, 0, stride, [](const auto& v) { return v.Position; });
+
+		switch (layout.Normal)
+		{
+		case VertexLayout::NormalFormat::Float3:
+			WriteAttribute<std::array<f32, 3>>(vertices, dst, layout.NormalOffset(), stride, [](const auto& v) { return v.Normal; });
+			break;
+		case VertexLayout::NormalFormat::Octahedral16:
+			WriteAttribute<std::array<i16, 2>>(vertices, dst, layout.NormalOffset(), stride, [](const auto& v) { return EncodeOctahedral(v.Normal); });
+			break;
+		}
+
+		switch (layout.TexCoord)
+		{
+		case VertexLayout::TexCoordFormat::Float2:
+			WriteAttribute<std::array<f32, 2>>(vertices, dst, layout.TexCoordOffset(), stride, [](const auto& v) { return v.TexCoord; });
+			break;
+		case VertexLayout::TexCoordFormat::Half2:
+			WriteAttribute<std::array<u16, 2>>(vertices, dst, layout.TexCoordOffset(), stride, [](const auto& v)
+			{
+				return std::array<u16, 2>{ FloatToHalf(v.TexCoord[0]), FloatToHalf(v.TexCoord[1]) };
+			});
+			break;
+		}
+
+		switch (layout.Color)
+		{
+		case VertexLayout::ColorFormat::Float4:
+			WriteAttribute<std::array<f32, 4>>(vertices, dst, layout.ColorOffset(), stride, [](const auto& v) { return v.Color; });
+			break;
+		case VertexLayout::ColorFormat::RGBA8:
+			WriteAttribute<std::array<u8, 4>>(vertices, dst, layout.ColorOffset(), stride, [](const auto& v)
+			{
+				return std::array<u8, 4>{ ToUnorm8(v.Color[0]), ToUnorm8(v.Color[1]), ToUnorm8(v.Color[2]), ToUnorm8(v.Color[3]) };
+			});
+			break;
+		case VertexLayout::ColorFormat::None:
+			break;
+		}
+	}
+
+	void Decode(std::span<const byte> packed, const VertexLayout& layout, std::span<MeshData::Vertex> out)
+	{
+		RYU_PROFILE_SCOPE();
+		const u32 stride = layout.Stride();
+		RYU_ASSERT(packed.size() >= out.size() * stride, "Packed vertex buffer is too small");
+
+		const byte* src = packed.data();
+		ReadAttribute<std::array<f32, 3>>(out, src, 0, stride, [](auto& v, const auto& value) { v.Position = value; });
+
+		switch (layout.Normal)
+		{
+		case VertexLayout::NormalFormat::Float3:
+			ReadAttribute<std::array<f32, 3>>(out, src, layout.NormalOffset(), stride, [](auto& v, const auto& value) { v.Normal = value; });
+			break;
+		case VertexLayout::NormalFormat::Octahedral16:
+			ReadAttribute<std::array<i16, 2>>(out, src, layout.NormalOffset(), stride, [](auto& v, const auto& value) { v.Normal = DecodeOctahedral(value); });
+			break;
+		}
+
+		switch (layout.TexCoord)
+		{
+		case VertexLayout::TexCoordFormat::Float2:
+			ReadAttribute<std::array<f32, 2>>(out, src, layout.TexCoordOffset(), stride, [](auto& v, const auto& value) { v.TexCoord = value; });
+			break;
+		case VertexLayout::TexCoordFormat::Half2:
+			ReadAttribute<std::array<u16, 2>>(out, src, layout.TexCoordOffset(), stride, [](auto& v, const auto& value)
+			{
+				v.TexCoord = { HalfToFloat(value[0]), HalfToFloat(value[1]) };
+			});
+			break;
+		}
+
+		switch (layout.Color)
+		{
+		case VertexLayout::ColorFormat::Float4:
+			ReadAttribute<std::array<f32, 4>>(out, src, layout.ColorOffset(), stride, [](auto& v, const auto& value) { v.Color = value; });
+			break;
+		case VertexLayout::ColorFormat::RGBA8:
+			ReadAttribute<std::array<u8, 4>>(out, src, layout.ColorOffset(), stride, [](auto& v, const auto& value)
+			{
+				v.Color = { value[0] / 255.0f, value[1] / 255.0f, value[2] / 255.0f, value[3] / 255.0f };
+			});
+			break;
+		case VertexLayout::ColorFormat::None:
+			for (MeshData::Vertex& vertex : out)
+			{
+				vertex.Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			}
+			break;
+		}
+	}
+
+	void Pack(MeshData& mesh)
+	{
+		Pack(mesh, ChooseLayout(mesh.Vertices));
+	}
+
+	void Pack(MeshData& mesh, const VertexLayout& layout)
+	{
+		RYU_ASSERT(!mesh.Mapping, "Cooked meshes come with their packed vertices");
+		mesh.PackedLayout = layout;
+		mesh.PackedVertices.resize(mesh.Vertices.size() * layout.Stride());
+		Encode(mesh.Vertices, layout, mesh.PackedVertices);
+	}
+
+	void PackIndices16(std::span<const u32> indices, std::span<u16> out)
+	{
+		RYU_ASSERT(out.size() >= indices.size(), "16-bit index buffer is too small");
+		std::ranges::transform(indices, out.begin(), [](u32 index) { return static_cast<u16>(index); });
+	}
+
+	// Folds the lower hemisphere over the diagonals, Cigolle et al. "A Survey of Efficient Representations for Independent Unit Vectors"
+	std::array<i16, 2> EncodeOctahedral(const std::array<f32, 3>& normal)
+	{
+		const auto& [nx, ny, nz] = normal;
+		const f32 l1  = std::abs(nx) + std::abs(ny) + std::abs(nz);
+		const f32 inv = l1 > 0.0f ? 1.0f / l1 : 0.0f;
+
+		const f32 x = nx * inv;
+		const f32 y = ny * inv;
+		const f32 foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		const f32 foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+		return { ToSnorm16(nz < 0.0f ? foldedX : x), ToSnorm16(nz < 0.0f ? foldedY : y) };
+	}
+
+	std::array<f32, 3> DecodeOctahedral(const std::array<i16, 2>& encoded)
+	{
+		f32 x = std::max(encoded[0] / 32767.0f, -1.0f);
+		f32 y = std::max(encoded[1] / 32767.0f, -1.0f);
+		const f32 z = 1.0f - std::abs(x) - std::abs(y);
+
+		const f32 t = std::max(-z, 0.0f);
+		x += x >= 0.0f ? -t : t;
+		y += y >= 0.0f ? -t : t;
+
+		const f32 invLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+		return { x * invLength, y * invLength, z * invLength };
+	}
+
+	// Round to nearest even, after Fabian Giesen's float_to_half_fast3_rtne
+	u16 FloatToHalf(f32 value)
+	{
+		u32 bits = std::bit_cast<u32>(value);
+		const u32 sign = bits & 0x8000'0000u;
+		bits ^= sign;
+
+		const u32 normal   = (bits + ((15u - 127u) << 23) + 0xFFFu + ((bits >> 13) & 1u)) >> 13;
+		const u32 denormal = std::bit_cast<u32>(std::bit_cast<f32>(bits) + 0.5f) - 0x3F00'0000u;
+		const u32 infNan   = bits > 0x7F80'0000u ? 0x7E00u : 0x7C00u;
+
+		const u32 half = bits >= 0x4780'0000u ? infNan : bits < 0x3880'0000u ? denormal : normal;
+		return static_cast<u16>(half | (sign >> 16));
+	}
+
+	f32 HalfToFloat(u16 value)
+	{
+		constexpr u32 shiftedExponent = 0x7C00u << 13;
+
+		u32 bits = (value & 0x7FFFu) << 13;
+		const u32 exponent = bits & shiftedExponent;
+		bits += (127u - 15u) << 23;
+
+		const u32 infNan   = bits + ((128u - 16u) << 23);
+		const u32 denormal = std::bit_cast<u32>(std::bit_cast<f32>(bits + (1u << 23)) - std::bit_cast<f32>(113u << 23));
+
+		bits = exponent == shiftedExponent ? infNan : exponent == 0 ? denormal : bits;
+		return std::bit_cast<f32>(bits | ((value & 0x8000u) << 16));
+	}
+}
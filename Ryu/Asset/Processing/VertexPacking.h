@@ -0,0 +1,29 @@
+#pragma once
+#include "Asset/AssetData.h"
+
+namespace Ryu::Asset::VertexPacking
+{
+	// Texture coordinates past this lose more than a texel of a 1024 texture as halves
+	constexpr f32 MAX_HALF_TEXCOORD = 2.0f;
+
+	// The smallest layout that keeps the mesh looking the same: octahedral normals when they are unit length,
+	// half UVs when they are in range, RGBA8 or no color when it fits
+	[[nodiscard]] VertexLayout ChooseLayout(std::span<const MeshData::Vertex> vertices);
+
+	// out needs vertices.size() * layout.Stride() bytes
+	void Encode(std::span<const MeshData::Vertex> vertices, const VertexLayout& layout, std::span<byte> out);
+	void Decode(std::span<const byte> packed, const VertexLayout& layout, std::span<MeshData::Vertex> out);
+
+	// Fills PackedVertices and PackedLayout, Vertices are left as they are
+	void Pack(MeshData& mesh);
+	void Pack(MeshData& mesh, const VertexLayout& layout);
+
+	// Only valid when every index is below 65536, see MeshData::Uses16BitIndices
+	void PackIndices16(std::span<const u32> indices, std::span<u16> out);
+
+	// Building blocks, branch free so the loops above vectorize
+	[[nodiscard]] std::array<i16, 2> EncodeOctahedral(const std::array<f32, 3>& normal);
+	[[nodiscard]] std::array<f32, 3> DecodeOctahedral(const std::array<i16, 2>& encoded);
+	[[nodiscard]] u16 FloatToHalf(f32 value);
+	[[nodiscard]] f32 HalfToFloat(u16 value);
+}
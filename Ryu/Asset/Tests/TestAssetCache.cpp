@@ -0,0 +1,465 @@
+#include "Asset/AssetCache.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <charconv>
+#include <fstream>
+#include <latch>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
+
+namespace Ryu::Asset::Tests
+{
+	// Stands in for a mesh: a text file of numbers, parsed like an OBJ would be
+	struct TestAssetData
+	{
+		std::vector<f32> Values;
+	};
+
+	// Made straight from the CPU data, there is no GPU factory here
+	struct TestGpuResource
+	{
+		static inline std::atomic<i32> s_alive{ 0 };
+
+		explicit TestGpuResource(size_t valueCount) : ValueCount(valueCount) { ++s_alive; }
+		~TestGpuResource() { --s_alive; }
+
+		size_t ValueCount;
+	};
+
+	std::atomic<u32>  g_loadCount{ 0 };
+	std::atomic<bool> g_holdLoads{ false };
+}
+
+namespace Ryu::Asset
+{
+	template<>
+	std::unique_ptr<Tests::TestAssetData> LoadAsset(const fs::path& path, DerivedDataCache*)
+	{
+		Tests::g_loadCount.fetch_add(1);
+		while (Tests::g_holdLoads.load())
+		{
+			std::this_thread::yield();
+		}
+
+		std::ifstream file(path);
+		if (!file)
+		{
+			return nullptr;
+		}
+
+		std::stringstream buffer;
+		buffer << file.rdbuf();
+		const std::string text = buffer.str();
+
+		auto data = std::make_unique<Tests::TestAssetData>();
+		const char* it  = text.data();
+		const char* end = it + text.size();
+		while (it < end)
+		{
+			f32 value = 0.0f;
+			const auto [next, ec] = std::from_chars(it, end, value);
+			if (ec == std::errc{})
+			{
+				data->Values.push_back(value);
+			}
+			it = (ec == std::errc{}) ? next + 1 : it + 1;
+		}
+		return data;
+	}
+
+	template<>
+	std::unique_ptr<Tests::TestGpuResource> AssetCache<Tests::TestAssetData, Tests::TestGpuResource>::MakeGpuResource(
+		const Tests::TestAssetData& data, std::string_view)
+	{
+		return std::make_unique<Tests::TestGpuResource>(data.Values.size());
+	}
+}
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Asset::Tests
+{
+	using TestCache  = AssetCache<TestAssetData, TestGpuResource>;
+	using TestHandle = AssetHandle<TestAssetData>;
+
+	constexpr size_t TEST_WORKER_COUNT = 4;
+
+	// Writes count files of valueCount numbers each into a scratch directory
+	std::vector<fs::path> WriteAssetFiles(std::string_view folder, u32 count, u32 valueCount)
+	{
+		const fs::path dir = fs::temp_directory_path() / "RyuAssetCacheTests" / folder;
+		fs::create_directories(dir);
+
+		std::vector<fs::path> paths;
+		for (u32 i = 0; i < count; ++i)
+		{
+			fs::path path = dir / std::format("Asset{}.txt", i);
+			std::ofstream file(path);
+			for (u32 v = 0; v < valueCount; ++v)
+			{
+				file << (i + v * 0.5f) << (v % 3 == 2 ? '\n' : ' ');
+			}
+			paths.push_back(std::move(path));
+		}
+		return paths;
+	}
+
+	TEST_CASE("AssetCache loading")
+	{
+		MT::JobSystem jobs(TEST_WORKER_COUNT);
+		const std::vector<fs::path> paths = WriteAssetFiles("Loading", 4, 300);
+
+		TestCache cache(nullptr);
+		cache.SetJobSystem(&jobs);
+
+		SUBCASE("Request load goes through Loading to Loaded")
+		{
+			const TestHandle handle = cache.Register(paths[0]);
+			CHECK(cache.GetState(handle) == AssetState::Unloaded);
+
+			g_holdLoads = true;
+			const MT::JobHandle load = cache.RequestLoad(handle);
+			CHECK(load.IsValid());
+			CHECK(cache.GetState(handle) == AssetState::Loading);
+			CHECK(cache.RequestLoad(handle) == load);  // Same load, not a second one
+
+			// The render thread path never waits
+			CHECK(cache.TryGetGpu(handle) == nullptr);
+
+			g_holdLoads = false;
+			load.Wait();
+			CHECK(cache.GetState(handle) == AssetState::Loaded);
+			REQUIRE(cache.GetCpu(handle) != nullptr);
+			CHECK(cache.GetCpu(handle)->Values.size() == 300);
+			CHECK_FALSE(cache.RequestLoad(handle).IsValid());  // Nothing left to load
+		}
+
+		SUBCASE("Lookups are not blocked by a load in progress")
+		{
+			const TestHandle slow = cache.Register(paths[1]);
+			const TestHandle fast = cache.Register(paths[2]);
+			std::ignore = cache.GetCpu(fast);
+
+			g_holdLoads = true;
+			const MT::JobHandle load = cache.RequestLoad(slow);
+
+			// Would deadlock if the load held the cache lock during I/O
+			CHECK(cache.GetCpu(fast) != nullptr);
+			CHECK(cache.GetState(fast) == AssetState::Loaded);
+
+			g_holdLoads = false;
+			load.Wait();
+		}
+
+		SUBCASE("Blocking getters from many threads load once")
+		{
+			const TestHandle handle = cache.Register(paths[3]);
+			const u32 loadsBefore = g_loadCount.load();
+
+			std::latch start(8);
+			std::atomic<u32> found{ 0 };
+			{
+				std::vector<std::jthread> threads;
+				for (u32 t = 0; t < 8; ++t)
+				{
+					threads.emplace_back([&]
+					{
+						start.arrive_and_wait();
+						if (const TestAssetData* data = cache.GetCpu(handle); data && data->Values.size() == 300)
+						{
+							found.fetch_add(1);
+						}
+					});
+				}
+			}
+
+			CHECK(found.load() == 8);
+			CHECK(g_loadCount.load() - loadsBefore == 1);
+		}
+
+		SUBCASE("Invalidating during a load drops its result")
+		{
+			const TestHandle handle = cache.Register(paths[0]);
+
+			g_holdLoads = true;
+			const MT::JobHandle load = cache.RequestLoad(handle);
+			cache.Invalidate(handle);
+			CHECK(cache.GetState(handle) == AssetState::Unloaded);
+
+			g_holdLoads = false;
+			load.Wait();
+			CHECK(cache.GetState(handle) == AssetState::Unloaded);
+
+			// A fresh request loads it again
+			CHECK(cache.GetCpu(handle) != nullptr);
+			CHECK(cache.GetState(handle) == AssetState::Loaded);
+		}
+
+		SUBCASE("Missing files fail")
+		{
+			const TestHandle handle = cache.Register(paths[0].parent_path() / "Missing.txt");
+			CHECK(cache.GetCpu(handle) == nullptr);
+			CHECK(cache.GetState(handle) == AssetState::Failed);
+			CHECK(cache.TryGetGpu(handle) == nullptr);
+		}
+	}
+
+	TEST_CASE("AssetCache without a job system loads on the caller")
+	{
+		const std::vector<fs::path> paths = WriteAssetFiles("Sync", 2, 30);
+		TestCache cache(nullptr);
+
+		const TestHandle handle = cache.Register(paths[0]);
+		CHECK_FALSE(cache.RequestLoad(handle).IsValid());
+		CHECK(cache.GetState(handle) == AssetState::Loaded);
+		CHECK(cache.GetCpu(cache.Register(paths[1]))->Values.size() == 30);
+	}
+
+	TEST_CASE("AssetCache requests more loads than the job pool holds")
+	{
+		// Submitting into a full pool runs queued loads on the requesting thread, which need the cache lock
+		MT::JobSystem jobs(1, 4);
+		const std::vector<fs::path> paths = WriteAssetFiles("FullPool", 64, 30);
+
+		TestCache cache(nullptr);
+		cache.SetJobSystem(&jobs);
+
+		std::vector<TestHandle> handles;
+		for (const fs::path& path : paths)
+		{
+			handles.push_back(cache.Register(path));
+		}
+
+		const u32 loadsBefore = g_loadCount.load();
+		for (TestHandle handle : handles)
+		{
+			std::ignore = cache.RequestLoad(handle);
+		}
+
+		for (TestHandle handle : handles)
+		{
+			const TestAssetData* data = cache.GetCpu(handle);
+			REQUIRE(data != nullptr);
+			CHECK(data->Values.size() == 30);
+		}
+		CHECK(g_loadCount.load() - loadsBefore == handles.size());
+	}
+
+	TEST_CASE("AssetCache lock-free lookups")
+	{
+		const std::vector<fs::path> paths = WriteAssetFiles("Lookup", 64, 30);
+		TestCache cache(nullptr);
+
+		std::vector<TestHandle> handles;
+		for (const fs::path& path : paths)
+		{
+			handles.push_back(cache.Register(path));
+		}
+
+		SUBCASE("Ready assets are found from many threads")
+		{
+			for (const TestHandle handle : handles)
+			{
+				REQUIRE(cache.GetGpu(handle) != nullptr);
+			}
+
+			std::latch start(8);
+			std::atomic<u32> mismatches{ 0 };
+			{
+				std::vector<std::jthread> threads;
+				for (u32 t = 0; t < 8; ++t)
+				{
+					threads.emplace_back([&]
+					{
+						start.arrive_and_wait();
+						for (u32 i = 0; i < 10'000; ++i)
+						{
+							const TestGpuResource* gpu = cache.TryGetGpu(handles[i % handles.size()]);
+							if (!gpu || gpu->ValueCount != 30)
+							{
+								mismatches.fetch_add(1);
+							}
+						}
+					});
+				}
+			}
+			CHECK(mismatches.load() == 0);
+		}
+
+		SUBCASE("Ready lookups never start a load")
+		{
+			CHECK(cache.FindReadyGpu(handles[0]) == nullptr);
+			CHECK(cache.GetState(handles[0]) == AssetState::Unloaded);
+
+			const TestGpuResource* gpu = cache.GetGpu(handles[0]);
+			REQUIRE(gpu != nullptr);
+			CHECK(cache.FindReadyGpu(handles[0]) == gpu);
+
+			cache.Invalidate(handles[0]);
+			CHECK(cache.FindReadyGpu(handles[0]) == nullptr);
+			CHECK(cache.GetState(handles[0]) == AssetState::Unloaded);
+		}
+
+		SUBCASE("Registering many assets keeps earlier ones reachable")
+		{
+			REQUIRE(cache.GetGpu(handles[0]) != nullptr);
+			for (u32 i = 0; i < 1000; ++i)
+			{
+				std::ignore = cache.Register(std::format("Procedural{}", i), std::make_unique<TestAssetData>());
+			}
+			CHECK(cache.TryGetGpu(handles[0]) != nullptr);
+		}
+
+		SUBCASE("Invalidated resources outlive the frames that may use them")
+		{
+			const TestGpuResource* gpu = cache.GetGpu(handles[0]);
+			REQUIRE(gpu != nullptr);
+			const i32 alive = TestGpuResource::s_alive.load();
+
+			cache.Invalidate(handles[0]);
+			CHECK(cache.GetState(handles[0]) == AssetState::Unloaded);
+			CHECK(gpu->ValueCount == 30);
+
+			for (u64 frame = 0; frame < AssetSlotTable<TestGpuResource>::RETIRE_AFTER_EPOCHS; ++frame)
+			{
+				CHECK(TestGpuResource::s_alive.load() == alive);
+				cache.AdvanceEpoch();
+			}
+			CHECK(TestGpuResource::s_alive.load() == alive - 1);
+
+			// Back to Ready on the next blocking get
+			CHECK(cache.GetGpu(handles[0]) != nullptr);
+			CHECK(cache.TryGetGpu(handles[0]) != nullptr);
+		}
+	}
+
+	// Kept here only as a benchmark baseline, the lookup before the slot table
+	struct LockedAssetLookup
+	{
+		[[nodiscard]] const TestGpuResource* Find(AssetId id) const
+		{
+			std::shared_lock lock(Mutex);
+			const auto it = Entries.find(id);
+			if (it == Entries.end())
+			{
+				return nullptr;
+			}
+
+			// The old path built the file name up front for its log messages
+			const std::string name = it->second.first.filename().string();
+			return name.empty() ? nullptr : it->second.second;
+		}
+
+		mutable std::shared_mutex                                                Mutex;
+		std::unordered_map<AssetId, std::pair<fs::path, const TestGpuResource*>> Entries;
+	};
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("AssetCache lookup benchmark" * doctest::skip())
+	{
+		constexpr u32 assetCount      = 1000;
+		constexpr u32 lookupsPerFrame = 100'000;
+		constexpr u32 frameCount      = 10;
+		constexpr u32 threadCount     = 8;
+
+		const std::vector<fs::path> paths = WriteAssetFiles("LookupBenchmark", assetCount, 3);
+		TestCache cache(nullptr);
+		LockedAssetLookup baseline;
+
+		std::vector<TestHandle> handles;
+		for (const fs::path& path : paths)
+		{
+			const TestHandle handle = cache.Register(path);
+			baseline.Entries[handle.Id] = { path, cache.GetGpu(handle) };
+			handles.push_back(handle);
+		}
+
+		// Each frame splits the lookups over the threads, like parallel render item extraction would
+		auto runFrames = [&](auto&& lookup)
+		{
+			Utils::Stopwatch timer(true);
+			for (u32 frame = 0; frame < frameCount; ++frame)
+			{
+				std::vector<std::jthread> threads;
+				for (u32 t = 0; t < threadCount; ++t)
+				{
+					threads.emplace_back([&, t]
+					{
+						size_t sum = 0;
+						for (u32 i = t; i < lookupsPerFrame; i += threadCount)
+						{
+							if (const TestGpuResource* gpu = lookup(handles[(i * 7919) % assetCount]))
+							{
+								sum += gpu->ValueCount;
+							}
+						}
+						volatile size_t sink = sum;
+						(void)sink;
+					});
+				}
+				threads.clear();
+				cache.AdvanceEpoch();
+			}
+			return timer.Elapsed<std::chrono::milliseconds>() / frameCount;
+		};
+
+		const f64 lockedMs   = runFrames([&baseline](TestHandle handle) { return baseline.Find(handle.Id); });
+		const f64 lockFreeMs = runFrames([&cache](TestHandle handle) { return cache.TryGetGpu(handle); });
+
+		CHECK(cache.TryGetGpu(handles.front()) != nullptr);
+		MESSAGE(lookupsPerFrame << " lookups/frame on " << threadCount << " threads: locked " << lockedMs
+			<< " ms | lock free " << lockFreeMs << " ms (" << lockedMs / lockFreeMs << "x)");
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("AssetCache load benchmark" * doctest::skip())
+	{
+		constexpr u32 assetCount = 500;
+		const std::vector<fs::path> paths = WriteAssetFiles("Benchmark", assetCount, 30'000);
+
+		auto registerAll = [&paths](TestCache& cache)
+		{
+			std::vector<TestHandle> handles;
+			for (const fs::path& path : paths)
+			{
+				handles.push_back(cache.Register(path));
+			}
+			return handles;
+		};
+
+		f64 serialMs = 0.0;
+		{
+			TestCache cache(nullptr);
+			const auto handles = registerAll(cache);
+
+			Utils::Stopwatch timer(true);
+			for (const TestHandle handle : handles)
+			{
+				std::ignore = cache.GetCpu(handle);
+			}
+			serialMs = timer.Elapsed<std::chrono::milliseconds>();
+		}
+
+		for (size_t workers : { 1ull, 3ull, 7ull })
+		{
+			MT::JobSystem jobs(workers);
+			TestCache cache(nullptr);
+			cache.SetJobSystem(&jobs);
+			const auto handles = registerAll(cache);
+
+			Utils::Stopwatch timer(true);
+			std::vector<MT::JobHandle> loads;
+			for (const TestHandle handle : handles)
+			{
+				loads.push_back(cache.RequestLoad(handle));
+			}
+			jobs.WaitForAll(loads);
+			const f64 parallelMs = timer.Elapsed<std::chrono::milliseconds>();
+
+			CHECK(cache.GetState(handles.back()) == AssetState::Loaded);
+			MESSAGE(assetCount << " assets: serial " << serialMs << " ms | " << workers << " workers + caller "
+				<< parallelMs << " ms (" << serialMs / parallelMs << "x)");
+		}
+	}
+}
@@ -0,0 +1,286 @@
+#include "Asset/AssetCache.h"
+#include "Asset/DerivedDataCache.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <fstream>
+
+namespace Ryu::Asset::Tests
+{
+	// Startup only needs CPU data, nothing is uploaded here
+	struct NoGpuResource {};
+}
+
+namespace Ryu::Asset
+{
+	template<>
+	std::unique_ptr<Tests::NoGpuResource> AssetCache<MeshData, Tests::NoGpuResource>::MakeGpuResource(const MeshData&, std::string_view)
+	{
+		return nullptr;
+	}
+}
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Asset::Tests
+{
+	using MeshCpuCache = AssetCache<MeshData, NoGpuResource>;
+
+	fs::path GetScratchDir(std::string_view folder)
+	{
+		const fs::path dir = fs::temp_directory_path() / "RyuDerivedDataCacheTests" / folder;
+		fs::remove_all(dir);
+		fs::create_directories(dir);
+		return dir;
+	}
+
+	void WriteText(const fs::path& path, std::string_view text)
+	{
+		std::ofstream(path, std::ios::binary) << text;
+	}
+
+	// A size x size grid of quads, the seed moves it so every asset has its own bytes
+	void WriteGridObj(const fs::path& path, u32 size, u32 seed)
+	{
+		std::ofstream file(path);
+		for (u32 y = 0; y <= size; ++y)
+		{
+			for (u32 x = 0; x <= size; ++x)
+			{
+				file << "v " << x << ' ' << (x * y % 7) * 0.1f << ' ' << y + seed * 0.01f << '\n';
+			}
+		}
+
+		file << "vn 0 1 0\nvt 0 0\n";
+		for (u32 y = 0; y < size; ++y)
+		{
+			for (u32 x = 0; x < size; ++x)
+			{
+				const u32 i = y * (size + 1) + x + 1;  // OBJ indices start at 1
+				const u32 j = i + size + 1;
+				file << "f " << i << "/1/1 " << j << "/1/1 " << i + 1 << "/1/1\n";
+				file << "f " << i + 1 << "/1/1 " << j << "/1/1 " << j + 1 << "/1/1\n";
+			}
+		}
+	}
+
+	TEST_CASE("Derived data keys")
+	{
+		const fs::path dir = GetScratchDir("Keys");
+		DerivedDataCache derivedData(dir / "Cache");
+
+		const fs::path a = dir / "A.txt";
+		const fs::path b = dir / "Other" / "B.txt";
+		fs::create_directories(b.parent_path());
+		WriteText(a, "Some source bytes");
+		WriteText(b, "Some source bytes");
+
+		const DerivedDataCache::Key key = derivedData.MakeKey(a, 1);
+		REQUIRE(key != DerivedDataCache::INVALID_KEY);
+
+		SUBCASE("Same bytes anywhere are the same key")
+		{
+			CHECK(derivedData.MakeKey(b, 1) == key);
+		}
+
+		SUBCASE("Bytes, importer version and settings all change the key")
+		{
+			WriteText(b, "Some source bytez");
+			CHECK(derivedData.MakeKey(b, 1) != key);
+			CHECK(derivedData.MakeKey(a, 2) != key);
+
+			constexpr std::array<u32, 2> settings{ 4, 1 };
+			constexpr std::array<u32, 2> otherSettings{ 4, 2 };
+			const DerivedDataCache::Key withSettings = derivedData.MakeKey(a, 1, std::as_bytes(std::span(settings)));
+			CHECK(withSettings != key);
+			CHECK(derivedData.MakeKey(a, 1, std::as_bytes(std::span(otherSettings))) != withSettings);
+		}
+
+		SUBCASE("Empty and missing sources")
+		{
+			WriteText(b, "");
+			CHECK(derivedData.MakeKey(b, 1) != DerivedDataCache::INVALID_KEY);
+			CHECK(derivedData.MakeKey(dir / "Missing.txt", 1) == DerivedDataCache::INVALID_KEY);
+		}
+
+		SUBCASE("Paths are spread over folders by key")
+		{
+			const fs::path path = derivedData.GetPath(0x0123456789abcdefull, ".ryumesh");
+			CHECK(path == dir / "Cache" / "01" / "0123456789abcdef.ryumesh");
+		}
+	}
+
+	TEST_CASE("Derived data hits and misses")
+	{
+		const fs::path dir = GetScratchDir("Stats");
+		DerivedDataCache derivedData(dir / "Cache");
+
+		u32 imports = 0;
+		auto load = [](const fs::path& path) -> std::unique_ptr<std::string>
+		{
+			std::ifstream file(path, std::ios::binary);
+			std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			return text.starts_with("Cooked") ? std::make_unique<std::string>(std::move(text)) : nullptr;
+		};
+		auto import = [&imports] { ++imports; return std::make_unique<std::string>("Cooked data"); };
+		auto store  = [](const std::string& data, const fs::path& path) { WriteText(path, data); return true; };
+
+		constexpr DerivedDataCache::Key key = 42;
+		const std::unique_ptr<std::string> first = derivedData.GetOrImport<std::string>(key, ".txt", load, import, store);
+		REQUIRE(first);
+		CHECK(imports == 1);
+		CHECK(fs::exists(derivedData.GetPath(key, ".txt")));
+
+		const std::unique_ptr<std::string> second = derivedData.GetOrImport<std::string>(key, ".txt", load, import, store);
+		REQUIRE(second);
+		CHECK(*second == *first);
+		CHECK(imports == 1);
+
+		DerivedDataCache::Stats stats = derivedData.GetStats();
+		CHECK(stats.Hits == 1);
+		CHECK(stats.Misses == 1);
+
+		SUBCASE("Unreadable data is imported again")
+		{
+			WriteText(derivedData.GetPath(key, ".txt"), "Damaged");
+			std::ignore = derivedData.GetOrImport<std::string>(key, ".txt", load, import, store);
+			CHECK(imports == 2);
+			CHECK(derivedData.GetStats().Misses == 2);
+		}
+
+		SUBCASE("Failed stores and imports")
+		{
+			auto failStore = [](const std::string&, const fs::path&) { return false; };
+			CHECK(derivedData.GetOrImport<std::string>(7, ".txt", load, import, failStore));
+			CHECK(derivedData.GetStats().StoreFailures == 1);
+
+			auto failImport = [] { return std::unique_ptr<std::string>(); };
+			CHECK_FALSE(derivedData.GetOrImport<std::string>(8, ".txt", load, failImport, store));
+			CHECK_FALSE(fs::exists(derivedData.GetPath(8, ".txt")));
+		}
+
+		derivedData.ResetStats();
+		stats = derivedData.GetStats();
+		CHECK(stats.Hits + stats.Misses + stats.StoreFailures + stats.HashedBytes == 0);
+	}
+
+	TEST_CASE("Asset cache imports through the derived data cache")
+	{
+		const fs::path dir = GetScratchDir("AssetCache");
+		const fs::path objPath = dir / "Grid.obj";
+		WriteGridObj(objPath, 4, 0);
+
+		DerivedDataCache derivedData(dir / "Cache");
+		MT::JobSystem jobs(2);
+
+		// A second run, as far as the derived data is concerned
+		for (u32 run = 0; run < 2; ++run)
+		{
+			MeshCpuCache cache(nullptr);
+			cache.SetJobSystem(&jobs);
+			cache.SetDerivedDataCache(&derivedData);
+
+			const MeshData* mesh = cache.GetCpu(cache.Register(objPath));
+			REQUIRE(mesh);
+			CHECK_FALSE(mesh->GetIndices().empty());
+		}
+
+		const DerivedDataCache::Stats stats = derivedData.GetStats();
+		CHECK(stats.Misses == 1);
+		CHECK(stats.Hits == 1);
+	}
+
+	TEST_CASE("Editing an OBJ's material library imports it again")
+	{
+		const fs::path dir = GetScratchDir("Materials");
+		const fs::path objPath = dir / "Quad.obj";
+		const fs::path mtlPath = dir / "Quad.mtl";
+		WriteText(objPath, "mtllib Quad.mtl\nusemtl Paint\nv 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvn 0 0 1\nvt 0 0\nf 1/1/1 2/1/1 3/1/1\nf 1/1/1 3/1/1 4/1/1\n");
+		WriteText(mtlPath, "newmtl Paint\nKd 1 0 0\n");
+
+		DerivedDataCache derivedData(dir / "Cache");
+		MT::JobSystem jobs(2);
+
+		auto loadAlbedo = [&]
+		{
+			MeshCpuCache cache(nullptr);
+			cache.SetJobSystem(&jobs);
+			cache.SetDerivedDataCache(&derivedData);
+
+			const MeshData* mesh = cache.GetCpu(cache.Register(objPath));
+			REQUIRE(mesh);
+			REQUIRE(mesh->Materials.size() == 1);
+			return mesh->Materials[0].Albedo;
+		};
+
+		CHECK(loadAlbedo()[0] == 1.0f);
+		CHECK(loadAlbedo()[0] == 1.0f);
+
+		// Same .obj bytes, only the material changed
+		WriteText(mtlPath, "newmtl Paint\nKd 0 1 0\n");
+		const std::array<f32, 4> albedo = loadAlbedo();
+		CHECK(albedo[0] == 0.0f);
+		CHECK(albedo[1] == 1.0f);
+
+		const DerivedDataCache::Stats stats = derivedData.GetStats();
+		CHECK(stats.Misses == 2);
+		CHECK(stats.Hits == 1);
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Derived data startup benchmark" * doctest::skip())
+	{
+		constexpr u32 assetCount = 1000;
+		constexpr u32 gridSize   = 24;  // ~1k triangles each, a typical prop
+
+		const fs::path dir = GetScratchDir("Benchmark");
+		std::vector<fs::path> paths;
+		for (u32 i = 0; i < assetCount; ++i)
+		{
+			paths.push_back(dir / ("Asset" + std::to_string(i) + ".obj"));
+			WriteGridObj(paths.back(), gridSize, i);
+		}
+
+		MT::JobSystem jobs;
+		DerivedDataCache derivedData(dir / "Cache");
+
+		// What a launch does: register everything, load it all on the job system and wait
+		auto startup = [&](DerivedDataCache* cacheToUse)
+		{
+			MeshCpuCache cache(nullptr);
+			cache.SetJobSystem(&jobs);
+			cache.SetDerivedDataCache(cacheToUse);
+
+			Utils::Stopwatch timer(true);
+			std::vector<MT::JobHandle> loads;
+			for (const fs::path& path : paths)
+			{
+				loads.push_back(cache.RequestLoad(cache.Register(path)));
+			}
+			jobs.WaitForAll(loads);
+
+			u32 loaded = 0;
+			cache.ForEach([&loaded](auto, const MeshCpuCache::Entry& entry) { loaded += entry.State == AssetState::Loaded; });
+			CHECK(loaded == assetCount);
+			return timer.Elapsed<std::chrono::milliseconds>();
+		};
+
+		const f64 uncachedMs = startup(nullptr);
+		const f64 coldMs     = startup(&derivedData);
+		const DerivedDataCache::Stats cold = derivedData.GetStats();
+
+		derivedData.ResetStats();
+		const f64 warmMs = startup(&derivedData);
+		const DerivedDataCache::Stats warm = derivedData.GetStats();
+
+		CHECK(cold.Misses == assetCount);
+		CHECK(warm.Hits == assetCount);
+		CHECK(warm.Misses == 0);
+
+		MESSAGE(assetCount << " OBJ assets, " << gridSize * gridSize * 2 << " triangles each, "
+			<< jobs.GetNumThreads() << " workers + caller");
+		MESSAGE("No cache:   " << uncachedMs << " ms");
+		MESSAGE("Cold cache: " << coldMs << " ms (" << cold.Hits << " hits, " << cold.Misses << " misses)");
+		MESSAGE("Warm cache: " << warmMs << " ms (" << warm.Hits << " hits, " << warm.Misses << " misses, "
+			<< warm.HashedBytes / 1024 << " KB hashed) " << uncachedMs / warmMs << "x");
+	}
+}
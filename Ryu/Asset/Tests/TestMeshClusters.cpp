@@ -0,0 +1,198 @@
+#include "Asset/Processing/MeshClusters.h"
+#include "Asset/Processing/MeshOptimizer.h"
+#include "Asset/Primitives.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <cmath>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Asset::Tests
+{
+	constexpr f32 EPSILON = 1e-4f;
+
+	bool Contains(const std::array<f32, 3>& center, f32 radius, const std::array<f32, 3>& point)
+	{
+		const f32 dx = point[0] - center[0], dy = point[1] - center[1], dz = point[2] - center[2];
+		return std::sqrt(dx * dx + dy * dy + dz * dz) <= radius + EPSILON;
+	}
+
+	// Triangles rebuilt from the meshlets, sorted so they compare against the index buffer
+	std::vector<std::array<u32, 3>> GetMeshletTriangles(const MeshData& mesh, u32 first, u32 count)
+	{
+		std::vector<std::array<u32, 3>> triangles;
+		for (const Meshlet& meshlet : std::span(mesh.Meshlets).subspan(first, count))
+		{
+			for (u32 t = 0; t < meshlet.TriangleCount; ++t)
+			{
+				auto& triangle = triangles.emplace_back();
+				for (u32 c = 0; c < 3; ++c)
+				{
+					triangle[c] = mesh.MeshletVertices[meshlet.VertexOffset + mesh.MeshletTriangles[meshlet.TriangleOffset + t * 3 + c]];
+				}
+			}
+		}
+		std::ranges::sort(triangles);
+		return triangles;
+	}
+
+	std::vector<std::array<u32, 3>> GetIndexTriangles(const MeshData& mesh, u32 offset, u32 count)
+	{
+		std::vector<std::array<u32, 3>> triangles;
+		for (u32 i = offset; i + 2 < offset + count; i += 3)
+		{
+			triangles.push_back({ mesh.Indices[i], mesh.Indices[i + 1], mesh.Indices[i + 2] });
+		}
+		std::ranges::sort(triangles);
+		return triangles;
+	}
+
+	// Cones follow the triangle winding like hardware culling does. The primitives are not consistent about
+	// it, so tests that care flip every triangle to face along its vertex normals first
+	void OrientToNormals(MeshData& mesh)
+	{
+		for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+		{
+			const auto& p0 = mesh.Vertices[mesh.Indices[i]].Position;
+			const auto& p1 = mesh.Vertices[mesh.Indices[i + 1]].Position;
+			const auto& p2 = mesh.Vertices[mesh.Indices[i + 2]].Position;
+			const auto& n  = mesh.Vertices[mesh.Indices[i]].Normal;
+
+			const f32 e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			const f32 e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			const f32 facing = (e1[1] * e2[2] - e1[2] * e2[1]) * n[0] + (e1[2] * e2[0] - e1[0] * e2[2]) * n[1] + (e1[0] * e2[1] - e1[1] * e2[0]) * n[2];
+			if (facing < 0.0f)
+			{
+				std::swap(mesh.Indices[i + 1], mesh.Indices[i + 2]);
+			}
+		}
+	}
+
+	TEST_CASE("Mesh bounds")
+	{
+		const std::unique_ptr<MeshData> sphere = Primitives::CreateSphere(64, 32);
+		MeshClusters::ComputeBounds(*sphere);
+
+		const MeshBounds& bounds = sphere->Bounds;
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			CHECK(bounds.Min[axis] == doctest::Approx(-bounds.Max[axis]).epsilon(EPSILON));
+			CHECK(std::abs(bounds.Center[axis]) < EPSILON);
+		}
+		CHECK(bounds.Radius == doctest::Approx(bounds.Max[0]).epsilon(0.01));
+
+		bool allInside = true;
+		for (const MeshData::Vertex& vertex : sphere->Vertices)
+		{
+			allInside &= Contains(bounds.Center, bounds.Radius, vertex.Position);
+			for (u32 axis = 0; axis < 3; ++axis)
+			{
+				allInside &= vertex.Position[axis] >= bounds.Min[axis] && vertex.Position[axis] <= bounds.Max[axis];
+			}
+		}
+		CHECK(allInside);
+
+		// The one submesh covers everything
+		REQUIRE(sphere->SubMeshes.size() == 1);
+		CHECK(sphere->SubMeshes[0].Bounds.Min == bounds.Min);
+		CHECK(sphere->SubMeshes[0].Bounds.Max == bounds.Max);
+	}
+
+	TEST_CASE("Meshlets")
+	{
+		std::unique_ptr<MeshData> mesh = Primitives::CreateSphere(64, 32);
+		OrientToNormals(*mesh);
+		MeshOptimizer::OptimizeVertexCache(*mesh);
+
+		const u32 split = static_cast<u32>(mesh->Indices.size() / 3 / 3 * 3);
+		mesh->SubMeshes = { { 0, split, 0 }, { split, static_cast<u32>(mesh->Indices.size()) - split, 1 } };
+		MeshClusters::Build(*mesh);
+
+		SUBCASE("Limits hold and every triangle is covered once")
+		{
+			bool withinLimits = true;
+			for (const Meshlet& meshlet : mesh->Meshlets)
+			{
+				withinLimits &= meshlet.VertexCount <= Meshlet::MAX_VERTICES && meshlet.TriangleCount <= Meshlet::MAX_TRIANGLES;
+				withinLimits &= meshlet.TriangleCount > 0;
+			}
+			CHECK(withinLimits);
+
+			for (const MeshData::SubMesh& subMesh : mesh->SubMeshes)
+			{
+				CHECK(subMesh.MeshletCount > 0);
+				CHECK(GetMeshletTriangles(*mesh, subMesh.MeshletOffset, subMesh.MeshletCount)
+					== GetIndexTriangles(*mesh, subMesh.IndexOffset, subMesh.IndexCount));
+			}
+
+			// Greedy filling should leave few meshlets half empty
+			const f64 trianglesPerMeshlet = mesh->Indices.size() / 3.0 / mesh->Meshlets.size();
+			CHECK(trianglesPerMeshlet > Meshlet::MAX_TRIANGLES * 0.5);
+			MESSAGE(mesh->Meshlets.size() << " meshlets, " << trianglesPerMeshlet << " triangles each on average");
+		}
+
+		SUBCASE("Spheres contain their vertices")
+		{
+			bool contained = true;
+			for (const Meshlet& meshlet : mesh->Meshlets)
+			{
+				for (u32 v = 0; v < meshlet.VertexCount; ++v)
+				{
+					contained &= Contains(meshlet.Center, meshlet.Radius, mesh->Vertices[mesh->MeshletVertices[meshlet.VertexOffset + v]].Position);
+				}
+			}
+			CHECK(contained);
+		}
+
+		SUBCASE("Cones cull meshlets facing away")
+		{
+			// From far outside the sphere, meshlets on the far side face away, the near ones never do
+			const std::array<f32, 3> viewer{ 0.0f, 0.0f, -100.0f };
+			u32 culled = 0;
+			bool nearSideKept = true;
+			for (const Meshlet& meshlet : mesh->Meshlets)
+			{
+				const bool backfacing = MeshClusters::IsBackfacing(meshlet, viewer);
+				culled += backfacing ? 1 : 0;
+				nearSideKept &= !(backfacing && meshlet.Center[2] < -0.1f);
+			}
+			CHECK(culled > 0);
+			CHECK(nearSideKept);
+		}
+	}
+
+	TEST_CASE("Flat meshlets face one way")
+	{
+		std::unique_ptr<MeshData> plane = Primitives::CreatePlane(16);
+		OrientToNormals(*plane);
+		MeshClusters::Build(*plane);
+
+		bool upOnly = true;
+		for (const Meshlet& meshlet : plane->Meshlets)
+		{
+			upOnly &= meshlet.ConeCutoff < EPSILON;  // All normals equal, the cone is a line
+			upOnly &= MeshClusters::IsBackfacing(meshlet, { 0.0f, -10.0f, 0.0f }) != MeshClusters::IsBackfacing(meshlet, { 0.0f, 10.0f, 0.0f });
+		}
+		CHECK(upOnly);
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Meshlet build benchmark" * doctest::skip())
+	{
+		std::unique_ptr<MeshData> mesh = Primitives::CreateSphere(1024, 512);  // ~1M triangles
+		MeshOptimizer::OptimizeVertexCache(*mesh);
+
+		Utils::Stopwatch timer(true);
+		MeshClusters::ComputeBounds(*mesh);
+		const f64 boundsMs = timer.Elapsed<std::chrono::milliseconds>();
+
+		timer.Restart();
+		MeshClusters::BuildMeshlets(*mesh);
+		const f64 meshletMs = timer.Elapsed<std::chrono::milliseconds>();
+
+		CHECK(!mesh->Meshlets.empty());
+		MESSAGE(mesh->Indices.size() / 3 << " triangles: bounds " << boundsMs << " ms | "
+			<< mesh->Meshlets.size() << " meshlets " << meshletMs << " ms");
+	}
+}
@@ -0,0 +1,270 @@
+#include "Asset/AssetLoader.h"
+#include "Asset/DerivedDataCache.h"
+#include "Asset/Loaders/CookedMeshLoader.h"
+#include "Asset/Loaders/OBJLoader.h"
+#include "Asset/Primitives.h"
+#include "Asset/Processing/MeshClusters.h"
+#include "Asset/Processing/MeshSimplifier.h"
+#include "Asset/Processing/VertexPacking.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Asset::Tests
+{
+	fs::path GetScratchDir(std::string_view folder)
+	{
+		const fs::path dir = fs::temp_directory_path() / "RyuMeshCookingTests" / folder;
+		fs::remove_all(dir);
+		fs::create_directories(dir);
+		return dir;
+	}
+
+	// A size x size grid of quads, two triangles each
+	void WriteGridObj(const fs::path& path, u32 size)
+	{
+		std::ofstream file(path);
+		for (u32 y = 0; y <= size; ++y)
+		{
+			for (u32 x = 0; x <= size; ++x)
+			{
+				file << "v " << x << ' ' << (x * y % 7) * 0.1f << ' ' << y << '\n';
+			}
+		}
+
+		file << "vn 0 1 0\nvt 0 0\n";
+		for (u32 y = 0; y < size; ++y)
+		{
+			for (u32 x = 0; x < size; ++x)
+			{
+				const u32 i = y * (size + 1) + x + 1;  // OBJ indices start at 1
+				const u32 j = i + size + 1;
+				file << "f " << i << "/1/1 " << j << "/1/1 " << i + 1 << "/1/1\n";
+				file << "f " << i + 1 << "/1/1 " << j << "/1/1 " << j + 1 << "/1/1\n";
+			}
+		}
+	}
+
+	bool SameVertices(std::span<const MeshData::Vertex> a, std::span<const MeshData::Vertex> b)
+	{
+		return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size_bytes()) == 0;
+	}
+
+	TEST_CASE("Cooked mesh")
+	{
+		const fs::path dir = GetScratchDir("Cooked");
+
+		SUBCASE("Round trip maps the same data")
+		{
+			std::unique_ptr<MeshData> source = Primitives::CreateCube();
+			source->SubMeshes.push_back({ 12, 24, 1 });
+			source->Materials.push_back({ .Name = "Red", .Albedo = { 1.0f, 0.0f, 0.0f, 1.0f }, .AlbedoTexturePath = "Red.png" });
+			source->Materials.push_back({ .Name = "Metal", .Metallic = 1.0f, .Roughness = 0.2f, .NormalTexturePath = "Metal_n.png" });
+			MeshClusters::Build(*source);
+			VertexPacking::Pack(*source);
+
+			const fs::path path = dir / "Cube.ryumesh";
+			REQUIRE(CookedMeshLoader::Write(*source, path));
+
+			const std::unique_ptr<MeshData> cooked = CookedMeshLoader::Load(path);
+			REQUIRE(cooked);
+			CHECK(cooked->Mapping);
+			CHECK(cooked->Vertices.empty());
+			CHECK(SameVertices(cooked->GetVertices(), source->GetVertices()));
+			CHECK(std::ranges::equal(cooked->GetIndices(), source->Indices));
+			CHECK(cooked->VertexBufferSize() == source->VertexBufferSize());
+
+			// Straight into the mapping, aligned for the GPU upload
+			CHECK(reinterpret_cast<uintptr_t>(cooked->GetVertices().data()) % 64 == 0);
+
+			REQUIRE(cooked->SubMeshes.size() == 2);
+			CHECK(cooked->SubMeshes[1].IndexOffset == 12);
+			CHECK(cooked->SubMeshes[1].MaterialIndex == 1);
+
+			REQUIRE(cooked->Materials.size() == 2);
+			CHECK(cooked->Materials[0].Name == "Red");
+			CHECK(cooked->Materials[0].AlbedoTexturePath == "Red.png");
+			CHECK(cooked->Materials[1].Metallic == 1.0f);
+			CHECK(cooked->Materials[1].NormalTexturePath == "Metal_n.png");
+
+			CHECK(cooked->Bounds.Radius == source->Bounds.Radius);
+			CHECK(cooked->SubMeshes[1].Bounds.Max == source->SubMeshes[1].Bounds.Max);
+			CHECK(cooked->Meshlets.size() == source->Meshlets.size());
+			CHECK(cooked->MeshletVertices == source->MeshletVertices);
+			CHECK(cooked->MeshletTriangles == source->MeshletTriangles);
+
+			CHECK(cooked->PackedVertices.empty());
+			CHECK(cooked->PackedLayout == source->PackedLayout);
+			CHECK(std::ranges::equal(cooked->GetPackedVertices(), source->PackedVertices));
+			CHECK(reinterpret_cast<uintptr_t>(cooked->GetPackedVertices().data()) % 64 == 0);
+		}
+
+		SUBCASE("Packed vertices are optional")
+		{
+			const fs::path path = dir / "Unpacked.ryumesh";
+			REQUIRE(CookedMeshLoader::Write(*Primitives::CreateCube(), path));
+
+			const std::unique_ptr<MeshData> cooked = CookedMeshLoader::Load(path);
+			REQUIRE(cooked);
+			CHECK_FALSE(cooked->HasPackedVertices());
+		}
+
+		SUBCASE("LODs round trip")
+		{
+			std::unique_ptr<MeshData> source = Primitives::CreateSphere();
+			MeshSimplifier::BuildLods(*source);
+			REQUIRE(source->HasLods());
+
+			const fs::path path = dir / "Sphere.ryumesh";
+			REQUIRE(CookedMeshLoader::Write(*source, path));
+
+			const std::unique_ptr<MeshData> cooked = CookedMeshLoader::Load(path);
+			REQUIRE(cooked);
+			CHECK(std::ranges::equal(cooked->GetIndices(), source->Indices));
+			REQUIRE(cooked->Lods.size() == source->Lods.size());
+			for (size_t i = 0; i < source->Lods.size(); ++i)
+			{
+				CHECK(cooked->Lods[i].IndexOffset == source->Lods[i].IndexOffset);
+				CHECK(cooked->Lods[i].IndexCount == source->Lods[i].IndexCount);
+				CHECK(cooked->Lods[i].Error == source->Lods[i].Error);
+			}
+		}
+
+		SUBCASE("Damaged files are rejected")
+		{
+			const fs::path path = dir / "Damaged.ryumesh";
+			REQUIRE(CookedMeshLoader::Write(*Primitives::CreateSphere(), path));
+
+			fs::resize_file(path, fs::file_size(path) - 4);
+			CHECK_FALSE(CookedMeshLoader::Load(path));
+
+			std::ofstream(path, std::ios::binary) << "RYUM but not really";
+			CHECK_FALSE(CookedMeshLoader::Load(path));
+
+			CHECK_FALSE(CookedMeshLoader::Load(dir / "Missing.ryumesh"));
+		}
+
+		SUBCASE("Ranges outside the data are rejected")
+		{
+			// Every section fits the file, only what is inside them is wrong
+			auto cookWith = [&dir](auto&& damage)
+			{
+				std::unique_ptr<MeshData> mesh = Primitives::CreateSphere();
+				MeshClusters::Build(*mesh);
+				MeshSimplifier::BuildLods(*mesh);
+				VertexPacking::Pack(*mesh);
+				damage(*mesh);
+
+				const fs::path path = dir / "Ranges.ryumesh";
+				REQUIRE(CookedMeshLoader::Write(*mesh, path));
+				return CookedMeshLoader::Load(path);
+			};
+
+			CHECK(cookWith([](MeshData&) {}));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.SubMeshes[0].IndexOffset = static_cast<u32>(mesh.Indices.size()); }));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.SubMeshes[0].MeshletCount += 1; }));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.Lods.back().IndexOffset = static_cast<u32>(mesh.Indices.size()); }));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.Indices[5] = static_cast<u32>(mesh.Vertices.size()); }));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.Meshlets[0].TriangleOffset = static_cast<u32>(mesh.MeshletTriangles.size()); }));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.MeshletTriangles[0] = static_cast<u8>(mesh.Meshlets[0].VertexCount); }));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.MeshletVertices[0] = static_cast<u32>(mesh.Vertices.size()); }));
+			CHECK_FALSE(cookWith([](MeshData& mesh) { mesh.PackedVertices.resize(mesh.PackedVertices.size() - 4); }));
+		}
+	}
+
+	TEST_CASE("Loading a mesh goes through the derived data cache")
+	{
+		const fs::path dir     = GetScratchDir("Prefer");
+		const fs::path objPath = dir / "Grid.obj";
+		WriteGridObj(objPath, 8);
+
+		DerivedDataCache derivedData(dir / "Cache");
+
+		const std::unique_ptr<MeshData> first = LoadAsset<MeshData>(objPath, &derivedData);
+		REQUIRE(first);
+		CHECK_FALSE(first->Mapping);
+		CHECK(first->HasPackedVertices());
+		REQUIRE(first->HasLods());
+		CHECK(first->Lods[0].IndexCount == 8 * 8 * 6);  // The other LODs follow it in the index buffer
+		CHECK(derivedData.GetStats().Misses == 1);
+
+		const std::unique_ptr<MeshData> second = LoadAsset<MeshData>(objPath, &derivedData);
+		REQUIRE(second);
+		CHECK(second->Mapping);
+		CHECK(SameVertices(second->GetVertices(), first->GetVertices()));
+		CHECK(std::ranges::equal(second->GetPackedVertices(), first->GetPackedVertices()));
+		CHECK(derivedData.GetStats().Hits == 1);
+
+		SUBCASE("An edited source is imported again")
+		{
+			WriteGridObj(objPath, 9);
+			const std::unique_ptr<MeshData> reloaded = LoadAsset<MeshData>(objPath, &derivedData);
+			REQUIRE(reloaded);
+			CHECK_FALSE(reloaded->Mapping);
+			CHECK(reloaded->Lods[0].IndexCount == 9 * 9 * 6);
+			CHECK(derivedData.GetStats().Misses == 2);
+		}
+
+		SUBCASE("Without a cache the source is imported every time")
+		{
+			const std::unique_ptr<MeshData> direct = LoadAsset<MeshData>(objPath);
+			REQUIRE(direct);
+			CHECK_FALSE(direct->Mapping);
+			CHECK(derivedData.GetStats().Misses == 1);
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Mesh loading benchmark" * doctest::skip())
+	{
+		constexpr u32 gridSize = 708;  // ~1M triangles
+		const fs::path dir     = GetScratchDir("Benchmark");
+		const fs::path objPath = dir / "Grid.obj";
+		WriteGridObj(objPath, gridSize);
+
+		DerivedDataCache derivedData(dir / "Cache");
+
+		// Touching every vertex keeps the mapped loads honest, their pages are only read here
+		auto consume = [](const MeshData& mesh)
+		{
+			f32 sum = 0.0f;
+			for (const MeshData::Vertex& vertex : mesh.GetVertices())
+			{
+				sum += vertex.Position[1];
+			}
+			volatile f32 sink = sum;
+			(void)sink;
+		};
+
+		auto timeLoad = [&](const fs::path& path)
+		{
+			Utils::Stopwatch timer(true);
+			const std::unique_ptr<MeshData> mesh = LoadAsset<MeshData>(path, &derivedData);
+			REQUIRE(mesh);
+			consume(*mesh);
+			return timer.Elapsed<std::chrono::milliseconds>();
+		};
+
+		// The first load parses the OBJ and cooks it into the cache, the rest map the cooked file
+		const f64 objColdMs = timeLoad(objPath);
+		const f64 cookedColdMs = timeLoad(objPath);
+
+		f64 objWarmMs = 0.0;
+		{
+			Utils::Stopwatch timer(true);
+			const std::unique_ptr<MeshData> mesh = OBJLoader::Load(objPath);
+			REQUIRE(mesh);
+			consume(*mesh);
+			objWarmMs = timer.Elapsed<std::chrono::milliseconds>();
+		}
+		const f64 cookedWarmMs = timeLoad(objPath);
+
+		MESSAGE(gridSize * gridSize * 2 << " triangles");
+		MESSAGE("Cold: OBJ + cook " << objColdMs << " ms | cooked " << cookedColdMs << " ms");
+		MESSAGE("Warm: OBJ " << objWarmMs << " ms | cooked " << cookedWarmMs << " ms (" << objWarmMs / cookedWarmMs << "x)");
+	}
+}
@@ -0,0 +1,156 @@
+#include "Asset/Processing/MeshOptimizer.h"
+#include "Asset/Primitives.h"
+#include <algorithm>
+#include <cstring>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Asset::Tests
+{
+	// What the OBJ loader hands over: one vertex per corner, indices 0..n-1
+	std::unique_ptr<MeshData> Unindex(const MeshData& source)
+	{
+		auto mesh = std::make_unique<MeshData>();
+		for (const u32 index : source.GetIndices())
+		{
+			mesh->Vertices.push_back(source.GetVertices()[index]);
+			mesh->Indices.push_back(static_cast<u32>(mesh->Indices.size()));
+		}
+		mesh->SubMeshes = source.SubMeshes;
+		return mesh;
+	}
+
+	// Triangles as sorted raw vertex bytes, so meshes can be compared regardless of order and indexing
+	std::vector<std::string> GetTriangles(const MeshData& mesh, u32 offset = 0, u32 count = ~0u)
+	{
+		const std::span<const u32> indices = mesh.GetIndices().subspan(offset, std::min<size_t>(count, mesh.GetIndices().size() - offset));
+
+		std::vector<std::string> triangles;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			std::string& triangle = triangles.emplace_back(3 * sizeof(MeshData::Vertex), '\0');
+			for (u32 corner = 0; corner < 3; ++corner)
+			{
+				std::memcpy(triangle.data() + corner * sizeof(MeshData::Vertex), &mesh.GetVertices()[indices[i + corner]], sizeof(MeshData::Vertex));
+			}
+		}
+		std::ranges::sort(triangles);
+		return triangles;
+	}
+
+	f32 GetACMR(const MeshData& mesh)
+	{
+		return MeshOptimizer::ComputeACMR(mesh.GetIndices(), static_cast<u32>(mesh.GetVertices().size()));
+	}
+
+	TEST_CASE("Mesh optimizer")
+	{
+		const std::unique_ptr<MeshData> sphere = Primitives::CreateSphere(64, 32);
+
+		SUBCASE("Welding shares identical vertices")
+		{
+			std::unique_ptr<MeshData> mesh = Unindex(*sphere);
+			const auto triangles = GetTriangles(*mesh);
+			CHECK(GetACMR(*mesh) == doctest::Approx(3.0f));
+
+			MeshOptimizer::WeldVertices(*mesh);
+			CHECK(mesh->Vertices.size() <= sphere->Vertices.size());
+			CHECK(mesh->Indices.size() == sphere->Indices.size());
+			CHECK(GetTriangles(*mesh) == triangles);
+		}
+
+		SUBCASE("Unindexed meshes get indices")
+		{
+			MeshData mesh;
+			mesh.Vertices = Unindex(*sphere)->Vertices;
+
+			MeshOptimizer::WeldVertices(mesh);
+			CHECK(mesh.Indices.size() == sphere->Indices.size());
+			CHECK(mesh.Vertices.size() < mesh.Indices.size());
+		}
+
+		SUBCASE("Cache optimization lowers ACMR and keeps every triangle")
+		{
+			std::unique_ptr<MeshData> mesh = Unindex(*Primitives::CreatePlane(64));
+			MeshOptimizer::WeldVertices(*mesh);
+
+			// Scramble the triangle order, like an exporter might
+			std::vector<u32>& indices = mesh->Indices;
+			for (size_t i = 0, j = 7; i + 3 <= indices.size(); i += 3, j = (j * 31 + 17) % (indices.size() / 3))
+			{
+				std::swap_ranges(indices.begin() + i, indices.begin() + i + 3, indices.begin() + j * 3);
+			}
+
+			const auto triangles = GetTriangles(*mesh);
+			const f32 before = GetACMR(*mesh);
+
+			MeshOptimizer::OptimizeVertexCache(*mesh);
+			const f32 after = GetACMR(*mesh);
+
+			CHECK(after < before);
+			CHECK(after < 0.9f);
+			CHECK(GetTriangles(*mesh) == triangles);
+		}
+
+		SUBCASE("Fetch optimization orders vertices by first use")
+		{
+			std::unique_ptr<MeshData> mesh = Unindex(*sphere);
+			MeshOptimizer::WeldVertices(*mesh);
+			MeshOptimizer::OptimizeVertexCache(*mesh);
+			mesh->Vertices.push_back({});  // Unreferenced
+			const auto triangles = GetTriangles(*mesh);
+
+			MeshOptimizer::OptimizeVertexFetch(*mesh);
+
+			u32 nextNew = 0;
+			bool ordered = true;
+			for (const u32 index : mesh->Indices)
+			{
+				ordered &= (index <= nextNew);
+				nextNew = std::max(nextNew, index + 1);
+			}
+			CHECK(ordered);
+			CHECK(nextNew == mesh->Vertices.size());
+			CHECK(GetTriangles(*mesh) == triangles);
+		}
+
+		SUBCASE("Triangles stay in their submesh")
+		{
+			std::unique_ptr<MeshData> mesh = Unindex(*sphere);
+			const u32 split = static_cast<u32>(mesh->Indices.size() / 3 / 2 * 3);
+			mesh->SubMeshes = { { 0, split, 0 }, { split, static_cast<u32>(mesh->Indices.size()) - split, 1 } };
+
+			const auto first  = GetTriangles(*mesh, 0, split);
+			const auto second = GetTriangles(*mesh, split);
+
+			MeshOptimizer::Optimize(*mesh);
+			CHECK(GetTriangles(*mesh, 0, split) == first);
+			CHECK(GetTriangles(*mesh, split) == second);
+		}
+	}
+
+	TEST_CASE("Mesh optimizer results")
+	{
+		const std::pair<const char*, std::unique_ptr<MeshData>> meshes[] =
+		{
+			{ "Cube",   Primitives::CreateCube() },
+			{ "Sphere", Primitives::CreateSphere(128, 64) },
+			{ "Plane",  Primitives::CreatePlane(256) },
+		};
+
+		for (const auto& [name, source] : meshes)
+		{
+			std::unique_ptr<MeshData> mesh = Unindex(*source);
+			const size_t vertexCount = mesh->Vertices.size();
+			const f32 acmrBefore     = GetACMR(*mesh);
+
+			MeshOptimizer::Optimize(*mesh);
+
+			CHECK(mesh->Vertices.size() < vertexCount);
+			CHECK(GetACMR(*mesh) < acmrBefore);
+			MESSAGE(name << ": " << vertexCount << " -> " << mesh->Vertices.size() << " vertices, "
+				<< mesh->Indices.size() << " indices, ACMR " << acmrBefore << " -> " << GetACMR(*mesh));
+		}
+	}
+}
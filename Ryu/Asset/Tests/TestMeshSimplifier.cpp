@@ -0,0 +1,227 @@
+#include "Asset/Processing/MeshSimplifier.h"
+#include "Asset/Processing/MeshOptimizer.h"
+#include "Asset/Primitives.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <ranges>
+#include <set>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Asset::Tests
+{
+	constexpr f32 EPSILON = 1e-4f;
+
+	f32 Length(const std::array<f32, 3>& v) { return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]); }
+
+	// How far inside a unit sphere the triangles reach, sampled over each face
+	f32 SphereDeviation(const MeshData& mesh, u32 offset, u32 count)
+	{
+		constexpr u32 steps = 4;
+
+		f32 deviation = 0.0f;
+		for (u32 i = offset; i + 2 < offset + count; i += 3)
+		{
+			const auto& a = mesh.Vertices[mesh.Indices[i]].Position;
+			const auto& b = mesh.Vertices[mesh.Indices[i + 1]].Position;
+			const auto& c = mesh.Vertices[mesh.Indices[i + 2]].Position;
+			for (u32 u = 0; u <= steps; ++u)
+			{
+				for (u32 v = 0; u + v <= steps; ++v)
+				{
+					const f32 wu = static_cast<f32>(u) / steps, wv = static_cast<f32>(v) / steps, ww = 1.0f - wu - wv;
+					const std::array<f32, 3> p
+					{
+						a[0] * wu + b[0] * wv + c[0] * ww,
+						a[1] * wu + b[1] * wv + c[1] * ww,
+						a[2] * wu + b[2] * wv + c[2] * ww,
+					};
+					deviation = std::max(deviation, std::abs(1.0f - Length(p)));
+				}
+			}
+		}
+		return deviation;
+	}
+
+	bool IsValid(std::span<const u32> indices, size_t vertexCount)
+	{
+		bool valid = indices.size() % 3 == 0;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			valid &= indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount;
+			valid &= indices[i] != indices[i + 1] && indices[i + 1] != indices[i + 2] && indices[i] != indices[i + 2];
+		}
+		return valid;
+	}
+
+	TEST_CASE("Simplify")
+	{
+		SUBCASE("Halves a sphere and stays close to it")
+		{
+			const std::unique_ptr<MeshData> sphere = Primitives::CreateSphere(64, 32);
+			const u32 target = static_cast<u32>(sphere->Indices.size() / 2);
+
+			const MeshSimplifier::Result result = MeshSimplifier::Simplify(sphere->Vertices, sphere->Indices, target);
+			CHECK(IsValid(result.Indices, sphere->Vertices.size()));
+			CHECK(result.Indices.size() <= target);
+			CHECK(result.Indices.size() > target * 3 / 4);
+
+			CHECK(result.Error > 0.0f);
+			CHECK(result.Error < 0.05f);
+		}
+
+		SUBCASE("Flat interiors go, borders stay")
+		{
+			const std::unique_ptr<MeshData> plane = Primitives::CreatePlane(32);
+
+			const MeshSimplifier::Result result = MeshSimplifier::Simplify(plane->Vertices, plane->Indices, 0);
+			CHECK(IsValid(result.Indices, plane->Vertices.size()));
+			CHECK(result.Indices.size() < plane->Indices.size() / 10);
+			CHECK(result.Error < EPSILON);
+
+			const std::set<u32> kept(result.Indices.begin(), result.Indices.end());
+			bool bordersKept = true;
+			for (u32 v = 0; v < plane->Vertices.size(); ++v)
+			{
+				const auto& p = plane->Vertices[v].Position;
+				if (std::abs(std::abs(p[0]) - 1.0f) < EPSILON || std::abs(std::abs(p[2]) - 1.0f) < EPSILON)
+				{
+					bordersKept &= kept.contains(v);
+				}
+			}
+			CHECK(bordersKept);
+		}
+
+		SUBCASE("Error limit")
+		{
+			const std::unique_ptr<MeshData> sphere = Primitives::CreateSphere(64, 32);
+
+			const MeshSimplifier::Result loose = MeshSimplifier::Simplify(sphere->Vertices, sphere->Indices, 0);
+			const MeshSimplifier::Result tight = MeshSimplifier::Simplify(sphere->Vertices, sphere->Indices, 0, { .MaxError = 0.002f });
+			CHECK(tight.Indices.size() > loose.Indices.size());
+			CHECK(tight.Error < loose.Error);
+		}
+
+		SUBCASE("Submesh edges stay put")
+		{
+			std::unique_ptr<MeshData> plane = Primitives::CreatePlane(32);
+			const u32 half = static_cast<u32>(plane->Indices.size() / 2);
+			plane->SubMeshes = { { 0, half, 0 }, { half, half, 1 } };
+
+			std::set<u32> first(plane->Indices.begin(), plane->Indices.begin() + half);
+			std::set<u32> shared;
+			std::ranges::copy_if(plane->Indices | std::views::drop(half), std::inserter(shared, shared.end()),
+				[&first](u32 v) { return first.contains(v); });
+			REQUIRE(!shared.empty());
+
+			MeshSimplifier::BuildLods(*plane, 2, 0.1f);
+			REQUIRE(plane->Lods.size() == 2);
+
+			const MeshLod& lod = plane->Lods[1];
+			const std::set<u32> kept(plane->Indices.begin() + lod.IndexOffset, plane->Indices.begin() + lod.IndexOffset + lod.IndexCount);
+			CHECK(std::ranges::includes(kept, shared));
+		}
+	}
+
+	TEST_CASE("LOD chain")
+	{
+		std::unique_ptr<MeshData> sphere = Primitives::CreateSphere(64, 32);
+		const u32 sourceCount = static_cast<u32>(sphere->Indices.size());
+		const std::vector<u32> source = sphere->Indices;
+
+		MeshSimplifier::BuildLods(*sphere, 5, 0.5f);
+		const std::vector<MeshLod>& lods = sphere->Lods;
+		REQUIRE(lods.size() >= 3);
+
+		SUBCASE("LOD 0 is the source")
+		{
+			CHECK(lods[0].IndexOffset == 0);
+			CHECK(lods[0].IndexCount == sourceCount);
+			CHECK(lods[0].Error == 0.0f);
+			CHECK(std::equal(source.begin(), source.end(), sphere->Indices.begin()));
+		}
+
+		SUBCASE("Triangles drop and error grows with each level")
+		{
+			bool reduced = true, ordered = true, valid = true;
+			for (size_t i = 1; i < lods.size(); ++i)
+			{
+				reduced &= lods[i].IndexCount <= lods[i - 1].IndexCount * 9 / 10;
+				ordered &= lods[i].Error >= lods[i - 1].Error;
+				ordered &= lods[i].IndexOffset == lods[i - 1].IndexOffset + lods[i - 1].IndexCount;
+				valid   &= IsValid({ sphere->Indices.data() + lods[i].IndexOffset, lods[i].IndexCount }, sphere->Vertices.size());
+			}
+			CHECK(reduced);
+			CHECK(lods[1].IndexCount <= lods[0].IndexCount / 2);
+			CHECK(lods.back().IndexCount < lods[0].IndexCount / 10);
+			CHECK(ordered);
+			CHECK(valid);
+			CHECK(sphere->Indices.size() == lods.back().IndexOffset + lods.back().IndexCount);
+
+			for (const MeshLod& lod : lods)
+			{
+				MESSAGE(lod.IndexCount / 3 << " triangles, error " << lod.Error);
+			}
+		}
+
+		SUBCASE("Reported error bounds the real one")
+		{
+			// LOD 0 is itself only close to the sphere, its own deviation is allowed on top
+			const f32 baseDeviation = SphereDeviation(*sphere, 0, lods[0].IndexCount);
+
+			bool bounded = true;
+			for (const MeshLod& lod : lods)
+			{
+				bounded &= SphereDeviation(*sphere, lod.IndexOffset, lod.IndexCount) <= lod.Error + baseDeviation + EPSILON;
+			}
+			CHECK(bounded);
+		}
+
+		SUBCASE("Screen space error stays under a pixel at any distance")
+		{
+			// 60 degree vertical field of view on a 1080 pixel tall viewport
+			constexpr f32 height = 1080.0f;
+			constexpr f32 maxPixels = 1.0f;
+			const f32 projectionScale = 0.5f * height / std::tan(std::numbers::pi_v<f32> / 6.0f);
+
+			const f32 baseDeviation = SphereDeviation(*sphere, 0, lods[0].IndexCount);
+
+			u32 previousLod = 0;
+			bool coarserWithDistance = true, withinPixel = true;
+			for (const f32 distance : { 2.0f, 5.0f, 10.0f, 20.0f, 50.0f, 100.0f, 500.0f, 2000.0f })
+			{
+				const f32 pixelsPerUnit = projectionScale / distance;
+				const u32 lod = SelectLod(lods, maxPixels / pixelsPerUnit);
+
+				const MeshLod& selected = lods[lod];
+				const f32 pixels = (SphereDeviation(*sphere, selected.IndexOffset, selected.IndexCount) - baseDeviation) * pixelsPerUnit;
+				withinPixel &= pixels <= maxPixels;
+				coarserWithDistance &= lod >= previousLod;
+				previousLod = lod;
+
+				MESSAGE("Distance " << distance << ": LOD " << lod << ", " << selected.IndexCount / 3 << " triangles, " << pixels << " px");
+			}
+			CHECK(withinPixel);
+			CHECK(coarserWithDistance);
+			CHECK(SelectLod(lods, 0.0f) == 0);
+			CHECK(previousLod == lods.size() - 1);
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("LOD build benchmark" * doctest::skip())
+	{
+		std::unique_ptr<MeshData> mesh = Primitives::CreateSphere(512, 256);  // ~262k triangles
+		MeshOptimizer::OptimizeVertexCache(*mesh);
+
+		Utils::Stopwatch timer(true);
+		MeshSimplifier::BuildLods(*mesh);
+		const f64 buildMs = timer.Elapsed<std::chrono::milliseconds>();
+
+		CHECK(mesh->HasLods());
+		MESSAGE(mesh->Lods[0].IndexCount / 3 << " triangles, " << mesh->Lods.size() << " LODs in " << buildMs << " ms");
+	}
+}
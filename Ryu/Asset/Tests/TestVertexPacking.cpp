@@ -0,0 +1,220 @@
+#include "Asset/Processing/VertexPacking.h"
+#include "Asset/Primitives.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Asset::Tests
+{
+	f32 AngleBetween(const std::array<f32, 3>& a, const std::array<f32, 3>& b)
+	{
+		const f32 dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+		return std::acos(std::clamp(dot, -1.0f, 1.0f));
+	}
+
+	std::vector<MeshData::Vertex> Roundtrip(std::span<const MeshData::Vertex> vertices, const VertexLayout& layout)
+	{
+		std::vector<byte> packed(vertices.size() * layout.Stride());
+		VertexPacking::Encode(vertices, layout, packed);
+
+		std::vector<MeshData::Vertex> decoded(vertices.size());
+		VertexPacking::Decode(packed, layout, decoded);
+		return decoded;
+	}
+
+	TEST_CASE("Half floats")
+	{
+		using VertexPacking::FloatToHalf;
+		using VertexPacking::HalfToFloat;
+
+		SUBCASE("Representable values are exact")
+		{
+			for (const f32 value : { 0.0f, -0.0f, 1.0f, -2.0f, 0.5f, 0.25f, 1024.0f, 65504.0f, 0x1p-14f, 0x1p-24f })
+			{
+				CHECK(HalfToFloat(FloatToHalf(value)) == value);
+			}
+			CHECK(FloatToHalf(1.0f) == 0x3C00);
+			CHECK(FloatToHalf(-2.0f) == 0xC000);
+		}
+
+		SUBCASE("Overflow, infinity and NaN")
+		{
+			CHECK(std::isinf(HalfToFloat(FloatToHalf(1e6f))));
+			CHECK(std::isinf(HalfToFloat(FloatToHalf(std::numeric_limits<f32>::infinity()))));
+			CHECK(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<f32>::quiet_NaN()))));
+		}
+
+		SUBCASE("Rounds to nearest")
+		{
+			f32 worst = 0.0f;
+			for (u32 i = 0; i <= 10'000; ++i)
+			{
+				const f32 value = i / 5'000.0f;  // [0, 2]
+				worst = std::max(worst, std::abs(HalfToFloat(FloatToHalf(value)) - value));
+			}
+			CHECK(worst <= 0x1p-11f);  // Half an ulp at [1, 2)
+			CHECK(FloatToHalf(1.0f + 0x1p-11f) == 0x3C00);  // Tie goes to even
+		}
+	}
+
+	TEST_CASE("Octahedral normals")
+	{
+		f32 worst = 0.0f;
+		for (u32 i = 0; i < 64; ++i)
+		{
+			for (u32 j = 0; j <= 32; ++j)
+			{
+				const f32 phi   = i * 2.0f * std::numbers::pi_v<f32> / 64.0f;
+				const f32 theta = j * std::numbers::pi_v<f32> / 32.0f;
+				const std::array<f32, 3> normal{ std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta) };
+
+				worst = std::max(worst, AngleBetween(normal, VertexPacking::DecodeOctahedral(VertexPacking::EncodeOctahedral(normal))));
+			}
+		}
+		CHECK(worst < 1e-3f);
+
+		const auto down = VertexPacking::DecodeOctahedral(VertexPacking::EncodeOctahedral({ 0.0f, 0.0f, -1.0f }));
+		CHECK(down[2] == doctest::Approx(-1.0f));
+	}
+
+	TEST_CASE("Vertex layouts")
+	{
+		const std::unique_ptr<MeshData> sphere = Primitives::CreateSphere();
+
+		SUBCASE("Primitives pack to the compact layout")
+		{
+			const VertexLayout layout = VertexPacking::ChooseLayout(sphere->GetVertices());
+			CHECK(layout.Normal == VertexLayout::NormalFormat::Octahedral16);
+			CHECK(layout.TexCoord == VertexLayout::TexCoordFormat::Half2);
+			CHECK(layout.Color == VertexLayout::ColorFormat::None);
+			CHECK(layout.Stride() == 20);
+		}
+
+		SUBCASE("Data that does not fit keeps full precision")
+		{
+			std::vector<MeshData::Vertex> vertices(sphere->Vertices.begin(), sphere->Vertices.end());
+			vertices[0].Color    = { 0.5f, 0.25f, 1.0f, 1.0f };
+			CHECK(VertexPacking::ChooseLayout(vertices).Color == VertexLayout::ColorFormat::RGBA8);
+
+			vertices[1].Color    = { 4.0f, 1.0f, 1.0f, 1.0f };  // HDR
+			vertices[2].TexCoord = { 10.0f, 0.0f };              // Tiled
+			vertices[3].Normal   = { 0.0f, 2.0f, 0.0f };         // Not normalized
+			CHECK(VertexPacking::ChooseLayout(vertices) == VertexLayout{});
+		}
+
+		SUBCASE("Full layout round trips exactly")
+		{
+			const auto decoded = Roundtrip(sphere->GetVertices(), VertexLayout{});
+			CHECK(std::memcmp(decoded.data(), sphere->Vertices.data(), sphere->VertexBufferSize()) == 0);
+		}
+
+		SUBCASE("Compact layout stays within its precision")
+		{
+			std::vector<MeshData::Vertex> vertices(sphere->Vertices.begin(), sphere->Vertices.end());
+			vertices[5].Color = { 0.2f, 0.4f, 0.6f, 0.8f };
+
+			const VertexLayout layout
+			{
+				.Normal   = VertexLayout::NormalFormat::Octahedral16,
+				.TexCoord = VertexLayout::TexCoordFormat::Half2,
+				.Color    = VertexLayout::ColorFormat::RGBA8,
+			};
+			const auto decoded = Roundtrip(vertices, layout);
+
+			bool ok = true;
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				ok &= decoded[i].Position == vertices[i].Position;
+				ok &= AngleBetween(decoded[i].Normal, vertices[i].Normal) < 1e-3f;
+				ok &= std::abs(decoded[i].TexCoord[0] - vertices[i].TexCoord[0]) <= 0x1p-11f;
+				ok &= std::abs(decoded[i].TexCoord[1] - vertices[i].TexCoord[1]) <= 0x1p-11f;
+				for (u32 c = 0; c < 4; ++c)
+				{
+					ok &= std::abs(decoded[i].Color[c] - vertices[i].Color[c]) <= 0.5f / 255.0f + 1e-6f;
+				}
+			}
+			CHECK(ok);
+		}
+
+		SUBCASE("Packing a mesh records its layout")
+		{
+			VertexPacking::Pack(*sphere);
+			CHECK(sphere->HasPackedVertices());
+			CHECK(sphere->PackedLayout == VertexPacking::ChooseLayout(sphere->Vertices));
+			CHECK(sphere->PackedVertices.size() == sphere->Vertices.size() * sphere->PackedLayout.Stride());
+		}
+
+		SUBCASE("16-bit indices")
+		{
+			REQUIRE(sphere->Uses16BitIndices());
+			std::vector<u16> indices(sphere->Indices.size());
+			VertexPacking::PackIndices16(sphere->Indices, indices);
+			CHECK(std::ranges::equal(indices, sphere->Indices));
+		}
+	}
+
+	TEST_CASE("Vertex packing savings")
+	{
+		const std::pair<const char*, std::unique_ptr<MeshData>> meshes[] =
+		{
+			{ "Triangle",   Primitives::CreateTriangle() },
+			{ "Cube",       Primitives::CreateCube() },
+			{ "Plane",      Primitives::CreatePlane(8) },
+			{ "Sphere",     Primitives::CreateSphere() },
+			{ "Cylinder",   Primitives::CreateCylinder() },
+			{ "Cone",       Primitives::CreateCone() },
+			{ "Large grid", Primitives::CreatePlane(1000) },  // 1M vertices, past the 16-bit index range
+		};
+
+		size_t totalBefore = 0, totalAfter = 0;
+		for (const auto& [name, mesh] : meshes)
+		{
+			VertexPacking::Pack(*mesh);
+
+			const size_t indexSize = mesh->Uses16BitIndices() ? sizeof(u16) : sizeof(u32);
+			const size_t before    = mesh->VertexBufferSize() + mesh->IndexBufferSize();
+			const size_t after     = mesh->PackedVertices.size() + mesh->Indices.size() * indexSize;
+			totalBefore += before;
+			totalAfter  += after;
+
+			CHECK(after < before);
+			MESSAGE(name << ": " << before << " -> " << after << " bytes, stride " << mesh->PackedLayout.Stride());
+		}
+		MESSAGE("Total: " << totalBefore << " -> " << totalAfter << " bytes (" << 100.0 * totalAfter / totalBefore << "%)");
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Vertex packing benchmark" * doctest::skip())
+	{
+		const std::unique_ptr<MeshData> mesh = Primitives::CreatePlane(1000);
+		const std::span<const MeshData::Vertex> vertices = mesh->GetVertices();
+		const VertexLayout layout = VertexPacking::ChooseLayout(vertices);
+		std::vector<byte> packed(vertices.size() * layout.Stride());
+
+		constexpr u32 iterations = 10;
+		Utils::Stopwatch timer(true);
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			VertexPacking::Encode(vertices, layout, packed);
+		}
+		const f64 encodeMs = timer.Elapsed<std::chrono::milliseconds>() / iterations;
+
+		std::vector<MeshData::Vertex> decoded(vertices.size());
+		timer.Restart();
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			VertexPacking::Decode(packed, layout, decoded);
+		}
+		const f64 decodeMs = timer.Elapsed<std::chrono::milliseconds>() / iterations;
+
+		CHECK(decoded.back().Position == vertices.back().Position);
+		const f64 vertexMillions = vertices.size() / 1e6;
+		MESSAGE(vertices.size() << " vertices: encode " << encodeMs << " ms (" << vertexMillions / (encodeMs / 1000.0)
+			<< " M/s) | decode " << decodeMs << " ms (" << vertexMillions / (decodeMs / 1000.0) << " M/s)");
+	}
+}
@@ -0,0 +1,87 @@
+#include "Core/Utils/MappedFile.h"
+#include <Windows.h>
+#include <utility>
+
+namespace Ryu::Utils
+{
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+		m_file = file;
+
+		LARGE_INTEGER size{};
+		if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			Close();
+			return;
+		}
+
+		m_mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_mapping)
+		{
+			Close();
+			return;
+		}
+
+		m_data = static_cast<const byte*>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!m_data)
+		{
+			Close();
+			return;
+		}
+		m_size = static_cast<u64>(size.QuadPart);
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_data(std::exchange(other.m_data, nullptr))
+		, m_size(std::exchange(other.m_size, 0))
+		, m_file(std::exchange(other.m_file, nullptr))
+		, m_mapping(std::exchange(other.m_mapping, nullptr))
+	{
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_data    = std::exchange(other.m_data, nullptr);
+			m_size    = std::exchange(other.m_size, 0);
+			m_file    = std::exchange(other.m_file, nullptr);
+			m_mapping = std::exchange(other.m_mapping, nullptr);
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	void MappedFile::Close() noexcept
+	{
+		if (m_data)
+		{
+			::UnmapViewOfFile(m_data);
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		if (m_mapping)
+		{
+			::CloseHandle(m_mapping);
+			m_mapping = nullptr;
+		}
+
+		if (m_file)
+		{
+			::CloseHandle(m_file);
+			m_file = nullptr;
+		}
+	}
+}
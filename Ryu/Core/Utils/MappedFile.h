@@ -0,0 +1,37 @@
+#pragma once
+#include "Core/Common/StandardTypes.h"
+#include "Core/Common/API.h"
+#include <filesystem>
+#include <span>
+
+namespace Ryu::Utils
+{
+	/**
+	 * @brief Read-only memory mapping of a whole file
+	 * @details Pages are brought in by the OS on first touch, so opening is cheap and only the parts
+	 * that are read cost I/O. The mapping stays valid until the object is destroyed
+	 */
+	class RYU_API MappedFile
+	{
+		RYU_DISABLE_COPY(MappedFile)
+
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path& path);
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		[[nodiscard]] bool IsValid() const noexcept { return m_data != nullptr; }
+		[[nodiscard]] std::span<const byte> GetData() const noexcept { return { m_data, m_size }; }
+		[[nodiscard]] u64 GetSize() const noexcept { return m_size; }
+
+		void Close() noexcept;
+
+	private:
+		const byte* m_data    = nullptr;
+		u64         m_size    = 0;
+		void*       m_file    = nullptr;
+		void*       m_mapping = nullptr;
+	};
+}
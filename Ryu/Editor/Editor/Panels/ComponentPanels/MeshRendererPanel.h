@@ -3,6 +3,7 @@
 
 #include "Asset/AssetData.h"
 #include "Asset/AssetRegistry.h"
+#include "Game/Components/BoundsComponent.h"
 #include "Game/Components/MeshRenderer.h"
 #include <ImGui/imgui.h>
 
@@ -11,7 +12,7 @@ namespace Ryu::Editor
     class MeshRendererPanel : public ComponentPanel<Game::MeshRenderer>
     {
     protected:
-        void DrawComponentUI(Game::MeshRenderer& component, Game::Entity)
+        void DrawComponentUI(Game::MeshRenderer& component, Game::Entity entity)
         {
             ImGui::Checkbox("Is Visible##MeshRendererPanel", &component.IsVisible);
 
@@ -40,6 +41,7 @@ namespace Ryu::Editor
                 {
                     Asset::AssetId droppedId = *static_cast<const Asset::AssetId*>(payload->Data);
                     component.MeshHandle = Asset::MeshHandle{ droppedId };
+                    ResetBounds(entity);
                 }
                 ImGui::EndDragDropTarget();
             }
@@ -51,8 +53,15 @@ namespace Ryu::Editor
                 if (ImGui::SmallButton("X##ClearMesh"))
                 {
                     component.MeshHandle = {};
+                    ResetBounds(entity);
                 }
             }
         }
+
+        // The renderer gives the entity the new mesh's bounds once it has loaded
+        static void ResetBounds(Game::Entity& entity)
+        {
+            entity.RemoveComponent<Game::LocalBounds>();
+        }
     };
 }
@@ -8,11 +8,16 @@ namespace Ryu::Editor
 	class TransformComponentPanel : public ComponentPanel<Game::Transform>
 	{
 	public:
-		void DrawComponentUI(Game::Transform& component, Game::Entity)
+		void DrawComponentUI(Game::Transform& component, Game::Entity entity)
 		{
-			ImGui::DragFloat3("Position##TransformComponentPanel", &component.Position.x, 0.1f, ImGuiSliderFlags_ColorMarkers);
+			bool changed = ImGui::DragFloat3("Position##TransformComponentPanel", &component.Position.x, 0.1f, ImGuiSliderFlags_ColorMarkers);
 			//ImGui::DragFloat3("Rotation##TransformComponentPanel", &component.rotation, 0.1f, ImGuiSliderFlags_ColorMarkers);
-			ImGui::DragFloat3("Scale##TransformComponentPanel", &component.Scale.x, 0.1f, 0.01f, ImGuiSliderFlags_ColorMarkers);
+			changed |= ImGui::DragFloat3("Scale##TransformComponentPanel", &component.Scale.x, 0.1f, 0.01f, ImGuiSliderFlags_ColorMarkers);
+
+			if (changed)
+			{
+				entity.MarkTransformDirty();
+			}
 		}
 	};
 }
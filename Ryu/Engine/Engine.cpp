@@ -44,6 +44,20 @@ namespace Ryu::Engine
 				allocationCount,
 				deallocationCount,
 				activeAllocationCount);
+
+			for (u8 i = 0; i < static_cast<u8>(Memory::AllocationTag::Count); ++i)
+			{
+				const auto tag = static_cast<Memory::AllocationTag>(i);
+				const Memory::UsageStats stats = Memory::GetUsageStats(tag);
+				if (stats.AllocationCount > 0)
+				{
+					RYU_LOG_DEBUG("  [{}] Current Usage: {} ({:.2f}MB) | Total Allocated: {} | Active Allocations: {}",
+						EnumToString(tag),
+						stats.CurrentUsage, Math::BytesToMB(stats.CurrentUsage),
+						stats.TotalAllocated,
+						stats.AllocationCount - stats.DeallocationCount);
+				}
+			}
 		}
 		else
 		{
@@ -73,6 +87,10 @@ namespace Ryu::Engine
 			RYU_LOG_INFO("--- A debugger is attached to the Engine!---");
 		}
 
+		// Job system first, anything created after it may already submit work
+		m_jobSystem       = std::make_unique<MT::JobSystem>();
+		m_mainThreadQueue = std::make_unique<MT::MainThreadQueue>();
+
 		RYU_PROFILE_BOOKMARK("Initialize graphics");
 
 		// Get window from current application
@@ -82,6 +100,9 @@ namespace Ryu::Engine
 		// Init renderer & cache asset registry in mesh renderer
 		m_renderer = std::make_unique<Gfx::Renderer>(window->GetHandle(), rendererHook);
 		Game::MeshRenderer::m_assetRegistry = m_renderer->GetAssetRegistry();
+		m_renderer->GetAssetRegistry()->SetJobSystem(m_jobSystem.get());
+		m_renderer->SetJobSystem(m_jobSystem.get());
+		m_renderer->GetAssetRegistry()->SetCacheDirectory(App::PathManager::Get().GetCacheDir());
 
 		// Init input manager
 		m_inputManager = std::make_unique<Game::InputManager>(
@@ -97,6 +118,8 @@ namespace Ryu::Engine
 		ServiceLocator::Register(m_renderer.get());
 		ServiceLocator::Register(m_inputManager.get());
 		ServiceLocator::Register(&Gfx::ShaderCompiler::Get());
+		ServiceLocator::Register(m_jobSystem.get());
+		ServiceLocator::Register(m_mainThreadQueue.get());
 
 		RYU_LOG_TRACE("Engine initialization completed");
 		return true;
@@ -115,6 +138,17 @@ namespace Ryu::Engine
 			window->Unsubscribe(m_closeListener);
 		}
 
+		// Finish in-flight jobs while the systems they may touch are still alive
+		m_jobSystem.reset();
+		m_mainThreadQueue.reset();
+
+		if (const Asset::DerivedDataCache* derivedData = m_renderer ? m_renderer->GetAssetRegistry()->GetDerivedDataCache() : nullptr)
+		{
+			const Asset::DerivedDataCache::Stats stats = derivedData->GetStats();
+			RYU_LOG_DEBUG("Derived data cache: {} hits, {} misses, {} failed stores, {:.2f}MB of sources hashed",
+				stats.Hits, stats.Misses, stats.StoreFailures, stats.HashedBytes / (1024.0 * 1024.0));
+		}
+
 		m_inputManager.reset();
 		m_renderer.reset();
 
@@ -148,6 +182,9 @@ namespace Ryu::Engine
 		{
 			frameTimer.Tick();
 
+			// Continuations parked with ResumeOnMainThread last frame
+			m_mainThreadQueue->Drain();
+
 			appWindow->Update();
 			m_inputManager->Update();
 			m_currentApp->OnTick(frameTimer);
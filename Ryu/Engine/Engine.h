@@ -4,6 +4,8 @@
 #include "Core/Utils/Singleton.h"
 #include "Graphics/Renderer.h"
 #include "Game/InputManager.h"
+#include "Threading/JobSystem.h"
+#include "Threading/Coroutines/MainThreadQueue.h"
 
 namespace Ryu::Engine
 {
@@ -33,6 +35,8 @@ namespace Ryu::Engine
 		[[nodiscard]] Window::Window* GetAppWindow() const {  return m_currentApp ? m_currentApp->GetWindow() : nullptr;}
 		[[nodiscard]] Gfx::Renderer* GetRenderer() const { return m_renderer.get(); }
 		[[nodiscard]] Game::InputManager* GetInputManager() { return m_inputManager.get(); }
+		[[nodiscard]] MT::JobSystem* GetJobSystem() const { return m_jobSystem.get(); }
+		[[nodiscard]] MT::MainThreadQueue* GetMainThreadQueue() const { return m_mainThreadQueue.get(); }
 
 		void RYU_API RunApp(std::shared_ptr<App::App> app, Gfx::IRendererHook* rendererHook = nullptr);
 
@@ -50,7 +54,9 @@ namespace Ryu::Engine
 		App::IApplication* m_currentApp = nullptr;
 
 		// Engine systems
-		std::unique_ptr<Game::InputManager> m_inputManager;
+		std::unique_ptr<MT::JobSystem>       m_jobSystem;
+		std::unique_ptr<MT::MainThreadQueue> m_mainThreadQueue;
+		std::unique_ptr<Game::InputManager>  m_inputManager;
 		std::unique_ptr<Gfx::Renderer>      m_renderer;
 
 		// Event listeners
@@ -6,6 +6,7 @@ namespace Ryu::App { class PathManager; class IApplication; }
 namespace Ryu::Gfx     { class Renderer; class ShaderCompiler; }
 namespace Ryu::Game    { class InputManager; }
 namespace Ryu::Memory  { class Allocator; }
+namespace Ryu::MT      { class JobSystem; class MainThreadQueue; }
 
 namespace Ryu::Engine
 {
@@ -23,5 +24,5 @@ namespace Ryu::Engine
         }
     };
 
-    inline constexpr EngineVersion CURRENT_VERSION = { 1, 0, 0 };
+    inline constexpr EngineVersion CURRENT_VERSION = { 1, 1, 0 };
 }
@@ -84,4 +84,20 @@ namespace Ryu::Engine
             s_services.InputManager = service;
         }
     }
+
+    void ServiceLocator::Register(MT::JobSystem* service)
+    {
+        if (s_initialized)
+        {
+            s_services.JobSystem = service;
+        }
+    }
+
+    void ServiceLocator::Register(MT::MainThreadQueue* service)
+    {
+        if (s_initialized)
+        {
+            s_services.MainQueue = service;
+        }
+    }
 }
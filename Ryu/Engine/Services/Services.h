@@ -14,6 +14,10 @@ namespace Ryu::Engine
 		Gfx::ShaderCompiler*   ShaderCompiler = nullptr;
 		Game::InputManager*    InputManager   = nullptr;
 		EngineVersion          Version;
+
+		// Added in 1.1, kept after Version so older modules still read the fields they know
+		MT::JobSystem*         JobSystem      = nullptr;
+		MT::MainThreadQueue*   MainQueue      = nullptr;
 	};
 
 	class ServiceLocator
@@ -32,6 +36,8 @@ namespace Ryu::Engine
 		static void Register(Gfx::Renderer* renderer);
 		static void Register(Gfx::ShaderCompiler* shaderCompiler);
 		static void Register(Game::InputManager* inputManager);
+		static void Register(MT::JobSystem* jobSystem);
+		static void Register(MT::MainThreadQueue* mainQueue);
 
 	private:
 		static inline Services s_services{};
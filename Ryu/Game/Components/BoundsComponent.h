@@ -0,0 +1,14 @@
+#pragma once
+#include "Math/Aabb.h"
+
+namespace Ryu::Game
+{
+	// Box around the entity in its local space. Entities with one are in the World's spatial index,
+	// placed by their WorldMatrix. The renderer fills it in from the mesh for MeshRenderers
+	struct LocalBounds
+	{
+		static constexpr auto ComponentName = "Local Bounds";
+
+		Math::Aabb Box{ Math::Vector3(-0.5f), Math::Vector3(0.5f) };
+	};
+}
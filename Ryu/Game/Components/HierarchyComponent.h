@@ -0,0 +1,19 @@
+#pragma once
+#include <entt/entity/entity.hpp>
+
+namespace Ryu::Game
+{
+	// Parent/child links of an entity's Transform. Every entity with a Transform has one, roots included.
+	// Maintained by the TransformSystem, change it through World::SetParent
+	struct Hierarchy
+	{
+		static constexpr auto ComponentName = "Hierarchy";
+
+		entt::entity Parent      = entt::null;
+		entt::entity FirstChild  = entt::null;
+		entt::entity NextSibling = entt::null;
+		entt::entity PrevSibling = entt::null;
+		u32          Depth       = 0;  // 0 for roots
+		u32          OrderIndex  = 0;  // Position in the depth sorted update order
+	};
+}
@@ -21,12 +21,25 @@ namespace Ryu::Game
 				* SM::Matrix::CreateTranslation(t.Position);
 		}
 
+		// Local to parent, the same as the world matrix only for entities without a parent
 		[[nodiscard]] inline Math::Matrix GetWorldMatrix() const { return ComputeWorldMatrix(*this); }
 
 		SM::Vector3 Position;
 		SM::Quaternion Orientation;
 		SM::Vector3 Scale;
 	};
+
+	// Transform of the entity relative to the world, local transform times the parent's WorldMatrix.
+	// Written by the TransformSystem, read it instead of calling GetWorldMatrix() on a Transform
+	struct WorldMatrix
+	{
+		static constexpr auto ComponentName = "World Matrix";
+
+		SM::Matrix Matrix;
+	};
+
+	// Tag for transforms changed since the last update, see World::MarkTransformDirty
+	struct TransformDirty {};
 }
 
 RYU_REFLECTED_CLASS(
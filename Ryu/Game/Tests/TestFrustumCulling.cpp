@@ -0,0 +1,155 @@
+#include "Game/Components/TransformComponent.h"
+#include "Game/World/Entity.h"
+#include "Game/World/World.h"
+#include "Math/Frustum.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <random>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Game::Tests
+{
+	class TestWorld : public World
+	{
+	public:
+		TestWorld() : World("Test World") {}
+	};
+
+	// Built the same way RenderFrameBuilder::ExtractCameraData builds a perspective camera
+	Math::Matrix MakeViewProjection(const SM::Vector3& position, const SM::Vector3& forward, f32 fovDegrees, f32 aspect, f32 nearPlane, f32 farPlane)
+	{
+		const Math::Matrix view = DirectX::XMMatrixLookAtLH(position, position + forward, SM::Vector3::Up);
+		const Math::Matrix projection = DirectX::XMMatrixPerspectiveFovLH(DirectX::XMConvertToRadians(fovDegrees), aspect, nearPlane, farPlane);
+		return view * projection;
+	}
+
+	TEST_CASE("Frustum planes")
+	{
+		// Looking down +z from 5 units left of the origin
+		const Math::Frustum frustum = Math::ExtractFrustum(MakeViewProjection({ -5.0f, 0.0f, 0.0f }, SM::Vector3(0.0f, 0.0f, 1.0f), 60.0f, 1.0f, 1.0f, 100.0f));
+
+		CHECK(Math::Intersects(frustum, { -5.0f, 0.0f, 10.0f }, 0.0f));
+		CHECK_FALSE(Math::Intersects(frustum, { -5.0f, 0.0f, -10.0f }, 0.0f));   // Behind
+		CHECK_FALSE(Math::Intersects(frustum, { -5.0f, 0.0f, 0.5f }, 0.0f));     // Before the near plane
+		CHECK_FALSE(Math::Intersects(frustum, { -5.0f, 0.0f, 150.0f }, 0.0f));   // Past the far plane
+		CHECK_FALSE(Math::Intersects(frustum, { 20.0f, 0.0f, 10.0f }, 0.0f));    // Off to the right
+		CHECK(Math::Intersects(frustum, { 20.0f, 0.0f, 10.0f }, 20.0f));         // Big enough to reach in
+		CHECK(Math::Intersects(frustum, { -5.0f, 0.0f, 101.0f }, 2.0f));         // Pokes through the far plane
+	}
+
+	TEST_CASE("Batched sphere culling matches the scalar test")
+	{
+		const Math::Frustum frustum = Math::ExtractFrustum(MakeViewProjection(SM::Vector3::Zero, SM::Vector3(1.0f, 0.0f, 1.0f), 70.0f, 16.0f / 9.0f, 0.1f, 50.0f));
+
+		std::mt19937 rng(3);
+		std::uniform_real_distribution<f32> position(-60.0f, 60.0f);
+		std::uniform_real_distribution<f32> size(0.0f, 5.0f);
+
+		// Odd count so the scalar tail runs as well
+		constexpr u64 count = 1003;
+		std::array<std::vector<f32>, 4> streams;
+		for (u64 i = 0; i < count; ++i)
+		{
+			streams[0].push_back(position(rng));
+			streams[1].push_back(position(rng));
+			streams[2].push_back(position(rng));
+			streams[3].push_back(size(rng));
+		}
+
+		std::vector<u8> visible(count);
+		const Math::SphereStreams spheres{ .Center = { streams[0].data(), streams[1].data(), streams[2].data() }, .Radius = streams[3].data() };
+		const u64 visibleCount = Math::CullSpheres(frustum, spheres, visible.data(), count);
+
+		u64 expectedCount = 0;
+		u64 mismatches    = 0;
+		for (u64 i = 0; i < count; ++i)
+		{
+			const bool expected = Math::Intersects(frustum, { streams[0][i], streams[1][i], streams[2][i] }, streams[3][i]);
+			expectedCount += expected;
+			mismatches    += expected != (visible[i] != 0);
+		}
+
+		CHECK(visibleCount == expectedCount);
+		CHECK(mismatches == 0);
+		CHECK(visibleCount > 0);
+		CHECK(visibleCount < count);
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Frustum culling benchmark" * doctest::skip())
+	{
+		constexpr u32 entityCount = 100'000;
+		constexpr f32 extent      = 500.0f;  // Scattered over a 1000 unit cube
+		constexpr f32 meshRadius  = 1.0f;    // What MeshBounds::Radius would hold
+		constexpr u32 frames      = 100;
+
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<f32> position(-extent, extent);
+		std::uniform_real_distribution<f32> scale(0.5f, 2.0f);
+
+		TestWorld world;
+		for (u32 i = 0; i < entityCount; ++i)
+		{
+			Entity entity = world.CreateEntity();
+			Transform& transform = entity.GetComponent<Transform>();
+			transform.Position = { position(rng), position(rng), position(rng) };
+			transform.Scale    = SM::Vector3(scale(rng));
+		}
+		world.UpdateTransforms();
+
+		// A 60 degree 16:9 camera reaching the cube's side, its frustum covers about a tenth of it
+		const Math::Frustum frustum = Math::ExtractFrustum(MakeViewProjection(SM::Vector3::Zero, SM::Vector3(0.0f, 0.0f, 1.0f), 60.0f, 16.0f / 9.0f, 0.1f, extent));
+
+		auto& worlds = world.GetRegistry().storage<WorldMatrix>();
+		std::array<std::vector<f32>, 4> streams;
+		for (std::vector<f32>& stream : streams)
+		{
+			stream.resize(worlds.size());
+		}
+		std::vector<u8> visible(worlds.size());
+
+		// What CollectRenderables does per view: world spheres from the world matrices, then the batched test
+		u64 visibleCount = 0;
+		Utils::Stopwatch timer(true);
+		for (u32 frame = 0; frame < frames; ++frame)
+		{
+			u64 i = 0;
+			for (const auto& [entity, worldMatrix] : worlds.each())
+			{
+				const Math::Matrix& m = worldMatrix.Matrix;
+				streams[0][i] = m._41;
+				streams[1][i] = m._42;
+				streams[2][i] = m._43;
+				streams[3][i] = meshRadius * std::max({ m.Right().Length(), m.Up().Length(), m.Backward().Length() });
+				++i;
+			}
+
+			const Math::SphereStreams spheres{ .Center = { streams[0].data(), streams[1].data(), streams[2].data() }, .Radius = streams[3].data() };
+			visibleCount = Math::CullSpheres(frustum, spheres, visible.data(), i);
+		}
+		const f64 batchedMs = timer.Elapsed<std::chrono::milliseconds>() / frames;
+
+		// One sphere at a time straight off the world matrices
+		u64 scalarCount = 0;
+		timer.Restart();
+		for (u32 frame = 0; frame < frames; ++frame)
+		{
+			scalarCount = 0;
+			for (const auto& [entity, worldMatrix] : worlds.each())
+			{
+				const Math::Matrix& m = worldMatrix.Matrix;
+				const f32 radius = meshRadius * std::max({ m.Right().Length(), m.Up().Length(), m.Backward().Length() });
+				scalarCount += Math::Intersects(frustum, m.Translation(), radius);
+			}
+		}
+		const f64 scalarMs = timer.Elapsed<std::chrono::milliseconds>() / frames;
+
+		CHECK(visibleCount == scalarCount);
+
+		MESSAGE(entityCount << " renderables, " << visibleCount << " visible ("
+			<< 100.0 * static_cast<f64>(visibleCount) / entityCount << "%), " << entityCount - visibleCount << " culled");
+		MESSAGE("Batched: " << batchedMs << " ms/view");
+		MESSAGE("Scalar:  " << scalarMs << " ms/view (" << scalarMs / batchedMs << "x)");
+	}
+}
@@ -0,0 +1,261 @@
+#include "Game/Components/BoundsComponent.h"
+#include "Game/Components/TransformComponent.h"
+#include "Game/World/ChunkCulling.h"
+#include "Game/World/Entity.h"
+#include "Game/World/World.h"
+#include "Memory/FrameArena.h"
+#include "Memory/New.h"
+#include "Threading/ChunkedCollector.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <random>
+#include <span>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Game::Tests
+{
+	class TestWorld : public World
+	{
+	public:
+		TestWorld() : World("Test World") {}
+	};
+
+	struct ExtractedItem
+	{
+		EntityHandle Entity;
+		Math::Matrix World;
+	};
+
+	using ExtractedViews = std::pmr::vector<std::pmr::vector<ExtractedItem>>;
+
+	template <typename Func>
+	void ForRange(MT::JobSystem* jobSystem, u64 count, Func&& func)
+	{
+		if (jobSystem)
+		{
+			jobSystem->ParallelFor(0, count, 1, func);
+		}
+		else if (count > 0)
+		{
+			func(u64(0), count);
+		}
+	}
+
+	// The way RenderFrameBuilder::ExtractViews runs, with LocalBounds in place of the meshes (those need a device):
+	// candidates per camera from the spatial index, then CullChunk on every chunk through a ChunkedCollector.
+	// Everything, the returned views included, comes from resource
+	ExtractedViews Extract(World& world, std::span<const Math::Frustum> frustums, MT::JobSystem* jobSystem,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+	{
+		auto& registry = world.GetRegistry();
+		auto& worlds   = registry.storage<WorldMatrix>();
+		auto& bounds   = registry.storage<LocalBounds>();
+		const u64 viewCount = frustums.size();
+
+		std::pmr::vector<std::pmr::vector<EntityHandle>> found(viewCount, resource);
+		ForRange(jobSystem, viewCount, [&](u64 first, u64 last)
+		{
+			for (u64 v = first; v < last; ++v)
+			{
+				world.GetSpatialSystem().Query(frustums[v], [&entities = found[v]](EntityHandle entity) { entities.push_back(entity); });
+			}
+		});
+
+		std::pmr::vector<u64> foundSizes(viewCount, resource);
+		std::ranges::transform(found, foundSizes.begin(), [](const std::pmr::vector<EntityHandle>& entities) { return entities.size(); });
+		MT::ChunkedCollector<ExtractedItem> collector(jobSystem, foundSizes, CULL_CHUNK_SIZE, resource);
+
+		collector.Run([&](u64 v, u64 first, u64 last, std::pmr::vector<ExtractedItem>& items)
+		{
+			CullChunk<ExtractedItem>(&frustums[v], std::span(found[v]).subspan(first, last - first),
+			[&](EntityHandle entity, ExtractedItem& item, CullSphere& sphere)
+			{
+				const Math::Matrix& m = worlds.get(entity).Matrix;
+				const Math::Aabb& box = bounds.get(entity).Box;
+				item   = { entity, m };
+				sphere = ToWorldSphere(box.GetCenter(), box.GetExtents().Length(), m);
+				return true;
+			},
+			[&items](const ExtractedItem& item) { items.push_back(item); });
+		});
+
+		ExtractedViews views(viewCount, resource);
+		for (u64 v = 0; v < viewCount; ++v)
+		{
+			views[v].reserve(collector.CountItems(v));
+			collector.AppendTo(v, views[v]);
+		}
+		return views;
+	}
+
+	// Entities scattered through a cube of the given half extent, all with bounds so the spatial index has them
+	void Populate(World& world, u32 entityCount, f32 extent)
+	{
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<f32> position(-extent, extent);
+
+		for (u32 i = 0; i < entityCount; ++i)
+		{
+			Entity entity = world.CreateEntity();
+			entity.GetComponent<Transform>().Position = { position(rng), position(rng), position(rng) };
+			entity.AddComponent<LocalBounds>();
+		}
+		world.UpdateTransforms();
+	}
+
+	// Four cameras back to back at the origin, each one sees about a tenth of the world
+	std::vector<Math::Frustum> MakeFrustums(f32 extent)
+	{
+		std::vector<Math::Frustum> frustums;
+		for (const SM::Vector3& forward : { SM::Vector3(0.0f, 0.0f, 1.0f), SM::Vector3(0.0f, 0.0f, -1.0f), SM::Vector3(1.0f, 0.0f, 0.0f), SM::Vector3(-1.0f, 0.0f, 0.0f) })
+		{
+			const Math::Matrix view = DirectX::XMMatrixLookAtLH(SM::Vector3::Zero, forward, SM::Vector3::Up);
+			const Math::Matrix projection = DirectX::XMMatrixPerspectiveFovLH(DirectX::XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, extent);
+			frustums.push_back(Math::ExtractFrustum(view * projection));
+		}
+		return frustums;
+	}
+
+	// Same items in the same order, whichever threads ran the chunks
+	u64 CountMismatches(const ExtractedViews& views, const ExtractedViews& expected)
+	{
+		REQUIRE(views.size() == expected.size());
+
+		u64 mismatches = 0;
+		for (u64 v = 0; v < views.size(); ++v)
+		{
+			REQUIRE(views[v].size() == expected[v].size());
+			for (u64 i = 0; i < views[v].size(); ++i)
+			{
+				mismatches += views[v][i].Entity != expected[v][i].Entity;
+				mismatches += views[v][i].World != expected[v][i].World;
+			}
+		}
+		return mismatches;
+	}
+
+	TEST_CASE("Parallel extraction matches the serial pass")
+	{
+		constexpr f32 extent = 100.0f;
+
+		TestWorld world;
+		Populate(world, 20'000, extent);
+		const std::vector<Math::Frustum> frustums = MakeFrustums(extent);
+
+		const ExtractedViews expected = Extract(world, frustums, nullptr);
+		for (const std::pmr::vector<ExtractedItem>& items : expected)
+		{
+			REQUIRE(items.size() > 4 * CULL_CHUNK_SIZE);  // Several chunks per view
+		}
+
+		MT::JobSystem jobSystem(4);
+		for (u32 run = 0; run < 10; ++run)
+		{
+			CHECK(CountMismatches(Extract(world, frustums, &jobSystem), expected) == 0);
+		}
+	}
+
+	TEST_CASE("Extraction in steady state makes no heap allocations")
+	{
+		constexpr f32 extent = 100.0f;
+
+		TestWorld world;
+		Populate(world, 20'000, extent);
+		const std::vector<Math::Frustum> frustums = MakeFrustums(extent);
+
+		// Some entities move every frame, back and forth, so the transform and spatial updates have work to do
+		std::vector<EntityHandle> movers;
+		for (const EntityHandle entity : world.GetRegistry().view<Transform>())
+		{
+			if (movers.size() < 1000)
+			{
+				movers.push_back(entity);
+			}
+		}
+
+		Memory::FrameArena arena(4 * 1024 * 1024);
+		MT::JobSystem jobSystem(4);
+
+		// A frame the way the renderer runs one: transforms, then every view extracted into the arena
+		auto runFrame = [&](u32 frame)
+		{
+			arena.BeginFrame();
+
+			const f32 step = (frame % 2 == 0) ? 5.0f : -5.0f;
+			for (const EntityHandle entity : movers)
+			{
+				world.GetRegistry().patch<Transform>(entity, [step](Transform& t) { t.Position.x += step; });
+			}
+			world.UpdateTransforms();
+
+			const ExtractedViews views = Extract(world, frustums, &jobSystem, arena.GetResource());
+			return views.size();
+		};
+
+		// Arena buffers grow to fit, the workers and the containers the systems keep reach their size
+		for (u32 frame = 0; frame < 10; ++frame)
+		{
+			REQUIRE(runFrame(frame) == frustums.size());
+		}
+
+		// Only checked afterwards, so nothing but the frames runs between the two counts
+		u64 viewCount = 0;
+		const size_t before = Memory::GetAllocationCount();
+		for (u32 frame = 10; frame < 60; ++frame)
+		{
+			viewCount += runFrame(frame);
+		}
+		const size_t after = Memory::GetAllocationCount();
+
+		CHECK(viewCount == 50 * frustums.size());
+		CHECK(after == before);
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Parallel extraction benchmark" * doctest::skip())
+	{
+		constexpr u32 entityCount = 200'000;
+		constexpr f32 extent      = 500.0f;
+		constexpr u32 frames      = 50;
+
+		TestWorld world;
+		Populate(world, entityCount, extent);
+		const std::vector<Math::Frustum> frustums = MakeFrustums(extent);
+
+		Utils::Stopwatch timer;
+		ExtractedViews views;
+		auto timeExtraction = [&](MT::JobSystem* jobSystem)
+		{
+			timer.Restart();
+			for (u32 frame = 0; frame < frames; ++frame)
+			{
+				views = Extract(world, frustums, jobSystem);
+			}
+			return timer.Elapsed<std::chrono::milliseconds>() / frames;
+		};
+
+		// One thread is the serial path the builder takes without a job system
+		const f64 serialMs = timeExtraction(nullptr);
+		const ExtractedViews expected = views;
+
+		u64 itemCount = 0;
+		for (const std::pmr::vector<ExtractedItem>& items : expected)
+		{
+			itemCount += items.size();
+		}
+
+		MESSAGE(entityCount << " entities, " << frustums.size() << " cameras, " << itemCount << " items per frame, average of " << frames << " runs");
+		MESSAGE("1 thread: " << serialMs << " ms/frame");
+
+		for (const u64 threads : { 2ull, 4ull, 8ull, 16ull })
+		{
+			MT::JobSystem jobSystem(threads - 1);  // The calling thread works too
+			const f64 parallelMs = timeExtraction(&jobSystem);
+
+			CHECK(CountMismatches(views, expected) == 0);
+
+			MESSAGE(threads << " threads: " << parallelMs << " ms/frame (" << serialMs / parallelMs << "x)");
+		}
+	}
+}
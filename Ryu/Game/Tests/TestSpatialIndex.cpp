@@ -0,0 +1,340 @@
+#include "Game/Components/BoundsComponent.h"
+#include "Game/Components/TransformComponent.h"
+#include "Game/World/Entity.h"
+#include "Game/World/World.h"
+#include "Math/AabbTree.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <random>
+#include <set>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Game::Tests
+{
+	class TestWorld : public World
+	{
+	public:
+		TestWorld() : World("Test World") {}
+	};
+
+	Math::Aabb MakeBox(const Math::Vector3& center, f32 halfSize)
+	{
+		return Math::Aabb::FromCenterExtents(center, Math::Vector3(halfSize));
+	}
+
+	// What a linear scan over the fat boxes finds, the tree has to agree with it
+	template <typename Test>
+	std::set<u64> BruteForce(const Math::AabbTree& tree, const std::vector<u32>& proxies, Test&& test)
+	{
+		std::set<u64> found;
+		for (const u32 proxy : proxies)
+		{
+			if (proxy != Math::AabbTree::NULL_NODE && test(tree.GetFatAabb(proxy)))
+			{
+				found.insert(tree.GetUserData(proxy));
+			}
+		}
+		return found;
+	}
+
+	TEST_CASE("AABB tree")
+	{
+		std::mt19937 rng(5);
+		std::uniform_real_distribution<f32> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<f32> size(0.1f, 3.0f);
+		std::uniform_real_distribution<f32> step(-0.5f, 0.5f);
+
+		constexpr u32 count = 2000;
+		Math::AabbTree tree(0.2f);
+		std::vector<u32> proxies(count);
+		std::vector<Math::Aabb> boxes(count);
+		for (u32 i = 0; i < count; ++i)
+		{
+			boxes[i]   = MakeBox({ position(rng), position(rng), position(rng) }, size(rng));
+			proxies[i] = tree.CreateProxy(boxes[i], i);
+		}
+
+		REQUIRE(tree.Validate());
+		CHECK(tree.GetProxyCount() == count);
+		CHECK(tree.GetHeight() < 32);  // Balanced, a list would be 2000 deep
+
+		// Move everything around, drop a third and add some back
+		for (u32 frame = 0; frame < 10; ++frame)
+		{
+			for (u32 i = 0; i < count; ++i)
+			{
+				const Math::Vector3 offset(step(rng), step(rng), step(rng));
+				boxes[i] = Math::Aabb{ boxes[i].Min + offset, boxes[i].Max + offset };
+				tree.MoveProxy(proxies[i], boxes[i]);
+			}
+		}
+
+		for (u32 i = 0; i < count; i += 3)
+		{
+			tree.DestroyProxy(proxies[i]);
+			proxies[i] = Math::AabbTree::NULL_NODE;
+		}
+
+		for (u32 i = 0; i < count; i += 6)
+		{
+			boxes[i]   = MakeBox({ position(rng), position(rng), position(rng) }, size(rng));
+			proxies[i] = tree.CreateProxy(boxes[i], i);
+		}
+
+		REQUIRE(tree.Validate());
+
+		SUBCASE("Fat boxes hold the real ones")
+		{
+			u32 escaped = 0;
+			for (u32 i = 0; i < count; ++i)
+			{
+				escaped += proxies[i] != Math::AabbTree::NULL_NODE && !tree.GetFatAabb(proxies[i]).Contains(boxes[i]);
+			}
+			CHECK(escaped == 0);
+
+			// Small moves stay put, leaving the fat box reinserts
+			const u32 proxy = proxies[1];
+			CHECK_FALSE(tree.MoveProxy(proxy, boxes[1]));
+			CHECK(tree.MoveProxy(proxy, Math::Aabb{ boxes[1].Min + Math::Vector3(1.0f), boxes[1].Max + Math::Vector3(1.0f) }));
+			CHECK(tree.Validate());
+		}
+
+		SUBCASE("Queries match a linear scan")
+		{
+			for (u32 query = 0; query < 50; ++query)
+			{
+				const Math::Vector3 center(position(rng), position(rng), position(rng));
+				const f32 radius = size(rng) * 5.0f;
+				const Math::Aabb box = MakeBox(center, radius);
+
+				std::set<u64> boxHits;
+				tree.Query(box, [&](u64 id) { boxHits.insert(id); });
+				CHECK(boxHits == BruteForce(tree, proxies, [&](const Math::Aabb& fat) { return fat.Overlaps(box); }));
+
+				std::set<u64> sphereHits;
+				tree.Query(center, radius, [&](u64 id) { sphereHits.insert(id); });
+				CHECK(sphereHits == BruteForce(tree, proxies, [&](const Math::Aabb& fat) { return Math::Intersects(fat, center, radius); }));
+
+				const Math::Vector3 direction(position(rng), position(rng), position(rng));
+				const Math::Vector3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+				constexpr f32 maxDistance = 2.0f;
+
+				std::set<u64> rayHits;
+				f32 closest = maxDistance;
+				tree.RayCast(center, direction, maxDistance, [&](u64 id, f32) { rayHits.insert(id); return maxDistance; });
+				tree.RayCast(center, direction, maxDistance, [&](u64, f32 distance) { closest = std::min(closest, distance); return distance; });
+
+				f32 expectedClosest = maxDistance;
+				CHECK(rayHits == BruteForce(tree, proxies, [&](const Math::Aabb& fat)
+				{
+					f32 distance = 0.0f;
+					const bool hit = Math::IntersectRay(fat, center, inverse, maxDistance, distance);
+					expectedClosest = hit ? std::min(expectedClosest, distance) : expectedClosest;
+					return hit;
+				}));
+				CHECK(closest == expectedClosest);
+			}
+
+			// Looking down +z from the origin
+			const Math::Matrix projection = DirectX::XMMatrixPerspectiveFovLH(1.0f, 1.5f, 0.1f, 100.0f);
+			const Math::Frustum frustum = Math::ExtractFrustum(projection);
+
+			std::set<u64> frustumHits;
+			tree.Query(frustum, [&](u64 id) { frustumHits.insert(id); });
+			CHECK(frustumHits == BruteForce(tree, proxies, [&](const Math::Aabb& fat) { return Math::Classify(frustum, fat) != Math::FrustumTest::Outside; }));
+			CHECK_FALSE(frustumHits.empty());
+		}
+	}
+
+	TEST_CASE("Spatial index follows the world")
+	{
+		TestWorld world;
+		Entity parent = world.CreateEntity("Parent");
+		Entity child  = world.CreateEntity("Child");
+		Entity plain  = world.CreateEntity("No bounds");
+
+		child.AddComponent<LocalBounds>();
+		REQUIRE(child.SetParent(parent));
+		child.GetComponent<Transform>().Position = { 0.0f, 10.0f, 0.0f };
+		child.MarkTransformDirty();
+		world.UpdateTransforms();
+
+		const SpatialSystem& index = world.GetSpatialSystem();
+		auto find = [&index](const Math::Vector3& center)
+		{
+			std::vector<EntityHandle> found;
+			index.Query(center, 1.0f, [&found](EntityHandle entity) { found.push_back(entity); });
+			return found;
+		};
+
+		CHECK(index.GetTree().GetProxyCount() == 1);
+		CHECK(find({ 0.0f, 10.0f, 0.0f }) == std::vector{ child.GetHandle() });
+		CHECK(find({ 0.0f, 0.0f, 0.0f }).empty());
+
+		SUBCASE("Moving the parent moves the child's box")
+		{
+			world.GetRegistry().patch<Transform>(parent.GetHandle(), [](Transform& t) { t.Position.x = 50.0f; });
+			world.UpdateTransforms();
+			CHECK(find({ 0.0f, 10.0f, 0.0f }).empty());
+			CHECK(find({ 50.0f, 10.0f, 0.0f }) == std::vector{ child.GetHandle() });
+			CHECK(index.GetLastReinsertCount() == 1);
+		}
+
+		SUBCASE("Scale reaches the box")
+		{
+			CHECK(find({ 4.0f, 10.0f, 0.0f }).empty());
+			child.GetComponent<Transform>().Scale = { 10.0f, 10.0f, 10.0f };
+			child.MarkTransformDirty();
+			world.UpdateTransforms();
+			CHECK(find({ 4.0f, 10.0f, 0.0f }) == std::vector{ child.GetHandle() });
+		}
+
+		SUBCASE("Changed bounds, removed bounds and destroyed entities")
+		{
+			world.GetRegistry().patch<LocalBounds>(child.GetHandle(), [](LocalBounds& bounds) { bounds.Box = MakeBox({ 20.0f, 0.0f, 0.0f }, 1.0f); });
+			CHECK(find({ 20.0f, 10.0f, 0.0f }) == std::vector{ child.GetHandle() });
+
+			plain.AddComponent<LocalBounds>();
+			CHECK(index.GetTree().GetProxyCount() == 2);
+			plain.RemoveComponent<LocalBounds>();
+			CHECK(index.GetTree().GetProxyCount() == 1);
+
+			world.DestroyEntityImmediate(child);
+			CHECK(index.GetTree().GetProxyCount() == 0);
+			CHECK(index.GetTree().Validate());
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Spatial index benchmark" * doctest::skip())
+	{
+		constexpr u32 entityCount = 100'000;
+		constexpr f32 extent      = 500.0f;
+		constexpr u32 frames      = 100;
+		constexpr u32 queries     = 1000;
+
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<f32> position(-extent, extent);
+		std::uniform_real_distribution<f32> speed(-0.05f, 0.05f);  // Per frame, a few frames to leave the 0.1 margin
+
+		TestWorld world;
+		std::vector<Entity> entities;
+		std::vector<SM::Vector3> velocities;
+		for (u32 i = 0; i < entityCount; ++i)
+		{
+			Entity entity = world.CreateEntity();
+			entity.GetComponent<Transform>().Position = { position(rng), position(rng), position(rng) };
+			entities.push_back(entity);
+			velocities.emplace_back(speed(rng), speed(rng), speed(rng));
+		}
+		world.UpdateTransforms();
+
+		// Everything moves every frame
+		auto& registry = world.GetRegistry();
+		Utils::Stopwatch timer;
+		auto runFrames = [&]
+		{
+			f64 updateMs = 0.0;
+			for (u32 frame = 0; frame < frames; ++frame)
+			{
+				for (u32 i = 0; i < entityCount; ++i)
+				{
+					registry.patch<Transform>(entities[i].GetHandle(), [&](Transform& t) { t.Position += velocities[i]; });
+				}
+
+				timer.Restart();
+				world.UpdateTransforms();
+				updateMs += timer.Elapsed<std::chrono::milliseconds>();
+			}
+			return updateMs / frames;
+		};
+
+		// Without bounds first, to separate out what the index adds to an update
+		const f64 transformsOnlyMs = runFrames();
+
+		// Insertion: what adding bounds to all of them costs
+		timer.Restart();
+		for (Entity& entity : entities)
+		{
+			entity.AddComponent<LocalBounds>();
+		}
+		const f64 insertMs = timer.Elapsed<std::chrono::milliseconds>();
+		const SpatialSystem& index = world.GetSpatialSystem();
+		const u32 height = index.GetTree().GetHeight();
+
+		const f64 updateMs   = runFrames();
+		const u32 reinserted = index.GetLastReinsertCount();
+
+		auto& worlds = registry.storage<WorldMatrix>();
+		auto& bounds = registry.storage<LocalBounds>();
+		auto linearScan = [&](auto&& test)
+		{
+			u64 hits = 0;
+			for (const auto& [entity, worldMatrix] : worlds.each())
+			{
+				hits += test(Math::TransformAabb(bounds.get(entity).Box, worldMatrix.Matrix));
+			}
+			return hits;
+		};
+
+		// Time a query against a scan that tests every entity's world box the same way
+		struct QueryTiming { f64 TreeUs; f64 ScanUs; u64 Hits; };
+		auto timeQuery = [&](auto&& treeQuery, auto&& scanTest, u32 iterations)
+		{
+			u64 hits = 0;
+			timer.Restart();
+			for (u32 q = 0; q < iterations; ++q)
+			{
+				hits += treeQuery(q);
+			}
+			const f64 treeUs = timer.Elapsed<std::chrono::microseconds>() / iterations;
+
+			const u32 scanIterations = std::max(1u, iterations / 100);
+			timer.Restart();
+			for (u32 q = 0; q < scanIterations; ++q)
+			{
+				linearScan([&](const Math::Aabb& box) { return scanTest(q, box); });
+			}
+			const f64 scanUs = timer.Elapsed<std::chrono::microseconds>() / scanIterations;
+			return QueryTiming{ treeUs, scanUs, hits / iterations };
+		};
+
+		std::vector<Math::Vector3> centers;
+		for (u32 q = 0; q < queries; ++q)
+		{
+			centers.emplace_back(position(rng), position(rng), position(rng));
+		}
+
+		// About a tenth of the world in view, like the culling benchmark
+		const Math::Matrix viewProjection = DirectX::XMMatrixPerspectiveFovLH(DirectX::XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, extent);
+		const Math::Frustum frustum = Math::ExtractFrustum(viewProjection);
+
+		const QueryTiming frustumTiming = timeQuery(
+			[&](u32) { u64 n = 0; index.Query(frustum, [&n](EntityHandle) { ++n; }); return n; },
+			[&](u32, const Math::Aabb& box) { return Math::Classify(frustum, box) != Math::FrustumTest::Outside; }, 20);
+
+		const QueryTiming sphereTiming = timeQuery(
+			[&](u32 q) { u64 n = 0; index.Query(centers[q], 20.0f, [&n](EntityHandle) { ++n; }); return n; },
+			[&](u32 q, const Math::Aabb& box) { return Math::Intersects(box, centers[q], 20.0f); }, queries);
+
+		const QueryTiming boxTiming = timeQuery(
+			[&](u32 q) { u64 n = 0; index.Query(MakeBox(centers[q], 20.0f), [&n](EntityHandle) { ++n; }); return n; },
+			[&](u32 q, const Math::Aabb& box) { return box.Overlaps(MakeBox(centers[q], 20.0f)); }, queries);
+
+		const Math::Vector3 direction(1.0f, 0.5f, 0.25f);
+		const Math::Vector3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+		const QueryTiming rayTiming = timeQuery(
+			[&](u32 q) { u64 n = 0; index.RayCast(centers[q], direction, 1000.0f, [&n](EntityHandle, f32) { ++n; return 1000.0f; }); return n; },
+			[&](u32 q, const Math::Aabb& box) { f32 distance; return Math::IntersectRay(box, centers[q], inverse, 1000.0f, distance); }, queries);
+
+		MESSAGE(entityCount << " entities with bounds, all moving, tree height " << height);
+		MESSAGE("Insert all:   " << insertMs << " ms");
+		MESSAGE("Update:       " << updateMs << " ms/frame (transforms alone " << transformsOnlyMs << " ms), "
+			<< reinserted << " reinserted in the last frame");
+		MESSAGE("Frustum:      " << frustumTiming.TreeUs << " us vs " << frustumTiming.ScanUs << " us scanning, " << frustumTiming.Hits << " hits");
+		MESSAGE("Sphere r=20:  " << sphereTiming.TreeUs << " us vs " << sphereTiming.ScanUs << " us scanning, " << sphereTiming.Hits << " hits");
+		MESSAGE("Box 40^3:     " << boxTiming.TreeUs << " us vs " << boxTiming.ScanUs << " us scanning, " << boxTiming.Hits << " hits");
+		MESSAGE("Ray 1000:     " << rayTiming.TreeUs << " us vs " << rayTiming.ScanUs << " us scanning, " << rayTiming.Hits << " hits");
+	}
+}
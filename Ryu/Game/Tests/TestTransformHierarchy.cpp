@@ -0,0 +1,227 @@
+#include "Game/Components/HierarchyComponent.h"
+#include "Game/Components/TransformComponent.h"
+#include "Game/World/Entity.h"
+#include "Game/World/World.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <random>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Game::Tests
+{
+	class TestWorld : public World
+	{
+	public:
+		TestWorld() : World("Test World") {}
+	};
+
+	bool NearlyEqual(const SM::Matrix& a, const SM::Matrix& b, f32 epsilon = 1e-4f)
+	{
+		for (u32 row = 0; row < 4; ++row)
+		{
+			for (u32 column = 0; column < 4; ++column)
+			{
+				if (std::abs(a.m[row][column] - b.m[row][column]) > epsilon)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	const SM::Matrix& GetWorld(Entity& entity)
+	{
+		return entity.GetComponent<WorldMatrix>().Matrix;
+	}
+
+	TEST_CASE("Transform hierarchy")
+	{
+		TestWorld world;
+		Entity root   = world.CreateEntity("Root");
+		Entity child  = world.CreateEntity("Child");
+		Entity leaf   = world.CreateEntity("Leaf");
+		Entity other  = world.CreateEntity("Other");
+
+		root.GetComponent<Transform>()  = Transform({ 10.0f, 0.0f, 0.0f }, SM::Quaternion::CreateFromYawPitchRoll(1.0f, 0.0f, 0.0f), { 2.0f, 2.0f, 2.0f });
+		child.GetComponent<Transform>() = Transform({ 0.0f, 5.0f, 0.0f });
+		leaf.GetComponent<Transform>()  = Transform({ 1.0f, 0.0f, 0.0f });
+
+		REQUIRE(child.SetParent(root));
+		REQUIRE(leaf.SetParent(child));
+		world.UpdateTransforms();
+
+		auto local = [](Entity& entity) { return entity.GetComponent<Transform>().GetWorldMatrix(); };
+
+		SUBCASE("Children are relative to their parents")
+		{
+			CHECK(world.GetTransformSystem().GetLastUpdateCount() == 4);
+			CHECK(NearlyEqual(GetWorld(root), local(root)));
+			CHECK(NearlyEqual(GetWorld(child), local(child) * local(root)));
+			CHECK(NearlyEqual(GetWorld(leaf), local(leaf) * local(child) * local(root)));
+			CHECK(leaf.GetParent() == child);
+			CHECK(leaf.GetComponent<Hierarchy>().Depth == 2);
+		}
+
+		SUBCASE("Only changed subtrees are recomputed")
+		{
+			world.UpdateTransforms();
+			CHECK(world.GetTransformSystem().GetLastUpdateCount() == 0);
+
+			child.GetComponent<Transform>().Position.y = 6.0f;
+			child.MarkTransformDirty();
+			world.UpdateTransforms();
+			CHECK(world.GetTransformSystem().GetLastUpdateCount() == 2);  // Child and leaf
+			CHECK(NearlyEqual(GetWorld(leaf), local(leaf) * local(child) * local(root)));
+
+			// Patching marks it too
+			world.GetRegistry().patch<Transform>(leaf.GetHandle(), [](Transform& t) { t.Scale = { 3.0f, 3.0f, 3.0f }; });
+			world.UpdateTransforms();
+			CHECK(world.GetTransformSystem().GetLastUpdateCount() == 1);
+			CHECK(NearlyEqual(GetWorld(leaf), local(leaf) * local(child) * local(root)));
+		}
+
+		SUBCASE("Reparenting moves the subtree")
+		{
+			REQUIRE(child.SetParent(other));
+			CHECK(leaf.GetComponent<Hierarchy>().Depth == 2);
+			CHECK(root.GetComponent<Hierarchy>().FirstChild == entt::null);
+
+			world.UpdateTransforms();
+			CHECK(NearlyEqual(GetWorld(leaf), local(leaf) * local(child)));  // Other sits at the origin
+
+			REQUIRE(child.SetParent(Entity()));
+			CHECK(child.GetComponent<Hierarchy>().Depth == 0);
+			CHECK(leaf.GetComponent<Hierarchy>().Depth == 1);
+		}
+
+		SUBCASE("Cycles are refused")
+		{
+			CHECK_FALSE(root.SetParent(leaf));
+			CHECK_FALSE(root.SetParent(root));
+			CHECK(root.GetParent() == Entity());
+		}
+
+		SUBCASE("Destroying a parent turns its children into roots")
+		{
+			world.DestroyEntityImmediate(child);
+			CHECK(leaf.GetParent() == Entity());
+			CHECK(leaf.GetComponent<Hierarchy>().Depth == 0);
+
+			world.UpdateTransforms();
+			CHECK(NearlyEqual(GetWorld(leaf), local(leaf)));
+		}
+
+		SUBCASE("Siblings unlink cleanly")
+		{
+			Entity second = world.CreateEntity("Second");
+			Entity third  = world.CreateEntity("Third");
+			REQUIRE(second.SetParent(root));
+			REQUIRE(third.SetParent(root));
+
+			world.DestroyEntityImmediate(second);
+			u32 children = 0;
+			for (entt::entity it = root.GetComponent<Hierarchy>().FirstChild; it != entt::null;
+				it = world.GetRegistry().get<Hierarchy>(it).NextSibling)
+			{
+				++children;
+			}
+			CHECK(children == 2);  // Third and child
+		}
+	}
+
+	// Trees of levels x width entities, each one below the top level hangs off a random entity a level up
+	std::vector<Entity> BuildForest(World& world, u32 count, u32 levels, u32 width, std::mt19937& rng)
+	{
+		std::vector<Entity> entities;
+		entities.reserve(count);
+
+		std::uniform_real_distribution<f32> offset(-1.0f, 1.0f);
+		std::uniform_int_distribution<u32> pick(0, width - 1);
+		while (entities.size() + levels * width <= count)
+		{
+			const u64 treeStart = entities.size();
+			for (u32 level = 0; level < levels; ++level)
+			{
+				for (u32 i = 0; i < width; ++i)
+				{
+					Entity entity = world.CreateEntity();
+					entity.GetComponent<Transform>().Position = { offset(rng), offset(rng), offset(rng) };
+					if (level > 0)
+					{
+						entity.SetParent(entities[treeStart + (level - 1) * width + pick(rng)]);
+					}
+					entities.push_back(entity);
+				}
+			}
+		}
+		return entities;
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Transform hierarchy benchmark" * doctest::skip())
+	{
+		constexpr u32 entityCount = 100'000;
+		constexpr u32 levels      = 10;
+		constexpr u32 width       = 10;  // 100 entity trees, 10 deep
+		constexpr u32 frames      = 100;
+
+		std::mt19937 rng(42);
+		TestWorld world;
+		const std::vector<Entity> entities = BuildForest(world, entityCount, levels, width, rng);
+
+		Utils::Stopwatch timer(true);
+		world.UpdateTransforms();  // Sorts and computes everything
+		const f64 firstMs = timer.Elapsed<std::chrono::milliseconds>();
+
+		// 1% of the entities move every frame
+		std::uniform_int_distribution<u64> pick(0, entities.size() - 1);
+		auto& registry = world.GetRegistry();
+
+		f64 cachedMs = 0.0;
+		u64 recomputed = 0;
+		for (u32 frame = 0; frame < frames; ++frame)
+		{
+			for (u32 i = 0; i < entityCount / 100; ++i)
+			{
+				registry.patch<Transform>(entities[pick(rng)].GetHandle(), [](Transform& t) { t.Position.x += 0.01f; });
+			}
+
+			timer.Restart();
+			world.UpdateTransforms();
+			cachedMs += timer.Elapsed<std::chrono::milliseconds>();
+			recomputed += world.GetTransformSystem().GetLastUpdateCount();
+		}
+
+		// Without caching: every entity multiplies its way up to the root, like GetWorldMatrix per render item
+		timer.Restart();
+		f32 sink = 0.0f;
+		for (u32 frame = 0; frame < 10; ++frame)
+		{
+			for (const auto& [entity, transform, hierarchy] : registry.view<Transform, Hierarchy>().each())
+			{
+				SM::Matrix matrix = transform.GetWorldMatrix();
+				for (entt::entity parent = hierarchy.Parent; parent != entt::null; parent = registry.get<Hierarchy>(parent).Parent)
+				{
+					matrix *= registry.get<Transform>(parent).GetWorldMatrix();
+				}
+				sink += matrix._41;
+			}
+		}
+		const f64 naiveMs = timer.Elapsed<std::chrono::milliseconds>() / 10.0;
+		volatile f32 keep = sink;
+		(void)keep;
+
+		// What a structural change costs on top
+		entities[0].SetParent(entities[1]);
+		timer.Restart();
+		world.UpdateTransforms();
+		const f64 resortMs = timer.Elapsed<std::chrono::milliseconds>();
+
+		MESSAGE(entities.size() << " entities in " << levels << " deep hierarchies, 1% moving");
+		MESSAGE("First update: " << firstMs << " ms | after a reparent: " << resortMs << " ms");
+		MESSAGE("Dirty update: " << cachedMs / frames << " ms/frame, " << recomputed / frames << " matrices recomputed");
+		MESSAGE("Uncached:     " << naiveMs << " ms/frame (" << naiveMs / (cachedMs / frames) << "x)");
+	}
+}
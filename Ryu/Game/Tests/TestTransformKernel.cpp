@@ -0,0 +1,127 @@
+#include "Game/Components/TransformComponent.h"
+#include "Math/TransformKernel.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <random>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Game::Tests
+{
+	// Random transforms, split into streams the way the TransformSystem gathers them
+	struct TransformSet
+	{
+		std::vector<Transform> Transforms;
+		std::array<std::vector<f32>, 10> Streams;
+
+		TransformSet(u64 count, u32 seed)
+		{
+			std::mt19937 rng(seed);
+			std::uniform_real_distribution<f32> position(-100.0f, 100.0f);
+			std::uniform_real_distribution<f32> angle(-3.14f, 3.14f);
+			std::uniform_real_distribution<f32> scale(0.1f, 4.0f);
+
+			Transforms.reserve(count);
+			for (u64 i = 0; i < count; ++i)
+			{
+				Transforms.emplace_back(
+					SM::Vector3(position(rng), position(rng), position(rng)),
+					SM::Quaternion::CreateFromYawPitchRoll(angle(rng), angle(rng), angle(rng)),
+					SM::Vector3(scale(rng), scale(rng), scale(rng)));
+			}
+
+			for (std::vector<f32>& stream : Streams)
+			{
+				stream.reserve(count);
+			}
+
+			for (const Transform& t : Transforms)
+			{
+				const f32 values[10] = { t.Position.x, t.Position.y, t.Position.z,
+					t.Orientation.x, t.Orientation.y, t.Orientation.z, t.Orientation.w, t.Scale.x, t.Scale.y, t.Scale.z };
+				for (u32 s = 0; s < 10; ++s)
+				{
+					Streams[s].push_back(values[s]);
+				}
+			}
+		}
+
+		Math::TransformStreams GetStreams() const
+		{
+			return Math::TransformStreams
+			{
+				.Position    = { Streams[0].data(), Streams[1].data(), Streams[2].data() },
+				.Orientation = { Streams[3].data(), Streams[4].data(), Streams[5].data(), Streams[6].data() },
+				.Scale       = { Streams[7].data(), Streams[8].data(), Streams[9].data() },
+			};
+		}
+	};
+
+	TEST_CASE("Transform kernel matches Transform::ComputeWorldMatrix")
+	{
+		// Full SIMD batches, a 4 wide remainder and scalar tails
+		for (const u64 count : { 0ull, 1ull, 3ull, 4ull, 7ull, 8ull, 13ull, 100ull })
+		{
+			CAPTURE(count);
+			const TransformSet set(count, 7);
+
+			// One past the end must stay untouched
+			std::vector<SM::Matrix> out(count + 1);
+			out[count]._11 = 42.0f;
+			Math::ComputeWorldMatrices(set.GetStreams(), out.data(), count);
+
+			f32 maxError = 0.0f;
+			for (u64 i = 0; i < count; ++i)
+			{
+				const SM::Matrix expected = Transform::ComputeWorldMatrix(set.Transforms[i]);
+				for (u32 element = 0; element < 16; ++element)
+				{
+					// Positions reach 100, so compare relative to the magnitude
+					const f32 e = (&expected._11)[element];
+					const f32 a = (&out[i]._11)[element];
+					maxError = std::max(maxError, std::abs(e - a) / std::max(1.0f, std::abs(e)));
+				}
+			}
+
+			CHECK(maxError < 1e-5f);
+			CHECK(out[count]._11 == 42.0f);
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Transform kernel benchmark" * doctest::skip())
+	{
+		constexpr u64 count  = 1'000'000;
+		constexpr u32 frames = 20;
+
+		const TransformSet set(count, 42);
+		const Math::TransformStreams streams = set.GetStreams();
+		std::vector<SM::Matrix> out(count);
+
+		Utils::Stopwatch timer(true);
+		for (u32 frame = 0; frame < frames; ++frame)
+		{
+			for (u64 i = 0; i < count; ++i)
+			{
+				out[i] = Transform::ComputeWorldMatrix(set.Transforms[i]);
+			}
+		}
+		const f64 scalarMs = timer.Elapsed<std::chrono::milliseconds>() / frames;
+		const f32 scalarSum = out[count / 2]._41 + out[count - 1]._22;
+
+		timer.Restart();
+		for (u32 frame = 0; frame < frames; ++frame)
+		{
+			Math::ComputeWorldMatrices(streams, out.data(), count);
+		}
+		const f64 kernelMs = timer.Elapsed<std::chrono::milliseconds>() / frames;
+		const f32 kernelSum = out[count / 2]._41 + out[count - 1]._22;
+
+		CHECK(std::abs(scalarSum - kernelSum) < 1e-3f);
+
+		MESSAGE(count << " transforms, average of " << frames << " runs");
+		MESSAGE("Transform::ComputeWorldMatrix: " << scalarMs << " ms");
+		MESSAGE("ComputeWorldMatrices:          " << kernelMs << " ms (" << scalarMs / kernelMs << "x)");
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Math/Frustum.h"
+#include <entt/entity/fwd.hpp>
+#include <algorithm>
+#include <array>
+#include <span>
+#include <utility>
+
+namespace Ryu::Game
+{
+	// Entities culled in one batch: big enough for the batched sphere test, small enough to spread a single view over the workers
+	inline constexpr u64 CULL_CHUNK_SIZE = 256;
+
+	// Largest axis scale of a world matrix, takes local space distances to world space
+	[[nodiscard]] inline f32 GetMaxScale(const Math::Matrix& world)
+	{
+		return std::max({ world.Right().Length(), world.Up().Length(), world.Backward().Length() });
+	}
+
+	// World space bounding sphere of an entity
+	struct CullSphere
+	{
+		Math::Vector3 Center;
+		f32 Radius = 0.0f;
+	};
+
+	[[nodiscard]] inline CullSphere ToWorldSphere(const Math::Vector3& localCenter, f32 localRadius, const Math::Matrix& world)
+	{
+		return { Math::Vector3::Transform(localCenter, world), localRadius * GetMaxScale(world) };
+	}
+
+	// Culls up to CULL_CHUNK_SIZE entities with a single batched frustum test, no allocations and no locks.
+	// gather(entity, Candidate& candidate, CullSphere& sphere) fills both and returns false to skip the entity,
+	// emit(const Candidate&) then gets the visible ones in order. Without a frustum everything gathered is visible
+	template <typename Candidate, typename Gather, typename Emit>
+	void CullChunk(const Math::Frustum* frustum, std::span<const entt::entity> entities, Gather&& gather, Emit&& emit)
+	{
+		RYU_ASSERT(entities.size() <= CULL_CHUNK_SIZE, "Chunk is larger than CULL_CHUNK_SIZE");
+
+		// Spheres split into streams for the frustum test
+		std::array<Candidate, CULL_CHUNK_SIZE> candidates;
+		std::array<f32, CULL_CHUNK_SIZE * 4> sphereData;
+		std::array<u8, CULL_CHUNK_SIZE> visible;
+
+		f32* centerX = sphereData.data();
+		f32* centerY = centerX + CULL_CHUNK_SIZE;
+		f32* centerZ = centerY + CULL_CHUNK_SIZE;
+		f32* radius  = centerZ + CULL_CHUNK_SIZE;
+
+		u64 count = 0;
+		for (const entt::entity entity : entities)
+		{
+			CullSphere sphere;
+			if (!gather(entity, candidates[count], sphere))
+			{
+				continue;
+			}
+
+			centerX[count] = sphere.Center.x;
+			centerY[count] = sphere.Center.y;
+			centerZ[count] = sphere.Center.z;
+			radius[count]  = sphere.Radius;
+			++count;
+		}
+
+		if (frustum)
+		{
+			const Math::SphereStreams spheres{ .Center = { centerX, centerY, centerZ }, .Radius = radius };
+			Math::CullSpheres(*frustum, spheres, visible.data(), count);
+		}
+		else
+		{
+			std::fill_n(visible.data(), count, u8(1));
+		}
+
+		for (u64 i = 0; i < count; ++i)
+		{
+			if (visible[i])
+			{
+				emit(std::as_const(candidates[i]));
+			}
+		}
+	}
+}
@@ -67,6 +67,26 @@ namespace Ryu::Game
     {
         return !HasFlag(EntityFlag::Disabled);
     }
+
+    bool Entity::SetParent(const Entity& parent)
+    {
+        WorldCheck();
+        RYU_ASSERT(!parent.m_world || parent.m_world == m_world, "Parent has to be in the same world");
+        return m_world->SetParent(m_handle, parent.m_world ? parent.m_handle : InvalidEntityHandle);
+    }
+
+    Entity Entity::GetParent() const
+    {
+        WorldCheck();
+        const EntityHandle parent = m_world->GetParent(m_handle);
+        return parent != InvalidEntityHandle ? Entity(parent, m_world) : Entity();
+    }
+
+    void Entity::MarkTransformDirty()
+    {
+        WorldCheck();
+        m_world->MarkTransformDirty(m_handle);
+    }
 }
 
 #undef WorldCheck
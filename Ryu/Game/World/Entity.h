@@ -36,6 +36,11 @@ namespace Ryu::Game
 		void SetEnabled(bool enabled);
 		bool IsEnabled() const;
 
+		// See World::SetParent, an invalid entity detaches this one
+		bool SetParent(const Entity& parent);
+		Entity GetParent() const;
+		void MarkTransformDirty();
+
 		bool operator==(const Entity& other) const
 		{
 			return m_handle == other.m_handle && m_world == other.m_world;
@@ -0,0 +1,74 @@
+#include "Game/World/SpatialSystem.h"
+#include "Game/World/TransformSystem.h"
+#include "Game/Components/BoundsComponent.h"
+#include "Game/Components/TransformComponent.h"
+#include "Core/Profiling/Profiling.h"
+#include <entt/entity/registry.hpp>
+
+namespace Ryu::Game
+{
+	void SpatialSystem::Connect(entt::registry& registry)
+	{
+		registry.on_construct<LocalBounds>().connect<&SpatialSystem::OnBoundsConstruct>(this);
+		registry.on_update<LocalBounds>().connect<&SpatialSystem::OnBoundsUpdate>(this);
+		registry.on_destroy<LocalBounds>().connect<&SpatialSystem::OnBoundsDestroy>(this);
+	}
+
+	void SpatialSystem::Update(entt::registry& registry, const TransformSystem& transforms)
+	{
+		RYU_PROFILE_SCOPE();
+		m_lastReinsertCount = 0;
+
+		if (m_tree.GetProxyCount() == 0)
+		{
+			return;
+		}
+
+		transforms.ForEachLastUpdated([this, &registry](entt::entity entity)
+		{
+			m_lastReinsertCount += Refit(registry, entity);
+		});
+	}
+
+	void SpatialSystem::OnBoundsConstruct(entt::registry& registry, entt::entity entity)
+	{
+		const u32 index = entt::to_entity(entity);
+		if (index >= m_proxies.size())
+		{
+			m_proxies.resize(index + 1, Math::AabbTree::NULL_NODE);
+		}
+
+		RYU_ASSERT(m_proxies[index] == Math::AabbTree::NULL_NODE, "Entity already has a proxy");
+		m_proxies[index] = m_tree.CreateProxy(ComputeWorldBox(registry, entity), static_cast<u64>(entity));
+	}
+
+	void SpatialSystem::OnBoundsUpdate(entt::registry& registry, entt::entity entity)
+	{
+		Refit(registry, entity);
+	}
+
+	void SpatialSystem::OnBoundsDestroy(entt::registry&, entt::entity entity)
+	{
+		u32& proxy = m_proxies[entt::to_entity(entity)];
+		m_tree.DestroyProxy(proxy);
+		proxy = Math::AabbTree::NULL_NODE;
+	}
+
+	bool SpatialSystem::Refit(const entt::registry& registry, entt::entity entity)
+	{
+		const u32 index = entt::to_entity(entity);
+		if (index >= m_proxies.size() || m_proxies[index] == Math::AabbTree::NULL_NODE)
+		{
+			return false;  // No bounds, not in the tree
+		}
+
+		return m_tree.MoveProxy(m_proxies[index], ComputeWorldBox(registry, entity));
+	}
+
+	Math::Aabb SpatialSystem::ComputeWorldBox(const entt::registry& registry, entt::entity entity)
+	{
+		const Math::Aabb& local = registry.get<LocalBounds>(entity).Box;
+		const WorldMatrix* world = registry.try_get<WorldMatrix>(entity);
+		return world ? Math::TransformAabb(local, world->Matrix) : local;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Math/AabbTree.h"
+#include <entt/entity/fwd.hpp>
+
+namespace Ryu::Game
+{
+	class TransformSystem;
+
+	// World space boxes of every entity with LocalBounds, in a dynamic AABB tree for frustum, sphere, box and ray queries.
+	// Follows the TransformSystem: after each transform update only the entities it recomputed are refitted,
+	// and the ones still inside their fat box don't touch the tree at all
+	class SpatialSystem
+	{
+		RYU_DISABLE_COPY_AND_MOVE(SpatialSystem)
+
+	public:
+		SpatialSystem() = default;
+
+		// Hooks LocalBounds construction, patching and destruction. Call once, before entities are created
+		void Connect(entt::registry& registry);
+
+		// Refits the entities the last TransformSystem::Update recomputed
+		void Update(entt::registry& registry, const TransformSystem& transforms);
+
+		[[nodiscard]] inline const Math::AabbTree& GetTree() const { return m_tree; }
+
+		// Proxies the last update had to reinsert
+		[[nodiscard]] inline u32 GetLastReinsertCount() const { return m_lastReinsertCount; }
+
+		// Results are conservative, boxes in the tree are slightly larger than the entities' own.
+		// The callbacks get the entity, the ray callback returns a distance like AabbTree::RayCast
+		template <typename Callback> void Query(const Math::Aabb& aabb, Callback&& callback) const;
+		template <typename Callback> void Query(const Math::Vector3& center, f32 radius, Callback&& callback) const;
+		template <typename Callback> void Query(const Math::Frustum& frustum, Callback&& callback) const;
+		template <typename Callback> void RayCast(const Math::Vector3& origin, const Math::Vector3& direction, f32 maxDistance, Callback&& callback) const;
+
+	private:
+		void OnBoundsConstruct(entt::registry& registry, entt::entity entity);
+		void OnBoundsUpdate(entt::registry& registry, entt::entity entity);
+		void OnBoundsDestroy(entt::registry& registry, entt::entity entity);
+
+		// Returns true if the proxy had to be reinserted
+		bool Refit(const entt::registry& registry, entt::entity entity);
+		static Math::Aabb ComputeWorldBox(const entt::registry& registry, entt::entity entity);
+
+	private:
+		Math::AabbTree   m_tree;
+		std::vector<u32> m_proxies;  // By entity index, AabbTree::NULL_NODE for entities without LocalBounds
+		u32              m_lastReinsertCount = 0;
+	};
+
+	template <typename Callback>
+	void SpatialSystem::Query(const Math::Aabb& aabb, Callback&& callback) const
+	{
+		m_tree.Query(aabb, [&callback](u64 userData) { callback(static_cast<entt::entity>(userData)); });
+	}
+
+	template <typename Callback>
+	void SpatialSystem::Query(const Math::Vector3& center, f32 radius, Callback&& callback) const
+	{
+		m_tree.Query(center, radius, [&callback](u64 userData) { callback(static_cast<entt::entity>(userData)); });
+	}
+
+	template <typename Callback>
+	void SpatialSystem::Query(const Math::Frustum& frustum, Callback&& callback) const
+	{
+		m_tree.Query(frustum, [&callback](u64 userData) { callback(static_cast<entt::entity>(userData)); });
+	}
+
+	template <typename Callback>
+	void SpatialSystem::RayCast(const Math::Vector3& origin, const Math::Vector3& direction, f32 maxDistance, Callback&& callback) const
+	{
+		m_tree.RayCast(origin, direction, maxDistance,
+			[&callback](u64 userData, f32 distance) { return callback(static_cast<entt::entity>(userData), distance); });
+	}
+}
@@ -0,0 +1,311 @@
+#include "Game/World/TransformSystem.h"
+#include "Game/Components/HierarchyComponent.h"
+#include "Game/Components/TransformComponent.h"
+#include "Math/TransformKernel.h"
+#include "Core/Logging/Logger.h"
+#include "Core/Profiling/Profiling.h"
+#include <entt/entity/registry.hpp>
+
+namespace Ryu::Game
+{
+	void TransformSystem::Connect(entt::registry& registry)
+	{
+		registry.on_construct<Transform>().connect<&TransformSystem::OnTransformConstruct>(this);
+		registry.on_update<Transform>().connect<&TransformSystem::OnTransformUpdate>(this);
+		registry.on_destroy<Transform>().connect<&TransformSystem::OnTransformDestroy>(this);
+		registry.on_destroy<Hierarchy>().connect<&TransformSystem::OnHierarchyDestroy>(this);
+	}
+
+	bool TransformSystem::SetParent(entt::registry& registry, entt::entity child, entt::entity parent)
+	{
+		Hierarchy* hierarchy = registry.try_get<Hierarchy>(child);
+		if (!hierarchy || (parent != entt::null && !registry.all_of<Hierarchy>(parent)))
+		{
+			return false;
+		}
+
+		if (hierarchy->Parent == parent)
+		{
+			return true;
+		}
+
+		// Parenting to its own subtree would make a cycle
+		for (entt::entity ancestor = parent; ancestor != entt::null; ancestor = registry.get<Hierarchy>(ancestor).Parent)
+		{
+			if (ancestor == child)
+			{
+				RYU_LOG_WARN("Tried to parent an entity to one of its own descendants");
+				return false;
+			}
+		}
+
+		Unlink(registry, child);
+
+		// New children go in front, no need to walk the sibling list
+		if (parent != entt::null)
+		{
+			Hierarchy& parentHierarchy = registry.get<Hierarchy>(parent);
+			if (parentHierarchy.FirstChild != entt::null)
+			{
+				registry.get<Hierarchy>(parentHierarchy.FirstChild).PrevSibling = child;
+			}
+
+			hierarchy->Parent       = parent;
+			hierarchy->NextSibling  = parentHierarchy.FirstChild;
+			parentHierarchy.FirstChild = child;
+		}
+
+		SetSubtreeDepth(registry, child, parent != entt::null ? registry.get<Hierarchy>(parent).Depth + 1 : 0);
+		registry.emplace_or_replace<TransformDirty>(child);
+		m_orderDirty = true;
+		return true;
+	}
+
+	void TransformSystem::Update(entt::registry& registry)
+	{
+		RYU_PROFILE_SCOPE();
+		m_lastUpdateCount = 0;
+		m_updateList.clear();
+
+		auto& dirtyTags = registry.storage<TransformDirty>();
+		if (!m_orderDirty && dirtyTags.empty())
+		{
+			return;
+		}
+
+		if (m_orderDirty)
+		{
+			RebuildOrder(registry);
+		}
+
+		auto& hierarchies = registry.storage<Hierarchy>();
+		for (const entt::entity entity : static_cast<const entt::sparse_set&>(dirtyTags))
+		{
+			if (const Hierarchy* hierarchy = hierarchies.contains(entity) ? &hierarchies.get(entity) : nullptr)
+			{
+				m_dirty[hierarchy->OrderIndex] = 1;
+			}
+		}
+		dirtyTags.clear();
+
+		// Parents come first, by the time an entity is reached its parent is final and knows if it moved
+		const u32 count = static_cast<u32>(m_order.size());
+		for (u32 i = 0; i < count; ++i)
+		{
+			const u32 parent = m_parentIndex[i];
+			if (!m_dirty[i])
+			{
+				if (parent == NO_PARENT || !m_dirty[parent])
+				{
+					continue;
+				}
+				m_dirty[i] = 1;
+			}
+			m_updateList.push_back(i);
+		}
+
+		// Local matrices for the whole list in one batch, then the parents go on in order
+		ComputeLocalMatrices(registry);
+
+		auto& worlds = registry.storage<WorldMatrix>();
+		for (u64 k = 0; k < m_updateList.size(); ++k)
+		{
+			const u32 i      = m_updateList[k];
+			const u32 parent = m_parentIndex[i];
+
+			SM::Matrix& world = worlds.get(m_order[i]).Matrix;
+			world = m_localMatrices[k];
+			if (parent != NO_PARENT)
+			{
+				world *= worlds.get(m_order[parent]).Matrix;
+			}
+		}
+		m_lastUpdateCount = static_cast<u32>(m_updateList.size());
+
+		std::fill(m_dirty.begin(), m_dirty.end(), u8(0));
+	}
+
+	void TransformSystem::ComputeLocalMatrices(entt::registry& registry)
+	{
+		RYU_PROFILE_SCOPE();
+
+		auto& transforms = registry.storage<Transform>();
+		const u64 count = m_updateList.size();
+		for (std::vector<f32>& stream : m_streams)
+		{
+			stream.resize(count);
+		}
+		m_localMatrices.resize(count);
+
+		for (u64 k = 0; k < count; ++k)
+		{
+			const Transform& transform = transforms.get(m_order[m_updateList[k]]);
+			m_streams[0][k] = transform.Position.x;
+			m_streams[1][k] = transform.Position.y;
+			m_streams[2][k] = transform.Position.z;
+			m_streams[3][k] = transform.Orientation.x;
+			m_streams[4][k] = transform.Orientation.y;
+			m_streams[5][k] = transform.Orientation.z;
+			m_streams[6][k] = transform.Orientation.w;
+			m_streams[7][k] = transform.Scale.x;
+			m_streams[8][k] = transform.Scale.y;
+			m_streams[9][k] = transform.Scale.z;
+		}
+
+		const Math::TransformStreams streams
+		{
+			.Position    = { m_streams[0].data(), m_streams[1].data(), m_streams[2].data() },
+			.Orientation = { m_streams[3].data(), m_streams[4].data(), m_streams[5].data(), m_streams[6].data() },
+			.Scale       = { m_streams[7].data(), m_streams[8].data(), m_streams[9].data() },
+		};
+		Math::ComputeWorldMatrices(streams, m_localMatrices.data(), count);
+	}
+
+	void TransformSystem::OnTransformConstruct(entt::registry& registry, entt::entity entity)
+	{
+		registry.emplace_or_replace<Hierarchy>(entity);
+		registry.emplace_or_replace<WorldMatrix>(entity);
+		registry.emplace_or_replace<TransformDirty>(entity);
+		m_orderDirty = true;
+	}
+
+	void TransformSystem::OnTransformUpdate(entt::registry& registry, entt::entity entity)
+	{
+		registry.emplace_or_replace<TransformDirty>(entity);
+	}
+
+	void TransformSystem::OnTransformDestroy(entt::registry& registry, entt::entity entity)
+	{
+		registry.remove<Hierarchy, WorldMatrix, TransformDirty>(entity);
+	}
+
+	void TransformSystem::OnHierarchyDestroy(entt::registry& registry, entt::entity entity)
+	{
+		Unlink(registry, entity);
+
+		// Children become roots and keep their local transforms
+		Hierarchy& hierarchy = registry.get<Hierarchy>(entity);
+		for (entt::entity child = hierarchy.FirstChild; child != entt::null;)
+		{
+			Hierarchy* childHierarchy = registry.try_get<Hierarchy>(child);
+			if (!childHierarchy)
+			{
+				break;  // The whole registry is going away
+			}
+
+			const entt::entity next = childHierarchy->NextSibling;
+			childHierarchy->Parent      = entt::null;
+			childHierarchy->NextSibling = entt::null;
+			childHierarchy->PrevSibling = entt::null;
+			SetSubtreeDepth(registry, child, 0);
+			registry.emplace_or_replace<TransformDirty>(child);
+			child = next;
+		}
+
+		hierarchy.FirstChild = entt::null;
+		m_orderDirty = true;
+	}
+
+	void TransformSystem::Unlink(entt::registry& registry, entt::entity entity)
+	{
+		Hierarchy& hierarchy = registry.get<Hierarchy>(entity);
+
+		if (hierarchy.PrevSibling != entt::null)
+		{
+			if (Hierarchy* prev = registry.try_get<Hierarchy>(hierarchy.PrevSibling))
+			{
+				prev->NextSibling = hierarchy.NextSibling;
+			}
+		}
+		else if (hierarchy.Parent != entt::null)
+		{
+			if (Hierarchy* parent = registry.try_get<Hierarchy>(hierarchy.Parent))
+			{
+				parent->FirstChild = hierarchy.NextSibling;
+			}
+		}
+
+		if (hierarchy.NextSibling != entt::null)
+		{
+			if (Hierarchy* next = registry.try_get<Hierarchy>(hierarchy.NextSibling))
+			{
+				next->PrevSibling = hierarchy.PrevSibling;
+			}
+		}
+
+		hierarchy.Parent      = entt::null;
+		hierarchy.NextSibling = entt::null;
+		hierarchy.PrevSibling = entt::null;
+	}
+
+	void TransformSystem::SetSubtreeDepth(entt::registry& registry, entt::entity root, u32 depth)
+	{
+		// Iterative, hierarchies can be deeper than the stack likes
+		std::vector<std::pair<entt::entity, u32>> stack{ { root, depth } };
+		while (!stack.empty())
+		{
+			const auto [entity, entityDepth] = stack.back();
+			stack.pop_back();
+
+			Hierarchy* hierarchy = registry.try_get<Hierarchy>(entity);
+			if (!hierarchy)
+			{
+				continue;
+			}
+
+			hierarchy->Depth = entityDepth;
+			for (entt::entity child = hierarchy->FirstChild; child != entt::null;)
+			{
+				stack.emplace_back(child, entityDepth + 1);
+				const Hierarchy* childHierarchy = registry.try_get<Hierarchy>(child);
+				child = childHierarchy ? childHierarchy->NextSibling : entt::null;
+			}
+		}
+	}
+
+	void TransformSystem::RebuildOrder(entt::registry& registry)
+	{
+		RYU_PROFILE_SCOPE();
+
+		auto& hierarchies = registry.storage<Hierarchy>();
+		const u32 count = static_cast<u32>(hierarchies.size());
+
+		// Counting sort on depth: linear, and stable so siblings keep their relative order between rebuilds
+		std::vector<u32> depthStart;
+		for (const auto& [entity, hierarchy] : hierarchies.each())
+		{
+			if (hierarchy.Depth + 2 > depthStart.size())
+			{
+				depthStart.resize(hierarchy.Depth + 2, 0);
+			}
+			++depthStart[hierarchy.Depth + 1];
+		}
+
+		for (u64 depth = 1; depth < depthStart.size(); ++depth)
+		{
+			depthStart[depth] += depthStart[depth - 1];
+		}
+
+		m_order.resize(count);
+		for (auto&& [entity, hierarchy] : hierarchies.each())
+		{
+			hierarchy.OrderIndex = depthStart[hierarchy.Depth]++;
+			m_order[hierarchy.OrderIndex] = entity;
+		}
+
+		m_parentIndex.resize(count);
+		for (u32 i = 0; i < count; ++i)
+		{
+			const Hierarchy& hierarchy = hierarchies.get(m_order[i]);
+			m_parentIndex[i] = hierarchy.Parent != entt::null ? hierarchies.get(hierarchy.Parent).OrderIndex : NO_PARENT;
+		}
+
+		// Lay the components out in update order too, so the pass walks memory front to back
+		registry.sort<Hierarchy>([](const Hierarchy& a, const Hierarchy& b) { return a.OrderIndex < b.OrderIndex; });
+		registry.sort<Transform, Hierarchy>();
+		registry.sort<WorldMatrix, Hierarchy>();
+
+		m_dirty.assign(count, 0);
+		m_orderDirty = false;
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "Math/Math.h"
+#include <entt/entity/fwd.hpp>
+
+namespace Ryu::Game
+{
+	// Keeps every entity's WorldMatrix in sync with its Transform and parents.
+	// Entities are kept sorted by hierarchy depth, parents always come before their children, so an update
+	// is one linear pass that recomputes entities tagged TransformDirty and everything below them.
+	// The order only gets rebuilt when entities are added, removed or reparented
+	class TransformSystem
+	{
+		RYU_DISABLE_COPY_AND_MOVE(TransformSystem)
+
+	public:
+		static constexpr u32 NO_PARENT = ~0u;
+
+	public:
+		TransformSystem() = default;
+
+		// Hooks Transform construction, patching and destruction. Call once, before entities are created
+		void Connect(entt::registry& registry);
+
+		// Null parent makes child a root. The local transform is kept, so the child moves with its new parent.
+		// Returns false if parent is child or one of its descendants
+		bool SetParent(entt::registry& registry, entt::entity child, entt::entity parent);
+
+		void Update(entt::registry& registry);
+
+		// World matrices recomputed by the last update
+		[[nodiscard]] inline u32 GetLastUpdateCount() const { return m_lastUpdateCount; }
+		[[nodiscard]] inline bool IsOrderDirty() const { return m_orderDirty; }
+
+		// Calls callback(entity) for every entity the last update recomputed, parents before children
+		template <typename Callback>
+		void ForEachLastUpdated(Callback&& callback) const
+		{
+			for (const u32 i : m_updateList)
+			{
+				callback(m_order[i]);
+			}
+		}
+
+	private:
+		void OnTransformConstruct(entt::registry& registry, entt::entity entity);
+		void OnTransformUpdate(entt::registry& registry, entt::entity entity);
+		void OnTransformDestroy(entt::registry& registry, entt::entity entity);
+		void OnHierarchyDestroy(entt::registry& registry, entt::entity entity);
+
+		void Unlink(entt::registry& registry, entt::entity entity);
+		void SetSubtreeDepth(entt::registry& registry, entt::entity root, u32 depth);
+		void RebuildOrder(entt::registry& registry);
+
+		// Gathers the listed transforms into m_streams and runs the batch kernel over them
+		void ComputeLocalMatrices(entt::registry& registry);
+
+	private:
+		std::vector<entt::entity> m_order;        // Depth sorted
+		std::vector<u32>          m_parentIndex;  // Into m_order, NO_PARENT for roots
+		std::vector<u8>           m_dirty;
+		std::vector<u32>          m_updateList;     // Order indices to recompute this update, in order
+		std::vector<SM::Matrix>   m_localMatrices;  // Matches m_updateList
+		std::array<std::vector<f32>, 10> m_streams; // Position xyz, orientation xyzw, scale xyz
+		u32                       m_lastUpdateCount = 0;
+		bool                      m_orderDirty      = true;
+	};
+}
@@ -1,13 +1,24 @@
 #include "Game/World/World.h"
 #include "Game/World/Entity.h"
+#include "Game/Components/HierarchyComponent.h"
 #include "Game/Components/TransformComponent.h"
 #include "Core/Logging/Logger.h"
+#include "Memory/New.h"
 #include <entt/entity/registry.hpp>
 
 namespace Ryu::Game
 {
+	World::World(const std::string& name)
+		: m_name(name)
+	{
+		m_transformSystem.Connect(m_registry);
+		m_spatialSystem.Connect(m_registry);
+	}
+
 	Entity World::CreateEntity(const std::string& name)
 	{
+		Memory::ScopedAllocationTag tag(Memory::AllocationTag::ECS);
+
 		EntityHandle handle = m_registry.create();
 
 		// Add metadata component
@@ -106,6 +117,31 @@ namespace Ryu::Game
 		return m_pendingDestructions.size();
 	}
 
+	bool World::SetParent(EntityHandle child, EntityHandle parent)
+	{
+		return m_transformSystem.SetParent(m_registry, child, parent);
+	}
+
+	EntityHandle World::GetParent(EntityHandle handle) const
+	{
+		const Hierarchy* hierarchy = m_registry.try_get<Hierarchy>(handle);
+		return hierarchy ? hierarchy->Parent : entt::null;
+	}
+
+	void World::MarkTransformDirty(EntityHandle handle)
+	{
+		if (m_registry.all_of<Transform>(handle))
+		{
+			m_registry.emplace_or_replace<TransformDirty>(handle);
+		}
+	}
+
+	void World::UpdateTransforms()
+	{
+		m_transformSystem.Update(m_registry);
+		m_spatialSystem.Update(m_registry, m_transformSystem);
+	}
+
 	void World::OnCreate() { }
 
 	void World::OnDestroy() { }
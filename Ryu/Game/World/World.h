@@ -1,6 +1,8 @@
 #pragma once
 #include "Core/Utils/Serializer.h"
 #include "Core/Utils/Timing/FrameTimer.h"
+#include "Game/World/SpatialSystem.h"
+#include "Game/World/TransformSystem.h"
 #include <entt/entity/registry.hpp>
 
 namespace Ryu::Game
@@ -30,6 +32,16 @@ namespace Ryu::Game
 		void ProcessPendingDestructions();
 		u64 GetPendingDestructionCount() const;
 
+		// Null parent detaches child. Local transforms are relative to the parent's world transform
+		bool SetParent(EntityHandle child, EntityHandle parent);
+		[[nodiscard]] EntityHandle GetParent(EntityHandle handle) const;
+
+		// Transforms edited in place need this to reach their WorldMatrix, registry.patch<Transform> does it too
+		void MarkTransformDirty(EntityHandle handle);
+
+		// Brings every WorldMatrix and the spatial index up to date, only touches what changed since the last call
+		void UpdateTransforms();
+
 		template <Utils::Serializable T> toml::table SerializeComponent(EntityHandle handle);
 		template <Utils::Serializable... Ts> auto SerializeComponents(EntityHandle handle);
 
@@ -40,9 +52,13 @@ namespace Ryu::Game
 		[[nodiscard]] inline const Registry& GetRegistry() const { return m_registry; }
 		[[nodiscard]] inline WorldManager* GetWorldManager() const { return m_worldManager; }
 		[[nodiscard]] inline const std::string& GetName() const { return m_name; }
+		[[nodiscard]] inline const TransformSystem& GetTransformSystem() const { return m_transformSystem; }
+
+		// Entities with LocalBounds by where they are, as of the last UpdateTransforms
+		[[nodiscard]] inline const SpatialSystem& GetSpatialSystem() const { return m_spatialSystem; }
 	
 	protected:
-		explicit World(const std::string& name) : m_name(name) {}
+		explicit World(const std::string& name);
 
 		virtual void OnCreate();
 		virtual void OnDestroy();
@@ -51,6 +67,8 @@ namespace Ryu::Game
 	private:
 		WorldManager*             m_worldManager = nullptr;
 		std::string               m_name;
+		TransformSystem           m_transformSystem;  // Before the registry, its signals point here
+		SpatialSystem             m_spatialSystem;    // Same
 		Registry                  m_registry;
 		std::vector<EntityHandle> m_pendingDestructions;
 	};
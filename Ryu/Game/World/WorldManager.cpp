@@ -16,6 +16,9 @@ namespace Ryu::Game
 			m_activeWorld->ProcessPendingDestructions();
 
 			m_activeWorld->OnTick(timer);
+
+			// Whatever the tick moved, so the rest of the frame sees current world matrices
+			m_activeWorld->UpdateTransforms();
 		}
 	}
 
@@ -150,9 +150,9 @@ namespace Ryu::Gfx
 		DrawInstanced(drawInfo.VertexCountPerInstance, drawInfo.InstanceCount, drawInfo.StartVertexLocation, drawInfo.StartInstanceLocation);
 	}
 
-	void CommandList::DrawMeshIndexedInstanced(const Mesh& mesh) const
+	void CommandList::DrawMeshIndexedInstanced(const Mesh& mesh, u32 lod) const
 	{
-		const Mesh::DrawInfo& drawInfo = mesh.GetDrawInfo();
+		const Mesh::DrawInfo drawInfo = mesh.GetLodDrawInfo(lod);
 		DrawIndexedInstanced(drawInfo.IndexCountPerInstance, drawInfo.InstanceCount, drawInfo.StartIndexLocation, drawInfo.BaseVertexLocation, drawInfo.StartInstanceLocation);
 	}
 }
@@ -43,7 +43,7 @@ namespace Ryu::Gfx
 		void DrawIndexedInstanced(u32 indexCountPerInstance, u32 instanceCount, u32 startVertexLocation, i32 baseVertexLocation, u32 startInstanceLocation) const;
 		
 		void DrawMeshInstanced(const Mesh& mesh);
-		void DrawMeshIndexedInstanced(const Mesh& mesh) const;
+		void DrawMeshIndexedInstanced(const Mesh& mesh, u32 lod = 0) const;
 
 	private:
 		D3D12_COMMAND_LIST_TYPE               m_type;
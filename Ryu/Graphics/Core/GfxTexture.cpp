@@ -17,10 +17,11 @@ namespace Ryu::Gfx
         DX12::SetObjectName(m_resource.Get(), name.data());
     }
 
-    Texture::Texture(Device* parent, u32 width, u32 height, DXGI_FORMAT format, std::string_view name)
+    Texture::Texture(Device* parent, u32 width, u32 height, DXGI_FORMAT format, std::string_view name, u32 mipLevels)
         : Resource(parent)
         , m_width(width)
         , m_height(height)
+        , m_mipLevels(mipLevels)
         , m_format(format)
         , m_needsUpload(true)
     {
@@ -32,7 +33,7 @@ namespace Ryu::Gfx
         texDesc.Width = width;
         texDesc.Height = height;
         texDesc.DepthOrArraySize = 1;
-        texDesc.MipLevels = 1;
+        texDesc.MipLevels = static_cast<UINT16>(mipLevels);
         texDesc.Format = format;
         texDesc.SampleDesc.Count = 1;
         texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
@@ -51,8 +52,8 @@ namespace Ryu::Gfx
         RYU_ASSERT(SUCCEEDED(hr), "Failed to create texture resource!");
         DX12::SetObjectName(m_resource.Get(), name.data());
 
-        // Create upload buffer
-        const u64 uploadBufferSize = GetRequiredIntermediateSize(m_resource.Get(), 0, 1);
+        // Create upload buffer, big enough for every mip
+        const u64 uploadBufferSize = GetRequiredIntermediateSize(m_resource.Get(), 0, mipLevels);
         const CD3DX12_HEAP_PROPERTIES uploadHeap(D3D12_HEAP_TYPE_UPLOAD);
         const CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize);
 
@@ -85,22 +86,29 @@ namespace Ryu::Gfx
 
     void Texture::Upload(const CommandList& cmdList, const void* data, u32 rowPitch)
     {
-        if (!m_needsUpload || !data)
-        {
-            return;
-        }
-
         D3D12_SUBRESOURCE_DATA subresourceData{};
         subresourceData.pData = data;
         subresourceData.RowPitch = rowPitch;
         subresourceData.SlicePitch = rowPitch * m_height;
 
+        Upload(cmdList, { &subresourceData, data ? 1u : 0u });
+    }
+
+    void Texture::Upload(const CommandList& cmdList, std::span<const D3D12_SUBRESOURCE_DATA> mips)
+    {
+        if (!m_needsUpload || mips.empty())
+        {
+            return;
+        }
+
+        RYU_ASSERT(mips.size() <= m_mipLevels, "More mips than the texture has!");
+
         UpdateSubresources(
             cmdList.GetNative(),
             m_resource.Get(),
             m_uploadBuffer.Get(),
-            0, 0, 1,
-            &subresourceData);
+            0, 0, static_cast<u32>(mips.size()),
+            mips.data());
 
         // Transition to shader resource
         const CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
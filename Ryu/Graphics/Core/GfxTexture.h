@@ -1,5 +1,6 @@
 #pragma once
 #include "Graphics/Core/GfxResource.h"
+#include <span>
 
 namespace Ryu::Gfx
 {
@@ -11,21 +12,24 @@ namespace Ryu::Gfx
     public:
         Texture(Device* parent);
         Texture(Device* parent, DX12::Resource* resource, std::string_view name);  // Swapchain textures
-        Texture(Device* parent, u32 width, u32 height, DXGI_FORMAT format, std::string_view name);  // New
+        Texture(Device* parent, u32 width, u32 height, DXGI_FORMAT format, std::string_view name, u32 mipLevels = 1);  // New
         virtual ~Texture() = default;
 
         void UpdateTextureResource(DX12::Resource* resource, std::string_view name);
         void CreateRenderTarget(D3D12_RENDER_TARGET_VIEW_DESC* desc, DescriptorHandle rtvHeapHandle);
         void Upload(const CommandList& cmdList, const void* data, u32 rowPitch);
+        void Upload(const CommandList& cmdList, std::span<const D3D12_SUBRESOURCE_DATA> mips);  // One per mip level
 
         [[nodiscard]] u32 GetWidth() const { return m_width; }
         [[nodiscard]] u32 GetHeight() const { return m_height; }
+        [[nodiscard]] u32 GetMipLevels() const { return m_mipLevels; }
         [[nodiscard]] DXGI_FORMAT GetFormat() const { return m_format; }
 
     private:
         ComPtr<DX12::Resource> m_uploadBuffer;
         u32 m_width = 0;
         u32 m_height = 0;
+        u32 m_mipLevels = 1;
         DXGI_FORMAT m_format = DXGI_FORMAT_UNKNOWN;
         bool m_isBackBuffer : 1 = false;
         bool m_isRenderTarget : 1 = false;
@@ -1,4 +1,5 @@
 #include "Graphics/GpuResourceFactory.h"
+#include "Asset/Processing/VertexPacking.h"
 #include "Core/Profiling/Profiling.h"
 
 namespace Ryu::Gfx
@@ -9,31 +10,52 @@ namespace Ryu::Gfx
     std::unique_ptr<Gfx::Mesh> GpuResourceFactory::CreateMesh(const Asset::MeshData& data, std::string_view name)
     {
         RYU_PROFILE_SCOPE();
-        if (data.Vertices.empty())
+        const std::span<const Asset::MeshData::Vertex> vertices = data.GetVertices();
+        const std::span<const u32> indices = data.GetIndices();
+        if (vertices.empty())
         {
             return nullptr;
         }
 
-        // Vertex buffer
+        // Vertex buffer, packed when the mesh has a packed copy. The mesh keeps the layout so the renderer can match it
+        const bool packed = data.HasPackedVertices();
+        const Asset::VertexLayout layout = packed ? data.PackedLayout : Asset::VertexLayout{};
+        const std::span<const byte> vertexData = packed
+            ? data.GetPackedVertices()
+            : std::span<const byte>(reinterpret_cast<const byte*>(vertices.data()), vertices.size_bytes());
+
         Buffer::Desc vbDesc
         {
-            .SizeInBytes   = data.VertexBufferSize(),
-            .StrideInBytes = data.VertexStride(),
+            .SizeInBytes   = static_cast<u32>(vertexData.size()),
+            .StrideInBytes = layout.Stride(),
             .Usage         = Buffer::Usage::Default,
             .Type          = Buffer::Type::Vertex,
             .Name          = std::string(name) + " VB"
         };
 
-        // Index buffer (optional)
+        // Index buffer (optional), 16-bit when every index fits
         std::unique_ptr<Buffer::Desc> ibDesc;
+        std::vector<byte> indexData;
         if (data.HasIndices())
         {
+            const bool use16Bit = data.Uses16BitIndices();
+            if (use16Bit)
+            {
+                indexData.resize(indices.size() * sizeof(u16));
+                Asset::VertexPacking::PackIndices16(indices, { reinterpret_cast<u16*>(indexData.data()), indices.size() });
+            }
+            else
+            {
+                indexData.resize(indices.size_bytes());
+                std::memcpy(indexData.data(), indices.data(), indices.size_bytes());
+            }
+
             ibDesc = std::make_unique<Buffer::Desc>(Buffer::Desc
             {
-                .SizeInBytes = data.IndexBufferSize(),
+                .SizeInBytes = static_cast<u32>(indexData.size()),
                 .Usage       = Buffer::Usage::Default,
                 .Type        = Buffer::Type::Index,
-                .Format      = DXGI_FORMAT_R32_UINT,
+                .Format      = use16Bit ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
                 .Name        = std::string(name) + " IB"
             });
         }
@@ -43,17 +65,20 @@ namespace Ryu::Gfx
         Mesh::DrawInfo drawInfo
         {
             .Topology               = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
-            .VertexCountPerInstance = static_cast<u32>(data.Vertices.size()),
-            .IndexCountPerInstance  = static_cast<u32>(data.Indices.size()),
+            .VertexCountPerInstance = static_cast<u32>(vertices.size()),
+            .IndexCountPerInstance  = data.Lods.empty() ? static_cast<u32>(indices.size()) : data.Lods[0].IndexCount,
             .InstanceCount          = 1
         };
         mesh->SetDrawInfo(drawInfo);
+        mesh->SetVertexLayout(layout);
+        mesh->SetLods(data.Lods);
+        mesh->SetBounds(data.Bounds);
 
         m_pendingMeshUploads.push(
         {
             mesh.get(),
-            data.Vertices,
-            data.Indices
+            { vertexData.begin(), vertexData.end() },
+            std::move(indexData)
         });
 
         return mesh;
@@ -68,14 +93,17 @@ namespace Ryu::Gfx
         }
 
         DXGI_FORMAT format = ConvertFormat(data.PixelFormat);
+        if (data.SRGB)
+        {
+            format = DXGI::GetFormatSRGB(format);
+        }
 
-        auto texture = std::make_unique<Texture>(m_device, data.Width, data.Height, format, name);
+        auto texture = std::make_unique<Texture>(m_device, data.Width, data.Height, format, name, static_cast<u32>(data.MipLevels));
 
         m_pendingTextureUploads.push(
         {
             texture.get(),
-            data.Data,
-            static_cast<u32>(data.RowPitch())
+            data
         });
 
         return texture;
@@ -103,7 +131,16 @@ namespace Ryu::Gfx
         {
             PendingTextureUpload& upload = m_pendingTextureUploads.front();
 
-            upload.Texture->Upload(cmdList, upload.Data.data(), upload.RowPitch);
+            const Asset::TextureData& data = upload.Data;
+
+            std::vector<D3D12_SUBRESOURCE_DATA> mips(static_cast<size_t>(data.MipLevels));
+            for (u32 mip = 0; mip < mips.size(); ++mip)
+            {
+                mips[mip].pData      = data.Data.data() + data.MipOffset(mip);
+                mips[mip].RowPitch   = data.MipRowPitch(mip);
+                mips[mip].SlicePitch = static_cast<LONG_PTR>(data.MipSize(mip));
+            }
+            upload.Texture->Upload(cmdList, mips);
 
             m_pendingTextureUploads.pop();
         }
@@ -31,6 +31,10 @@ namespace Ryu::Gfx
             case Asset::TextureData::Format::R32F:    return DXGI_FORMAT_R32_FLOAT;
             case Asset::TextureData::Format::RG32F:   return DXGI_FORMAT_R32G32_FLOAT;
             case Asset::TextureData::Format::RGBA32F: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+            case Asset::TextureData::Format::BC1:     return DXGI_FORMAT_BC1_UNORM;
+            case Asset::TextureData::Format::BC3:     return DXGI_FORMAT_BC3_UNORM;
+            case Asset::TextureData::Format::BC5:     return DXGI_FORMAT_BC5_UNORM;
+            case Asset::TextureData::Format::BC7:     return DXGI_FORMAT_BC7_UNORM;
             default:                                  return DXGI_FORMAT_R8G8B8A8_UNORM;
             }
         }
@@ -39,15 +43,14 @@ namespace Ryu::Gfx
         struct PendingMeshUpload
         {
             Mesh* Mesh;
-            std::vector<Asset::MeshData::Vertex> Vertices;
-            std::vector<u32> Indices;
+            std::vector<byte> Vertices;  // In the mesh's vertex layout
+            std::vector<byte> Indices;   // u16 or u32, matching the index buffer format
         };
 
         struct PendingTextureUpload
         {
             Texture* Texture;
-            std::vector<byte> Data;
-            u32 RowPitch;
+            Asset::TextureData Data;  // Copy of the asset, the mip layout is needed at upload time
         };
 
         Device*                          m_device;
@@ -31,6 +31,17 @@ namespace Ryu::Gfx
 		}
 	}
 	
+	Mesh::DrawInfo Mesh::GetLodDrawInfo(u32 lod) const
+	{
+		DrawInfo info = m_drawInfo;
+		if (lod > 0 && lod < m_lods.size())
+		{
+			info.StartIndexLocation    = m_lods[lod].IndexOffset;
+			info.IndexCountPerInstance = m_lods[lod].IndexCount;
+		}
+		return info;
+	}
+
 	void Mesh::SetPipelineBuffers(const CommandList& cmdList, u32 slot)
 	{
 		cmdList.SetTopology(m_drawInfo.Topology);
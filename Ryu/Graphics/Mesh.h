@@ -1,4 +1,5 @@
 #pragma once
+#include "Asset/AssetData.h"
 #include "Graphics/Core/GfxBuffer.h"
 
 namespace Ryu::Gfx
@@ -31,11 +32,27 @@ namespace Ryu::Gfx
 		[[nodiscard]] inline DrawInfo& GetDrawInfo()             { return m_drawInfo;               }
 		inline void SetDrawInfo(const DrawInfo& info)            { m_drawInfo = info;               }
 
+		// How the vertex buffer is laid out, the pipeline that draws the mesh has to read the same
+		[[nodiscard]] inline const Asset::VertexLayout& GetVertexLayout() const { return m_vertexLayout;   }
+		inline void SetVertexLayout(const Asset::VertexLayout& layout)          { m_vertexLayout = layout; }
+
+		// LOD index ranges and the bounds LOD selection measures against, copied from the mesh data
+		[[nodiscard]] inline std::span<const Asset::MeshLod> GetLods() const { return m_lods;                            }
+		[[nodiscard]] inline const Asset::MeshBounds& GetBounds() const      { return m_bounds;                          }
+		inline void SetLods(std::span<const Asset::MeshLod> lods)            { m_lods.assign(lods.begin(), lods.end()); }
+		inline void SetBounds(const Asset::MeshBounds& bounds)               { m_bounds = bounds;                        }
+
+		// The draw info with the index range of a LOD, LOD 0 if the mesh has no such LOD
+		[[nodiscard]] DrawInfo GetLodDrawInfo(u32 lod) const;
+
 		void UploadBufferData(const CommandList& cmdList, void* vbData, void* ibData);
 		void SetPipelineBuffers(const CommandList& cmdList, u32 slot);
 
 	private:
 		DrawInfo m_drawInfo;
+		Asset::VertexLayout m_vertexLayout;
+		std::vector<Asset::MeshLod> m_lods;
+		Asset::MeshBounds m_bounds;
 		std::unique_ptr<Buffer> m_vertexBuffer;
 		std::unique_ptr<Buffer> m_indexBuffer;
 	};
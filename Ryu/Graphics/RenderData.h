@@ -1,6 +1,7 @@
 #pragma once
 #include "Asset/AssetData.h"
 #include "Math/Math.h"
+#include <memory_resource>
 
 namespace Ryu::Gfx
 {
@@ -10,6 +11,7 @@ namespace Ryu::Gfx
 		Asset::MeshHandle MeshHandle;
 		Math::Matrix WorldTransform;
 		u8 RenderLayer = 0;
+		u8 Lod = 0;       // Picked per view from the projected error, see RenderFrameBuilder
 		u64 SortKey = 0;  // Sorting key for batching
 	};
 
@@ -29,21 +31,32 @@ namespace Ryu::Gfx
 		u32 Priority    = 0;
 	};
 
+	// Mesh renderers a view draws and the ones it doesn't, for whatever reason: outside the frustum, hidden or masked out by layer.
+	// Most of them never get looked at one by one, the spatial index rejects them a subtree at a time
+	struct CullingStats
+	{
+		u32 Visible = 0;
+		u32 Culled  = 0;
+	};
+
 	// Collection of render items for a single camera view
+	// The containers use whatever resource they were built with, the renderer hands in its frame arena
 	struct RenderView
 	{
 		CameraData CameraData;
-		std::vector<RenderItem> OpaqueItems;
-		std::vector<RenderItem> TransparentItems;
+		std::pmr::vector<RenderItem> OpaqueItems;
+		std::pmr::vector<RenderItem> TransparentItems;
+		CullingStats Culling;
 		// Add lights, shadow casters etc when needed
 	};
 
 	// Complete render frame data
 	struct RenderFrame
 	{
-		std::vector<RenderView> Views;
+		std::pmr::vector<RenderView> Views;
 		f32 DeltaTime;
 		f32 TotalTime;
 		u64 FrameNumber;
+		CullingStats Culling;  // Summed over the views
 	};
 }
@@ -1,115 +1,301 @@
 #include "Graphics/RenderFrameBuilder.h"
 
+#include "Asset/AssetRegistry.h"
+#include "Core/Config/CVar.h"
 #include "Core/Profiling/Profiling.h"
+#include "Game/Components/BoundsComponent.h"
 #include "Game/Components/CameraComponent.h"
 #include "Game/Components/MeshRenderer.h"
 #include "Game/Components/TransformComponent.h"
+#include "Game/World/ChunkCulling.h"
 #include "Game/World/World.h"
 #include "Graphics/Core/GfxDevice.h"
+#include "Graphics/Mesh.h"
+#include "Math/Frustum.h"
+#include "Threading/ChunkedCollector.h"
 #include <ranges>
 
 namespace Ryu::Gfx
 {
+	static Config::CVar<f32> cv_lodErrorPixels(
+		"Renderer.LodErrorPixels",
+		1.0f,
+		"How many pixels off a mesh LOD may draw. 0 always draws the full mesh");
+
+	static Config::CVar<bool> cv_frustumCulling(
+		"Renderer.FrustumCulling",
+		true,
+		"Skip renderables whose bounds are outside the camera frustum");
+
+	// Runs func(first, last) over [0, count), split across the job system when there is one
+	template <typename Func>
+	static void ForRange(MT::JobSystem* jobSystem, u64 count, Func&& func)
+	{
+		if (jobSystem)
+		{
+			jobSystem->ParallelFor(0, count, 1, func);
+		}
+		else if (count > 0)
+		{
+			func(u64(0), count);
+		}
+	}
+
 	RenderFrame RenderFrameBuilder::ExtractRenderData(Game::World& world, const Utils::FrameTimer& timer)
 	{
 		RYU_PROFILE_SCOPE();
 
 		RenderFrame frame
 		{
+			.Views       = std::pmr::vector<RenderView>(m_frameResource),
 			.DeltaTime   = timer.DeltaTimeF(),
 			.TotalTime   = (f32)timer.TimeSinceStart<std::chrono::seconds>(),
 			.FrameNumber = timer.FrameCount()
 		};
 
+		// Usually a no-op, the world manager already did it after the tick. Not when the world is only being edited.
+		// Either way it happens once here, every view reads the same world matrices
+		SyncBounds(world);
+		world.UpdateTransforms();
+
 		// Collect all cameras, sorted by priority
-		std::vector<CameraData> cameras;
+		std::pmr::vector<CameraData> cameras(m_frameResource);
 		CollectCameras(world, cameras);
 
 		// If no camera components exist, SceneRenderer will use its default camera
+		frame.Views = ExtractViews(world, cameras);
 
-		// For each camera, collect visible renderables
-		for (const auto& camera : cameras)
+		for (const RenderView& view : frame.Views)
 		{
-			RenderView view{};
-			view.CameraData = camera;
+			frame.Culling.Visible += view.Culling.Visible;
+			frame.Culling.Culled  += view.Culling.Culled;
+		}
+
+		return frame;
+	}
+
+	RenderView RenderFrameBuilder::ExtractViewForCamera(Game::World& world, const CameraData& cameraData)
+	{
+		RYU_PROFILE_SCOPE();
+
+		SyncBounds(world);
+		world.UpdateTransforms();
 
-			CollectRenderables(
-				world,
-				camera.CullingMask,
-				view.OpaqueItems,
-				view.TransparentItems);
+		std::pmr::vector<RenderView> views = ExtractViews(world, std::span(&cameraData, 1));
+		return std::move(views.front());
+	}
 
-			// Sort opaque front-to-back (minimize overdraw)
-			std::ranges::sort(view.OpaqueItems,
-			[](const RenderItem& a, const RenderItem& b)
+	std::pmr::vector<RenderView> RenderFrameBuilder::ExtractViews(Game::World& world, std::span<const CameraData> cameras)
+	{
+		RYU_PROFILE_SCOPE();
+
+		auto& registry  = world.GetRegistry();
+		auto& renderers = registry.storage<Game::MeshRenderer>();
+		auto& worlds    = registry.storage<Game::WorldMatrix>();
+		const bool cull = cv_frustumCulling;
+		const u64 viewCount = cameras.size();
+
+		std::pmr::vector<RenderView> views(m_frameResource);
+		views.reserve(viewCount);
+		for (const CameraData& camera : cameras)
+		{
+			views.push_back(RenderView
 			{
-				return a.SortKey < b.SortKey;
+				.CameraData       = camera,
+				.OpaqueItems      = std::pmr::vector<RenderItem>(m_frameResource),
+				.TransparentItems = std::pmr::vector<RenderItem>(m_frameResource)
 			});
+		}
 
-			// Sort transparent back-to-front (correct blending)
-			std::ranges::sort(view.TransparentItems,
-			[](const RenderItem& a, const RenderItem& b)
+		// What each view has to look at: what the spatial index finds in its frustum, or every mesh renderer without culling.
+		// The spatial index only has renderers with bounds, the ones whose mesh is still loading have nothing to draw yet
+		std::pmr::vector<Math::Frustum> frustums(viewCount, m_frameResource);
+		std::pmr::vector<std::pmr::vector<entt::entity>> found(viewCount, m_frameResource);
+		std::pmr::vector<std::span<const entt::entity>> sources(viewCount, m_frameResource);
+		ForRange(m_jobSystem, viewCount, [&](u64 first, u64 last)
+		{
+			for (u64 v = first; v < last; ++v)
 			{
-				return a.SortKey > b.SortKey;
-			});
+				frustums[v] = Math::ExtractFrustum(cameras[v].ViewProjectionMatrix);
+				if (!cull)
+				{
+					sources[v] = std::span<const entt::entity>(renderers.data(), renderers.size());
+					continue;
+				}
+
+				std::pmr::vector<entt::entity>& entities = found[v];
+				world.GetSpatialSystem().Query(frustums[v], [&entities](entt::entity entity) { entities.push_back(entity); });
+				sources[v] = entities;
+			}
+		});
 
-			frame.Views.push_back(std::move(view));
-		}
+		struct Candidate
+		{
+			const Game::WorldMatrix* World;
+			const Game::MeshRenderer* Renderer;
+			const Mesh* GpuMesh;
+		};
 
-		return frame;
-	}
+		// Every view cut into chunks and all of them handed out at once, so one busy camera still spreads over the workers
+		std::pmr::vector<u64> sourceSizes(viewCount, m_frameResource);
+		std::ranges::transform(sources, sourceSizes.begin(), [](std::span<const entt::entity> entities) { return entities.size(); });
+		MT::ChunkedCollector<RenderItem> collector(m_jobSystem, sourceSizes, Game::CULL_CHUNK_SIZE, m_frameResource);
 
-	RenderView RenderFrameBuilder::ExtractViewForCamera(Game::World& world, const CameraData& cameraData)
-	{
-		RYU_PROFILE_SCOPE();
+		collector.Run([&](u64 v, u64 first, u64 last, std::pmr::vector<RenderItem>& items)
+		{
+			const CameraData& camera = cameras[v];
+			const std::span<const entt::entity> entities = sources[v].subspan(first, last - first);
 
-		RenderView view { .CameraData = cameraData };
+			// The tree answers for boxes with a margin, the spheres are exact
+			Game::CullChunk<Candidate>(cull ? &frustums[v] : nullptr, entities,
+			[&](entt::entity entity, Candidate& candidate, Game::CullSphere& sphere)
+			{
+				if (!renderers.contains(entity) || !worlds.contains(entity))
+				{
+					return false;
+				}
+
+				const Game::MeshRenderer& renderer = renderers.get(entity);
+				if (!renderer.IsVisible                                          // Skip invisible
+					|| ((camera.CullingMask & (1u << renderer.RenderLayer)) == 0))  // Layer culling
+				{
+					return false;
+				}
+
+				// Lock free, loads and GPU uploads are left to SyncBounds on the calling thread
+				const Game::WorldMatrix& worldMatrix = worlds.get(entity);
+				const Mesh* mesh = m_assetRegistry->Meshes().FindReadyGpu(renderer.MeshHandle);
+				candidate = { &worldMatrix, &renderer, mesh };
+
+				// Without bounds yet (still streaming in) there is nothing to cull against
+				sphere = mesh
+					? Game::ToWorldSphere(Math::Vector3(mesh->GetBounds().Center.data()), mesh->GetBounds().Radius, worldMatrix.Matrix)
+					: Game::CullSphere{ worldMatrix.Matrix.Translation(), std::numeric_limits<f32>::infinity() };
+				return true;
+			},
+			[&](const Candidate& candidate)
+			{
+				RenderItem item = CreateRenderItem(*candidate.World, *candidate.Renderer, candidate.GpuMesh, camera);
+				item.SortKey = ComputeSortKey(item);
+				items.push_back(item);
+			});
+		});
 
-		CollectRenderables(
-			world,
-			cameraData.CullingMask,
-			view.OpaqueItems,
-			view.TransparentItems);
+		// Views gather their chunks back in order and sort
+		ForRange(m_jobSystem, viewCount, [&](u64 first, u64 last)
+		{
+			for (u64 v = first; v < last; ++v)
+			{
+				RenderView& view = views[v];
+
+				// For now, all items are opaque
+				const u64 total = collector.CountItems(v);
+				view.OpaqueItems.reserve(total);
+				collector.AppendTo(v, view.OpaqueItems);
+
+				view.Culling.Visible = static_cast<u32>(total);
+				view.Culling.Culled  = static_cast<u32>(renderers.size() - total);
+
+				// Sort opaque front-to-back (minimize overdraw)
+				std::ranges::sort(view.OpaqueItems,
+				[](const RenderItem& a, const RenderItem& b)
+				{
+					return a.SortKey < b.SortKey;
+				});
+
+				// Sort transparent back-to-front (correct blending)
+				std::ranges::sort(view.TransparentItems,
+				[](const RenderItem& a, const RenderItem& b)
+				{
+					return a.SortKey > b.SortKey;
+				});
+			}
+		});
 
-		return view;
+		return views;
 	}
 
-	void RenderFrameBuilder::CollectRenderables(Game::World& world, u32 cullingMask, std::vector<RenderItem>& opaqueOut, 
-		[[maybe_unused]] std::vector<RenderItem>& transparentOut)  // Temporary until I figure out transparency
+	void RenderFrameBuilder::SyncBounds(Game::World& world)
 	{
 		RYU_PROFILE_SCOPE();
 
 		auto& registry = world.GetRegistry();
+		auto& meshes   = m_assetRegistry->Meshes();
 
-		// Query all entities with Transform and MeshRenderer
-		auto view = registry.view<Game::Transform, Game::MeshRenderer>();
+		auto toBox = [](const Mesh* mesh)
+		{
+			const Asset::MeshBounds& bounds = mesh->GetBounds();
+			return Math::Aabb{ Math::Vector3(bounds.Min.data()), Math::Vector3(bounds.Max.data()) };
+		};
 
-		for (const auto& [entity, transform, renderer] : view.each())
+		// Bounds of a mesh that was invalidated are dropped until it is back, it may come back with other bounds.
+		// One that already came back gets its new bounds. Checked in chunks, most frames find nothing to change
+		auto& renderers = registry.storage<Game::MeshRenderer>();
+		auto& bounded   = registry.storage<Game::LocalBounds>();
+		auto isStale = [&](entt::entity entity)
 		{
-			if (!renderer.IsVisible                                      // Skip invisible
-				|| ((cullingMask & (1u << renderer.RenderLayer)) == 0))  // Layer culling
+			if (!renderers.contains(entity))
 			{
-				continue;
+				return false;  // Bounds that came from somewhere else
 			}
+			const Mesh* mesh = meshes.FindReadyGpu(renderers.get(entity).MeshHandle);
+			if (!mesh)
+			{
+				return true;
+			}
+			const Math::Aabb box = toBox(mesh);
+			const Math::Aabb& current = bounded.get(entity).Box;
+			return box.Min != current.Min || box.Max != current.Max;
+		};
+
+		const u64 boundedCount = bounded.size();
+		MT::ChunkedCollector<entt::entity> stale(m_jobSystem, std::span(&boundedCount, 1), Game::CULL_CHUNK_SIZE, m_frameResource);
+		stale.Run([&](u64, u64 first, u64 last, std::pmr::vector<entt::entity>& items)
+		{
+			std::ranges::copy_if(std::span(bounded.data() + first, last - first), std::back_inserter(items), isStale);
+		});
 
-			RenderItem item = CreateRenderItem(transform, renderer);
-			item.SortKey = ComputeSortKey(item);
+		std::pmr::vector<entt::entity> staleEntities(m_frameResource);
+		stale.AppendTo(0, staleEntities);
+		for (const entt::entity entity : staleEntities)
+		{
+			if (const Mesh* mesh = meshes.FindReadyGpu(renderers.get(entity).MeshHandle))
+			{
+				registry.patch<Game::LocalBounds>(entity, [&](Game::LocalBounds& bounds) { bounds.Box = toBox(mesh); });
+			}
+			else
+			{
+				registry.remove<Game::LocalBounds>(entity);
+			}
+		}
+
+		// Once per mesh renderer, when its mesh has finished loading. Starting loads and creating GPU resources happens here
+		// on the calling thread, extraction only looks meshes up
+		std::pmr::vector<std::pair<entt::entity, const Mesh*>> loaded(m_frameResource);
+		for (const auto& [entity, renderer] : registry.view<Game::MeshRenderer>(entt::exclude<Game::LocalBounds>).each())
+		{
+			if (const Mesh* mesh = meshes.TryGetGpu(renderer.MeshHandle))
+			{
+				loaded.emplace_back(entity, mesh);
+			}
+		}
 
-			// For now, all items are opaque
-			opaqueOut.push_back(item);
+		for (const auto& [entity, mesh] : loaded)
+		{
+			registry.emplace<Game::LocalBounds>(entity, toBox(mesh));
 		}
 	}
 
-	void RenderFrameBuilder::CollectCameras(Game::World& world, std::vector<CameraData>& camerasOut)
+	void RenderFrameBuilder::CollectCameras(Game::World& world, std::pmr::vector<CameraData>& camerasOut)
 	{
 		RYU_PROFILE_SCOPE();
 
 		auto& registry = world.GetRegistry();
-		auto view = registry.view<Game::Transform, Game::CameraComponent>();
+		auto view = registry.view<Game::WorldMatrix, Game::CameraComponent>();
 
-		for (const auto& [entity, transform, camera] : view.each())
+		for (const auto& [entity, worldMatrix, camera] : view.each())
 		{
-			const CameraData camData = ExtractCameraData(transform, camera);
+			const CameraData camData = ExtractCameraData(worldMatrix, camera);
 			camerasOut.push_back(camData);
 		}
 
@@ -117,7 +303,7 @@ namespace Ryu::Gfx
 		std::ranges::sort(camerasOut, [](const CameraData& a, const CameraData& b) { return a.Priority < b.Priority; });
 	}
 
-	CameraData RenderFrameBuilder::ExtractCameraData(const Game::Transform& transform, const Game::CameraComponent& camera)
+	CameraData RenderFrameBuilder::ExtractCameraData(const Game::WorldMatrix& world, const Game::CameraComponent& camera)
 	{
 		RYU_PROFILE_SCOPE();
 
@@ -131,9 +317,11 @@ namespace Ryu::Gfx
 		width  = std::max(width, 10u);
 		height = std::max(height, 10u);
 
+		const Math::Vector3 position = world.Matrix.Translation();
+
 		CameraData data
 		{
-			.Position    = transform.Position,
+			.Position    = position,
 			.NearPlane   = camera.ClipPlane[0],
 			.FarPlane    = camera.ClipPlane[1],
 			.CullingMask = camera.CullingMask,
@@ -144,15 +332,16 @@ namespace Ryu::Gfx
 		data.Viewport.width  = static_cast<f32>(width);
 		data.Viewport.height = static_cast<f32>(height);
 
-		// Position/orientation from entity Transform
-		SM::Matrix rotMat = SM::Matrix::CreateFromQuaternion(transform.Orientation);
-		data.Forward      = SM::Vector3::Transform(SM::Vector3::Forward, transform.Orientation);
-		SM::Vector3 up    = SM::Vector3::Transform(SM::Vector3::Up, transform.Orientation);
+		// Position/orientation from the entity's world matrix, parents included. Normalized to drop any scale
+		data.Forward   = SM::Vector3::TransformNormal(SM::Vector3::Forward, world.Matrix);
+		SM::Vector3 up = SM::Vector3::TransformNormal(SM::Vector3::Up, world.Matrix);
+		data.Forward.Normalize();
+		up.Normalize();
 
 		// Create a view matrix from transform
 		data.ViewMatrix = DirectX::XMMatrixLookAtLH(
-			transform.Position,
-			transform.Position + data.Forward,
+			position,
+			position + data.Forward,
 			up);
 
 		const f32 aspect = data.Viewport.AspectRatio();
@@ -186,14 +375,52 @@ namespace Ryu::Gfx
 		return data;
 	}
 
-	RenderItem RenderFrameBuilder::CreateRenderItem(const Game::Transform& transform, const Game::MeshRenderer& renderer)
+	RenderItem RenderFrameBuilder::CreateRenderItem(const Game::WorldMatrix& world, const Game::MeshRenderer& renderer, const Mesh* mesh, const CameraData& camera)
 	{
-		return RenderItem
+		RenderItem item
 		{
 			.MeshHandle     = renderer.MeshHandle,
-			.WorldTransform = transform.GetWorldMatrix(),
+			.WorldTransform = world.Matrix,
 			.RenderLayer    = renderer.RenderLayer
 		};
+
+		item.Lod = SelectLod(mesh, item.WorldTransform, camera);
+		return item;
+	}
+
+	u8 RenderFrameBuilder::SelectLod(const Mesh* mesh, const Math::Matrix& world, const CameraData& camera) const
+	{
+		const f32 maxPixels = cv_lodErrorPixels;
+		if (maxPixels <= 0.0f)
+		{
+			return 0;
+		}
+
+		// Meshes that are still streaming in are not drawn anyway
+		if (!mesh || mesh->GetLods().size() < 2)
+		{
+			return 0;
+		}
+
+		// LOD errors are in mesh space, the largest axis scale takes them to world space
+		const f32 scale = Game::GetMaxScale(world);
+		if (scale <= 0.0f)
+		{
+			return 0;
+		}
+
+		// Measured at the closest point of the bounding sphere, so no part of the mesh gets more error than allowed
+		const Asset::MeshBounds& bounds = mesh->GetBounds();
+		const Math::Vector3 center = Math::Vector3::Transform(Math::Vector3(bounds.Center.data()), world);
+		const f32 depth = std::max((center - camera.Position).Dot(camera.Forward) - bounds.Radius * scale, camera.NearPlane);
+
+		// Pixels per world unit at that depth. _34 is 1 for perspective and 0 for orthographic projections
+		const Math::Matrix& projection = camera.ProjectionMatrix;
+		const f32 w = projection._34 * depth + projection._44;
+		const f32 pixelsPerUnit = projection._22 * camera.Viewport.height * 0.5f / w;
+
+		const f32 maxError = maxPixels / (pixelsPerUnit * scale);
+		return static_cast<u8>(Asset::SelectLod(mesh->GetLods(), maxError));
 	}
 
 	u64 RenderFrameBuilder::ComputeSortKey(const RenderItem& item)
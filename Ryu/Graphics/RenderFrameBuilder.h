@@ -1,41 +1,57 @@
 #pragma once
 #include "Graphics/RenderData.h"
+#include <span>
 
 namespace Ryu::Game
 {
 	class World;
 	struct CameraComponent;
-	struct Transform;
+	struct WorldMatrix;
 	struct MeshRenderer;
 }
 namespace Ryu::Asset { class AssetRegistry; }
+namespace Ryu::MT { class JobSystem; }
 namespace Ryu::Utils { class FrameTimer; }
 
 namespace Ryu::Gfx
 {
 	class Device;
+	class Mesh;
 
 	// Lightweight builder class that traverses the world and builds a render frame that can be consumed by the WorldRenderer
 	class RenderFrameBuilder
 	{
 	public:
-		RenderFrameBuilder(Asset::AssetRegistry* registry, Device* device)
-			: m_assetRegistry(registry), m_device(device) {}
+		// Everything in the returned frame is allocated from frameResource, it has to outlive the frame.
+		// frameResource has to take allocations from several threads when a job system is given
+		RenderFrameBuilder(Asset::AssetRegistry* registry, Device* device,
+			std::pmr::memory_resource* frameResource = std::pmr::get_default_resource(), MT::JobSystem* jobSystem = nullptr)
+			: m_assetRegistry(registry), m_device(device), m_frameResource(frameResource), m_jobSystem(jobSystem) {}
 
 		[[nodiscard]] RenderFrame ExtractRenderData(Game::World& world, const Utils::FrameTimer& timer);
 		[[nodiscard]] RenderView ExtractViewForCamera(Game::World& world, const CameraData& cameraData);
 
+		// One view per camera with its visible renderables, sorted. World matrices have to be up to date.
+		// With a job system the entities are split into chunks and every view's chunks run in parallel
+		[[nodiscard]] std::pmr::vector<RenderView> ExtractViews(Game::World& world, std::span<const CameraData> cameras);
+
 	private:
-		void CollectRenderables(Game::World& world,u32 cullingMask,
-			std::vector<RenderItem>& opaqueOut, std::vector<RenderItem>& transparentOut);
+		// Gives mesh renderers whose mesh just loaded their LocalBounds, which puts them in the world's spatial index,
+		// and takes them away again while the mesh is invalidated. The only place meshes get loaded and uploaded
+		void SyncBounds(Game::World& world);
+
+		void CollectCameras(Game::World& world, std::pmr::vector<CameraData>& camerasOut);
+		CameraData ExtractCameraData(const Game::WorldMatrix& world, const Game::CameraComponent& camera);
+		RenderItem CreateRenderItem(const Game::WorldMatrix& world, const Game::MeshRenderer& renderer, const Mesh* mesh, const CameraData& camera);
 
-		void CollectCameras(Game::World& world, std::vector<CameraData>& camerasOut);
-		CameraData ExtractCameraData(const Game::Transform& transform, const Game::CameraComponent& camera);
-		RenderItem CreateRenderItem(const Game::Transform& transform, const Game::MeshRenderer& renderer);
+		// Coarsest LOD of the mesh whose error, projected for the camera, stays under the pixel budget
+		u8 SelectLod(const Mesh* mesh, const Math::Matrix& world, const CameraData& camera) const;
 		static u64 ComputeSortKey(const RenderItem& item);
 
 	private:
 		Device* m_device{ nullptr };
 		Asset::AssetRegistry* m_assetRegistry{ nullptr };
+		std::pmr::memory_resource* m_frameResource{ nullptr };
+		MT::JobSystem* m_jobSystem{ nullptr };
 	};
 }
@@ -8,6 +8,7 @@
 #include "Graphics/Core/GfxTexture.h"
 #include "Graphics/IRendererHook.h"
 #include "Graphics/RenderFrameBuilder.h"
+#include "Memory/New.h"
 
 namespace Ryu::Gfx
 {
@@ -46,8 +47,12 @@ namespace Ryu::Gfx
     void Renderer::RenderWorld(Game::World& world, const Utils::FrameTimer& frameTimer)
     {
         RYU_PROFILE_SCOPE();
+        Memory::ScopedAllocationTag tag(Memory::AllocationTag::Render);
 
-        RenderFrameBuilder builder(&m_assets, m_device.get());
+        // The previous frame is done with by now, its extraction data can be overwritten
+        m_frameArena.BeginFrame();
+        m_assets.AdvanceEpoch();
+        RenderFrameBuilder builder(&m_assets, m_device.get(), m_frameArena.GetResource(), m_jobSystem);
 
         const Gfx::RenderFrame frameData = builder.ExtractRenderData(world, frameTimer);
         m_worldRenderer.RenderFrame(frameData, &m_gpuFactory, m_hook);
@@ -11,6 +11,7 @@
 #include "Graphics/Mesh.h"
 #include "Graphics/WorldRenderer.h"
 #include "Graphics/Shader/ShaderLibrary.h"
+#include "Memory/FrameArena.h"
 
 namespace Ryu::Utils { class FrameTimer; }
 namespace Ryu::Game { class World; }
@@ -30,6 +31,9 @@ namespace Ryu::Gfx
 		[[nodiscard]] inline ShaderLibrary* GetShaderLibrary() { return &m_shaderLibrary; }
 		[[nodiscard]] inline WorldRenderer* GetWorldRenderer() { return &m_worldRenderer; }
 
+		// Frame extraction spreads over its workers when set
+		inline void SetJobSystem(MT::JobSystem* jobSystem) { m_jobSystem = jobSystem; }
+
 		void RenderWorld(Game::World& world, const Utils::FrameTimer& frameTimer);
 		void OnResize(u32 w, u32 h);
 			
@@ -40,5 +44,7 @@ namespace Ryu::Gfx
 		ShaderLibrary           m_shaderLibrary;
 		WorldRenderer           m_worldRenderer;
 		IRendererHook*          m_hook;
+		Memory::FrameArena      m_frameArena;  // Backs the extracted RenderFrame
+		MT::JobSystem*          m_jobSystem = nullptr;
 	};
 }
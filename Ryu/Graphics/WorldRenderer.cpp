@@ -30,6 +30,21 @@ namespace Ryu::Gfx
 			Math::Vector4 CameraPosition;  // xyz = position, w = unused
 			Math::Vector4 Time;            // x = delta, y = total, zw = unused
 		};
+
+		u32 GetLayoutIndex(const Asset::VertexLayout& layout)
+		{
+			return (static_cast<u32>(layout.Normal) * 2 + static_cast<u32>(layout.TexCoord)) * 3 + static_cast<u32>(layout.Color);
+		}
+
+		// Built from Mesh.hlsl, one per combination of the defines it reads
+		const char* GetVertexShaderName(const Asset::VertexLayout& layout)
+		{
+			const bool octahedral = layout.Normal == Asset::VertexLayout::NormalFormat::Octahedral16;
+			const bool noColor    = layout.Color == Asset::VertexLayout::ColorFormat::None;
+			return octahedral
+				? (noColor ? "MeshOctahedralNoColorVS" : "MeshOctahedralVS")
+				: (noColor ? "MeshNoColorVS" : "MeshVS");
+		}
 	}
 
 	WorldRenderer::WorldRenderer(Device* device, ShaderLibrary* shaderLib, Asset::AssetRegistry* registry, const Config& config)
@@ -186,20 +201,54 @@ namespace Ryu::Gfx
 
 		RYU_TODO("Load shaders from a configurable source instead of hardcoding")
 		Shader* vs = m_shaderLib->GetShader("MeshVS");
+		RYU_ASSERT(vs && vs->IsValid(), "Failed to get valid vertex shader!");
+
+		// Every mesh shader variant is built with the same root signature
+		m_rootSignature = std::make_unique<RootSignature>(m_device, vs->GetRootSignature(), "Root Signature");
+
+		// Pipelines for other layouts are made again when a mesh in that layout next draws
+		for (std::unique_ptr<PipelineState>& pipeline : m_opaquePipelines)
+		{
+			pipeline.reset();
+		}
+		GetOpaquePipeline(Asset::VertexLayout{});
+	}
+
+	PipelineState* WorldRenderer::GetOpaquePipeline(const Asset::VertexLayout& layout)
+	{
+		std::unique_ptr<PipelineState>& pipeline = m_opaquePipelines[GetLayoutIndex(layout)];
+		if (!pipeline)
+		{
+			pipeline = CreateOpaquePipeline(layout);
+		}
+		return pipeline.get();
+	}
+
+	std::unique_ptr<PipelineState> WorldRenderer::CreateOpaquePipeline(const Asset::VertexLayout& layout) const
+	{
+		RYU_PROFILE_SCOPE();
+
+		using Layout = Asset::VertexLayout;
+
+		Shader* vs = m_shaderLib->GetShader(GetVertexShaderName(layout));
 		Shader* ps = m_shaderLib->GetShader("MeshPS");
 
 		RYU_ASSERT(vs && vs->IsValid(), "Failed to get valid vertex shader!");
 		RYU_ASSERT(ps && ps->IsValid(), "Failed to get valid pixel shader!");
 
-		m_rootSignature = std::make_unique<RootSignature>(m_device, vs->GetRootSignature(), "Root Signature");
+		// The input assembler unpacks snorm, half and unorm attributes to floats, only octahedral normals need the shader
+		const DXGI_FORMAT normalFormat   = layout.Normal == Layout::NormalFormat::Float3 ? DXGI_FORMAT_R32G32B32_FLOAT : DXGI_FORMAT_R16G16_SNORM;
+		const DXGI_FORMAT texCoordFormat = layout.TexCoord == Layout::TexCoordFormat::Float2 ? DXGI_FORMAT_R32G32_FLOAT : DXGI_FORMAT_R16G16_FLOAT;
+		const DXGI_FORMAT colorFormat    = layout.Color == Layout::ColorFormat::Float4 ? DXGI_FORMAT_R32G32B32A32_FLOAT : DXGI_FORMAT_R8G8B8A8_UNORM;
 
 		const D3D12_INPUT_ELEMENT_DESC inputElementDescs[] =
 		{
-			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0,                       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+			{ "NORMAL",   0, normalFormat,                0, layout.NormalOffset(),   D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+			{ "TEXCOORD", 0, texCoordFormat,              0, layout.TexCoordOffset(), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+			{ "COLOR",    0, colorFormat,                 0, layout.ColorOffset(),    D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
 		};
+		const u32 inputElementCount = static_cast<u32>(std::size(inputElementDescs)) - (layout.Color == Layout::ColorFormat::None ? 1 : 0);
 
 		Shader::Blob* const vsBlob = vs->GetBlob();
 		Shader::Blob* const psBlob = ps->GetBlob();
@@ -218,7 +267,7 @@ namespace Ryu::Gfx
 
 		PipelineStateStream psoStream{};
 		psoStream.RootSignature     = m_rootSignature->GetNative();
-		psoStream.InputLayout       = { inputElementDescs, static_cast<u32>(std::size(inputElementDescs)) };
+		psoStream.InputLayout       = { inputElementDescs, inputElementCount };
 		psoStream.PrimitiveTopology = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
 		psoStream.VS                = CD3DX12_SHADER_BYTECODE(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize());
 		psoStream.PS                = CD3DX12_SHADER_BYTECODE(psBlob->GetBufferPointer(), psBlob->GetBufferSize());
@@ -236,7 +285,7 @@ namespace Ryu::Gfx
 			.pPipelineStateSubobjectStream = &psoStream
 		};
 
-		m_opaquePipeline = std::make_unique<PipelineState>(m_device, psoStreamDesc, "Opaque Pipeline State");
+		return std::make_unique<PipelineState>(m_device, psoStreamDesc, "Opaque Pipeline State");
 	}
 
 	void WorldRenderer::BeginFrame()
@@ -248,7 +297,7 @@ namespace Ryu::Gfx
 		CommandList* cmdList = m_device->GetGraphicsCommandList();
 		const Texture* renderTarget = m_device->GetCurrentBackBuffer();
 
-		m_device->BeginFrame(m_opaquePipeline.get());
+		m_device->BeginFrame(GetOpaquePipeline(Asset::VertexLayout{}));
 
 		cmdList->SetGraphicsRootSignature(*m_rootSignature);
 		cmdList->SetDescriptorHeap(*m_cbvHeap);
@@ -283,12 +332,26 @@ namespace Ryu::Gfx
 		RYU_PROFILE_SCOPE();
 
 		CommandList* cmdList = m_device->GetGraphicsCommandList();
-		// TODO: Improve pipeline state management - currently set during BeginFrame
-		cmdList->GetNative()->SetPipelineState(*m_opaquePipeline);
+		Asset::VertexLayout boundLayout{};
+		cmdList->GetNative()->SetPipelineState(*GetOpaquePipeline(boundLayout));
 
 		for (const auto& item : view.OpaqueItems)
 		{
-			DrawRenderItem(item, view.CameraData);
+			// Skipped until its data has streamed in, the draw loop never waits on a load
+			Mesh* mesh = m_assetRegistry->Meshes().TryGetGpu(item.MeshHandle);
+			if (!mesh)
+			{
+				continue;
+			}
+
+			// Only switched when the layout differs from the last item's
+			if (mesh->GetVertexLayout() != boundLayout)
+			{
+				boundLayout = mesh->GetVertexLayout();
+				cmdList->GetNative()->SetPipelineState(*GetOpaquePipeline(boundLayout));
+			}
+
+			DrawRenderItem(item, *mesh, view.CameraData);
 		}
 	}
 
@@ -306,7 +369,10 @@ namespace Ryu::Gfx
 
 		for (const auto& item : view.TransparentItems)
 		{
-			DrawRenderItem(item, view.CameraData);
+			if (Mesh* mesh = m_assetRegistry->Meshes().TryGetGpu(item.MeshHandle))
+			{
+				DrawRenderItem(item, *mesh, view.CameraData);
+			}
 		}
 	}
 
@@ -331,16 +397,10 @@ namespace Ryu::Gfx
 		cmdList->SetGraphicsConstantBuffer(0, *frameCB);
 	}
 
-	void WorldRenderer::DrawRenderItem(const RenderItem& item, const CameraData& camera)
+	void WorldRenderer::DrawRenderItem(const RenderItem& item, Mesh& mesh, const CameraData& camera)
 	{
 		RYU_PROFILE_SCOPE();
 
-		Mesh* mesh = m_assetRegistry->Meshes().GetGpu(item.MeshHandle);
-		if (!mesh)
-		{
-			return;
-		}
-
 		ObjectConstants objData
 		{
 			.World               = item.WorldTransform.Transpose(),
@@ -353,15 +413,15 @@ namespace Ryu::Gfx
 		CommandList* cmdList = m_device->GetGraphicsCommandList();
 		cmdList->SetGraphicsConstantBuffer(1, *objCB);
 
-		mesh->SetPipelineBuffers(*cmdList, 0);
+		mesh.SetPipelineBuffers(*cmdList, 0);
 
-		if (mesh->HasIndexBuffer())
+		if (mesh.HasIndexBuffer())
 		{
-			cmdList->DrawMeshIndexedInstanced(*mesh);
+			cmdList->DrawMeshIndexedInstanced(mesh, item.Lod);
 		}
 		else
 		{
-			cmdList->DrawMeshInstanced(*mesh);
+			cmdList->DrawMeshInstanced(mesh);
 		}
 	}
 
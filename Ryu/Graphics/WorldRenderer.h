@@ -10,6 +10,7 @@ namespace Ryu::Asset { class AssetRegistry; class IGpuResourceFactory; }
 namespace Ryu::Gfx
 {
 	class Device;
+	class Mesh;
 	class ShaderLibrary;
 	class IRendererHook;
 
@@ -45,6 +46,8 @@ namespace Ryu::Gfx
 	private:
 		void CreateResources();
 		void CreatePipelineState();
+		std::unique_ptr<PipelineState> CreateOpaquePipeline(const Asset::VertexLayout& layout) const;
+		PipelineState* GetOpaquePipeline(const Asset::VertexLayout& layout);
 		void InitializeDefaultCamera();
 		void UpdateDefaultCameraProjection();
 
@@ -55,7 +58,10 @@ namespace Ryu::Gfx
 		void RenderTransparentPass(const Gfx::RenderView& view);
 
 		void BindPerFrameData(const CameraData& camera, f32 deltaTime, f32 totalTime);
-		void DrawRenderItem(const RenderItem& item, const CameraData& camera);
+		void DrawRenderItem(const RenderItem& item, Mesh& mesh, const CameraData& camera);
+
+	private:
+		static constexpr u32 VERTEX_LAYOUT_COUNT = 2 * 2 * 3;  // Every combination of Asset::VertexLayout formats
 
 	private:
 		Device*                         m_device        = nullptr;
@@ -64,7 +70,7 @@ namespace Ryu::Gfx
 		Config                          m_config{};
 
 		std::unique_ptr<RootSignature>  m_rootSignature;
-		std::unique_ptr<PipelineState>  m_opaquePipeline;
+		std::array<std::unique_ptr<PipelineState>, VERTEX_LAYOUT_COUNT> m_opaquePipelines;  // One per vertex layout, made on first use
 		std::unique_ptr<PipelineState>  m_transparentPipeline;
 		std::unique_ptr<DescriptorHeap> m_cbvHeap;
 		ConstantBufferPool              m_cbPool;
@@ -0,0 +1,57 @@
+#include "Math/Aabb.h"
+
+namespace Ryu::Math
+{
+	Aabb TransformAabb(const Aabb& aabb, const Matrix& world)
+	{
+		const Vector3 center  = Vector3::Transform(aabb.GetCenter(), world);
+		const Vector3 extents = aabb.GetExtents();
+
+		// Row i of the matrix is where local axis i ends up, each world axis collects every row's reach along it
+		const Vector3 worldExtents
+		{
+			std::abs(world._11) * extents.x + std::abs(world._21) * extents.y + std::abs(world._31) * extents.z,
+			std::abs(world._12) * extents.x + std::abs(world._22) * extents.y + std::abs(world._32) * extents.z,
+			std::abs(world._13) * extents.x + std::abs(world._23) * extents.y + std::abs(world._33) * extents.z,
+		};
+		return Aabb::FromCenterExtents(center, worldExtents);
+	}
+
+	bool Intersects(const Aabb& aabb, const Vector3& center, f32 radius)
+	{
+		const Vector3 closest = Vector3::Clamp(center, aabb.Min, aabb.Max);
+		return Vector3::DistanceSquared(center, closest) <= radius * radius;
+	}
+
+	bool IntersectRay(const Aabb& aabb, const Vector3& origin, const Vector3& inverseDirection, f32 maxDistance, f32& distanceOut)
+	{
+		f32 enter = 0.0f;
+		f32 exit  = maxDistance;
+
+		const f32 origins[3]  = { origin.x, origin.y, origin.z };
+		const f32 inverses[3] = { inverseDirection.x, inverseDirection.y, inverseDirection.z };
+		const f32 mins[3]     = { aabb.Min.x, aabb.Min.y, aabb.Min.z };
+		const f32 maxs[3]     = { aabb.Max.x, aabb.Max.y, aabb.Max.z };
+
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			f32 slabEnter = (mins[axis] - origins[axis]) * inverses[axis];
+			f32 slabExit  = (maxs[axis] - origins[axis]) * inverses[axis];
+			if (slabEnter > slabExit)
+			{
+				std::swap(slabEnter, slabExit);
+			}
+
+			// NaN from 0 * inf (origin on a slab of a parallel ray) fails these and leaves the range alone
+			enter = slabEnter > enter ? slabEnter : enter;
+			exit  = slabExit < exit ? slabExit : exit;
+			if (enter > exit)
+			{
+				return false;
+			}
+		}
+
+		distanceOut = enter;
+		return true;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Math/Math.h"
+
+namespace Ryu::Math
+{
+	// Axis aligned box
+	struct Aabb
+	{
+		Vector3 Min;
+		Vector3 Max;
+
+		[[nodiscard]] inline Vector3 GetCenter() const  { return (Min + Max) * 0.5f; }
+		[[nodiscard]] inline Vector3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		// What the tree balances on, the chance of a random ray or box hitting it goes with the area
+		[[nodiscard]] inline f32 GetSurfaceArea() const
+		{
+			const Vector3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		[[nodiscard]] inline bool Contains(const Aabb& other) const
+		{
+			return Min.x <= other.Min.x && Min.y <= other.Min.y && Min.z <= other.Min.z
+				&& other.Max.x <= Max.x && other.Max.y <= Max.y && other.Max.z <= Max.z;
+		}
+
+		[[nodiscard]] inline bool Overlaps(const Aabb& other) const
+		{
+			return Min.x <= other.Max.x && Min.y <= other.Max.y && Min.z <= other.Max.z
+				&& other.Min.x <= Max.x && other.Min.y <= Max.y && other.Min.z <= Max.z;
+		}
+
+		[[nodiscard]] static inline Aabb Union(const Aabb& a, const Aabb& b)
+		{
+			return Aabb{ Vector3::Min(a.Min, b.Min), Vector3::Max(a.Max, b.Max) };
+		}
+
+		[[nodiscard]] static inline Aabb FromCenterExtents(const Vector3& center, const Vector3& extents)
+		{
+			return Aabb{ center - extents, center + extents };
+		}
+	};
+
+	// Smallest box holding the box moved by a row vector world matrix
+	RYU_API Aabb TransformAabb(const Aabb& aabb, const Matrix& world);
+
+	RYU_API bool Intersects(const Aabb& aabb, const Vector3& center, f32 radius);
+
+	// Slab test. inverseDirection is 1 / direction per axis, infinities are fine.
+	// On a hit distanceOut is where the ray enters the box, 0 if it starts inside
+	RYU_API bool IntersectRay(const Aabb& aabb, const Vector3& origin, const Vector3& inverseDirection, f32 maxDistance, f32& distanceOut);
+}
@@ -0,0 +1,342 @@
+#include "Math/AabbTree.h"
+
+namespace Ryu::Math
+{
+	u32 AabbTree::CreateProxy(const Aabb& aabb, u64 userData)
+	{
+		const Vector3 margin(m_margin);
+
+		const u32 proxy = AllocateNode();
+		Node& node = m_nodes[proxy];
+		node.Box      = Aabb{ aabb.Min - margin, aabb.Max + margin };
+		node.UserData = userData;
+		node.Height   = 0;
+
+		InsertLeaf(proxy);
+		++m_proxyCount;
+		return proxy;
+	}
+
+	void AabbTree::DestroyProxy(u32 proxy)
+	{
+		RYU_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf() && m_nodes[proxy].Height == 0, "Not a proxy");
+
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		--m_proxyCount;
+	}
+
+	bool AabbTree::MoveProxy(u32 proxy, const Aabb& aabb)
+	{
+		RYU_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf() && m_nodes[proxy].Height == 0, "Not a proxy");
+
+		const Vector3 margin(m_margin);
+		const Aabb& fatBox = m_nodes[proxy].Box;
+		if (fatBox.Contains(aabb))
+		{
+			// Unless the fat box is now much bigger than the box, like after it shrank, it would only add to every query
+			const Vector3 slack = margin * 4.0f;
+			if (Aabb{ aabb.Min - slack, aabb.Max + slack }.Contains(fatBox))
+			{
+				return false;
+			}
+		}
+
+		RemoveLeaf(proxy);
+		m_nodes[proxy].Box = Aabb{ aabb.Min - margin, aabb.Max + margin };
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	void AabbTree::Clear()
+	{
+		m_nodes.clear();
+		m_root       = NULL_NODE;
+		m_freeList   = NULL_NODE;
+		m_proxyCount = 0;
+	}
+
+	bool AabbTree::Validate() const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return m_proxyCount == 0;
+		}
+
+		if (m_nodes[m_root].Parent != NULL_NODE)
+		{
+			return false;
+		}
+
+		u32 leaves = 0;
+		std::vector<u32> stack{ m_root };
+		while (!stack.empty())
+		{
+			const u32 index = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_nodes[index];
+			if (node.IsLeaf())
+			{
+				++leaves;
+				if (node.Child2 != NULL_NODE || node.Height != 0)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const Node& child1 = m_nodes[node.Child1];
+			const Node& child2 = m_nodes[node.Child2];
+			if (child1.Parent != index || child2.Parent != index
+				|| node.Height != 1 + std::max(child1.Height, child2.Height)
+				|| !node.Box.Contains(child1.Box) || !node.Box.Contains(child2.Box))
+			{
+				return false;
+			}
+
+			stack.push_back(node.Child1);
+			stack.push_back(node.Child2);
+		}
+
+		return leaves == m_proxyCount;
+	}
+
+	u32 AabbTree::AllocateNode()
+	{
+		if (m_freeList == NULL_NODE)
+		{
+			m_nodes.emplace_back();
+			return static_cast<u32>(m_nodes.size() - 1);
+		}
+
+		const u32 index = m_freeList;
+		m_freeList = m_nodes[index].Parent;
+		m_nodes[index] = Node{};
+		return index;
+	}
+
+	void AabbTree::FreeNode(u32 node)
+	{
+		m_nodes[node].Parent = m_freeList;
+		m_nodes[node].Height = -1;
+		m_freeList = node;
+	}
+
+	void AabbTree::InsertLeaf(u32 leaf)
+	{
+		if (m_root == NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].Parent = NULL_NODE;
+			return;
+		}
+
+		// Walk down to the best sibling. Pairing with a node costs the area of the new parent, and every node
+		// above it grows to hold the leaf as well. Stop once going further down can't beat pairing here
+		const Aabb leafBox = m_nodes[leaf].Box;
+		u32 index = m_root;
+		while (!m_nodes[index].IsLeaf())
+		{
+			const Node& node = m_nodes[index];
+			const f32 area         = node.Box.GetSurfaceArea();
+			const f32 combinedArea = Aabb::Union(node.Box, leafBox).GetSurfaceArea();
+
+			const f32 cost        = 2.0f * combinedArea;
+			const f32 inheritance = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](u32 childIndex)
+			{
+				const Node& child = m_nodes[childIndex];
+				const f32 unionArea = Aabb::Union(child.Box, leafBox).GetSurfaceArea();
+				return (child.IsLeaf() ? unionArea : unionArea - child.Box.GetSurfaceArea()) + inheritance;
+			};
+
+			const f32 cost1 = descendCost(node.Child1);
+			const f32 cost2 = descendCost(node.Child2);
+			if (cost < cost1 && cost < cost2)
+			{
+				break;
+			}
+
+			index = cost1 < cost2 ? node.Child1 : node.Child2;
+		}
+
+		const u32 sibling   = index;
+		const u32 oldParent = m_nodes[sibling].Parent;
+		const u32 newParent = AllocateNode();  // Can move m_nodes, no references held across it
+
+		Node& parent = m_nodes[newParent];
+		parent.Parent = oldParent;
+		parent.Box    = Aabb::Union(leafBox, m_nodes[sibling].Box);
+		parent.Height = m_nodes[sibling].Height + 1;
+		parent.Child1 = sibling;
+		parent.Child2 = leaf;
+
+		if (oldParent != NULL_NODE)
+		{
+			ReplaceChild(oldParent, sibling, newParent);
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		m_nodes[sibling].Parent = newParent;
+		m_nodes[leaf].Parent    = newParent;
+
+		Refit(newParent);
+	}
+
+	void AabbTree::RemoveLeaf(u32 leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		// The sibling takes the parent's place
+		const u32 parent      = m_nodes[leaf].Parent;
+		const u32 grandParent = m_nodes[parent].Parent;
+		const u32 sibling     = m_nodes[parent].Child1 == leaf ? m_nodes[parent].Child2 : m_nodes[parent].Child1;
+
+		m_nodes[sibling].Parent = grandParent;
+		if (grandParent != NULL_NODE)
+		{
+			ReplaceChild(grandParent, parent, sibling);
+		}
+		else
+		{
+			m_root = sibling;
+		}
+
+		FreeNode(parent);
+		m_nodes[leaf].Parent = NULL_NODE;
+		Refit(grandParent);
+	}
+
+	void AabbTree::ReplaceChild(u32 parent, u32 oldChild, u32 newChild)
+	{
+		Node& node = m_nodes[parent];
+		if (node.Child1 == oldChild)
+		{
+			node.Child1 = newChild;
+		}
+		else
+		{
+			node.Child2 = newChild;
+		}
+	}
+
+	void AabbTree::Refit(u32 index)
+	{
+		while (index != NULL_NODE)
+		{
+			index = Balance(index);
+
+			Node& node = m_nodes[index];
+			const Node& child1 = m_nodes[node.Child1];
+			const Node& child2 = m_nodes[node.Child2];
+			node.Height = 1 + std::max(child1.Height, child2.Height);
+			node.Box    = Aabb::Union(child1.Box, child2.Box);
+
+			index = node.Parent;
+		}
+	}
+
+	u32 AabbTree::Balance(u32 indexA)
+	{
+		// A rotation moves the taller child up into A's place, A takes its shorter child
+		Node& a = m_nodes[indexA];
+		if (a.IsLeaf() || a.Height < 2)
+		{
+			return indexA;
+		}
+
+		const u32 indexB = a.Child1;
+		const u32 indexC = a.Child2;
+		Node& b = m_nodes[indexB];
+		Node& c = m_nodes[indexC];
+
+		const i32 balance = c.Height - b.Height;
+		if (balance > 1)
+		{
+			// C goes up
+			const u32 indexF = c.Child1;
+			const u32 indexG = c.Child2;
+			Node& f = m_nodes[indexF];
+			Node& g = m_nodes[indexG];
+
+			c.Child1 = indexA;
+			c.Parent = a.Parent;
+			a.Parent = indexC;
+
+			if (c.Parent != NULL_NODE)
+			{
+				ReplaceChild(c.Parent, indexA, indexC);
+			}
+			else
+			{
+				m_root = indexC;
+			}
+
+			// The taller of C's children stays with C
+			const bool keepF  = f.Height > g.Height;
+			const u32 indexUp = keepF ? indexF : indexG;
+			const u32 indexDown = keepF ? indexG : indexF;
+			Node& up   = m_nodes[indexUp];
+			Node& down = m_nodes[indexDown];
+
+			c.Child2    = indexUp;
+			a.Child2    = indexDown;
+			down.Parent = indexA;
+
+			a.Box    = Aabb::Union(b.Box, down.Box);
+			c.Box    = Aabb::Union(a.Box, up.Box);
+			a.Height = 1 + std::max(b.Height, down.Height);
+			c.Height = 1 + std::max(a.Height, up.Height);
+			return indexC;
+		}
+
+		if (balance < -1)
+		{
+			// B goes up
+			const u32 indexD = b.Child1;
+			const u32 indexE = b.Child2;
+			Node& d = m_nodes[indexD];
+			Node& e = m_nodes[indexE];
+
+			b.Child1 = indexA;
+			b.Parent = a.Parent;
+			a.Parent = indexB;
+
+			if (b.Parent != NULL_NODE)
+			{
+				ReplaceChild(b.Parent, indexA, indexB);
+			}
+			else
+			{
+				m_root = indexB;
+			}
+
+			const bool keepD    = d.Height > e.Height;
+			const u32 indexUp   = keepD ? indexD : indexE;
+			const u32 indexDown = keepD ? indexE : indexD;
+			Node& up   = m_nodes[indexUp];
+			Node& down = m_nodes[indexDown];
+
+			b.Child2    = indexUp;
+			a.Child1    = indexDown;
+			down.Parent = indexA;
+
+			a.Box    = Aabb::Union(c.Box, down.Box);
+			b.Box    = Aabb::Union(a.Box, up.Box);
+			a.Height = 1 + std::max(c.Height, down.Height);
+			b.Height = 1 + std::max(a.Height, up.Height);
+			return indexB;
+		}
+
+		return indexA;
+	}
+}
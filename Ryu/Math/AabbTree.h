@@ -0,0 +1,227 @@
+#pragma once
+#include "Math/Frustum.h"
+
+namespace Ryu::Math
+{
+	// Dynamic bounding volume tree over fattened boxes, the same structure as Box2D's b2DynamicTree and Bullet's DBVT.
+	// Leaves go where they add the least surface area and rotations keep the tree balanced. Each box carries a margin,
+	// objects moving around inside it are not reinserted
+	class AabbTree
+	{
+	public:
+		static constexpr u32 NULL_NODE = ~0u;
+
+	public:
+		explicit AabbTree(f32 margin = 0.1f) : m_margin(margin) {}
+
+		// The returned proxy stays valid until it is destroyed
+		u32 CreateProxy(const Aabb& aabb, u64 userData);
+		void DestroyProxy(u32 proxy);
+
+		// Returns true if the box left the fat box and the proxy got reinserted
+		bool MoveProxy(u32 proxy, const Aabb& aabb);
+
+		void Clear();
+
+		[[nodiscard]] inline u64 GetUserData(u32 proxy) const      { return m_nodes[proxy].UserData; }
+		[[nodiscard]] inline const Aabb& GetFatAabb(u32 proxy) const { return m_nodes[proxy].Box;      }
+		[[nodiscard]] inline u32 GetProxyCount() const               { return m_proxyCount;            }
+		[[nodiscard]] inline u32 GetHeight() const                   { return m_root != NULL_NODE ? static_cast<u32>(m_nodes[m_root].Height) : 0; }
+
+		// Walks the whole tree checking links, heights and that parents hold their children
+		[[nodiscard]] bool Validate() const;
+
+		// The queries call callback(userData) for every proxy whose fat box passes the test
+		template <typename Callback> void Query(const Aabb& aabb, Callback&& callback) const;
+		template <typename Callback> void Query(const Vector3& center, f32 radius, Callback&& callback) const;
+		template <typename Callback> void Query(const Frustum& frustum, Callback&& callback) const;
+
+		// Calls callback(userData, distance) for the fat boxes the ray enters before maxDistance, in no particular order.
+		// Distances are in multiples of direction. The callback returns the distance to keep looking up to:
+		// its hit distance to only get closer ones, maxDistance to get everything, or a negative value to stop
+		template <typename Callback> void RayCast(const Vector3& origin, const Vector3& direction, f32 maxDistance, Callback&& callback) const;
+
+	private:
+		struct Node
+		{
+			Aabb Box;
+			u64  UserData = 0;
+			u32  Parent   = NULL_NODE;  // Next free node while on the free list
+			u32  Child1   = NULL_NODE;
+			u32  Child2   = NULL_NODE;
+			i32  Height   = -1;         // 0 for leaves, -1 while free
+
+			[[nodiscard]] inline bool IsLeaf() const { return Child1 == NULL_NODE; }
+		};
+
+		// Balanced trees stay around 1.5 log2(n) deep, the fixed part covers millions of proxies
+		template <typename T>
+		class Stack
+		{
+		public:
+			inline void Push(const T& value)
+			{
+				if (m_size < m_fixed.size()) { m_fixed[m_size] = value; }
+				else                         { m_overflow.push_back(value); }
+				++m_size;
+			}
+
+			inline T Pop()
+			{
+				--m_size;
+				if (m_size < m_fixed.size())
+				{
+					return m_fixed[m_size];
+				}
+
+				const T value = m_overflow.back();
+				m_overflow.pop_back();
+				return value;
+			}
+
+			[[nodiscard]] inline bool IsEmpty() const { return m_size == 0; }
+
+		private:
+			std::array<T, 64> m_fixed;
+			std::vector<T>    m_overflow;
+			u64               m_size = 0;
+		};
+
+		template <typename Test, typename Callback>
+		void Traverse(Test&& test, Callback&& callback) const;
+
+		u32 AllocateNode();
+		void FreeNode(u32 node);
+		void InsertLeaf(u32 leaf);
+		void RemoveLeaf(u32 leaf);
+		void ReplaceChild(u32 parent, u32 oldChild, u32 newChild);
+		void Refit(u32 node);  // Recomputes heights and boxes from node up to the root, balancing on the way
+		u32 Balance(u32 node);
+
+	private:
+		std::vector<Node> m_nodes;
+		u32               m_root       = NULL_NODE;
+		u32               m_freeList   = NULL_NODE;
+		u32               m_proxyCount = 0;
+		f32               m_margin;
+	};
+
+	template <typename Test, typename Callback>
+	void AabbTree::Traverse(Test&& test, Callback&& callback) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		Stack<u32> stack;
+		stack.Push(m_root);
+		while (!stack.IsEmpty())
+		{
+			const Node& node = m_nodes[stack.Pop()];
+			if (!test(node.Box))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				callback(node.UserData);
+			}
+			else
+			{
+				stack.Push(node.Child1);
+				stack.Push(node.Child2);
+			}
+		}
+	}
+
+	template <typename Callback>
+	void AabbTree::Query(const Aabb& aabb, Callback&& callback) const
+	{
+		Traverse([&aabb](const Aabb& box) { return box.Overlaps(aabb); }, callback);
+	}
+
+	template <typename Callback>
+	void AabbTree::Query(const Vector3& center, f32 radius, Callback&& callback) const
+	{
+		Traverse([&center, radius](const Aabb& box) { return Intersects(box, center, radius); }, callback);
+	}
+
+	template <typename Callback>
+	void AabbTree::Query(const Frustum& frustum, Callback&& callback) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		// Once a node is inside every plane so is everything below it, those skip the tests
+		Stack<std::pair<u32, bool>> stack;
+		stack.Push({ m_root, false });
+		while (!stack.IsEmpty())
+		{
+			auto [index, inside] = stack.Pop();
+			const Node& node = m_nodes[index];
+			if (!inside)
+			{
+				const FrustumTest test = Classify(frustum, node.Box);
+				if (test == FrustumTest::Outside)
+				{
+					continue;
+				}
+				inside = test == FrustumTest::Inside;
+			}
+
+			if (node.IsLeaf())
+			{
+				callback(node.UserData);
+			}
+			else
+			{
+				stack.Push({ node.Child1, inside });
+				stack.Push({ node.Child2, inside });
+			}
+		}
+	}
+
+	template <typename Callback>
+	void AabbTree::RayCast(const Vector3& origin, const Vector3& direction, f32 maxDistance, Callback&& callback) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		// Zero components turn into infinities, which the slab test handles
+		const Vector3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+		Stack<u32> stack;
+		stack.Push(m_root);
+		while (!stack.IsEmpty())
+		{
+			const Node& node = m_nodes[stack.Pop()];
+
+			f32 distance = 0.0f;
+			if (!IntersectRay(node.Box, origin, inverseDirection, maxDistance, distance))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				const f32 clip = callback(node.UserData, distance);
+				if (clip < 0.0f)
+				{
+					return;
+				}
+				maxDistance = std::min(maxDistance, clip);
+			}
+			else
+			{
+				stack.Push(node.Child1);
+				stack.Push(node.Child2);
+			}
+		}
+	}
+}
@@ -0,0 +1,117 @@
+#include "Math/Frustum.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace Ryu::Math
+{
+	Frustum ExtractFrustum(const Matrix& m)
+	{
+		// Clip space tests against the matrix columns: -w <= x <= w, -w <= y <= w, 0 <= z <= w
+		Frustum frustum
+		{
+			.Planes =
+			{
+				Plane(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41),
+				Plane(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41),
+				Plane(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42),
+				Plane(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42),
+				Plane(m._13,         m._23,         m._33,         m._43),
+				Plane(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43),
+			}
+		};
+
+		// Unit normals, so the plane distance can be compared against a radius
+		for (Plane& plane : frustum.Planes)
+		{
+			plane.Normalize();
+		}
+		return frustum;
+	}
+
+	bool Intersects(const Frustum& frustum, const Vector3& center, f32 radius)
+	{
+		// Summed in the same order as CullSpheres, both give the same answer for spheres touching a plane
+		for (const Plane& plane : frustum.Planes)
+		{
+			if (center.x * plane.x + plane.w + center.y * plane.y + center.z * plane.z < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FrustumTest Classify(const Frustum& frustum, const Aabb& aabb)
+	{
+		const Vector3 center  = aabb.GetCenter();
+		const Vector3 extents = aabb.GetExtents();
+
+		FrustumTest result = FrustumTest::Inside;
+		for (const Plane& plane : frustum.Planes)
+		{
+			// Distance of the center and how far the box reaches towards the plane
+			const f32 distance = center.x * plane.x + plane.w + center.y * plane.y + center.z * plane.z;
+			const f32 reach    = extents.x * std::abs(plane.x) + extents.y * std::abs(plane.y) + extents.z * std::abs(plane.z);
+			if (distance + reach < 0.0f)
+			{
+				return FrustumTest::Outside;
+			}
+
+			if (distance - reach < 0.0f)
+			{
+				result = FrustumTest::Intersects;
+			}
+		}
+		return result;
+	}
+
+	u64 CullSpheres(const Frustum& frustum, const SphereStreams& spheres, u8* visibleOut, u64 count)
+	{
+		std::array<__m128, 6> planeX, planeY, planeZ, planeW;
+		for (u32 p = 0; p < 6; ++p)
+		{
+			planeX[p] = _mm_set1_ps(frustum.Planes[p].x);
+			planeY[p] = _mm_set1_ps(frustum.Planes[p].y);
+			planeZ[p] = _mm_set1_ps(frustum.Planes[p].z);
+			planeW[p] = _mm_set1_ps(frustum.Planes[p].w);
+		}
+
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+
+		u64 visible = 0;
+		u64 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 x         = _mm_loadu_ps(spheres.Center[0] + i);
+			const __m128 y         = _mm_loadu_ps(spheres.Center[1] + i);
+			const __m128 z         = _mm_loadu_ps(spheres.Center[2] + i);
+			const __m128 negRadius = _mm_xor_ps(_mm_loadu_ps(spheres.Radius + i), signBit);
+
+			// Every plane has to pass, no early out, the branch would cost more than the remaining planes
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (u32 p = 0; p < 6; ++p)
+			{
+				__m128 distance = _mm_add_ps(_mm_mul_ps(x, planeX[p]), planeW[p]);
+				distance = _mm_add_ps(_mm_mul_ps(y, planeY[p]), distance);
+				distance = _mm_add_ps(_mm_mul_ps(z, planeZ[p]), distance);
+				inside   = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+			}
+
+			const u32 mask = static_cast<u32>(_mm_movemask_ps(inside));
+			visibleOut[i + 0] = (mask >> 0) & 1;
+			visibleOut[i + 1] = (mask >> 1) & 1;
+			visibleOut[i + 2] = (mask >> 2) & 1;
+			visibleOut[i + 3] = (mask >> 3) & 1;
+			visible += std::popcount(mask);
+		}
+
+		for (; i < count; ++i)
+		{
+			const Vector3 center(spheres.Center[0][i], spheres.Center[1][i], spheres.Center[2][i]);
+			visibleOut[i] = Intersects(frustum, center, spheres.Radius[i]) ? 1 : 0;
+			visible += visibleOut[i];
+		}
+
+		return visible;
+	}
+}
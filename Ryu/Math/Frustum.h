@@ -0,0 +1,39 @@
+#pragma once
+#include "Math/Aabb.h"
+
+namespace Ryu::Math
+{
+	// Six normalized planes facing into the frustum: left, right, bottom, top, near, far.
+	// A point p is inside a plane when Dot(plane normal, p) + plane.w >= 0
+	struct Frustum
+	{
+		std::array<Plane, 6> Planes;
+	};
+
+	enum class FrustumTest : u8
+	{
+		Outside,
+		Intersects,
+		Inside
+	};
+
+	// Spheres split into one stream per component, sphere i is element i of every stream
+	struct SphereStreams
+	{
+		std::array<const f32*, 3> Center;  // x, y, z
+		const f32* Radius;
+	};
+
+	// Planes of a row vector view projection matrix with a D3D [0, 1] depth range
+	RYU_API Frustum ExtractFrustum(const Matrix& viewProjection);
+
+	// Conservative, a sphere outside the frustum near one of its corners can still count as inside
+	RYU_API bool Intersects(const Frustum& frustum, const Vector3& center, f32 radius);
+
+	// Inside only if the whole box is, lets a tree skip the plane tests for everything below a node
+	RYU_API FrustumTest Classify(const Frustum& frustum, const Aabb& aabb);
+
+	// visibleOut[i] is 1 if sphere i intersects the frustum, 0 if not. Returns the number of visible spheres.
+	// Tests 4 spheres against a plane at a time
+	RYU_API u64 CullSpheres(const Frustum& frustum, const SphereStreams& spheres, u8* visibleOut, u64 count);
+}
@@ -0,0 +1,175 @@
+#include "Math/TransformKernel.h"
+#include <immintrin.h>
+#include <cstring>
+
+namespace Ryu::Math
+{
+	namespace
+	{
+		struct Sse
+		{
+			using Vec = __m128;
+			static constexpr u64 WIDTH = 4;
+
+			static Vec Load(const f32* p) { return _mm_loadu_ps(p); }
+			static Vec Set(f32 v)         { return _mm_set1_ps(v); }
+			static Vec Add(Vec a, Vec b)  { return _mm_add_ps(a, b); }
+			static Vec Sub(Vec a, Vec b)  { return _mm_sub_ps(a, b); }
+			static Vec Mul(Vec a, Vec b)  { return _mm_mul_ps(a, b); }
+		};
+
+#if defined(__AVX__)
+		struct Avx
+		{
+			using Vec = __m256;
+			static constexpr u64 WIDTH = 8;
+
+			static Vec Load(const f32* p) { return _mm256_loadu_ps(p); }
+			static Vec Set(f32 v)         { return _mm256_set1_ps(v); }
+			static Vec Add(Vec a, Vec b)  { return _mm256_add_ps(a, b); }
+			static Vec Sub(Vec a, Vec b)  { return _mm256_sub_ps(a, b); }
+			static Vec Mul(Vec a, Vec b)  { return _mm256_mul_ps(a, b); }
+		};
+		using Wide = Avx;
+#else
+		using Wide = Sse;
+#endif
+
+		// One transform per lane, one register per matrix element
+		template <typename Vec>
+		struct MatrixLanes
+		{
+			Vec M[3][3];
+			Vec Position[3];
+		};
+
+		template <typename Isa>
+		MatrixLanes<typename Isa::Vec> ComputeLanes(const TransformStreams& t, u64 i)
+		{
+			using V = typename Isa::Vec;
+
+			const V x = Isa::Load(t.Orientation[0] + i);
+			const V y = Isa::Load(t.Orientation[1] + i);
+			const V z = Isa::Load(t.Orientation[2] + i);
+			const V w = Isa::Load(t.Orientation[3] + i);
+
+			const V x2 = Isa::Add(x, x);
+			const V y2 = Isa::Add(y, y);
+			const V z2 = Isa::Add(z, z);
+
+			const V xx = Isa::Mul(x, x2), yy = Isa::Mul(y, y2), zz = Isa::Mul(z, z2);
+			const V xy = Isa::Mul(x, y2), xz = Isa::Mul(x, z2), yz = Isa::Mul(y, z2);
+			const V wx = Isa::Mul(w, x2), wy = Isa::Mul(w, y2), wz = Isa::Mul(w, z2);
+
+			const V sx  = Isa::Load(t.Scale[0] + i);
+			const V sy  = Isa::Load(t.Scale[1] + i);
+			const V sz  = Isa::Load(t.Scale[2] + i);
+			const V one = Isa::Set(1.0f);
+
+			// Same rotation as XMMatrixRotationQuaternion, row r scaled by scale[r]
+			MatrixLanes<V> lanes;
+			lanes.M[0][0] = Isa::Mul(Isa::Sub(one, Isa::Add(yy, zz)), sx);
+			lanes.M[0][1] = Isa::Mul(Isa::Add(xy, wz), sx);
+			lanes.M[0][2] = Isa::Mul(Isa::Sub(xz, wy), sx);
+			lanes.M[1][0] = Isa::Mul(Isa::Sub(xy, wz), sy);
+			lanes.M[1][1] = Isa::Mul(Isa::Sub(one, Isa::Add(xx, zz)), sy);
+			lanes.M[1][2] = Isa::Mul(Isa::Add(yz, wx), sy);
+			lanes.M[2][0] = Isa::Mul(Isa::Add(xz, wy), sz);
+			lanes.M[2][1] = Isa::Mul(Isa::Sub(yz, wx), sz);
+			lanes.M[2][2] = Isa::Mul(Isa::Sub(one, Isa::Add(xx, yy)), sz);
+
+			lanes.Position[0] = Isa::Load(t.Position[0] + i);
+			lanes.Position[1] = Isa::Load(t.Position[1] + i);
+			lanes.Position[2] = Isa::Load(t.Position[2] + i);
+			return lanes;
+		}
+
+		// Transposes 4 lanes back into 4 consecutive row major matrices
+		void StoreLanes(const MatrixLanes<__m128>& lanes, f32* out)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one  = _mm_set1_ps(1.0f);
+
+			for (u32 row = 0; row < 4; ++row)
+			{
+				__m128 a = row < 3 ? lanes.M[row][0] : lanes.Position[0];
+				__m128 b = row < 3 ? lanes.M[row][1] : lanes.Position[1];
+				__m128 c = row < 3 ? lanes.M[row][2] : lanes.Position[2];
+				__m128 d = row < 3 ? zero : one;
+				_MM_TRANSPOSE4_PS(a, b, c, d);
+
+				_mm_storeu_ps(out + 0 * 16 + row * 4, a);
+				_mm_storeu_ps(out + 1 * 16 + row * 4, b);
+				_mm_storeu_ps(out + 2 * 16 + row * 4, c);
+				_mm_storeu_ps(out + 3 * 16 + row * 4, d);
+			}
+		}
+
+#if defined(__AVX__)
+		// Both halves go through the 4 wide transpose, AVX has no cheaper way across its lanes
+		void StoreLanes(const MatrixLanes<__m256>& lanes, f32* out)
+		{
+			MatrixLanes<__m128> low, high;
+			for (u32 row = 0; row < 3; ++row)
+			{
+				for (u32 column = 0; column < 3; ++column)
+				{
+					low.M[row][column]  = _mm256_castps256_ps128(lanes.M[row][column]);
+					high.M[row][column] = _mm256_extractf128_ps(lanes.M[row][column], 1);
+				}
+				low.Position[row]  = _mm256_castps256_ps128(lanes.Position[row]);
+				high.Position[row] = _mm256_extractf128_ps(lanes.Position[row], 1);
+			}
+
+			StoreLanes(low, out);
+			StoreLanes(high, out + 4 * 16);
+		}
+#endif
+
+		void ComputeOne(const TransformStreams& t, u64 i, f32* out)
+		{
+			const f32 x = t.Orientation[0][i], y = t.Orientation[1][i], z = t.Orientation[2][i], w = t.Orientation[3][i];
+			const f32 sx = t.Scale[0][i], sy = t.Scale[1][i], sz = t.Scale[2][i];
+
+			const f32 xx = 2.0f * x * x, yy = 2.0f * y * y, zz = 2.0f * z * z;
+			const f32 xy = 2.0f * x * y, xz = 2.0f * x * z, yz = 2.0f * y * z;
+			const f32 wx = 2.0f * w * x, wy = 2.0f * w * y, wz = 2.0f * w * z;
+
+			const f32 matrix[16] =
+			{
+				(1.0f - (yy + zz)) * sx, (xy + wz) * sx,          (xz - wy) * sx,          0.0f,
+				(xy - wz) * sy,          (1.0f - (xx + zz)) * sy, (yz + wx) * sy,          0.0f,
+				(xz + wy) * sz,          (yz - wx) * sz,          (1.0f - (xx + yy)) * sz, 0.0f,
+				t.Position[0][i],        t.Position[1][i],        t.Position[2][i],        1.0f,
+			};
+			std::memcpy(out, matrix, sizeof(matrix));
+		}
+	}
+
+	void ComputeWorldMatrices(const TransformStreams& transforms, Matrix* out, u64 count)
+	{
+		static_assert(sizeof(Matrix) == 16 * sizeof(f32));
+		f32* dst = &out->_11;
+
+		u64 i = 0;
+		for (; i + Wide::WIDTH <= count; i += Wide::WIDTH)
+		{
+			StoreLanes(ComputeLanes<Wide>(transforms, i), dst + i * 16);
+		}
+
+		// A last 4 wide step before going one at a time
+		if constexpr (Wide::WIDTH > Sse::WIDTH)
+		{
+			if (i + Sse::WIDTH <= count)
+			{
+				StoreLanes(ComputeLanes<Sse>(transforms, i), dst + i * 16);
+				i += Sse::WIDTH;
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			ComputeOne(transforms, i, dst + i * 16);
+		}
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Math/Math.h"
+
+namespace Ryu::Math
+{
+	// Transforms split into one stream per component, transform i is element i of every stream
+	struct TransformStreams
+	{
+		std::array<const f32*, 3> Position;     // x, y, z
+		std::array<const f32*, 4> Orientation;  // x, y, z, w of a unit quaternion
+		std::array<const f32*, 3> Scale;        // x, y, z
+	};
+
+	// out[i] = CreateScale(scale) * CreateFromQuaternion(orientation) * CreateTranslation(position), built directly:
+	// the rotation rows come out of the quaternion already scaled and the position goes in the last row.
+	// Runs 8 transforms at a time when built with AVX enabled (/arch:AVX2), 4 with SSE otherwise
+	RYU_API void ComputeWorldMatrices(const TransformStreams& transforms, Matrix* out, u64 count);
+}
@@ -0,0 +1,139 @@
+#include "Memory/FrameArena.h"
+#include <algorithm>
+#include <new>
+
+namespace Ryu::Memory
+{
+	namespace
+	{
+		// Buffers start on a cache line, so per-thread sections carved out of them don't share one
+		constexpr size_t BUFFER_ALIGNMENT = 64;
+
+		constexpr size_t AlignUp(size_t value, size_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		std::byte* AllocateData(size_t capacity)
+		{
+			return static_cast<std::byte*>(::operator new(capacity, std::align_val_t{ BUFFER_ALIGNMENT }));
+		}
+	}
+
+	FrameArena::FrameArena(size_t capacityPerFrame, u32 frameCount)
+		: m_frameCount(std::clamp<u32>(frameCount, 1, MAX_FRAME_COUNT))
+	{
+		RYU_ASSERT(frameCount >= 1 && frameCount <= MAX_FRAME_COUNT, "FrameArena supports 1 to 3 buffers");
+
+		const size_t capacity = AlignUp(std::max<size_t>(capacityPerFrame, BUFFER_ALIGNMENT), BUFFER_ALIGNMENT);
+		for (u32 i = 0; i < m_frameCount; ++i)
+		{
+			m_buffers[i].Data     = AllocateData(capacity);
+			m_buffers[i].Capacity = capacity;
+		}
+	}
+
+	FrameArena::~FrameArena()
+	{
+		for (u32 i = 0; i < m_frameCount; ++i)
+		{
+			ResetBuffer(m_buffers[i]);
+			FreeData(m_buffers[i]);
+		}
+	}
+
+	void FrameArena::BeginFrame()
+	{
+		m_current = (m_current + 1) % m_frameCount;
+		++m_frameIndex;
+
+		Buffer& buffer = m_buffers[m_current];
+
+		// Spilled last time round, grow so the same workload fits without touching the heap again
+		if (buffer.Overflow)
+		{
+			const size_t needed = buffer.Offset.load(std::memory_order_relaxed) + buffer.OverflowBytes;
+			const size_t grown  = AlignUp(std::max(buffer.Capacity * 2, needed), BUFFER_ALIGNMENT);
+
+			ResetBuffer(buffer);
+			FreeData(buffer);
+			buffer.Data     = AllocateData(grown);
+			buffer.Capacity = grown;
+		}
+
+		buffer.Offset.store(0, std::memory_order_relaxed);
+	}
+
+	void* FrameArena::Allocate(size_t size, size_t alignment)
+	{
+		RYU_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		Buffer& buffer = m_buffers[m_current];
+		const uintptr_t base = reinterpret_cast<uintptr_t>(buffer.Data);
+
+		size_t offset = buffer.Offset.load(std::memory_order_relaxed);
+		while (true)
+		{
+			const size_t alignedOffset = AlignUp(base + offset, alignment) - base;
+			const size_t end           = alignedOffset + size;
+
+			if (end > buffer.Capacity)
+			{
+				return AllocateOverflow(buffer, size, alignment);
+			}
+
+			if (buffer.Offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+			{
+				return buffer.Data + alignedOffset;
+			}
+		}
+	}
+
+	size_t FrameArena::GetUsedBytes() const noexcept
+	{
+		const Buffer& buffer = m_buffers[m_current];
+		return std::min(buffer.Offset.load(std::memory_order_relaxed), buffer.Capacity) + buffer.OverflowBytes;
+	}
+
+	void* FrameArena::AllocateOverflow(Buffer& buffer, size_t size, size_t alignment)
+	{
+		// Header padded so the payload keeps the requested alignment
+		const size_t chunkAlignment = std::max(alignment, alignof(OverflowChunk));
+		const size_t headerSize     = AlignUp(sizeof(OverflowChunk), chunkAlignment);
+
+		void* memory = ::operator new(headerSize + size, std::align_val_t{ chunkAlignment });
+		OverflowChunk* chunk = static_cast<OverflowChunk*>(memory);
+		chunk->Alignment = chunkAlignment;
+
+		{
+			std::lock_guard lock(m_overflowMutex);
+			chunk->Next          = buffer.Overflow;
+			buffer.Overflow      = chunk;
+			buffer.OverflowBytes += size + alignment;
+		}
+
+		return static_cast<std::byte*>(memory) + headerSize;
+	}
+
+	void FrameArena::ResetBuffer(Buffer& buffer)
+	{
+		OverflowChunk* chunk = buffer.Overflow;
+		while (chunk)
+		{
+			OverflowChunk* next = chunk->Next;
+			::operator delete(chunk, std::align_val_t{ chunk->Alignment });
+			chunk = next;
+		}
+
+		buffer.Overflow      = nullptr;
+		buffer.OverflowBytes = 0;
+		buffer.Offset.store(0, std::memory_order_relaxed);
+	}
+
+	void FrameArena::FreeData(Buffer& buffer)
+	{
+		::operator delete(buffer.Data, std::align_val_t{ BUFFER_ALIGNMENT });
+		buffer.Data     = nullptr;
+		buffer.Capacity = 0;
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+
+namespace Ryu::Memory
+{
+	// Bump allocator for data that only lives for a frame or two. Keeps frameCount buffers and
+	// rotates through them in BeginFrame(), so whatever was allocated during the previous
+	// frameCount - 1 frames stays valid while the current frame fills the next buffer.
+	// Nothing is freed individually. A buffer that ran out spills into heap chunks for the rest
+	// of that frame and grows when it comes around again, so a steady workload stops allocating
+	class FrameArena
+	{
+		RYU_DISABLE_COPY_AND_MOVE(FrameArena)
+
+	public:
+		static constexpr size_t DEFAULT_CAPACITY    = 1024 * 1024;
+		static constexpr u32    DEFAULT_FRAME_COUNT = 2;
+		static constexpr u32    MAX_FRAME_COUNT     = 3;
+
+		explicit FrameArena(size_t capacityPerFrame = DEFAULT_CAPACITY, u32 frameCount = DEFAULT_FRAME_COUNT);
+		~FrameArena();
+
+		// Moves on to the oldest buffer and resets it. Not safe to call while other threads allocate
+		void BeginFrame();
+
+		// Safe to call from several threads within a frame
+		[[nodiscard]] void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// Uninitialized storage for count objects of T
+		template <typename T>
+		[[nodiscard]] T* AllocateArray(size_t count)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		// For std::pmr containers, deallocation is a no-op and memory is reclaimed in BeginFrame()
+		[[nodiscard]] std::pmr::memory_resource* GetResource() noexcept { return &m_resource; }
+
+		[[nodiscard]] size_t GetUsedBytes() const noexcept;
+		[[nodiscard]] size_t GetCapacity() const noexcept { return m_buffers[m_current].Capacity; }
+		[[nodiscard]] u32 GetFrameCount() const noexcept { return m_frameCount; }
+		[[nodiscard]] u64 GetFrameIndex() const noexcept { return m_frameIndex; }
+
+	private:
+		// Heap block used once a buffer is full, freed when the buffer is reset
+		struct OverflowChunk
+		{
+			OverflowChunk* Next;
+			size_t         Alignment;
+		};
+
+		struct Buffer
+		{
+			std::byte*          Data     = nullptr;
+			size_t              Capacity = 0;
+			std::atomic<size_t> Offset{ 0 };
+			OverflowChunk*      Overflow = nullptr;
+			size_t              OverflowBytes = 0;
+		};
+
+		class Resource final : public std::pmr::memory_resource
+		{
+		public:
+			explicit Resource(FrameArena& arena) : m_arena(arena) {}
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override { return m_arena.Allocate(bytes, alignment); }
+			void do_deallocate(void*, size_t, size_t) override {}
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		private:
+			FrameArena& m_arena;
+		};
+
+		void* AllocateOverflow(Buffer& buffer, size_t size, size_t alignment);
+		void ResetBuffer(Buffer& buffer);
+		static void FreeData(Buffer& buffer);
+
+	private:
+		std::array<Buffer, MAX_FRAME_COUNT> m_buffers;
+		u32                                 m_frameCount;
+		u32                                 m_current    = 0;
+		u64                                 m_frameIndex = 0;
+		std::mutex                          m_overflowMutex;
+		Resource                            m_resource{ *this };
+	};
+}
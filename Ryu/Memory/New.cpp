@@ -1,54 +1,365 @@
 #include "Memory/New.h"
+#include <array>
+#include <atomic>
 #include <new>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
 
 /* --------------------------------------------------------------------------------------
-I am storing the size of the allocation in the first sizeof(size_t) bytes of the allocation.
+I am storing the size of the allocation in a small header right in front of the returned pointer,
+together with the offset back to the malloc block so over-aligned allocations can be freed.
+The top byte of the size holds the AllocationTag the block was charged to.
+
+Counters are kept per thread and only summed when someone asks for them. The owning thread
+is the only writer of its block, so the hot path is plain relaxed loads and stores on a cache
+line no other thread writes to. Blocks are never freed, when a thread exits its block is
+handed to the next new thread and keeps accumulating (the sums don't care who owns it).
 ----------------------------------------------------------------------------------------- */
 
 // Change this to 0 to disable memory stats
 #define RYU_ENABLE_MEMORY_STATS 1
 
-static Ryu::Memory::UsageStats g_stats{};
-
 namespace
 {
-	// Alignment for size_t storage (typically 8 bytes on 64-bit systems)
-	constexpr size_t SIZE_STORAGE_ALIGN = alignof(size_t);
-	constexpr size_t SIZE_STORAGE_SIZE = sizeof(size_t);
-	constexpr size_t SIZE_ALIGNED_STORAGE = (SIZE_STORAGE_SIZE + SIZE_STORAGE_ALIGN - 1) & ~(SIZE_STORAGE_ALIGN - 1);
+	using Ryu::Memory::AllocationTag;
+
+	constexpr size_t TAG_COUNT = static_cast<size_t>(AllocationTag::Count);
+
+	// Net usage change a thread buffers before publishing it to the shared total (and the peak)
+	constexpr i64 USAGE_FLUSH_THRESHOLD = 64 * 1024;
+
+	struct TagCounters
+	{
+		std::atomic<u64> TotalAllocated{ 0 };
+		std::atomic<u64> AllocationCount{ 0 };
+		std::atomic<u64> DeallocationCount{ 0 };
+		std::atomic<i64> CurrentUsage{ 0 };  // Negative when this thread freed more than it allocated
+	};
+
+	struct alignas(64) ThreadCounters
+	{
+		std::atomic<u64>                    TotalAllocated{ 0 };
+		std::atomic<u64>                    AllocationCount{ 0 };
+		std::atomic<u64>                    DeallocationCount{ 0 };
+		std::atomic<i64>                    CurrentUsage{ 0 };
+		std::array<TagCounters, TAG_COUNT>  Tags{};
+		i64                                 PendingUsage = 0;  // Owner only, not yet in g_publishedUsage
+		std::atomic<bool>                   InUse{ false };
+		ThreadCounters*                     Next = nullptr;
+	};
+
+	// Everything here is constant initialized, operator new can run before any dynamic initializer
+	constinit std::atomic<ThreadCounters*> g_counterBlocks{ nullptr };
+	constinit std::atomic<i64>             g_publishedUsage{ 0 };
+	constinit std::atomic<size_t>          g_peakUsage{ 0 };
+
+	// Used with atomic RMW by threads that already tore down their thread locals
+	constinit ThreadCounters g_sharedCounters{};
+
+	void PublishUsage(ThreadCounters& counters)
+	{
+		const i64 pending = counters.PendingUsage;
+		counters.PendingUsage = 0;
+
+		const i64 published = g_publishedUsage.fetch_add(pending, std::memory_order_relaxed) + pending;
+		if (published <= 0)
+		{
+			return;
+		}
+
+		size_t peak = g_peakUsage.load(std::memory_order_relaxed);
+		while (static_cast<size_t>(published) > peak && !g_peakUsage.compare_exchange_weak(peak, static_cast<size_t>(published), std::memory_order_relaxed))
+		{
+			// Keep trying until we update peak or current is no longer greater
+		}
+	}
+
+	ThreadCounters* AcquireCounters()
+	{
+		// Reuse a block from a thread that exited
+		for (ThreadCounters* block = g_counterBlocks.load(std::memory_order_acquire); block; block = block->Next)
+		{
+			bool expected = false;
+			if (!block->InUse.load(std::memory_order_relaxed) && block->InUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+			{
+				return block;
+			}
+		}
+
+		// malloc, not new, we are inside operator new. Over-allocate to get the block on its own
+		// cache line, it is never freed so the raw pointer can be dropped
+		void* memory = std::malloc(sizeof(ThreadCounters) + alignof(ThreadCounters));
+		if (!memory)
+		{
+			return nullptr;
+		}
+
+		size_t space = sizeof(ThreadCounters) + alignof(ThreadCounters);
+		memory = std::align(alignof(ThreadCounters), sizeof(ThreadCounters), memory, space);
+
+		ThreadCounters* block = new (memory) ThreadCounters();
+		block->InUse.store(true, std::memory_order_relaxed);
+
+		ThreadCounters* head = g_counterBlocks.load(std::memory_order_relaxed);
+		do
+		{
+			block->Next = head;
+		} while (!g_counterBlocks.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+
+		return block;
+	}
+
+	// Hands the block back when the thread exits
+	struct ThreadCountersOwner
+	{
+		ThreadCounters* Counters = nullptr;
+		bool            Exited   = false;
+
+		~ThreadCountersOwner()
+		{
+			if (Counters)
+			{
+				PublishUsage(*Counters);
+				Counters->InUse.store(false, std::memory_order_release);
+				Counters = nullptr;
+			}
+
+			// Deletes from later thread local destructors go to the shared block
+			Exited = true;
+		}
+	};
+
+	thread_local constinit ThreadCountersOwner t_owner{};
+	thread_local constinit AllocationTag       t_currentTag = AllocationTag::General;
+
+	// Returns the block to charge and whether it is shared (needs RMW) or owned by this thread
+	inline std::pair<ThreadCounters*, bool> GetCounters()
+	{
+		if (t_owner.Counters) [[likely]]
+		{
+			return { t_owner.Counters, false };
+		}
+
+		if (!t_owner.Exited)
+		{
+			t_owner.Counters = AcquireCounters();
+			if (t_owner.Counters)
+			{
+				return { t_owner.Counters, false };
+			}
+		}
+
+		return { &g_sharedCounters, true };
+	}
+
+	template <typename T>
+	inline void Bump(std::atomic<T>& counter, T delta, bool shared)
+	{
+		if (shared)
+		{
+			counter.fetch_add(delta, std::memory_order_relaxed);
+		}
+		else
+		{
+			// Single writer, a plain load/store pair is enough and keeps the line exclusive to this core
+			counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+		}
+	}
+
+	void AddAllocation(size_t size, AllocationTag tag)
+	{
+		auto [counters, shared] = GetCounters();
+		const i64 signedSize = static_cast<i64>(size);
+
+		Bump<u64>(counters->TotalAllocated, size, shared);
+		Bump<u64>(counters->AllocationCount, 1, shared);
+		Bump<i64>(counters->CurrentUsage, signedSize, shared);
+
+		TagCounters& tagCounters = counters->Tags[static_cast<size_t>(tag)];
+		Bump<u64>(tagCounters.TotalAllocated, size, shared);
+		Bump<u64>(tagCounters.AllocationCount, 1, shared);
+		Bump<i64>(tagCounters.CurrentUsage, signedSize, shared);
+
+		if (shared)
+		{
+			g_publishedUsage.fetch_add(signedSize, std::memory_order_relaxed);
+			return;
+		}
+
+		counters->PendingUsage += signedSize;
+		if (counters->PendingUsage >= USAGE_FLUSH_THRESHOLD)
+		{
+			PublishUsage(*counters);
+		}
+	}
+
+	void RemoveAllocation(size_t size, AllocationTag tag)
+	{
+		auto [counters, shared] = GetCounters();
+		const i64 signedSize = static_cast<i64>(size);
+
+		Bump<u64>(counters->DeallocationCount, 1, shared);
+		Bump<i64>(counters->CurrentUsage, -signedSize, shared);
+
+		TagCounters& tagCounters = counters->Tags[static_cast<size_t>(tag)];
+		Bump<u64>(tagCounters.DeallocationCount, 1, shared);
+		Bump<i64>(tagCounters.CurrentUsage, -signedSize, shared);
+
+		if (shared)
+		{
+			g_publishedUsage.fetch_sub(signedSize, std::memory_order_relaxed);
+			return;
+		}
+
+		counters->PendingUsage -= signedSize;
+		if (counters->PendingUsage <= -USAGE_FLUSH_THRESHOLD)
+		{
+			PublishUsage(*counters);
+		}
+	}
+
+	// Calls func on every counter block, including the shared one
+	template <typename Func>
+	void ForEachCounters(Func&& func)
+	{
+		func(g_sharedCounters);
+		for (ThreadCounters* block = g_counterBlocks.load(std::memory_order_acquire); block; block = block->Next)
+		{
+			func(*block);
+		}
+	}
+
+	size_t ClampUsage(i64 usage)
+	{
+		// Frees racing with the sum can make it dip below zero for a moment
+		return usage > 0 ? static_cast<size_t>(usage) : 0;
+	}
 
-	// Calculate total allocation size including size storage
-	constexpr size_t GetTotalAllocationSize(size_t requestedSize)
+	// Every allocation is preceded by a header holding the size (and tag) and the distance back to the
+	// start of the malloc block. The header is padded to the default new alignment so plain new keeps
+	// malloc's 16 byte guarantee, over-aligned requests get extra room to slide the user pointer forward
+	struct AllocationHeader
 	{
-		return SIZE_ALIGNED_STORAGE + requestedSize;
+		size_t SizeAndTag;
+		size_t Offset;  // userPtr - rawPtr
+	};
+
+	constexpr size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	constexpr size_t HEADER_SIZE = (sizeof(AllocationHeader) + DEFAULT_ALIGNMENT - 1) & ~(DEFAULT_ALIGNMENT - 1);
+
+	// Tag lives in the top byte of the stored size
+	constexpr size_t TAG_SHIFT = 56;
+	constexpr size_t SIZE_MASK = (size_t(1) << TAG_SHIFT) - 1;
+
+	// Calculate total allocation size including the header and alignment slack
+	constexpr size_t GetTotalAllocationSize(size_t requestedSize, size_t alignment)
+	{
+		return HEADER_SIZE + requestedSize + (alignment > DEFAULT_ALIGNMENT ? alignment : 0);
+	}
+
+	// First address past the header that satisfies alignment
+	inline void* GetUserPtr(void* rawPtr, size_t alignment)
+	{
+		const uintptr_t first = reinterpret_cast<uintptr_t>(rawPtr) + HEADER_SIZE;
+		if (alignment <= DEFAULT_ALIGNMENT)
+		{
+			return reinterpret_cast<void*>(first);
+		}
+
+		return reinterpret_cast<void*>((first + alignment - 1) & ~(alignment - 1));
 	}
 
-	// Store size in the allocated memory
-	constexpr void StoreSize(void* rawPtr, size_t size)
+	inline AllocationHeader* GetHeader(void* userPtr)
 	{
-		*static_cast<size_t*>(rawPtr) = size;
+		return reinterpret_cast<AllocationHeader*>(static_cast<char*>(userPtr) - sizeof(AllocationHeader));
+	}
+
+	// Store size, tag and offset right in front of the user pointer
+	inline void StoreHeader(void* rawPtr, void* userPtr, size_t size, AllocationTag tag)
+	{
+		AllocationHeader* header = GetHeader(userPtr);
+		header->SizeAndTag = (static_cast<size_t>(tag) << TAG_SHIFT) | size;
+		header->Offset     = static_cast<size_t>(static_cast<char*>(userPtr) - static_cast<char*>(rawPtr));
 	}
 
 	// Retrieve size from allocated memory
-	constexpr size_t GetStoredSize(void* userPtr)
+	inline size_t GetStoredSize(void* userPtr)
 	{
-		void* rawPtr = static_cast<char*>(userPtr) - SIZE_ALIGNED_STORAGE;
-		return *static_cast<size_t*>(rawPtr);
+		return GetHeader(userPtr)->SizeAndTag & SIZE_MASK;
 	}
 
-	// Get user pointer from raw allocation
-	constexpr void* GetUserPtr(void* rawPtr)
+	// Retrieve the tag the allocation was charged to
+	inline AllocationTag GetStoredTag(void* userPtr)
 	{
-		return static_cast<char*>(rawPtr) + SIZE_ALIGNED_STORAGE;
+		return static_cast<AllocationTag>(GetHeader(userPtr)->SizeAndTag >> TAG_SHIFT);
 	}
 
 	// Get raw pointer from user pointer
-	constexpr void* GetRawPtr(void* dataPtr)
+	inline void* GetRawPtr(void* userPtr)
 	{
-		return static_cast<char*>(dataPtr) - SIZE_ALIGNED_STORAGE;
+		return static_cast<char*>(userPtr) - GetHeader(userPtr)->Offset;
 	}
+
+	// Shared by every operator new form, returns nullptr on failure
+	void* TrackedAllocate(size_t size, size_t alignment) noexcept
+	{
+		void* rawPtr = std::malloc(GetTotalAllocationSize(size, alignment));
+		if (!rawPtr)
+		{
+			return nullptr;
+		}
+
+		const AllocationTag tag = t_currentTag;
+		void* userPtr = GetUserPtr(rawPtr, alignment);
+		StoreHeader(rawPtr, userPtr, size, tag);
+
+		AddAllocation(size, tag);
+
+		return userPtr;
+	}
+
+	// Shared by every operator delete form, the header knows everything the sized/aligned forms pass in
+	void TrackedFree(void* ptr) noexcept
+	{
+		if (!ptr)
+		{
+			return;
+		}
+
+		RemoveAllocation(GetStoredSize(ptr), GetStoredTag(ptr));
+		std::free(GetRawPtr(ptr));
+	}
+
+	inline void CheckStoredSize([[maybe_unused]] void* ptr, [[maybe_unused]] size_t size) noexcept
+	{
+#if defined(RYU_BUILD_DEBUG)
+		if (ptr && GetStoredSize(ptr) != size)
+		{
+			assert(false && "Provided size does not match stored size");
+		}
+#endif
+	}
+}
+
+#pragma region Tags
+Ryu::Memory::ScopedAllocationTag::ScopedAllocationTag(AllocationTag tag) noexcept
+	: m_previous(t_currentTag)
+{
+	t_currentTag = tag;
+}
+
+Ryu::Memory::ScopedAllocationTag::~ScopedAllocationTag() noexcept
+{
+	t_currentTag = m_previous;
+}
+
+Ryu::Memory::AllocationTag Ryu::Memory::GetCurrentAllocationTag() noexcept
+{
+	return t_currentTag;
 }
+#pragma endregion
 
 #pragma region Getters
 bool Ryu::Memory::IsMemoryTrackingEnabled()
@@ -60,110 +371,170 @@ bool Ryu::Memory::IsMemoryTrackingEnabled()
 #endif
 }
 
+Ryu::Memory::UsageStats Ryu::Memory::GetUsageStats()
+{
+	i64 currentUsage = 0;
+	UsageStats stats{};
+
+	ForEachCounters([&](const ThreadCounters& counters)
+	{
+		stats.TotalAllocated    += counters.TotalAllocated.load(std::memory_order_relaxed);
+		stats.AllocationCount   += counters.AllocationCount.load(std::memory_order_relaxed);
+		stats.DeallocationCount += counters.DeallocationCount.load(std::memory_order_relaxed);
+		currentUsage            += counters.CurrentUsage.load(std::memory_order_relaxed);
+	});
+
+	stats.CurrentUsage = ClampUsage(currentUsage);
+
+	// The merged value is exact, fold it into the sampled peak
+	size_t peak = g_peakUsage.load(std::memory_order_relaxed);
+	while (stats.CurrentUsage > peak && !g_peakUsage.compare_exchange_weak(peak, stats.CurrentUsage, std::memory_order_relaxed))
+	{
+		// Keep trying until we update peak or current is no longer greater
+	}
+	stats.PeakUsage = std::max(peak, stats.CurrentUsage);
+
+	return stats;
+}
+
 size_t Ryu::Memory::GetTotalAllocated()
 {
-	return g_stats.TotalAllocated.load();
+	return GetUsageStats().TotalAllocated;
 }
 
 size_t Ryu::Memory::GetCurrentUsage()
 {
-	return g_stats.CurrentUsage.load();
+	return GetUsageStats().CurrentUsage;
 }
 
 size_t Ryu::Memory::GetPeakUsage()
 {
-	return g_stats.PeakUsage.load();
+	return GetUsageStats().PeakUsage;
 }
 
 size_t Ryu::Memory::GetAllocationCount()
 {
-	return g_stats.AllocationCount.load();
+	return GetUsageStats().AllocationCount;
 }
 
 size_t Ryu::Memory::GetDeallocationCount()
 {
-	return g_stats.DeallocationCount.load();
+	return GetUsageStats().DeallocationCount;
 }
-#pragma endregion
 
-// Override new/delete operations
-#if RYU_ENABLE_MEMORY_STATS
-[[nodiscard]] void* operator new(size_t size)
+Ryu::Memory::UsageStats Ryu::Memory::GetUsageStats(AllocationTag tag)
 {
-	size_t totalSize = GetTotalAllocationSize(size);
-	void* rawPtr = std::malloc(totalSize);
-	if (!rawPtr)
+	const size_t index = static_cast<size_t>(tag);
+	if (index >= TAG_COUNT)
 	{
-		throw std::bad_alloc();
+		return {};
 	}
 
-	StoreSize(rawPtr, size);
-	void* userPtr = GetUserPtr(rawPtr);
+	i64 currentUsage = 0;
+	UsageStats stats{};
 
-	g_stats.AddAllocation(size);
-
-	return userPtr;
+	ForEachCounters([&](const ThreadCounters& counters)
+	{
+		const TagCounters& tagCounters = counters.Tags[index];
+		stats.TotalAllocated    += tagCounters.TotalAllocated.load(std::memory_order_relaxed);
+		stats.AllocationCount   += tagCounters.AllocationCount.load(std::memory_order_relaxed);
+		stats.DeallocationCount += tagCounters.DeallocationCount.load(std::memory_order_relaxed);
+		currentUsage            += tagCounters.CurrentUsage.load(std::memory_order_relaxed);
+	});
+
+	stats.CurrentUsage = ClampUsage(currentUsage);
+	return stats;
 }
 
-[[nodiscard]] void* operator new(size_t size, const std::nothrow_t&) noexcept
+size_t Ryu::Memory::GetTotalAllocated(AllocationTag tag)
 {
-	size_t totalSize = GetTotalAllocationSize(size);
-	void* rawPtr = std::malloc(totalSize);
-	if (!rawPtr)
-	{
-		return nullptr;
-	}
+	return GetUsageStats(tag).TotalAllocated;
+}
 
-	StoreSize(rawPtr, size);
-	void* userPtr = GetUserPtr(rawPtr);
+size_t Ryu::Memory::GetCurrentUsage(AllocationTag tag)
+{
+	return GetUsageStats(tag).CurrentUsage;
+}
 
-	g_stats.AddAllocation(size);
+size_t Ryu::Memory::GetAllocationCount(AllocationTag tag)
+{
+	return GetUsageStats(tag).AllocationCount;
+}
 
-	return userPtr;
+size_t Ryu::Memory::GetDeallocationCount(AllocationTag tag)
+{
+	return GetUsageStats(tag).DeallocationCount;
 }
+#pragma endregion
 
-void operator delete(void* ptr) noexcept
+// Override new/delete operations
+#if RYU_ENABLE_MEMORY_STATS
+[[nodiscard]] void* operator new(size_t size)
 {
+	void* ptr = TrackedAllocate(size, DEFAULT_ALIGNMENT);
 	if (!ptr)
 	{
-		return;
+		throw std::bad_alloc();
 	}
+	return ptr;
+}
 
-	size_t size = GetStoredSize(ptr);
-	void* rawPtr = GetRawPtr(ptr);
-
-	g_stats.RemoveAllocation(size);
-	std::free(rawPtr);
+[[nodiscard]] void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return TrackedAllocate(size, DEFAULT_ALIGNMENT);
 }
 
-void operator delete(void* ptr, size_t size) noexcept
+[[nodiscard]] void* operator new(size_t size, std::align_val_t alignment)
 {
+	void* ptr = TrackedAllocate(size, static_cast<size_t>(alignment));
 	if (!ptr)
 	{
-		return;
+		throw std::bad_alloc();
 	}
+	return ptr;
+}
 
-#if defined(RYU_BUILD_DEBUG)
-	size_t stored_size = GetStoredSize(ptr);
-	if (stored_size != size)
-	{
-		assert(false && "Provided size does not match stored size");
-	}
-#endif
+[[nodiscard]] void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return TrackedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+	TrackedFree(ptr);
+}
 
-	void* rawPtr = GetRawPtr(ptr);
-	g_stats.RemoveAllocation(size);
-	std::free(rawPtr);
+void operator delete(void* ptr, size_t size) noexcept
+{
+	CheckStoredSize(ptr, size);
+	TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t size, std::align_val_t) noexcept
+{
+	CheckStoredSize(ptr, size);
+	TrackedFree(ptr);
 }
 
 [[nodiscard]] void* operator new[](size_t size) { return operator new(size); }
 [[nodiscard]] void* operator new[](size_t size, const std::nothrow_t&) noexcept { return operator new(size, std::nothrow); }
+[[nodiscard]] void* operator new[](size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+[[nodiscard]] void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return operator new(size, alignment, std::nothrow); }
 
 void operator delete(void* ptr, const std::nothrow_t&) noexcept { operator delete(ptr); }
 void operator delete(void* ptr, size_t size, const std::nothrow_t&) noexcept { operator delete(ptr, size); }
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { operator delete(ptr, alignment); }
 
 void operator delete[](void* ptr) noexcept { operator delete(ptr); }
 void operator delete[](void* ptr, const std::nothrow_t&) noexcept { operator delete(ptr); }
 void operator delete[](void* ptr, size_t size) noexcept { operator delete(ptr, size); }
 void operator delete[](void* ptr, size_t size, const std::nothrow_t&) noexcept { operator delete(ptr, size); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept { operator delete(ptr, alignment); }
+void operator delete[](void* ptr, size_t size, std::align_val_t alignment) noexcept { operator delete(ptr, size, alignment); }
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { operator delete(ptr, alignment); }
 #endif
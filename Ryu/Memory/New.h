@@ -1,50 +1,83 @@
 #pragma once
-#include <atomic>
+#include "Core/Common/Enum.h"
 
 namespace Ryu::Memory
 {
-	struct UsageStats
+	// Subsystem an allocation is charged to, set with ScopedAllocationTag. Stored in the allocation
+	// header, so a block is un-charged from the same tag no matter which thread frees it
+	enum class AllocationTag : u8
 	{
-		std::atomic<size_t> TotalAllocated{ 0 };
-		std::atomic<size_t> CurrentUsage{ 0 };
-		std::atomic<size_t> PeakUsage{ 0 };
-		std::atomic<size_t> AllocationCount{ 0 };
-		std::atomic<size_t> DeallocationCount{ 0 };
+		General,
+		Asset,
+		Render,
+		ECS,
+		Threading,
+		Game,
+		Editor,
 
-		void UpdatePeakUsage(size_t current)
-		{
-			size_t peak = PeakUsage.load();
-			while (current > peak && !PeakUsage.compare_exchange_weak(peak, current))
-			{
-				// Keep trying until we update peak or current is no longer greater
-			}
-		}
+		Count
+	};
 
-		void AddAllocation(size_t size)
-		{
-			TotalAllocated += size;
-			CurrentUsage += size;
-			UpdatePeakUsage(CurrentUsage.load());
-			AllocationCount++;
-		}
+	// Snapshot of the merged counters, see GetUsageStats()
+	struct UsageStats
+	{
+		size_t TotalAllocated    = 0;
+		size_t CurrentUsage      = 0;
+		size_t PeakUsage         = 0;
+		size_t AllocationCount   = 0;
+		size_t DeallocationCount = 0;
+	};
 
-		void RemoveAllocation(size_t size)
-		{
-			CurrentUsage -= size;
-			DeallocationCount++;
-		}
+	// Charges every allocation made on this thread to tag until it goes out of scope. Scopes nest
+	class ScopedAllocationTag
+	{
+		RYU_DISABLE_COPY_AND_MOVE(ScopedAllocationTag)
 
-		void RemoveAllocation()
-		{
-			DeallocationCount++;
-		}
+	public:
+		explicit ScopedAllocationTag(AllocationTag tag) noexcept;
+		~ScopedAllocationTag() noexcept;
+
+	private:
+		AllocationTag m_previous;
 	};
 
+	[[nodiscard]] AllocationTag GetCurrentAllocationTag() noexcept;
+
 	bool IsMemoryTrackingEnabled();
 
+	// Counters live per thread and are summed when queried, so these walk every thread's block.
+	// Peak usage is sampled when threads publish their usage (every few KB), it may miss short spikes
+	UsageStats GetUsageStats();
 	size_t GetTotalAllocated();
 	size_t GetCurrentUsage();
 	size_t GetPeakUsage();
 	size_t GetAllocationCount();
 	size_t GetDeallocationCount();
+
+	// Per tag queries
+	UsageStats GetUsageStats(AllocationTag tag);  // PeakUsage is not tracked per tag and stays 0
+	size_t GetTotalAllocated(AllocationTag tag);
+	size_t GetCurrentUsage(AllocationTag tag);
+	size_t GetAllocationCount(AllocationTag tag);
+	size_t GetDeallocationCount(AllocationTag tag);
+}
+
+namespace Ryu
+{
+	template<>
+	inline constexpr std::string_view EnumToString<::Ryu::Memory::AllocationTag>(::Ryu::Memory::AllocationTag value)
+	{
+		switch (value)
+		{
+			using enum ::Ryu::Memory::AllocationTag;
+		case General  : return "General";
+		case Asset    : return "Asset";
+		case Render   : return "Render";
+		case ECS      : return "ECS";
+		case Threading: return "Threading";
+		case Game     : return "Game";
+		case Editor   : return "Editor";
+		default       : return "<UNKNOWN>";
+		}
+	}
 }
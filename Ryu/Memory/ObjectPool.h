@@ -0,0 +1,110 @@
+#pragma once
+#include <memory>
+
+namespace Ryu::Memory
+{
+	// Fixed-size slots for one type, handed out from chunks of ChunkSize objects and recycled through
+	// a free list. Chunks are only released when the pool is destroyed. Not thread safe, meant to be
+	// owned by the system that creates and destroys the objects
+	template <typename T, size_t ChunkSize = 64>
+	class ObjectPool
+	{
+		RYU_DISABLE_COPY_AND_MOVE(ObjectPool)
+
+		static_assert(ChunkSize > 0);
+
+	public:
+		ObjectPool() = default;
+
+		~ObjectPool()
+		{
+			RYU_ASSERT(m_liveCount == 0, "ObjectPool destroyed with live objects");
+
+			while (m_chunks)
+			{
+				Chunk* next = m_chunks->Next;
+				delete m_chunks;
+				m_chunks = next;
+			}
+		}
+
+		template <typename... Args>
+		[[nodiscard]] T* Create(Args&&... args)
+		{
+			if (!m_freeList)
+			{
+				Grow();
+			}
+
+			Slot* slot = m_freeList;
+			m_freeList = slot->Next;
+
+			try
+			{
+				T* object = std::construct_at(reinterpret_cast<T*>(slot->Storage), std::forward<Args>(args)...);
+				++m_liveCount;
+				return object;
+			}
+			catch (...)
+			{
+				slot->Next = m_freeList;
+				m_freeList = slot;
+				throw;
+			}
+		}
+
+		void Destroy(T* object)
+		{
+			if (!object)
+			{
+				return;
+			}
+
+			std::destroy_at(object);
+
+			// Storage is the first member of the union, so the object and the slot share an address
+			Slot* slot = reinterpret_cast<Slot*>(object);
+			slot->Next = m_freeList;
+			m_freeList = slot;
+			--m_liveCount;
+		}
+
+		[[nodiscard]] size_t GetLiveCount() const noexcept { return m_liveCount; }
+		[[nodiscard]] size_t GetCapacity() const noexcept { return m_chunkCount * ChunkSize; }
+
+	private:
+		union Slot
+		{
+			alignas(T) std::byte Storage[sizeof(T)];
+			Slot* Next;
+		};
+
+		struct Chunk
+		{
+			Slot   Slots[ChunkSize];
+			Chunk* Next = nullptr;
+		};
+
+		void Grow()
+		{
+			Chunk* chunk = new Chunk;
+			chunk->Next  = m_chunks;
+			m_chunks     = chunk;
+			++m_chunkCount;
+
+			// Linked in order so consecutive Create() calls hand out adjacent slots
+			for (size_t i = 0; i + 1 < ChunkSize; ++i)
+			{
+				chunk->Slots[i].Next = &chunk->Slots[i + 1];
+			}
+			chunk->Slots[ChunkSize - 1].Next = m_freeList;
+			m_freeList = &chunk->Slots[0];
+		}
+
+	private:
+		Slot*  m_freeList   = nullptr;
+		Chunk* m_chunks     = nullptr;
+		size_t m_chunkCount = 0;
+		size_t m_liveCount  = 0;
+	};
+}
@@ -0,0 +1,285 @@
+#include "Memory/PoolAllocator.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace Ryu::Memory::Pool
+{
+	namespace
+	{
+		constexpr size_t SLAB_SIZE      = 64 * 1024;
+		constexpr size_t SLAB_ALIGNMENT = 64;
+		constexpr u32    BATCH_SIZE     = 32;              // Blocks moved between a thread and the shared pool at once
+		constexpr u32    MAX_CACHED     = BATCH_SIZE * 2;  // Per class, past this a batch goes back
+
+		// Step 16 up to 128, then four classes per doubling keeps the waste under 25%
+		constexpr std::array<u32, 16> CLASS_SIZES = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+		constexpr size_t CLASS_COUNT = CLASS_SIZES.size();
+
+		static_assert(CLASS_SIZES.back() == MAX_BLOCK_SIZE);
+
+		// Indexed by (size + 15) / 16
+		constexpr auto CLASS_LOOKUP = []
+		{
+			std::array<u8, MAX_BLOCK_SIZE / BLOCK_ALIGNMENT + 1> lookup{};
+			u8 sizeClass = 0;
+			for (size_t i = 0; i < lookup.size(); ++i)
+			{
+				while (CLASS_SIZES[sizeClass] < i * BLOCK_ALIGNMENT)
+				{
+					++sizeClass;
+				}
+				lookup[i] = sizeClass;
+			}
+			return lookup;
+		}();
+
+		constexpr size_t GetClassIndex(size_t size)
+		{
+			return CLASS_LOOKUP[(size + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT];
+		}
+
+		struct FreeBlock
+		{
+			FreeBlock* Next;
+		};
+
+		struct alignas(64) SharedList
+		{
+			std::mutex Mutex;
+			FreeBlock* Head = nullptr;
+		};
+
+		constinit std::array<SharedList, CLASS_COUNT> g_sharedLists{};
+		constinit std::atomic<size_t> g_slabCount{ 0 };
+
+		// Carves a fresh slab into blocks and links them. Called with the class mutex held
+		FreeBlock* AllocateSlab(size_t blockSize)
+		{
+			std::byte* slab = static_cast<std::byte*>(::operator new(SLAB_SIZE, std::align_val_t{ SLAB_ALIGNMENT }));
+			g_slabCount.fetch_add(1, std::memory_order_relaxed);
+
+			const size_t blockCount = SLAB_SIZE / blockSize;
+			for (size_t i = 0; i + 1 < blockCount; ++i)
+			{
+				reinterpret_cast<FreeBlock*>(slab + i * blockSize)->Next = reinterpret_cast<FreeBlock*>(slab + (i + 1) * blockSize);
+			}
+			reinterpret_cast<FreeBlock*>(slab + (blockCount - 1) * blockSize)->Next = nullptr;
+
+			return reinterpret_cast<FreeBlock*>(slab);
+		}
+
+		// Returns the chain [head, tail] to the shared list of the class
+		void ReturnChain(size_t classIndex, FreeBlock* head, FreeBlock* tail)
+		{
+			SharedList& shared = g_sharedLists[classIndex];
+			std::scoped_lock lock(shared.Mutex);
+			tail->Next  = shared.Head;
+			shared.Head = head;
+		}
+
+		// Pops a single block off the shared list, for threads whose cache is already gone
+		FreeBlock* TakeShared(size_t classIndex)
+		{
+			SharedList& shared = g_sharedLists[classIndex];
+			std::scoped_lock lock(shared.Mutex);
+
+			if (!shared.Head)
+			{
+				shared.Head = AllocateSlab(CLASS_SIZES[classIndex]);
+			}
+
+			FreeBlock* block = shared.Head;
+			shared.Head = block->Next;
+			return block;
+		}
+
+		enum class CacheState : u8
+		{
+			Unused,    // Nothing cached yet, the flush on exit isn't registered
+			Active,
+			TornDown,  // Flushed on thread exit, blocks go to the shared lists directly
+		};
+
+		// Trivially destructible on purpose: it has to stay usable until the thread is gone, other
+		// thread_locals and statics destroyed after the flush may still free blocks
+		struct ThreadCache
+		{
+			std::array<FreeBlock*, CLASS_COUNT> Heads{};
+			std::array<u32, CLASS_COUNT>        Counts{};
+			CacheState                          State = CacheState::Unused;
+
+			void Flush() noexcept
+			{
+				for (size_t i = 0; i < CLASS_COUNT; ++i)
+				{
+					if (FreeBlock* head = Heads[i])
+					{
+						FreeBlock* tail = head;
+						while (tail->Next)
+						{
+							tail = tail->Next;
+						}
+
+						ReturnChain(i, head, tail);
+						Heads[i]  = nullptr;
+						Counts[i] = 0;
+					}
+				}
+			}
+
+			void Refill(size_t classIndex)
+			{
+				SharedList& shared = g_sharedLists[classIndex];
+				std::scoped_lock lock(shared.Mutex);
+
+				if (!shared.Head)
+				{
+					shared.Head = AllocateSlab(CLASS_SIZES[classIndex]);
+				}
+
+				// Detach up to a batch
+				FreeBlock* head = shared.Head;
+				FreeBlock* tail = head;
+				u32 count = 1;
+				while (count < BATCH_SIZE && tail->Next)
+				{
+					tail = tail->Next;
+					++count;
+				}
+
+				shared.Head = tail->Next;
+				tail->Next  = Heads[classIndex];
+
+				Heads[classIndex]  = head;
+				Counts[classIndex] += count;
+			}
+
+			void Release(size_t classIndex)
+			{
+				// Keep the most recently freed (warmest) blocks, hand back the rest of the list
+				FreeBlock* keepTail = Heads[classIndex];
+				for (u32 i = 1; i < Counts[classIndex] - BATCH_SIZE; ++i)
+				{
+					keepTail = keepTail->Next;
+				}
+
+				FreeBlock* head = keepTail->Next;
+				FreeBlock* tail = head;
+				while (tail->Next)
+				{
+					tail = tail->Next;
+				}
+
+				keepTail->Next = nullptr;
+				Counts[classIndex] -= BATCH_SIZE;
+				ReturnChain(classIndex, head, tail);
+			}
+		};
+
+		constinit thread_local ThreadCache t_cache;
+
+		// Its destructor flushes the cache when the thread exits
+		struct ThreadCacheFlush
+		{
+			bool Armed = false;
+
+			~ThreadCacheFlush()
+			{
+				t_cache.Flush();
+				t_cache.State = CacheState::TornDown;
+			}
+		};
+
+		thread_local ThreadCacheFlush t_cacheFlush;
+
+		// Off the fast path: the first use on a thread registers the flush, after it the cache is skipped.
+		// Returns whether the cache can be used
+		bool PrepareCache(ThreadCache& cache) noexcept
+		{
+			if (cache.State == CacheState::TornDown)
+			{
+				return false;
+			}
+
+			t_cacheFlush.Armed = true;  // Constructing it registers the destructor
+			cache.State = CacheState::Active;
+			return true;
+		}
+	}
+
+	void* Allocate(size_t size)
+	{
+		if (size > MAX_BLOCK_SIZE) [[unlikely]]
+		{
+			return ::operator new(size);
+		}
+
+		const size_t classIndex = GetClassIndex(size);
+		ThreadCache& cache = t_cache;
+
+		if (cache.State != CacheState::Active && !PrepareCache(cache)) [[unlikely]]
+		{
+			return TakeShared(classIndex);
+		}
+
+		if (!cache.Heads[classIndex]) [[unlikely]]
+		{
+			cache.Refill(classIndex);
+		}
+
+		FreeBlock* block = cache.Heads[classIndex];
+		cache.Heads[classIndex] = block->Next;
+		--cache.Counts[classIndex];
+		return block;
+	}
+
+	void Free(void* ptr, size_t size) noexcept
+	{
+		if (!ptr)
+		{
+			return;
+		}
+
+		if (size > MAX_BLOCK_SIZE) [[unlikely]]
+		{
+			::operator delete(ptr, size);
+			return;
+		}
+
+		const size_t classIndex = GetClassIndex(size);
+		ThreadCache& cache = t_cache;
+
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+		if (cache.State != CacheState::Active && !PrepareCache(cache)) [[unlikely]]
+		{
+			ReturnChain(classIndex, block, block);
+			return;
+		}
+
+		block->Next = cache.Heads[classIndex];
+		cache.Heads[classIndex] = block;
+
+		if (++cache.Counts[classIndex] > MAX_CACHED) [[unlikely]]
+		{
+			cache.Release(classIndex);
+		}
+	}
+
+	size_t GetBlockSize(size_t size) noexcept
+	{
+		return size > MAX_BLOCK_SIZE ? size : CLASS_SIZES[GetClassIndex(size)];
+	}
+
+	void FlushThreadCache() noexcept
+	{
+		t_cache.Flush();
+	}
+
+	Stats GetStats() noexcept
+	{
+		const size_t slabs = g_slabCount.load(std::memory_order_relaxed);
+		return Stats{ .SlabCount = slabs, .ReservedBytes = slabs * SLAB_SIZE };
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+namespace Ryu::Memory
+{
+	// Size-class allocator for small, short-lived objects. Blocks are carved out of 64 KiB slabs
+	// and recycled through per-thread caches, so the common path is a thread-local list pop/push
+	// and only a refill or overflow touches the shared pool. Slabs are kept for the lifetime of
+	// the process. Blocks may be freed from any thread, but the size has to be passed back in
+	namespace Pool
+	{
+		// Largest size served from the pool, anything bigger goes straight to operator new
+		constexpr size_t MAX_BLOCK_SIZE = 512;
+		constexpr size_t BLOCK_ALIGNMENT = 16;
+
+		struct Stats
+		{
+			size_t SlabCount     = 0;
+			size_t ReservedBytes = 0;  // Bytes held in slabs, used or not
+		};
+
+		[[nodiscard]] void* Allocate(size_t size);
+		void Free(void* ptr, size_t size) noexcept;
+
+		// Size of the class that serves size (what the block can actually hold)
+		[[nodiscard]] size_t GetBlockSize(size_t size) noexcept;
+
+		// Hands this thread's cached blocks back to the shared pool. Done automatically on thread exit,
+		// blocks freed after that (by later thread_local or static destructors) skip the cache
+		void FlushThreadCache() noexcept;
+
+		[[nodiscard]] Stats GetStats() noexcept;
+	}
+
+	// Inherit to give a class operator new/delete that go through the pool. Only for types aligned
+	// to at most BLOCK_ALIGNMENT, a virtual destructor makes delete pass the right size for derived types
+	struct PoolAllocated
+	{
+		static void* operator new(size_t size) { return Pool::Allocate(size); }
+		static void operator delete(void* ptr, size_t size) noexcept { Pool::Free(ptr, size); }
+	};
+}
@@ -1,7 +1,10 @@
 #pragma once
+#include "Memory/PoolAllocator.h"
 #include <utility>
 #include <concepts>
 #include <atomic>
+#include <memory>
+#include <new>
 
 namespace Ryu::Memory
 {
@@ -11,7 +14,8 @@ namespace Ryu::Memory
 	// Control block for managing reference counts
 	namespace Internal
 	{
-		class RefControlBlock
+		// Comes from the small-block pool, so a RefCounted object costs one heap allocation instead of two
+		class RefControlBlock : public PoolAllocated
 		{
 		public:
 			RefControlBlock();
@@ -61,6 +65,19 @@ namespace Ryu::Memory
 		{ t->GetControlBlock() } -> std::same_as<Internal::RefControlBlock*>;
 	};
 
+	// Concept for classes that keep their own counts, see IntrusiveRefCounted
+	template <typename T>
+	concept IntrusiveRefCountable = requires(T * t)
+	{
+		{ t->AddRef() } -> std::same_as<u32>;
+		{ t->TryAddRef() } -> std::same_as<bool>;
+		{ t->Release() } -> std::same_as<u32>;
+		{ t->GetRefCount() } -> std::same_as<u32>;
+		{ t->AddWeakRef() };
+		{ t->ReleaseWeakRef() };
+		{ t->GetWeakCount() } -> std::same_as<u32>;
+	};
+
 	// Mixin class that implements reference counting
 	class RefCounted : public IRefCounted
 	{
@@ -83,6 +100,149 @@ namespace Ryu::Memory
 		mutable Internal::RefControlBlock* m_controlBlock;
 	};
 
+	// Atomic counts can be shared across threads, SingleThreaded ones are plain integers for objects
+	// that never leave the thread that owns them
+	enum class RefCountMode
+	{
+		Atomic,
+		SingleThreaded
+	};
+
+	namespace Internal
+	{
+		template <RefCountMode Mode>
+		class RefCounter
+		{
+		public:
+			explicit constexpr RefCounter(u32 initial) noexcept : m_count(initial) {}
+
+			u32 Increment() noexcept { return m_count.fetch_add(1, std::memory_order_relaxed) + 1; }
+			u32 Decrement() noexcept { return m_count.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+			u32 Load() const noexcept { return m_count.load(std::memory_order_acquire); }
+
+			bool IncrementIfNonZero() noexcept
+			{
+				u32 count = m_count.load(std::memory_order_relaxed);
+				while (count != 0)
+				{
+					if (m_count.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed))
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+		private:
+			std::atomic<u32> m_count;
+		};
+
+		template <>
+		class RefCounter<RefCountMode::SingleThreaded>
+		{
+		public:
+			explicit constexpr RefCounter(u32 initial) noexcept : m_count(initial) {}
+
+			u32 Increment() noexcept { return ++m_count; }
+			u32 Decrement() noexcept { return --m_count; }
+			u32 Load() const noexcept { return m_count; }
+			bool IncrementIfNonZero() noexcept { return m_count != 0 && ++m_count; }
+
+		private:
+			u32 m_count;
+		};
+	}
+
+	// Mixin that keeps the strong and weak counts inside the object, so Ref<Derived> reaches them with
+	// plain inline calls: no vtable, no separate control block. The object is destroyed when the last
+	// strong reference goes, its memory is freed when the last weak one does (like make_shared), through
+	// Derived's own operator delete when it has one (PoolAllocated) and the aligned one when it is over-aligned.
+	// The memory is freed as a Derived, so weak references need Derived to be the type that was allocated
+	template <typename Derived, RefCountMode Mode = RefCountMode::Atomic>
+	class IntrusiveRefCounted
+	{
+	public:
+		static constexpr RefCountMode CountMode = Mode;
+
+		IntrusiveRefCounted() noexcept = default;
+		IntrusiveRefCounted(const IntrusiveRefCounted&) noexcept {}  // A copy is a new object with its own counts
+		IntrusiveRefCounted& operator=(const IntrusiveRefCounted&) noexcept { return *this; }
+
+		u32 AddRef() const noexcept { return m_strong.Increment(); }
+
+		// For WeakRef::Lock(), fails once the object started dying
+		bool TryAddRef() const noexcept { return m_strong.IncrementIfNonZero(); }
+
+		u32 Release() const noexcept
+		{
+			const u32 count = m_strong.Decrement();
+			if (count == 0)
+			{
+				std::destroy_at(const_cast<Derived*>(static_cast<const Derived*>(this)));
+				ReleaseWeakRef();  // The one the strong references held together
+			}
+			return count;
+		}
+
+		u32 GetRefCount() const noexcept { return m_strong.Load(); }
+
+		void AddWeakRef() const noexcept { m_weak.Increment(); }
+
+		void ReleaseWeakRef() const noexcept
+		{
+			if (m_weak.Decrement() == 0)
+			{
+				// The counts are trivially destructible, so they stay usable between the destructor and this
+				Deallocate(const_cast<Derived*>(static_cast<const Derived*>(this)));
+			}
+		}
+
+		u32 GetWeakCount() const noexcept
+		{
+			return m_weak.Load() - (m_strong.Load() > 0 ? 1 : 0);
+		}
+
+	protected:
+		~IntrusiveRefCounted() = default;
+
+	private:
+		// Picks the deallocation function a delete expression on Derived would have used
+		static void Deallocate(void* ptr) noexcept
+		{
+			constexpr bool isOverAligned = alignof(Derived) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+			constexpr std::align_val_t alignment{ alignof(Derived) };
+
+			if constexpr (isOverAligned && requires { Derived::operator delete(ptr, sizeof(Derived), alignment); })
+			{
+				Derived::operator delete(ptr, sizeof(Derived), alignment);
+			}
+			else if constexpr (isOverAligned && requires { Derived::operator delete(ptr, alignment); })
+			{
+				Derived::operator delete(ptr, alignment);
+			}
+			else if constexpr (requires { Derived::operator delete(ptr, sizeof(Derived)); })
+			{
+				Derived::operator delete(ptr, sizeof(Derived));
+			}
+			else if constexpr (requires { Derived::operator delete(ptr); })
+			{
+				Derived::operator delete(ptr);
+			}
+			else if constexpr (isOverAligned)
+			{
+				::operator delete(ptr, sizeof(Derived), alignment);
+			}
+			else
+			{
+				::operator delete(ptr, sizeof(Derived));
+			}
+		}
+
+	private:
+		mutable Internal::RefCounter<Mode> m_strong{ 0 };
+		mutable Internal::RefCounter<Mode> m_weak{ 1 };
+	};
+
 	template <typename T>
 	class Ref
 	{
@@ -102,7 +262,7 @@ namespace Ryu::Memory
 		template<typename U> requires std::convertible_to<U*, T*>
 		Ref(Ref<U>&& other) noexcept : m_ptr(other.Release()) {}
 
-		virtual ~Ref() { DecrementRefCount(); }
+		~Ref() { DecrementRefCount(); }
 
 		template<typename U, typename... Args>
 		static Ref<U> Create(Args&&... args) { return Ref<U>(new U(std::forward<Args>(args)...)); }
@@ -135,7 +295,7 @@ namespace Ryu::Memory
 		{
 			if (m_ptr)
 			{
-				if constexpr (RefCountable<T>) 
+				if constexpr (RefCountable<T> || IntrusiveRefCountable<T>) 
 				{
 					return m_ptr->GetRefCount();
 				}
@@ -151,7 +311,7 @@ namespace Ryu::Memory
 		{
 			if (m_ptr)
 			{
-				if constexpr (RefCountable<T>)
+				if constexpr (RefCountable<T> || IntrusiveRefCountable<T>)
 				{
 					return m_ptr->GetWeakCount();
 				}
@@ -219,7 +379,7 @@ namespace Ryu::Memory
 		{
 			if (m_ptr) 
 			{
-				if constexpr (RefCountable<T>) 
+				if constexpr (RefCountable<T> || IntrusiveRefCountable<T>) 
 				{
 					m_ptr->AddRef();
 				}
@@ -234,7 +394,7 @@ namespace Ryu::Memory
 		{
 			if (m_ptr)
 			{
-				if constexpr (RefCountable<T>) 
+				if constexpr (RefCountable<T> || IntrusiveRefCountable<T>) 
 				{
 					m_ptr->Release();
 				}
@@ -287,6 +447,10 @@ namespace Ryu::Memory
 					m_controlBlock = m_ptr->GetControlBlock();
 					m_ptr->AddWeakRef();
 				}
+				else if constexpr (IntrusiveRefCountable<T>)
+				{
+					m_ptr->AddWeakRef();  // Counts live in the object, there is no control block
+				}
 			}
 		}
 
@@ -326,7 +490,14 @@ namespace Ryu::Memory
 
 		void IncrementWeakCount() noexcept
 		{
-			if (m_controlBlock)
+			if constexpr (IntrusiveRefCountable<T>)
+			{
+				if (m_ptr)
+				{
+					m_ptr->AddWeakRef();
+				}
+			}
+			else if (m_controlBlock)
 			{
 				m_controlBlock->AddWeakRef();
 			}
@@ -334,7 +505,16 @@ namespace Ryu::Memory
 
 		void DecrementWeakCount() noexcept
 		{
-			if (m_controlBlock)
+			if constexpr (IntrusiveRefCountable<T>)
+			{
+				// The object may already be destroyed, this only touches its counts and frees the memory
+				if (m_ptr)
+				{
+					m_ptr->ReleaseWeakRef();
+					m_ptr = nullptr;
+				}
+			}
+			else if (m_controlBlock)
 			{
 				if constexpr (RefCountable<T> || std::derived_from<T, IRefCounted>)
 				{
@@ -359,7 +539,17 @@ namespace Ryu::Memory
 		// Attempt to lock the weak reference and get a strong reference
 		Ref<T> Lock() const noexcept
 		{
-			if (IsValid())
+			if constexpr (IntrusiveRefCountable<T>)
+			{
+				// Adopt the count taken by TryAddRef, the object can't die between the check and the increment
+				Ref<T> ref;
+				if (m_ptr && m_ptr->TryAddRef())
+				{
+					ref.m_ptr = m_ptr;
+				}
+				return ref;
+			}
+			else if (IsValid())
 			{
 				return Ref<T>(m_ptr);
 			}
@@ -368,6 +558,10 @@ namespace Ryu::Memory
 
 		bool IsValid() const noexcept
 		{
+			if constexpr (IntrusiveRefCountable<T>)
+			{
+				return m_ptr && m_ptr->GetRefCount() > 0;
+			}
 			return m_controlBlock && m_controlBlock->IsAlive();
 		}
 
@@ -378,7 +572,11 @@ namespace Ryu::Memory
 
 		u32 GetWeakCount() const noexcept
 		{
-			if (m_controlBlock)
+			if constexpr (IntrusiveRefCountable<T>)
+			{
+				return m_ptr ? m_ptr->GetWeakCount() : 0;
+			}
+			else if (m_controlBlock)
 			{
 				return m_controlBlock->GetWeakCount();
 			}
@@ -387,7 +585,11 @@ namespace Ryu::Memory
 
 		u32 GetRefCount() const noexcept
 		{
-			if (m_controlBlock)
+			if constexpr (IntrusiveRefCountable<T>)
+			{
+				return m_ptr ? m_ptr->GetRefCount() : 0;
+			}
+			else if (m_controlBlock)
 			{
 				return m_controlBlock->GetStrongCount();
 			}
@@ -0,0 +1,230 @@
+#include "Memory/FrameArena.h"
+#include "Memory/New.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Memory::Tests
+{
+	// Roughly the shape of Gfx::RenderItem. BuildFrame is a stand-in workload with the allocation pattern of a
+	// render frame (a list of views, each with a growing item list), it does not run RenderFrameBuilder
+	struct alignas(16) FakeRenderItem
+	{
+		std::array<f32, 16> Transform{};
+		u64 SortKey = 0;
+	};
+
+	struct FakeRenderView
+	{
+		u32 Camera = 0;
+		std::pmr::vector<FakeRenderItem> OpaqueItems;
+	};
+
+	std::pmr::vector<FakeRenderView> BuildFrame(std::pmr::memory_resource* resource, u32 cameraCount, u64 itemCount)
+	{
+		std::pmr::vector<FakeRenderView> views(resource);
+		views.reserve(cameraCount);
+
+		for (u32 camera = 0; camera < cameraCount; ++camera)
+		{
+			FakeRenderView& view = views.emplace_back(camera, std::pmr::vector<FakeRenderItem>(resource));
+			view.OpaqueItems.reserve(itemCount);
+			for (u64 i = 0; i < itemCount; ++i)
+			{
+				view.OpaqueItems.push_back({ .SortKey = (i * 7919) % itemCount });
+			}
+			std::ranges::sort(view.OpaqueItems, {}, &FakeRenderItem::SortKey);
+		}
+
+		return views;
+	}
+
+	bool IsAligned(const void* ptr, size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+	}
+
+	TEST_CASE("Frame arena")
+	{
+		SUBCASE("Allocations are aligned and bump forward")
+		{
+			FrameArena arena(4096);
+
+			void* a = arena.Allocate(3, 1);
+			void* b = arena.Allocate(8, 8);
+			void* c = arena.Allocate(64, 64);
+			f64* d  = arena.AllocateArray<f64>(10);
+
+			CHECK(IsAligned(b, 8));
+			CHECK(IsAligned(c, 64));
+			CHECK(IsAligned(d, alignof(f64)));
+			CHECK(static_cast<std::byte*>(b) > static_cast<std::byte*>(a));
+			CHECK(static_cast<std::byte*>(c) >= static_cast<std::byte*>(b) + 8);
+			CHECK(arena.GetUsedBytes() >= 3 + 8 + 64 + 10 * sizeof(f64));
+		}
+
+		SUBCASE("Buffers rotate and keep the previous frame intact")
+		{
+			FrameArena arena(1024, 2);
+
+			u32* first = arena.AllocateArray<u32>(16);
+			std::fill_n(first, 16, 0xAAAAAAAAu);
+
+			arena.BeginFrame();
+			CHECK(arena.GetUsedBytes() == 0);
+			u32* second = arena.AllocateArray<u32>(16);
+			std::fill_n(second, 16, 0xBBBBBBBBu);
+
+			// Double buffered, the frame before is still readable
+			CHECK(first != second);
+			CHECK(std::all_of(first, first + 16, [](u32 v) { return v == 0xAAAAAAAAu; }));
+
+			// Two frames later the first buffer is handed out again from the start
+			arena.BeginFrame();
+			CHECK(arena.AllocateArray<u32>(16) == first);
+			CHECK(arena.GetFrameIndex() == 2);
+		}
+
+		SUBCASE("Running out spills to the heap, then the buffer grows")
+		{
+			FrameArena arena(256, 1);
+			const size_t initialCapacity = arena.GetCapacity();
+
+			std::vector<std::byte*> blocks;
+			for (u32 i = 0; i < 32; ++i)
+			{
+				std::byte* block = static_cast<std::byte*>(arena.Allocate(100, 16));
+				REQUIRE(block != nullptr);
+				CHECK(IsAligned(block, 16));
+				std::fill_n(block, 100, std::byte{ static_cast<u8>(i) });
+				blocks.push_back(block);
+			}
+
+			// Nothing overwrote anything
+			for (u32 i = 0; i < 32; ++i)
+			{
+				CHECK(std::all_of(blocks[i], blocks[i] + 100, [i](std::byte b) { return b == std::byte{ static_cast<u8>(i) }; }));
+			}
+
+			arena.BeginFrame();
+			CHECK(arena.GetCapacity() >= 32 * 100);
+			CHECK(arena.GetCapacity() > initialCapacity);
+
+			// The same workload now fits without going to the heap
+			const size_t allocationsBefore = GetAllocationCount();
+			for (u32 i = 0; i < 32; ++i)
+			{
+				(void)arena.Allocate(100, 16);
+			}
+			CHECK(GetAllocationCount() == allocationsBefore);
+		}
+
+		SUBCASE("Concurrent allocations don't overlap")
+		{
+			constexpr u64 threadCount = 4, perThread = 2000;
+			FrameArena arena(threadCount * perThread * sizeof(u64) / 2);  // Half of it overflows
+
+			std::vector<std::vector<u64*>> results(threadCount);
+			{
+				std::vector<std::jthread> threads;
+				for (u64 t = 0; t < threadCount; ++t)
+				{
+					threads.emplace_back([&arena, &results, t]
+					{
+						for (u64 i = 0; i < perThread; ++i)
+						{
+							u64* value = arena.AllocateArray<u64>(1);
+							*value = t * perThread + i;
+							results[t].push_back(value);
+						}
+					});
+				}
+			}
+
+			bool intact = true;
+			std::vector<u64*> all;
+			for (u64 t = 0; t < threadCount; ++t)
+			{
+				for (u64 i = 0; i < perThread; ++i)
+				{
+					intact &= (*results[t][i] == t * perThread + i);
+					all.push_back(results[t][i]);
+				}
+			}
+
+			std::ranges::sort(all);
+			CHECK(intact);
+			CHECK(std::ranges::adjacent_find(all) == all.end());
+		}
+	}
+
+	TEST_CASE("Frame arena steady state")
+	{
+		constexpr u32 cameraCount = 2;
+		constexpr u64 itemCount = 5000;
+
+		FrameArena arena(64 * 1024);  // Too small on purpose, the first frames grow it
+
+		// Warm up: one full cycle through both buffers sizes them
+		for (u32 frame = 0; frame < 4; ++frame)
+		{
+			arena.BeginFrame();
+			(void)BuildFrame(arena.GetResource(), cameraCount, itemCount);
+		}
+
+		const UsageStats before = GetUsageStats();
+		for (u32 frame = 0; frame < 100; ++frame)
+		{
+			arena.BeginFrame();
+			auto views = BuildFrame(arena.GetResource(), cameraCount, itemCount);
+			REQUIRE(views.size() == cameraCount);
+			CHECK(views[0].OpaqueItems.size() == itemCount);
+		}
+		const UsageStats after = GetUsageStats();
+
+		// Once warm, a repeating frame of pmr allocations never touches the heap. What the real extraction
+		// allocates outside its memory resource is up to RenderFrameBuilder, this only covers the arena
+		CHECK(after.AllocationCount == before.AllocationCount);
+		CHECK(after.TotalAllocated == before.TotalAllocated);
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Frame arena benchmark" * doctest::skip())
+	{
+		constexpr u32 frames = 200, cameraCount = 2;
+
+		for (u64 itemCount : { 100ull, 1000ull, 10'000ull })
+		{
+			f64 heapUs = 0.0, arenaUs = 0.0;
+			size_t heapAllocations = 0;
+			{
+				const size_t before = GetAllocationCount();
+				Utils::Stopwatch timer(true);
+				for (u32 frame = 0; frame < frames; ++frame)
+				{
+					(void)BuildFrame(std::pmr::new_delete_resource(), cameraCount, itemCount);
+				}
+				heapUs = timer.Elapsed<std::chrono::microseconds>();
+				heapAllocations = GetAllocationCount() - before;
+			}
+			{
+				FrameArena arena;
+				Utils::Stopwatch timer(true);
+				for (u32 frame = 0; frame < frames; ++frame)
+				{
+					arena.BeginFrame();
+					(void)BuildFrame(arena.GetResource(), cameraCount, itemCount);
+				}
+				arenaUs = timer.Elapsed<std::chrono::microseconds>();
+			}
+
+			MESSAGE(itemCount << " items, us per frame: heap " << heapUs / frames << " (" << heapAllocations / frames
+				<< " allocations) | frame arena " << arenaUs / frames);
+		}
+	}
+}
@@ -0,0 +1,273 @@
+#include "Memory/New.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Memory::Tests
+{
+	// Allocates through the global operator new and touches the memory so the pair can't be optimized away
+	std::vector<std::unique_ptr<char[]>> AllocateBlocks(u64 count, size_t size)
+	{
+		std::vector<std::unique_ptr<char[]>> blocks;
+		blocks.reserve(count);
+		for (u64 i = 0; i < count; ++i)
+		{
+			blocks.emplace_back(new char[size]);
+			std::memset(blocks.back().get(), static_cast<int>(i), size);
+		}
+		return blocks;
+	}
+
+	// What the tracking used to do: five shared atomics and a CAS loop per allocation.
+	// Kept here only as a benchmark baseline
+	struct SharedUsageStats
+	{
+		std::atomic<size_t> TotalAllocated{ 0 };
+		std::atomic<size_t> CurrentUsage{ 0 };
+		std::atomic<size_t> PeakUsage{ 0 };
+		std::atomic<size_t> AllocationCount{ 0 };
+		std::atomic<size_t> DeallocationCount{ 0 };
+
+		void AddAllocation(size_t size)
+		{
+			TotalAllocated += size;
+			CurrentUsage += size;
+
+			const size_t current = CurrentUsage.load();
+			size_t peak = PeakUsage.load();
+			while (current > peak && !PeakUsage.compare_exchange_weak(peak, current))
+			{
+			}
+
+			AllocationCount++;
+		}
+
+		void RemoveAllocation(size_t size)
+		{
+			CurrentUsage -= size;
+			DeallocationCount++;
+		}
+	};
+
+	TEST_CASE("Memory tracking")
+	{
+		REQUIRE(IsMemoryTrackingEnabled());
+
+		SUBCASE("Allocations from other threads are merged on query")
+		{
+			constexpr u64 threadCount = 4, blockCount = 100;
+			constexpr size_t blockSize = 256;
+
+			const UsageStats before = GetUsageStats();
+			std::vector<std::vector<std::unique_ptr<char[]>>> perThread(threadCount);
+			{
+				std::vector<std::jthread> threads;
+				for (u64 t = 0; t < threadCount; ++t)
+				{
+					threads.emplace_back([&perThread, t] { perThread[t] = AllocateBlocks(blockCount, blockSize); });
+				}
+			}
+
+			// The threads are gone, what they allocated still counts
+			const UsageStats during = GetUsageStats();
+			CHECK(during.AllocationCount - before.AllocationCount >= threadCount * blockCount);
+			CHECK(during.CurrentUsage - before.CurrentUsage >= threadCount * blockCount * blockSize);
+			CHECK(during.PeakUsage >= during.CurrentUsage);
+
+			// Freed on this thread, charged back correctly
+			perThread.clear();
+			const UsageStats after = GetUsageStats();
+			CHECK(after.DeallocationCount - before.DeallocationCount >= threadCount * blockCount);
+			CHECK(after.CurrentUsage < during.CurrentUsage);
+		}
+
+		SUBCASE("Scoped tags charge allocations to the tag")
+		{
+			const size_t assetBefore  = GetCurrentUsage(AllocationTag::Asset);
+			const size_t renderBefore = GetCurrentUsage(AllocationTag::Render);
+			CHECK(GetCurrentAllocationTag() == AllocationTag::General);
+
+			std::vector<std::unique_ptr<char[]>> assetBlocks, renderBlocks;
+			{
+				ScopedAllocationTag assetTag(AllocationTag::Asset);
+				assetBlocks = AllocateBlocks(10, 1000);
+				{
+					ScopedAllocationTag renderTag(AllocationTag::Render);
+					CHECK(GetCurrentAllocationTag() == AllocationTag::Render);
+					renderBlocks = AllocateBlocks(4, 500);
+				}
+				CHECK(GetCurrentAllocationTag() == AllocationTag::Asset);
+			}
+			CHECK(GetCurrentAllocationTag() == AllocationTag::General);
+
+			// The vectors' own buffers were tagged too, so only a lower bound holds
+			CHECK(GetCurrentUsage(AllocationTag::Asset) - assetBefore >= 10 * 1000);
+			CHECK(GetCurrentUsage(AllocationTag::Render) - renderBefore >= 4 * 500);
+			CHECK(GetUsageStats(AllocationTag::Asset).PeakUsage == 0);
+
+			// Freeing from another thread still un-charges the tag the block was allocated with
+			std::jthread([&] { assetBlocks.clear(); }).join();
+			CHECK(GetCurrentUsage(AllocationTag::Asset) < assetBefore + 10 * 1000);
+
+			renderBlocks.clear();
+			CHECK(GetCurrentUsage(AllocationTag::Render) < renderBefore + 4 * 500);
+			CHECK(GetDeallocationCount(AllocationTag::Render) >= 4);
+		}
+
+		SUBCASE("Totals add up across tags")
+		{
+			UsageStats tagged{};
+			for (u8 tag = 0; tag < static_cast<u8>(AllocationTag::Count); ++tag)
+			{
+				const UsageStats stats = GetUsageStats(static_cast<AllocationTag>(tag));
+				tagged.AllocationCount += stats.AllocationCount;
+				tagged.TotalAllocated  += stats.TotalAllocated;
+			}
+
+			const UsageStats total = GetUsageStats();
+			CHECK(tagged.AllocationCount == total.AllocationCount);
+			CHECK(tagged.TotalAllocated == total.TotalAllocated);
+			CHECK(EnumToString(AllocationTag::ECS) == "ECS");
+		}
+	}
+
+	template <size_t Alignment>
+	struct alignas(Alignment) OverAligned
+	{
+		std::array<f32, 4> Data{};
+	};
+
+	template <typename T>
+	bool IsAligned(const T* ptr)
+	{
+		return reinterpret_cast<uintptr_t>(ptr) % alignof(T) == 0;
+	}
+
+	template <size_t Alignment>
+	void CheckOverAligned()
+	{
+		using T = OverAligned<Alignment>;
+		static_assert(alignof(T) == Alignment);
+
+		const UsageStats before = GetUsageStats();
+
+		T* single = new T();
+		T* array  = new T[7];
+		std::vector<T> vector(13);
+
+		CHECK(IsAligned(single));
+		CHECK(IsAligned(array));
+		CHECK(IsAligned(array + 1));
+		CHECK(IsAligned(vector.data()));
+
+		const UsageStats during = GetUsageStats();
+		CHECK(during.AllocationCount - before.AllocationCount >= 3);
+		CHECK(during.CurrentUsage - before.CurrentUsage >= (1 + 7 + 13) * sizeof(T));
+
+		delete single;
+		delete[] array;
+		std::vector<T>().swap(vector);
+
+		const UsageStats after = GetUsageStats();
+		CHECK(after.DeallocationCount - before.DeallocationCount >= 3);
+		CHECK(after.CurrentUsage == before.CurrentUsage);
+	}
+
+	TEST_CASE("Aligned allocations")
+	{
+		SUBCASE("Plain new keeps the default new alignment")
+		{
+			for (size_t size : { 1ull, 8ull, 24ull, 100ull, 4096ull })
+			{
+				auto block = std::make_unique<char[]>(size);
+				CHECK(reinterpret_cast<uintptr_t>(block.get()) % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0);
+			}
+		}
+
+		SUBCASE("Over-aligned types are aligned and tracked")
+		{
+			CheckOverAligned<32>();
+			CheckOverAligned<64>();
+			CheckOverAligned<256>();
+			CheckOverAligned<4096>();
+		}
+
+		SUBCASE("Explicit align_val_t forms")
+		{
+			const UsageStats before = GetUsageStats();
+
+			void* ptr = ::operator new(1000, std::align_val_t{ 128 });
+			CHECK(reinterpret_cast<uintptr_t>(ptr) % 128 == 0);
+			::operator delete(ptr, 1000, std::align_val_t{ 128 });
+
+			void* nothrowPtr = ::operator new[](64, std::align_val_t{ 64 }, std::nothrow);
+			REQUIRE(nothrowPtr != nullptr);
+			CHECK(reinterpret_cast<uintptr_t>(nothrowPtr) % 64 == 0);
+			::operator delete[](nothrowPtr, std::align_val_t{ 64 }, std::nothrow);
+
+			const UsageStats after = GetUsageStats();
+			CHECK(after.AllocationCount - before.AllocationCount == 2);
+			CHECK(after.DeallocationCount - before.DeallocationCount == 2);
+			CHECK(after.TotalAllocated - before.TotalAllocated == 1064);
+			CHECK(after.CurrentUsage == before.CurrentUsage);
+		}
+
+		SUBCASE("Tags survive the aligned path")
+		{
+			const size_t before = GetCurrentUsage(AllocationTag::Render);
+
+			OverAligned<64>* value = nullptr;
+			{
+				ScopedAllocationTag tag(AllocationTag::Render);
+				value = new OverAligned<64>();
+			}
+
+			CHECK(GetCurrentUsage(AllocationTag::Render) == before + sizeof(OverAligned<64>));
+			delete value;
+			CHECK(GetCurrentUsage(AllocationTag::Render) == before);
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Memory tracking benchmark" * doctest::skip())
+	{
+		constexpr u64 iterations = 1'000'000;
+		constexpr size_t size = 64;
+
+		SharedUsageStats sharedStats;
+
+		// Untracked: straight malloc/free, which is what new/delete cost with RYU_ENABLE_MEMORY_STATS 0
+		auto untracked = [] { for (u64 i = 0; i < iterations; ++i) { void* p = std::malloc(size); static_cast<volatile char*>(p)[0] = 1; std::free(p); } };
+		auto shared    = [&sharedStats] { for (u64 i = 0; i < iterations; ++i) { void* p = std::malloc(size); sharedStats.AddAllocation(size); static_cast<volatile char*>(p)[0] = 1; sharedStats.RemoveAllocation(size); std::free(p); } };
+		auto tracked   = [] { for (u64 i = 0; i < iterations; ++i) { char* p = new char[size]; static_cast<volatile char*>(p)[0] = 1; delete[] p; } };
+
+		auto run = [](u64 threadCount, auto&& body)
+		{
+			Utils::Stopwatch timer(true);
+			{
+				std::vector<std::jthread> threads;
+				for (u64 t = 0; t < threadCount; ++t)
+				{
+					threads.emplace_back(body);
+				}
+			}
+			return timer.Elapsed<std::chrono::microseconds>() * 1000.0 / static_cast<f64>(iterations * threadCount);
+		};
+
+		for (u64 threadCount : { 1ull, 2ull, 4ull, 8ull })
+		{
+			const f64 untrackedNs = run(threadCount, untracked);
+			const f64 sharedNs    = run(threadCount, shared);
+			const f64 trackedNs   = run(threadCount, tracked);
+
+			MESSAGE(threadCount << " threads, ns per new/delete pair: untracked " << untrackedNs
+				<< " | shared atomics " << sharedNs << " | per-thread counters " << trackedNs);
+		}
+	}
+}
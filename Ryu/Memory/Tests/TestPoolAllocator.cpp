@@ -0,0 +1,200 @@
+#include "Memory/PoolAllocator.h"
+#include "Memory/ObjectPool.h"
+#include "Memory/New.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::Memory::Tests
+{
+	struct Tracked
+	{
+		static inline i32 s_alive = 0;
+
+		explicit Tracked(i32 value) : Value(value) { ++s_alive; }
+		~Tracked() { --s_alive; }
+
+		i32 Value;
+	};
+
+	struct ThrowsOnConstruct
+	{
+		ThrowsOnConstruct() { throw std::runtime_error("No"); }
+	};
+
+	TEST_CASE("Pool allocator")
+	{
+		SUBCASE("Blocks are aligned and sized by class")
+		{
+			for (size_t size : { 1ull, 16ull, 17ull, 100ull, 129ull, 300ull, 512ull })
+			{
+				void* ptr = Pool::Allocate(size);
+				CHECK(reinterpret_cast<uintptr_t>(ptr) % Pool::BLOCK_ALIGNMENT == 0);
+				CHECK(Pool::GetBlockSize(size) >= size);
+				std::memset(ptr, 0xCD, Pool::GetBlockSize(size));
+				Pool::Free(ptr, size);
+			}
+
+			CHECK(Pool::GetBlockSize(0) == 16);
+			CHECK(Pool::GetBlockSize(129) == 160);
+			CHECK(Pool::GetBlockSize(4096) == 4096);  // Past the pool, plain operator new
+		}
+
+		SUBCASE("Freed blocks are reused without touching the heap")
+		{
+			std::vector<void*> blocks(100);
+			std::ranges::generate(blocks, [] { return Pool::Allocate(48); });
+			std::ranges::for_each(blocks, [](void* p) { Pool::Free(p, 48); });
+
+			const size_t before = GetAllocationCount();
+			std::ranges::generate(blocks, [] { return Pool::Allocate(40); });  // Same class
+			CHECK(GetAllocationCount() == before);
+
+			std::ranges::sort(blocks);
+			CHECK(std::ranges::adjacent_find(blocks) == blocks.end());
+			std::ranges::for_each(blocks, [](void* p) { Pool::Free(p, 40); });
+		}
+
+		SUBCASE("Blocks can be freed on another thread")
+		{
+			constexpr u64 count = 10'000;
+			std::vector<u64*> blocks(count);
+
+			std::jthread([&blocks]
+			{
+				for (u64 i = 0; i < count; ++i)
+				{
+					blocks[i] = static_cast<u64*>(Pool::Allocate(sizeof(u64) * 4));
+					*blocks[i] = i;
+				}
+			}).join();
+
+			bool intact = true;
+			for (u64 i = 0; i < count; ++i)
+			{
+				intact &= (*blocks[i] == i);
+				Pool::Free(blocks[i], sizeof(u64) * 4);
+			}
+			CHECK(intact);
+			Pool::FlushThreadCache();
+		}
+
+		SUBCASE("Frees after the thread cache flushed on exit reach the shared pool")
+		{
+			// Constructed before the thread's first pool use, so it is destroyed after the cache flushed
+			struct FreeOnExit
+			{
+				void* Block = nullptr;
+				~FreeOnExit() { Pool::Free(Block, 448); }
+			};
+
+			void* block = nullptr;
+			std::jthread([&block]
+			{
+				thread_local FreeOnExit freeOnExit;
+				freeOnExit.Block = block = Pool::Allocate(448);
+			}).join();
+
+			// Pushed onto the shared list, the next refill hands it out first
+			Pool::FlushThreadCache();
+			void* reused = Pool::Allocate(448);
+			CHECK(reused == block);
+			Pool::Free(reused, 448);
+		}
+
+		SUBCASE("Concurrent allocate and free")
+		{
+			constexpr u64 threadCount = 4, rounds = 200, perRound = 100;
+
+			std::vector<std::jthread> threads;
+			std::atomic<bool> ok{ true };
+			for (u64 t = 0; t < threadCount; ++t)
+			{
+				threads.emplace_back([&ok, t]
+				{
+					std::vector<u64*> live;
+					for (u64 r = 0; r < rounds; ++r)
+					{
+						for (u64 i = 0; i < perRound; ++i)
+						{
+							u64* block = static_cast<u64*>(Pool::Allocate(64));
+							*block = t;
+							live.push_back(block);
+						}
+
+						// Free every other one, so the caches overflow and refill
+						for (size_t i = 0; i < live.size(); i += 2)
+						{
+							if (*live[i] != t) { ok = false; }
+							Pool::Free(live[i], 64);
+							live[i] = nullptr;
+						}
+						std::erase(live, nullptr);
+					}
+
+					for (u64* block : live)
+					{
+						if (*block != t) { ok = false; }
+						Pool::Free(block, 64);
+					}
+				});
+			}
+			threads.clear();
+
+			CHECK(ok.load());
+			CHECK(Pool::GetStats().SlabCount > 0);
+		}
+	}
+
+	TEST_CASE("Object pool")
+	{
+		SUBCASE("Create and destroy run constructors and destructors")
+		{
+			ObjectPool<Tracked, 8> pool;
+
+			std::vector<Tracked*> objects;
+			for (i32 i = 0; i < 20; ++i)
+			{
+				objects.push_back(pool.Create(i));
+			}
+
+			CHECK(Tracked::s_alive == 20);
+			CHECK(pool.GetLiveCount() == 20);
+			CHECK(pool.GetCapacity() == 24);
+			CHECK(objects[13]->Value == 13);
+
+			for (Tracked* object : objects)
+			{
+				pool.Destroy(object);
+			}
+			CHECK(Tracked::s_alive == 0);
+			CHECK(pool.GetLiveCount() == 0);
+		}
+
+		SUBCASE("Slots are recycled")
+		{
+			ObjectPool<Tracked, 4> pool;
+
+			Tracked* first = pool.Create(1);
+			pool.Destroy(first);
+			Tracked* second = pool.Create(2);
+
+			CHECK(first == second);
+			CHECK(pool.GetCapacity() == 4);
+			pool.Destroy(second);
+		}
+
+		SUBCASE("A throwing constructor leaves the pool intact")
+		{
+			ObjectPool<ThrowsOnConstruct, 2> pool;
+			CHECK_THROWS_AS((void)pool.Create(), std::runtime_error);
+			CHECK(pool.GetLiveCount() == 0);
+		}
+	}
+}
@@ -1,4 +1,11 @@
 #include "Memory/Ref.h"
+#include "Memory/New.h"
+#include "Memory/ObjectPool.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest/doctest.h"
@@ -19,6 +26,37 @@ namespace Ryu::Memory::Tests
         int m_value;
     };
 
+    template <RefCountMode Mode>
+    class IntrusiveObject : public IntrusiveRefCounted<IntrusiveObject<Mode>, Mode>
+    {
+    public:
+        static inline int s_alive = 0;
+
+        explicit IntrusiveObject(int value = 0) : m_value(value) { ++s_alive; }
+        ~IntrusiveObject() { --s_alive; }
+
+        int GetValue() const { return m_value; }
+
+    private:
+        int m_value;
+    };
+
+    using AtomicIntrusive = IntrusiveObject<RefCountMode::Atomic>;
+    using LocalIntrusive  = IntrusiveObject<RefCountMode::SingleThreaded>;
+
+    // The last Release has to go through the class's own operator delete
+    class PooledIntrusive : public IntrusiveRefCounted<PooledIntrusive>, public PoolAllocated
+    {
+    public:
+        std::array<u64, 4> Payload{};
+    };
+
+    class alignas(64) AlignedIntrusive : public IntrusiveRefCounted<AlignedIntrusive>
+    {
+    public:
+        std::array<f32, 16> Values{};
+    };
+
     // Derived class for testing inheritance
     class DerivedTestObject : public TestObject
     {
@@ -661,5 +699,300 @@ namespace Ryu::Memory::Tests
         }
     }
 
+    TEST_CASE("Ref allocations")
+    {
+        SUBCASE("Control blocks come from the pool")
+        {
+            // Warm up this thread's pool cache
+            (void)Ref<TestObject>(new TestObject(1));
+
+            const size_t before = GetAllocationCount();
+            {
+                Ref<TestObject> ref(new TestObject(42));
+                WeakRef<TestObject> weak(ref);
+                CHECK(weak.IsValid());
+            }
+            CHECK(GetAllocationCount() - before == 1);  // Just the object
+        }
+
+        SUBCASE("Control block outlives the object for weak references")
+        {
+            WeakRef<TestObject> weak;
+            {
+                Ref<TestObject> ref(new TestObject(42));
+                weak = ref;
+            }
+
+            // Freed back to the pool once the last weak reference goes
+            CHECK(weak.IsExpired());
+            weak.Reset();
+            CHECK(weak.GetWeakCount() == 0);
+        }
+    }
+
+    TEST_CASE("Intrusive Ref")
+    {
+        SUBCASE("Counts live in the object")
+        {
+            static_assert(sizeof(LocalIntrusive) == 3 * sizeof(u32));
+            static_assert(!std::is_polymorphic_v<AtomicIntrusive>);
+
+            const size_t before = GetAllocationCount();
+            {
+                Ref<AtomicIntrusive> ref1(new AtomicIntrusive(42));
+                Ref<AtomicIntrusive> ref2 = ref1;
+                CHECK(ref1.GetRefCount() == 2);
+                CHECK(ref2->GetValue() == 42);
+                CHECK(AtomicIntrusive::s_alive == 1);
+            }
+            CHECK(AtomicIntrusive::s_alive == 0);
+            CHECK(GetAllocationCount() - before == 1);
+        }
+
+        SUBCASE("Weak references keep the memory, not the object")
+        {
+            WeakRef<LocalIntrusive> weak;
+            {
+                Ref<LocalIntrusive> ref(new LocalIntrusive(7));
+                weak = ref;
+
+                CHECK(weak.IsValid());
+                CHECK(weak.GetWeakCount() == 1);
+                CHECK(weak.GetRefCount() == 1);
+                CHECK(ref.GetWeakCount() == 1);
+
+                Ref<LocalIntrusive> locked = weak.Lock();
+                CHECK(locked->GetValue() == 7);
+                CHECK(ref.GetRefCount() == 2);
+            }
+
+            CHECK(LocalIntrusive::s_alive == 0);  // Destroyed with the last strong reference
+            CHECK(weak.IsExpired());
+            CHECK(weak.GetRefCount() == 0);
+            CHECK(weak.GetWeakCount() == 1);
+            CHECK(weak.Lock() == nullptr);
+
+            WeakRef<LocalIntrusive> copy = weak;
+            CHECK(copy.GetWeakCount() == 2);
+            weak.Reset();
+            copy.Reset();  // Frees the memory
+            CHECK(copy.GetWeakCount() == 0);
+        }
 
+        SUBCASE("The memory goes back through the type's operator delete")
+        {
+            {
+                Ref<PooledIntrusive> warmUp(new PooledIntrusive);  // First use may carve a slab
+            }
+
+            // Pool blocks go back to the pool, nothing reaches the global heap
+            const size_t before = GetAllocationCount();
+            for (int i = 0; i < 100; ++i)
+            {
+                Ref<PooledIntrusive> ref(new PooledIntrusive);
+                Ref<PooledIntrusive> copy = ref;
+                copy->Payload[0] = static_cast<u64>(i);
+            }
+            CHECK(GetAllocationCount() == before);
+
+            // Also when a weak reference outlives the object
+            for (int i = 0; i < 100; ++i)
+            {
+                WeakRef<PooledIntrusive> weak;
+                {
+                    Ref<PooledIntrusive> ref(new PooledIntrusive);
+                    weak = ref;
+                    CHECK(weak.Lock() == ref);
+                }
+                CHECK(weak.IsExpired());
+                CHECK(weak.Lock() == nullptr);
+            }
+            CHECK(GetAllocationCount() == before);
+
+            // Over-aligned types come back through the aligned delete
+            Ref<AlignedIntrusive> aligned(new AlignedIntrusive);
+            CHECK(reinterpret_cast<uintptr_t>(aligned.Get()) % 64 == 0);
+
+            WeakRef<AlignedIntrusive> weakAligned(aligned);
+            aligned = nullptr;
+            CHECK(weakAligned.IsExpired());
+            CHECK(weakAligned.GetWeakCount() == 1);
+            weakAligned.Reset();
+        }
+
+        SUBCASE("Atomic counts hold up across threads")
+        {
+            Ref<AtomicIntrusive> ref(new AtomicIntrusive(1));
+            WeakRef<AtomicIntrusive> weak(ref);
+            {
+                std::vector<std::jthread> threads;
+                for (int t = 0; t < 4; ++t)
+                {
+                    threads.emplace_back([ref, weak]
+                    {
+                        for (int i = 0; i < 10'000; ++i)
+                        {
+                            Ref<AtomicIntrusive> copy = ref;
+                            Ref<AtomicIntrusive> locked = weak.Lock();
+                            (void)locked;
+                        }
+                    });
+                }
+            }
+
+            CHECK(ref.GetRefCount() == 1);
+            CHECK(weak.GetWeakCount() == 1);
+            ref = nullptr;
+            CHECK(AtomicIntrusive::s_alive == 0);
+            CHECK(weak.IsExpired());
+        }
+
+        SUBCASE("Locking races the last release")
+        {
+            // Whoever wins, the object dies once and the memory is freed once
+            for (int round = 0; round < 200; ++round)
+            {
+                Ref<AtomicIntrusive> ref(new AtomicIntrusive(round));
+                WeakRef<AtomicIntrusive> weak(ref);
+                {
+                    std::jthread locker([weak]
+                    {
+                        for (int i = 0; i < 100; ++i)
+                        {
+                            if (Ref<AtomicIntrusive> locked = weak.Lock())
+                            {
+                                CHECK(AtomicIntrusive::s_alive == 1);
+                            }
+                        }
+                    });
+                    ref = nullptr;
+                }
+                CHECK(AtomicIntrusive::s_alive == 0);
+                CHECK(weak.IsExpired());
+            }
+        }
+    }
+
+    // Run with --no-skip to include the benchmarks
+    TEST_CASE("Ref allocation benchmark" * doctest::skip())
+    {
+        constexpr u64 iterations = 1'000'000;
+
+        auto allocationsPer = [](auto&& body)
+        {
+            const size_t before = GetAllocationCount();
+            for (u64 i = 0; i < 1000; ++i)
+            {
+                body(i);
+            }
+            return static_cast<f64>(GetAllocationCount() - before) / 1000.0;
+        };
+
+        auto nsPer = [](u64 threadCount, auto&& body)
+        {
+            Utils::Stopwatch timer(true);
+            {
+                std::vector<std::jthread> threads;
+                for (u64 t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&body] { for (u64 i = 0; i < iterations; ++i) { body(i); } });
+                }
+            }
+            return timer.Elapsed<std::chrono::microseconds>() * 1000.0 / static_cast<f64>(iterations * threadCount);
+        };
+
+        auto ref        = [](u64 i) { Ref<TestObject> r(new TestObject(static_cast<int>(i))); volatile int v = r->GetValue(); (void)v; };
+        auto shared     = [](u64 i) { std::shared_ptr<int> p(new int(static_cast<int>(i))); volatile int v = *p; (void)v; };
+        auto makeShared = [](u64 i) { auto p = std::make_shared<int>(static_cast<int>(i)); volatile int v = *p; (void)v; };
+
+        MESSAGE("Heap allocations per object: Ref " << allocationsPer(ref)
+            << " | shared_ptr(new) " << allocationsPer(shared) << " | make_shared " << allocationsPer(makeShared));
+
+        for (u64 threadCount : { 1ull, 4ull })
+        {
+            MESSAGE(threadCount << " threads, ns per create/destroy: Ref " << nsPer(threadCount, ref)
+                << " | shared_ptr(new) " << nsPer(threadCount, shared) << " | make_shared " << nsPer(threadCount, makeShared));
+        }
+
+        // Raw block throughput, the control block size class
+        auto heapBlock = [](u64) { void* p = ::operator new(16); static_cast<volatile char*>(p)[0] = 1; ::operator delete(p, 16); };
+        auto poolBlock = [](u64) { void* p = Pool::Allocate(16); static_cast<volatile char*>(p)[0] = 1; Pool::Free(p, 16); };
+
+        for (u64 threadCount : { 1ull, 4ull })
+        {
+            MESSAGE(threadCount << " threads, ns per 16 byte block: operator new " << nsPer(threadCount, heapBlock)
+                << " | pool " << nsPer(threadCount, poolBlock));
+        }
+
+        // Typed pool against new/delete for a batch of objects alive at once
+        {
+            constexpr u64 batch = 1000, rounds = 1000;
+            std::vector<TestObject*> objects(batch);
+
+            Utils::Stopwatch timer(true);
+            for (u64 r = 0; r < rounds; ++r)
+            {
+                for (u64 i = 0; i < batch; ++i) { objects[i] = new TestObject(static_cast<int>(i)); }
+                for (u64 i = 0; i < batch; ++i) { delete objects[i]; }
+            }
+            const f64 heapNs = timer.Elapsed<std::chrono::microseconds>() * 1000.0 / (batch * rounds);
+
+            ObjectPool<TestObject> pool;
+            timer.Restart();
+            for (u64 r = 0; r < rounds; ++r)
+            {
+                for (u64 i = 0; i < batch; ++i) { objects[i] = pool.Create(static_cast<int>(i)); }
+                for (u64 i = 0; i < batch; ++i) { pool.Destroy(objects[i]); }
+            }
+            const f64 poolNs = timer.Elapsed<std::chrono::microseconds>() * 1000.0 / (batch * rounds);
+
+            MESSAGE("ns per object, batches of " << batch << ": new/delete " << heapNs << " | ObjectPool " << poolNs);
+        }
+    }
+
+    // Run with --no-skip to include the benchmarks
+    TEST_CASE("Ref copy benchmark" * doctest::skip())
+    {
+        constexpr u64 iterations = 10'000'000;
+
+        // Copies into a small ring and drops the oldest, so every step is one increment and one decrement
+        auto nsPerCopy = [](const auto& source)
+        {
+            std::array<std::remove_cvref_t<decltype(source)>, 8> ring;
+            Utils::Stopwatch timer(true);
+            for (u64 i = 0; i < iterations; ++i)
+            {
+                ring[i & 7] = source;
+            }
+            return timer.Elapsed<std::chrono::microseconds>() * 1000.0 / static_cast<f64>(iterations);
+        };
+
+        const Ref<TestObject> virtualRef(new TestObject(1));
+        const Ref<AtomicIntrusive> atomicRef(new AtomicIntrusive(1));
+        const Ref<LocalIntrusive> localRef(new LocalIntrusive(1));
+        const std::shared_ptr<int> shared = std::make_shared<int>(1);
+
+        MESSAGE("ns per copy/destroy: Ref (RefCounted) " << nsPerCopy(virtualRef)
+            << " | Ref (intrusive atomic) " << nsPerCopy(atomicRef)
+            << " | Ref (intrusive single thread) " << nsPerCopy(localRef)
+            << " | shared_ptr " << nsPerCopy(shared));
+
+        // Four threads hammering the same object, the contended case for the atomic counts
+        auto contended = [](const auto& source)
+        {
+            Utils::Stopwatch timer(true);
+            {
+                std::vector<std::jthread> threads;
+                for (int t = 0; t < 4; ++t)
+                {
+                    threads.emplace_back([&source] { for (u64 i = 0; i < iterations / 4; ++i) { auto copy = source; } });
+                }
+            }
+            return timer.Elapsed<std::chrono::microseconds>() * 1000.0 / static_cast<f64>(iterations);
+        };
+
+        MESSAGE("4 threads, ns per copy/destroy: Ref (RefCounted) " << contended(virtualRef)
+            << " | Ref (intrusive atomic) " << contended(atomicRef)
+            << " | shared_ptr " << contended(shared));
+    }
 }
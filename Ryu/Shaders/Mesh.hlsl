@@ -19,12 +19,22 @@ cbuffer cbPerObject : register(b1)
 	//float4x4 gNormalMatrix; // Inverse transpose of world for lighting
 }
 
+// Packed vertex layouts (Asset::VertexLayout) get their own vertex shader, see the Mesh*.hlsl files.
+// Half texcoords and RGBA8 colors need nothing, the input assembler turns them into floats
+//   OCTAHEDRAL_NORMALS - normals come in as 2x snorm16
+//   NO_VERTEX_COLOR    - no color in the vertex, every vertex is white
 struct VSInput
 {
 	float3 position : POSITION;
+#ifdef OCTAHEDRAL_NORMALS
+	float2 normal   : NORMAL;
+#else
 	float3 normal   : NORMAL;
+#endif
 	float2 texcoord : TEXCOORD;
+#ifndef NO_VERTEX_COLOR
 	float4 color    : COLOR;
+#endif
 	uint vertexID   : SV_VertexID;
 };
 
@@ -37,6 +47,33 @@ struct PSInput
 	float4 color    : COLOR;
 };
 
+// Same as VertexPacking::DecodeOctahedral
+float3 DecodeOctahedral(float2 encoded)
+{
+	float3 n = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+	float t = saturate(-n.z);
+	n.xy += lerp(t.xx, -t.xx, step(0.0f, n.xy));
+	return normalize(n);
+}
+
+float3 ReadNormal(VSInput input)
+{
+#ifdef OCTAHEDRAL_NORMALS
+	return DecodeOctahedral(input.normal);
+#else
+	return input.normal;
+#endif
+}
+
+float4 ReadColor(VSInput input)
+{
+#ifdef NO_VERTEX_COLOR
+	return float4(1.0f, 1.0f, 1.0f, 1.0f);
+#else
+	return input.color;
+#endif
+}
+
 [RootSignature(RootSig)]
 PSInput VSMain(VSInput input)
 {
@@ -46,9 +83,9 @@ PSInput VSMain(VSInput input)
 	result.position = mul(float4(input.position, 1.0f), gWorldViewProj);
 	result.worldPos = worldPos.xyz;
 	result.normal = float3(1.0f, 1.0f, 1.0f);
-	//result.normal = mul((float3x3) gNormalMatrix, input.normal);
+	//result.normal = mul((float3x3) gNormalMatrix, ReadNormal(input));
 	result.texcoord = input.texcoord;
-	result.color = input.color;
+	result.color = ReadColor(input);
 	
 	return result;
 }
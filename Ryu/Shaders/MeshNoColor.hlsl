@@ -0,0 +1,2 @@
+#define NO_VERTEX_COLOR
+#include "Mesh.hlsl"
@@ -0,0 +1,2 @@
+#define OCTAHEDRAL_NORMALS
+#include "Mesh.hlsl"
@@ -0,0 +1,3 @@
+#define OCTAHEDRAL_NORMALS
+#define NO_VERTEX_COLOR
+#include "Mesh.hlsl"
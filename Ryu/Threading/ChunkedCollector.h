@@ -0,0 +1,66 @@
+#pragma once
+#include "Threading/JobSystem.h"
+#include <memory_resource>
+
+namespace Ryu::MT
+{
+	// Cuts groups of items (a view's renderables, say) into fixed size chunks, runs every chunk of every group at once
+	// and gathers what they produce without locks. Each worker appends to its own list. A chunk run by a thread outside
+	// the pool, or by a worker that is already inside another chunk because it helps run jobs while waiting, gets a list
+	// of its own instead. Chunks remember where their results went, so a group reads back in the order a serial pass
+	// would have made them, whichever threads ran it
+	template <typename T>
+	class ChunkedCollector
+	{
+		RYU_DISABLE_COPY_AND_MOVE(ChunkedCollector)
+
+	public:
+		// Everything lives in resource, which has to take allocations from several threads when a job system is given
+		ChunkedCollector(JobSystem* jobSystem, std::span<const u64> groupSizes, u64 chunkSize,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		// collect(group, first, last, items) appends the results for [first, last) of group to items, a std::pmr::vector<T>.
+		// Spread over the job system when there is one, on the calling thread otherwise. Call once
+		template <typename Collect>
+		void Run(Collect&& collect);
+
+		[[nodiscard]] u64 GetChunkCount() const noexcept { return m_chunkStart.back(); }
+		[[nodiscard]] u64 CountItems(u64 group) const;
+
+		// Appends the results of group to out, in order
+		template <typename Container>
+		void AppendTo(u64 group, Container& out) const;
+
+	private:
+		// Where a chunk's results went
+		struct ChunkOutput
+		{
+			const std::pmr::vector<T>* Items = nullptr;
+			u64 Offset = 0;
+			u64 Count  = 0;
+		};
+
+		// Only ever touched by its own worker
+		struct alignas(64) WorkerList
+		{
+			explicit WorkerList(std::pmr::memory_resource* resource) : Items(resource) {}
+
+			std::pmr::vector<T> Items;
+			bool InUse = false;
+		};
+
+		template <typename Collect>
+		void RunChunk(Collect& collect, u64 chunk);
+
+	private:
+		JobSystem*                             m_jobSystem;
+		u64                                    m_chunkSize;
+		std::pmr::vector<u64>                  m_groupSizes;
+		std::pmr::vector<u64>                  m_chunkStart;   // First chunk of each group, and the chunk count last
+		std::pmr::vector<WorkerList>           m_workerLists;  // One per worker, a single one without a job system
+		std::pmr::vector<std::pmr::vector<T>>  m_chunkLists;   // For chunks that can not use a worker list
+		std::pmr::vector<ChunkOutput>          m_outputs;
+	};
+}
+
+#include "Threading/ChunkedCollector.inl"
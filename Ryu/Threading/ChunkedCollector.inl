@@ -0,0 +1,110 @@
+#include <algorithm>
+
+namespace Ryu::MT
+{
+	template<typename T>
+	inline ChunkedCollector<T>::ChunkedCollector(JobSystem* jobSystem, std::span<const u64> groupSizes, u64 chunkSize,
+		std::pmr::memory_resource* resource)
+		: m_jobSystem(jobSystem)
+		, m_chunkSize(chunkSize)
+		, m_groupSizes(groupSizes.begin(), groupSizes.end(), resource)
+		, m_chunkStart(groupSizes.size() + 1, 0, resource)
+		, m_workerLists(resource)
+		, m_chunkLists(resource)
+		, m_outputs(resource)
+	{
+		RYU_ASSERT(chunkSize > 0, "Chunks need at least one item");
+
+		for (u64 group = 0; group < groupSizes.size(); ++group)
+		{
+			m_chunkStart[group + 1] = m_chunkStart[group] + (groupSizes[group] + chunkSize - 1) / chunkSize;
+		}
+
+		// Never resized after this, chunk outputs point into these lists
+		const u64 workerCount = jobSystem ? jobSystem->GetNumThreads() : 1;
+		m_workerLists.reserve(workerCount);
+		for (u64 i = 0; i < workerCount; ++i)
+		{
+			m_workerLists.emplace_back(resource);
+		}
+		m_chunkLists.resize(GetChunkCount());
+		m_outputs.resize(GetChunkCount());
+	}
+
+	template<typename T>
+	template<typename Collect>
+	inline void ChunkedCollector<T>::Run(Collect&& collect)
+	{
+		if (!m_jobSystem)
+		{
+			for (u64 chunk = 0; chunk < GetChunkCount(); ++chunk)
+			{
+				RunChunk(collect, chunk);
+			}
+			return;
+		}
+
+		m_jobSystem->ParallelFor(0, GetChunkCount(), 1, [this, &collect](u64 first, u64 last)
+		{
+			for (u64 chunk = first; chunk < last; ++chunk)
+			{
+				RunChunk(collect, chunk);
+			}
+		});
+	}
+
+	template<typename T>
+	inline u64 ChunkedCollector<T>::CountItems(u64 group) const
+	{
+		u64 count = 0;
+		for (u64 chunk = m_chunkStart[group]; chunk < m_chunkStart[group + 1]; ++chunk)
+		{
+			count += m_outputs[chunk].Count;
+		}
+		return count;
+	}
+
+	template<typename T>
+	template<typename Container>
+	inline void ChunkedCollector<T>::AppendTo(u64 group, Container& out) const
+	{
+		for (u64 chunk = m_chunkStart[group]; chunk < m_chunkStart[group + 1]; ++chunk)
+		{
+			if (const ChunkOutput& output = m_outputs[chunk]; output.Count > 0)
+			{
+				const auto begin = output.Items->begin() + output.Offset;
+				out.insert(out.end(), begin, begin + output.Count);
+			}
+		}
+	}
+
+	template<typename T>
+	template<typename Collect>
+	inline void ChunkedCollector<T>::RunChunk(Collect& collect, u64 chunk)
+	{
+		const u64 group = static_cast<u64>(std::ranges::upper_bound(m_chunkStart, chunk) - m_chunkStart.begin()) - 1;
+		const u64 first = (chunk - m_chunkStart[group]) * m_chunkSize;
+		const u64 last  = std::min(first + m_chunkSize, m_groupSizes[group]);
+
+		// A worker whose list is in use got here from inside collect, that chunk is still appending to it
+		const i64 worker = m_jobSystem ? m_jobSystem->GetCurrentWorkerIndex() : 0;
+		WorkerList* workerList = (worker >= 0 && !m_workerLists[worker].InUse) ? &m_workerLists[worker] : nullptr;
+		std::pmr::vector<T>& items = workerList ? workerList->Items : m_chunkLists[chunk];
+
+		if (workerList)
+		{
+			workerList->InUse = true;
+		}
+
+		ChunkOutput& output = m_outputs[chunk];
+		output.Items  = &items;
+		output.Offset = items.size();
+		collect(group, first, last, items);
+		output.Count  = items.size() - output.Offset;
+
+		if (workerList)
+		{
+			workerList->InUse = false;
+		}
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <memory>
+
+namespace Ryu::MT
+{
+	// Lock-free stack of slot indices for fixed-size pools. The head carries an ABA tag
+	// in its upper 32 bits so an index that is popped and pushed back can't fool a stale CAS
+	class IndexFreeList
+	{
+		RYU_DISABLE_COPY_AND_MOVE(IndexFreeList)
+
+	public:
+		static constexpr u32 INVALID_INDEX = ~0u;
+
+		// Starts full, holding every index in [0, capacity)
+		explicit IndexFreeList(u32 capacity)
+			: m_next(std::make_unique<std::atomic<u32>[]>(capacity))
+			, m_head(Pack(0, capacity > 0 ? 0 : INVALID_INDEX))
+		{
+			for (u32 i = 0; i < capacity; ++i)
+			{
+				m_next[i].store(i + 1 < capacity ? i + 1 : INVALID_INDEX, std::memory_order_relaxed);
+			}
+		}
+
+		// Returns INVALID_INDEX when the pool is exhausted
+		[[nodiscard]] u32 Pop() noexcept
+		{
+			u64 head = m_head.load(std::memory_order_acquire);
+			while (true)
+			{
+				const u32 index = Index(head);
+				if (index == INVALID_INDEX)
+				{
+					return INVALID_INDEX;
+				}
+
+				const u64 next = Pack(Tag(head) + 1, m_next[index].load(std::memory_order_relaxed));
+				if (m_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					return index;
+				}
+			}
+		}
+
+		void Push(u32 index) noexcept
+		{
+			u64 head = m_head.load(std::memory_order_relaxed);
+			while (true)
+			{
+				m_next[index].store(Index(head), std::memory_order_relaxed);
+				if (m_head.compare_exchange_weak(head, Pack(Tag(head) + 1, index), std::memory_order_release, std::memory_order_relaxed))
+				{
+					return;
+				}
+			}
+		}
+
+	private:
+		static constexpr u64 Pack(u32 tag, u32 index) noexcept { return (static_cast<u64>(tag) << 32) | index; }
+		static constexpr u32 Tag(u64 head) noexcept { return static_cast<u32>(head >> 32); }
+		static constexpr u32 Index(u64 head) noexcept { return static_cast<u32>(head); }
+
+	private:
+		std::unique_ptr<std::atomic<u32>[]> m_next;
+		alignas(64) std::atomic<u64>        m_head;
+	};
+}
@@ -1,57 +1,207 @@
 #pragma once
-#include <thread>
-#include <mutex>
 #include <array>
+#include <atomic>
 
 namespace Ryu::MT
 {
-	/* Ref: https://wickedengine.net/2018/11/simple-job-system-using-standard-c/ */
+	/* Ref: https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue */
 
-	// Thread-safe ring buffer
-	template <typename T, size_t capacity>
+	enum class RingBufferMode
+	{
+		MPMC,  // Any number of producers and consumers
+		SPSC,  // Exactly one producer thread and one consumer thread
+	};
+
+	// Bounded lock-free ring buffer. PushBack fails when full and PopFront fails when empty, neither blocks
+	template <typename T, size_t capacity, RingBufferMode Mode = RingBufferMode::MPMC>
 	class TSRingBuffer
 	{
+		static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "Ring buffer capacity must be a power of two");
+
+		RYU_DISABLE_COPY_AND_MOVE(TSRingBuffer)
+
 	public:
-		inline bool PushBack(const T& item)
+		TSRingBuffer()
+		{
+			// A cell is free for the producer at position p when its sequence equals p
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		inline bool PushBack(const T& item) { return Push(item); }
+		inline bool PushBack(T&& item) { return Push(std::move(item)); }
+
+		inline bool PopFront(T& item)
+		{
+			size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+			Cell* cell = nullptr;
+
+			while (true)
+			{
+				cell = &m_cells[pos & MASK];
+				const size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+				const auto diff       = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+				if (diff == 0)
+				{
+					if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;  // Empty
+				}
+				else
+				{
+					pos = m_dequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+
+			item = std::move(cell->Data);
+
+			// Hand the cell back to producers one lap ahead
+			cell->Sequence.store(pos + capacity, std::memory_order_release);
+			return true;
+		}
+
+		// Approximate under contention
+		[[nodiscard]] inline size_t Size() const noexcept
+		{
+			const size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+			const size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+			return enqueued > dequeued ? enqueued - dequeued : 0;
+		}
+
+		[[nodiscard]] inline bool IsEmpty() const noexcept { return Size() == 0; }
+		[[nodiscard]] static constexpr size_t Capacity() noexcept { return capacity; }
+
+	private:
+		template <typename U>
+		inline bool Push(U&& item)
 		{
-			bool result = false;
+			size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+			Cell* cell = nullptr;
 
+			while (true)
 			{
-				std::scoped_lock lock(m_mutex);
+				cell = &m_cells[pos & MASK];
+				const size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+				const auto diff       = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
 
-				size_t next = (m_head + 1) % capacity;
-				if (next != tail)
+				if (diff == 0)
 				{
-					data[head] = item;
-					head       = next;
-					result     = true;
+					if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;  // Full, the consumer of the previous lap hasn't released this cell yet
+				}
+				else
+				{
+					pos = m_enqueuePos.load(std::memory_order_relaxed);
 				}
 			}
 
-			return result;
+			cell->Data = std::forward<U>(item);
+			cell->Sequence.store(pos + 1, std::memory_order_release);
+			return true;
 		}
 
+	private:
+		static constexpr size_t MASK = capacity - 1;
+
+		struct Cell
+		{
+			std::atomic<size_t> Sequence;
+			T                   Data{};
+		};
+
+		std::array<Cell, capacity>      m_cells;
+		alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+		alignas(64) std::atomic<size_t> m_dequeuePos{ 0 };
+	};
+
+	// Single producer/single consumer version. No CAS and no per-cell sequence, each side only
+	// publishes its own index and caches the other side's so it rarely touches the shared line
+	template <typename T, size_t capacity>
+	class TSRingBuffer<T, capacity, RingBufferMode::SPSC>
+	{
+		static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "Ring buffer capacity must be a power of two");
+
+		RYU_DISABLE_COPY_AND_MOVE(TSRingBuffer)
+
+	public:
+		TSRingBuffer() = default;
+
+		inline bool PushBack(const T& item) { return Push(item); }
+		inline bool PushBack(T&& item) { return Push(std::move(item)); }
+
+		// Consumer thread only
 		inline bool PopFront(T& item)
 		{
-			bool result = false;
+			const size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_cachedTail)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (head == m_cachedTail)
+				{
+					return false;
+				}
+			}
+
+			item = std::move(m_data[head & MASK]);
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Approximate unless called from the producer or consumer
+		[[nodiscard]] inline size_t Size() const noexcept
+		{
+			return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] inline bool IsEmpty() const noexcept { return Size() == 0; }
+		[[nodiscard]] static constexpr size_t Capacity() noexcept { return capacity; }
 
+	private:
+		// Producer thread only
+		template <typename U>
+		inline bool Push(U&& item)
+		{
+			const size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_cachedHead == capacity)
 			{
-				std::scoped_lock lock(m_mutex);
-				if (m_tail != m_head)
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail - m_cachedHead == capacity)
 				{
-					item   = m_data[m_tail];
-					m_tail = (m_tail + 1) % capacity;
-					result = true;
+					return false;
 				}
 			}
 
-			return result;
+			m_data[tail & MASK] = std::forward<U>(item);
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
 		}
 
 	private:
-		std::array<T, capacity> m_data;
-		size_t m_head = 0;
-		size_t m_tail = 0;
-		std::mutex m_mutex;
+		static constexpr size_t MASK = capacity - 1;
+
+		std::array<T, capacity> m_data{};
+
+		// Each index shares its line with the copy of the other index its owner keeps
+		alignas(64) std::atomic<size_t> m_tail{ 0 };
+		size_t                          m_cachedHead = 0;
+		alignas(64) std::atomic<size_t> m_head{ 0 };
+		size_t                          m_cachedTail = 0;
 	};
+
+	template <typename T, size_t capacity>
+	using SPSCRingBuffer = TSRingBuffer<T, capacity, RingBufferMode::SPSC>;
 }
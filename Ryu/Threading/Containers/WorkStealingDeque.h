@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Ryu::MT
+{
+	/* Ref: Chase & Lev, "Dynamic Circular Work-Stealing Deque" (2005)
+	   Ref: Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models" (2013) */
+
+	// Single-owner work-stealing deque. Only the owning thread may call Push/Pop (LIFO end),
+	// any thread may call Steal (FIFO end). T must be trivially copyable (normally a pointer)
+	template <typename T>
+	class WorkStealingDeque
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque elements must be trivially copyable");
+		RYU_DISABLE_COPY_AND_MOVE(WorkStealingDeque)
+
+		class Buffer
+		{
+		public:
+			explicit Buffer(i64 capacity)
+				: m_capacity(capacity)
+				, m_mask(capacity - 1)
+				, m_data(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity)))
+			{
+			}
+
+			[[nodiscard]] inline i64 Capacity() const noexcept { return m_capacity; }
+			inline void Put(i64 index, T item) noexcept { m_data[index & m_mask].store(item, std::memory_order_relaxed); }
+			[[nodiscard]] inline T Get(i64 index) const noexcept { return m_data[index & m_mask].load(std::memory_order_relaxed); }
+
+			[[nodiscard]] Buffer* Grow(i64 bottom, i64 top) const
+			{
+				Buffer* buffer = new Buffer(m_capacity * 2);
+				for (i64 i = top; i != bottom; ++i)
+				{
+					buffer->Put(i, Get(i));
+				}
+				return buffer;
+			}
+
+		private:
+			i64                               m_capacity;
+			i64                               m_mask;
+			std::unique_ptr<std::atomic<T>[]> m_data;
+		};
+
+	public:
+		explicit WorkStealingDeque(i64 capacity = 1024)
+			: m_top(0)
+			, m_bottom(0)
+			, m_buffer(new Buffer(capacity))
+		{
+			// Capacity must be a power of two so we can mask instead of modulo
+			RYU_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0, "WorkStealingDeque capacity must be a power of two");
+		}
+
+		~WorkStealingDeque()
+		{
+			delete m_buffer.load(std::memory_order_relaxed);
+		}
+
+		// Owner only
+		void Push(T item)
+		{
+			const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+			const i64 top    = m_top.load(std::memory_order_acquire);
+			Buffer* buffer   = m_buffer.load(std::memory_order_relaxed);
+
+			if (bottom - top > buffer->Capacity() - 1)
+			{
+				// Thieves may still be reading from the old buffer, retire it instead of freeing
+				Buffer* grown = buffer->Grow(bottom, top);
+				m_retired.emplace_back(buffer);
+				m_buffer.store(grown, std::memory_order_release);
+				buffer = grown;
+			}
+
+			buffer->Put(bottom, item);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		// Owner only
+		[[nodiscard]] std::optional<T> Pop()
+		{
+			const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			Buffer* buffer   = m_buffer.load(std::memory_order_relaxed);
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			i64 top = m_top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Deque was empty
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return std::nullopt;
+			}
+
+			T item = buffer->Get(bottom);
+			if (top == bottom)
+			{
+				// Last item, race against thieves for it
+				const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				if (!won)
+				{
+					return std::nullopt;
+				}
+			}
+
+			return item;
+		}
+
+		// Any thread
+		[[nodiscard]] std::optional<T> Steal()
+		{
+			i64 top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const i64 bottom = m_bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+			{
+				return std::nullopt;
+			}
+
+			Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+			T item = buffer->Get(top);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				// Lost the race to another thief or the owner
+				return std::nullopt;
+			}
+
+			return item;
+		}
+
+		// Approximate when called from a non-owner thread
+		[[nodiscard]] i64 Size() const noexcept
+		{
+			const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+			const i64 top    = m_top.load(std::memory_order_relaxed);
+			return bottom > top ? bottom - top : 0;
+		}
+
+		[[nodiscard]] bool IsEmpty() const noexcept { return Size() == 0; }
+
+	private:
+		// Keep top and bottom on separate cache lines, thieves hammer top while the owner writes bottom
+		alignas(64) std::atomic<i64>         m_top;
+		alignas(64) std::atomic<i64>         m_bottom;
+		alignas(64) std::atomic<Buffer*>     m_buffer;
+		std::vector<std::unique_ptr<Buffer>> m_retired;
+	};
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "Threading/Coroutines/Task.h"
+#include "Threading/Coroutines/MainThreadQueue.h"
+#include "Threading/JobSystem.h"
+
+namespace Ryu::MT
+{
+	// co_await handle: suspends until the job finished, then resumes on a worker. The continuation is
+	// submitted as a job depending on the awaited one, so waiting costs no thread
+	inline auto operator co_await(JobHandle handle) noexcept
+	{
+		struct Awaiter
+		{
+			JobHandle Handle;
+
+			bool await_ready() const noexcept { return Handle.IsReady(); }
+			void await_resume() const noexcept {}
+
+			void await_suspend(std::coroutine_handle<> continuation) const
+			{
+				Handle.System->Submit([continuation] { continuation.resume(); }, { Handle });
+			}
+		};
+
+		return Awaiter{ handle };
+	}
+
+	// co_await ResumeOnWorker(jobs): moves the rest of the coroutine onto a worker thread
+	[[nodiscard]] inline auto ResumeOnWorker(JobSystem& jobs) noexcept
+	{
+		struct Awaiter
+		{
+			JobSystem& Jobs;
+
+			bool await_ready() const noexcept { return false; }
+			void await_resume() const noexcept {}
+
+			void await_suspend(std::coroutine_handle<> continuation) const
+			{
+				Jobs.Submit([continuation] { continuation.resume(); });
+			}
+		};
+
+		return Awaiter{ jobs };
+	}
+
+	// co_await ResumeOnMainThread(queue): continues on the main thread at the next drain, which is
+	// the next frame. Also works as "wait one frame" when already on the main thread
+	[[nodiscard]] inline auto ResumeOnMainThread(MainThreadQueue& queue) noexcept
+	{
+		struct Awaiter
+		{
+			MainThreadQueue& Queue;
+
+			bool await_ready() const noexcept { return false; }
+			void await_resume() const noexcept {}
+
+			void await_suspend(std::coroutine_handle<> continuation) const
+			{
+				Queue.Post(continuation);
+			}
+		};
+
+		return Awaiter{ queue };
+	}
+
+	namespace Internal
+	{
+		// Starts eagerly and frees its own frame when done, nobody holds on to it
+		struct DetachedTask
+		{
+			struct promise_type
+			{
+				DetachedTask get_return_object() const noexcept { return {}; }
+				std::suspend_never initial_suspend() const noexcept { return {}; }
+				std::suspend_never final_suspend() const noexcept { return {}; }
+				void return_void() const noexcept {}
+				void unhandled_exception() const noexcept { std::terminate(); }
+			};
+		};
+
+		template <typename T>
+		inline DetachedTask RunDetached(Task<T> task)
+		{
+			// The task owns the result, a throwing body ends up in GetResult() and is discarded with it
+			co_await task.WhenDone();
+		}
+
+		template <typename T>
+		inline DetachedTask SignalWhenDone(Task<T>& task, WaitCounter& done)
+		{
+			co_await task.WhenDone();
+
+			// Last touch of SyncWait's frame. The counter holds its waiter back until Decrement has returned,
+			// and the task is parked at its final suspend by now, so SyncWait may return and destroy both
+			done.Decrement();
+		}
+	}
+
+	// Starts the task on the calling thread and lets it finish wherever its awaits take it.
+	// The result is dropped, exceptions included
+	template <typename T>
+	inline void Spawn(Task<T> task)
+	{
+		Internal::RunDetached(std::move(task));
+	}
+
+	// Starts the task and blocks until it finished, running jobs in the meantime. For tests and tools,
+	// from the main thread this can deadlock on a task waiting for ResumeOnMainThread
+	template <typename T>
+	inline decltype(auto) SyncWait(JobSystem& jobs, Task<T> task)
+	{
+		WaitCounter done(1);
+		Internal::SignalWhenDone(task, done);
+		jobs.Wait(done);
+		return task.GetResult();
+	}
+}
@@ -0,0 +1,34 @@
+#include "Threading/Coroutines/MainThreadQueue.h"
+
+namespace Ryu::MT
+{
+	void MainThreadQueue::Post(std::coroutine_handle<> continuation)
+	{
+		std::lock_guard lock(m_mutex);
+		m_pending.push_back(continuation);
+	}
+
+	u64 MainThreadQueue::Drain()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			std::swap(m_pending, m_draining);
+		}
+
+		// Resume outside the lock, continuations are free to post again
+		for (std::coroutine_handle<> continuation : m_draining)
+		{
+			continuation.resume();
+		}
+
+		const u64 count = m_draining.size();
+		m_draining.clear();  // Keeps the capacity, steady state draining does not allocate
+		return count;
+	}
+
+	bool MainThreadQueue::IsEmpty() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_pending.empty();
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <coroutine>
+#include <mutex>
+#include <vector>
+
+namespace Ryu::MT
+{
+	// Coroutines waiting to continue on the main thread. Any thread may post,
+	// the main thread drains the queue once per frame (see Engine::MainLoop).
+	// Handles still queued on destruction are dropped, never resumed
+	class MainThreadQueue
+	{
+		RYU_DISABLE_COPY_AND_MOVE(MainThreadQueue)
+
+	public:
+		MainThreadQueue() = default;
+
+		void Post(std::coroutine_handle<> continuation);
+
+		// Resumes everything posted before the call. Coroutines that post again while being
+		// resumed land in the next drain, so "resume next frame" really means the next frame
+		u64 Drain();
+
+		[[nodiscard]] bool IsEmpty() const;
+
+	private:
+		mutable std::mutex                   m_mutex;
+		std::vector<std::coroutine_handle<>> m_pending;
+		std::vector<std::coroutine_handle<>> m_draining;
+	};
+}
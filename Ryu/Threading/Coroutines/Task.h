@@ -0,0 +1,180 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace Ryu::MT
+{
+	template <typename T = void>
+	class Task;
+
+	namespace Internal
+	{
+		struct TaskPromiseBase
+		{
+			// Resumes whoever awaited the task once it finishes, symmetric transfer keeps long chains off the stack
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				void await_resume() const noexcept {}
+
+				template <typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) const noexcept
+				{
+					return self.promise().Continuation;
+				}
+			};
+
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter final_suspend() const noexcept { return {}; }
+			void unhandled_exception() noexcept { Exception = std::current_exception(); }
+
+			std::coroutine_handle<> Continuation = std::noop_coroutine();
+			std::exception_ptr      Exception;
+		};
+
+		template <typename T>
+		struct TaskPromise : TaskPromiseBase
+		{
+			Task<T> get_return_object() noexcept;
+
+			template <typename U>
+			void return_value(U&& value)
+			{
+				Value.emplace(std::forward<U>(value));
+			}
+
+			T TakeResult()
+			{
+				if (Exception)
+				{
+					std::rethrow_exception(Exception);
+				}
+				return std::move(*Value);
+			}
+
+			std::optional<T> Value;
+		};
+
+		template <>
+		struct TaskPromise<void> : TaskPromiseBase
+		{
+			Task<void> get_return_object() noexcept;
+
+			void return_void() const noexcept {}
+
+			void TakeResult() const
+			{
+				if (Exception)
+				{
+					std::rethrow_exception(Exception);
+				}
+			}
+		};
+	}
+
+	// Lazily started coroutine producing a T. Nothing runs until the task is awaited (or handed to
+	// Spawn/SyncWait), exceptions thrown inside are rethrown to whoever awaits it.
+	// Where the body runs depends on what it awaits, see Threading/Coroutines/Awaitables.h
+	template <typename T>
+	class [[nodiscard]] Task
+	{
+	public:
+		using promise_type = Internal::TaskPromise<T>;
+		using Handle       = std::coroutine_handle<promise_type>;
+
+		Task() = default;
+		explicit Task(Handle handle) noexcept : m_handle(handle) {}
+		Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Destroy();
+				m_handle = std::exchange(other.m_handle, nullptr);
+			}
+			return *this;
+		}
+
+		~Task() { Destroy(); }
+
+		[[nodiscard]] bool IsValid() const noexcept { return static_cast<bool>(m_handle); }
+		[[nodiscard]] bool IsDone() const noexcept { return !m_handle || m_handle.done(); }
+
+		// Only valid once IsDone(), rethrows if the body threw
+		decltype(auto) GetResult() { return m_handle.promise().TakeResult(); }
+
+		// Starts the task and resumes the awaiting coroutine with its result
+		auto operator co_await() noexcept
+		{
+			struct Awaiter
+			{
+				Handle Coroutine;
+
+				bool await_ready() const noexcept { return !Coroutine || Coroutine.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+				{
+					Coroutine.promise().Continuation = awaiting;
+					return Coroutine;
+				}
+
+				decltype(auto) await_resume() const { return Coroutine.promise().TakeResult(); }
+			};
+
+			return Awaiter{ m_handle };
+		}
+
+		// Like co_await but leaves the result (or exception) in the task for GetResult()
+		auto WhenDone() noexcept
+		{
+			struct Awaiter
+			{
+				Handle Coroutine;
+
+				bool await_ready() const noexcept { return !Coroutine || Coroutine.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+				{
+					Coroutine.promise().Continuation = awaiting;
+					return Coroutine;
+				}
+
+				void await_resume() const noexcept {}
+			};
+
+			return Awaiter{ m_handle };
+		}
+
+	private:
+		void Destroy() noexcept
+		{
+			if (m_handle)
+			{
+				m_handle.destroy();
+				m_handle = nullptr;
+			}
+		}
+
+	private:
+		Handle m_handle;
+	};
+
+	namespace Internal
+	{
+		template <typename T>
+		inline Task<T> TaskPromise<T>::get_return_object() noexcept
+		{
+			return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object() noexcept
+		{
+			return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+		}
+	}
+}
@@ -1,28 +1,57 @@
 #pragma once
-#include "Threading/JobHandle.h"
-#include <functional>
+#include "Threading/ThreadPool.h"
+#include <cstddef>
+#include <new>
 
 namespace Ryu::MT
 {
-	class Job
+	class JobSystem;
+
+	// Callables bigger than this don't fit in a job, capture by reference or through a pointer instead
+	inline constexpr size_t JOB_STORAGE_SIZE  = 128;
+	inline constexpr size_t JOB_STORAGE_ALIGN = alignof(std::max_align_t);
+
+	// Pooled job slot. The callable lives inline in the slot and the slot doubles as the pool's task
+	// node, so scheduling a job never allocates
+	class alignas(64) Job : public ThreadPool::Task
 	{
+		friend class JobSystem;
+
 	public:
 		template <typename Func>
-		Job(Func&& func, std::vector<std::shared_ptr<JobHandle>> dependencies = {})
-			: m_function(std::forward<Func>(func))
-			, m_dependencies(std::move(dependencies))
-			, m_handle(std::make_shared<JobHandle>())
+		void Bind(Func&& func)
 		{
+			using Callable = std::decay_t<Func>;
+			static_assert(sizeof(Callable) <= JOB_STORAGE_SIZE, "Job callable does not fit in the inline storage, capture less");
+			static_assert(alignof(Callable) <= JOB_STORAGE_ALIGN, "Job callable is over-aligned for the inline storage");
+
+			::new (static_cast<void*>(m_storage)) Callable(std::forward<Func>(func));
+			m_invoke  = [](void* storage) { (*static_cast<Callable*>(storage))(); };
+			m_destroy = [](void* storage) { static_cast<Callable*>(storage)->~Callable(); };
 		}
 
+		// Runs and destroys the bound callable
 		void Execute();
-		bool AreDependenciesReady() const;
 
-		inline std::shared_ptr<JobHandle> GetHandle() const { return m_handle; }
+	private:
+		static constexpr u32 NO_EDGE = ~0u;
+
+		static constexpr u64 PackState(u32 generation, u32 edgeHead) noexcept { return (static_cast<u64>(generation) << 32) | edgeHead; }
+		static constexpr u32 StateGeneration(u64 state) noexcept { return static_cast<u32>(state >> 32); }
+		static constexpr u32 StateEdgeHead(u64 state) noexcept { return static_cast<u32>(state); }
 
 	private:
-		std::function<void()>                   m_function;
-		std::vector<std::shared_ptr<JobHandle>> m_dependencies;
-		std::shared_ptr<JobHandle>              m_handle;
+		alignas(JOB_STORAGE_ALIGN) std::byte m_storage[JOB_STORAGE_SIZE];
+		void (*m_invoke)(void*)  = nullptr;
+		void (*m_destroy)(void*) = nullptr;
+		JobSystem*       m_owner = nullptr;
+		u32              m_index = 0;
+
+		// Unfinished predecessors, starts at 1 so the job can't be scheduled while it is still being linked
+		std::atomic<u32> m_pendingDependencies{ 0 };
+
+		// [63-32] generation, bumped when the job completes (this is what handles compare against and wait on)
+		// [31-0]  head of the successor edge list
+		std::atomic<u64> m_state{ PackState(0, NO_EDGE) };
 	};
 }
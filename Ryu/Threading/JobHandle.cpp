@@ -1,26 +1,18 @@
 #include "Threading/JobHandle.h"
+#include "Threading/JobSystem.h"
 
-	namespace Ryu::MT
+namespace Ryu::MT
+{
+	void JobHandle::Wait() const
 	{
-		JobHandle::JobHandle()
-			: m_isCompleted(false)
+		if (IsValid())
 		{
+			System->Wait(*this);
 		}
+	}
 
-		void JobHandle::Wait() const
-		{
-			std::unique_lock lock(m_mutex);
-			m_cv.wait(lock, [this] { return m_isCompleted.load(); });
-		}
-		
-		bool JobHandle::IsReady() const noexcept
-		{
-			return m_isCompleted.load();
-		}
-
-		void JobHandle::Complete()
-		{
-			m_isCompleted.store(true);
-			m_cv.notify_all();
-		}
+	bool JobHandle::IsReady() const noexcept
+	{
+		return !IsValid() || System->IsComplete(*this);
 	}
+}
@@ -1,31 +1,30 @@
 #pragma once
 #include <chrono>
-#include <mutex>
-#include <condition_variable>
 
 namespace Ryu::MT
 {
-	class JobHandle
+	class JobSystem;
+
+	// Generation-indexed reference to a pooled job. Trivially copyable, goes stale (and reads as
+	// complete) as soon as the job finishes and its slot is recycled
+	struct JobHandle
 	{
-		friend class JobSystem;
-		friend class Job;
+		static constexpr u32 INVALID_INDEX = ~0u;
+
+		JobSystem* System     = nullptr;
+		u32        Index      = INVALID_INDEX;
+		u32        Generation = 0;
+
+		[[nodiscard]] constexpr bool IsValid() const noexcept { return System && Index != INVALID_INDEX; }
+		constexpr explicit operator bool() const noexcept { return IsValid(); }
+		constexpr bool operator==(const JobHandle&) const = default;
 
-	public:
-		JobHandle();
-		
+		// Invalid handles count as complete
 		void Wait() const;
-		bool IsReady() const noexcept;
+		[[nodiscard]] bool IsReady() const noexcept;
 
 		template <typename Rep, typename Period>
 		bool WaitFor(const std::chrono::duration<Rep, Period>& timeout) const;
-
-	private:
-		void Complete();
-
-	private:
-		mutable std::mutex              m_mutex;
-		mutable std::condition_variable m_cv;
-		std::atomic<bool>               m_isCompleted;
 	};
 }
 
@@ -1,9 +1,20 @@
+#include <thread>
+
 namespace Ryu::MT
 {
 	template<typename Rep, typename Period>
 	inline bool JobHandle::WaitFor(const std::chrono::duration<Rep, Period>& timeout) const
 	{
-		std::unique_lock lock(m_mutex);
-		return m_cv.wait_for(lock, timeout, [this] { return m_isCompleted.load(); });
+		// std::atomic::wait has no timed variant, poll instead
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+		while (!IsReady())
+		{
+			if (std::chrono::steady_clock::now() >= deadline)
+			{
+				return false;
+			}
+			std::this_thread::yield();
+		}
+		return true;
 	}
 }
@@ -2,45 +2,238 @@
 
 namespace Ryu::MT
 {
-    JobSystem::JobSystem(size_t workerThreads)
-		: m_pool(workerThreads)
-    {
-    }
-    
-    void JobSystem::WaitForAll(std::span<std::shared_ptr<JobHandle>> handles)
-    {
-        for (const auto& handle : handles)
-        {
-            handle->Wait();
-        }
-    }
-
-    void JobSystem::ProcessReadyJobs()
-    {
-        std::lock_guard lock(m_mutex);
-
-        std::queue<std::unique_ptr<Job>> remaining;
-
-        while (!m_pendingJobs.empty())
-        {
-            std::unique_ptr<Job> job = std::move(m_pendingJobs.front());
-            m_pendingJobs.pop();
-
-            if (job->AreDependenciesReady())
-            {
-                // Capture weak reference to this JobSystem
-                m_pool.Submit([jobPtr = std::move(job), this]
-                {
-                    jobPtr->Execute();
-                    ProcessReadyJobs(); // Check for newly ready jobs
-                });
-            }
-            else
-            {
-                remaining.push(std::move(job));
-            }
-        }
-
-        m_pendingJobs = std::move(remaining);
-    }
+	JobSystem::JobSystem(size_t workerThreads, u32 maxJobs)
+		: m_maxJobs(maxJobs)
+		, m_jobs(std::make_unique<Job[]>(maxJobs))
+		, m_edges(std::make_unique<JobEdge[]>(static_cast<size_t>(maxJobs) * 4))
+		, m_freeJobs(maxJobs)
+		, m_freeEdges(maxJobs * 4)
+		, m_pool(workerThreads)
+	{
+		for (u32 i = 0; i < m_maxJobs; ++i)
+		{
+			Job& job    = m_jobs[i];
+			job.Run     = &JobSystem::RunTask;
+			job.m_owner = this;
+			job.m_index = i;
+		}
+	}
+
+	void JobSystem::Wait(JobHandle handle)
+	{
+		if (!handle.IsValid())
+		{
+			return;
+		}
+
+		RYU_ASSERT(handle.System == this, "Waiting on a job from another JobSystem");
+
+		Job& job = m_jobs[handle.Index];
+		const bool isWorker = m_pool.GetCurrentWorkerIndex() >= 0;
+
+		while (true)
+		{
+			const u64 state = job.m_state.load(std::memory_order_acquire);
+			if (Job::StateGeneration(state) != handle.Generation)
+			{
+				return;
+			}
+
+			if (m_pool.RunPendingTask())
+			{
+				continue;
+			}
+
+			// A worker that blocks could starve the very job it waits for, only outside threads sleep
+			if (isWorker)
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				job.m_state.wait(state, std::memory_order_acquire);
+			}
+		}
+	}
+
+	void JobSystem::Wait(const WaitCounter& counter)
+	{
+		const bool isWorker = m_pool.GetCurrentWorkerIndex() >= 0;
+
+		while (!counter.IsZero())
+		{
+			if (m_pool.RunPendingTask())
+			{
+				continue;
+			}
+
+			// Same as waiting on a handle, only outside threads are allowed to block
+			if (isWorker)
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				counter.Wait();
+			}
+		}
+	}
+
+	void JobSystem::WaitForAll(std::span<const JobHandle> handles)
+	{
+		for (const JobHandle& handle : handles)
+		{
+			Wait(handle);
+		}
+	}
+
+	bool JobSystem::IsComplete(JobHandle handle) const noexcept
+	{
+		if (!handle.IsValid())
+		{
+			return true;
+		}
+
+		const u64 state = m_jobs[handle.Index].m_state.load(std::memory_order_acquire);
+		return Job::StateGeneration(state) != handle.Generation;
+	}
+
+	u32 JobSystem::PopFreeSlot(IndexFreeList& freeList)
+	{
+		// Pool exhausted, help drain it instead of allocating more. A running job keeps its slot, so once there
+		// is nothing left to help with every slot may belong to a job that is itself stuck here, give up then
+		u32 idleRounds = 0;
+		u32 index = freeList.Pop();
+		while (index == IndexFreeList::INVALID_INDEX && idleRounds < MAX_IDLE_ROUNDS)
+		{
+			if (!m_pool.RunPendingTask())
+			{
+				++idleRounds;
+				std::this_thread::yield();
+			}
+			index = freeList.Pop();
+		}
+		return index;
+	}
+
+	Job* JobSystem::TryAllocateJob()
+	{
+		const u32 index = PopFreeSlot(m_freeJobs);
+		if (index == IndexFreeList::INVALID_INDEX)
+		{
+			return nullptr;
+		}
+
+		Job& job = m_jobs[index];
+		job.m_pendingDependencies.store(1, std::memory_order_relaxed);
+		return &job;
+	}
+
+	JobHandle JobSystem::MakeHandle(const Job& job)
+	{
+		return JobHandle
+		{
+			.System     = this,
+			.Index      = job.m_index,
+			.Generation = Job::StateGeneration(job.m_state.load(std::memory_order_relaxed))
+		};
+	}
+
+	bool JobSystem::AddSuccessor(JobHandle dependency, u32 successor)
+	{
+		Job& job = m_jobs[dependency.Index];
+
+		// No edge to link with, let the dependency finish first and count it as done
+		const u32 edge = PopFreeSlot(m_freeEdges);
+		if (edge == IndexFreeList::INVALID_INDEX)
+		{
+			Wait(dependency);
+			return false;
+		}
+		m_edges[edge].Successor = successor;
+
+		u64 state = job.m_state.load(std::memory_order_acquire);
+		while (true)
+		{
+			// Generation moved on, the dependency already finished (its slot may even be reused)
+			if (Job::StateGeneration(state) != dependency.Generation)
+			{
+				m_freeEdges.Push(edge);
+				return false;
+			}
+
+			m_edges[edge].Next = Job::StateEdgeHead(state);
+			const u64 linked = Job::PackState(dependency.Generation, edge);
+			if (job.m_state.compare_exchange_weak(state, linked, std::memory_order_release, std::memory_order_acquire))
+			{
+				return true;
+			}
+		}
+	}
+
+	void JobSystem::Link(Job& job, std::span<const JobHandle> dependencies)
+	{
+		for (const JobHandle& dependency : dependencies)
+		{
+			if (!dependency.IsValid())
+			{
+				continue;
+			}
+
+			RYU_ASSERT(dependency.System == this, "Job dependencies must come from the same JobSystem");
+
+			// Count first, the dependency may finish (and decrement) the moment we are in its successor list
+			job.m_pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+			if (!AddSuccessor(dependency, job.m_index))
+			{
+				// Already finished, can't reach zero here because of the submission guard
+				job.m_pendingDependencies.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		// Drop the submission guard, schedule now if nothing is left to wait on
+		if (job.m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Schedule(job);
+		}
+	}
+
+	void JobSystem::Schedule(Job& job)
+	{
+		// From a worker this lands on its own deque, so successors run hot on the same core unless stolen
+		m_pool.Enqueue(&job);
+	}
+
+	void JobSystem::RunTask(ThreadPool::Task* task)
+	{
+		Job& job = static_cast<Job&>(*task);
+		job.m_owner->Run(job);
+	}
+
+	void JobSystem::Run(Job& job)
+	{
+		job.Execute();
+
+		// Bump the generation (this is what completes every handle) and take the successor list in one go
+		const u32 generation = Job::StateGeneration(job.m_state.load(std::memory_order_relaxed));
+		const u64 previous   = job.m_state.exchange(Job::PackState(generation + 1, Job::NO_EDGE), std::memory_order_acq_rel);
+		job.m_state.notify_all();
+
+		// Nothing below touches the slot, it can be handed out again right away
+		m_freeJobs.Push(job.m_index);
+
+		u32 edge = Job::StateEdgeHead(previous);
+		while (edge != Job::NO_EDGE)
+		{
+			const JobEdge link = m_edges[edge];
+			m_freeEdges.Push(edge);
+			edge = link.Next;
+
+			Job& successor = m_jobs[link.Successor];
+			if (successor.m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Schedule(successor);
+			}
+		}
+	}
 }
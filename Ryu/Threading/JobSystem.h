@@ -1,34 +1,112 @@
 #pragma once
-#include "Threading/ThreadPool.h"
+#include "Threading/Job.h"
+#include "Threading/JobHandle.h"
+#include "Threading/WaitCounter.h"
+#include "Threading/Containers/IndexFreeList.h"
 #include <span>
 
 namespace Ryu::MT
 {
+	// Jobs form a dependency graph: each job counts its unfinished predecessors and keeps a list of
+	// successors. Finishing a job pushes its newly ready successors straight to the pool.
+	// Jobs and dependency edges come from fixed-size pools, submitting a job does not allocate
 	class JobSystem
 	{
+		RYU_DISABLE_COPY_AND_MOVE(JobSystem)
+
 	public:
-		explicit JobSystem(size_t workerThreads = std::thread::hardware_concurrency() - 1);
+		static constexpr u32 DEFAULT_MAX_JOBS = 4096;
+
+		explicit JobSystem(size_t workerThreads = std::thread::hardware_concurrency() - 1, u32 maxJobs = DEFAULT_MAX_JOBS);
 
-		// Submit job with dependencies
+		// Submit job with dependencies. When the job pool stays full (every slot held by a running job, say ones
+		// that submit more work) the job runs right here once its dependencies are done, and the handle is empty
 		template <typename Func>
-		std::shared_ptr<JobHandle> Submit(Func&& func, std::vector<std::shared_ptr<JobHandle>> dependencies = {});
+		JobHandle Submit(Func&& func, std::span<const JobHandle> dependencies = {});
 
 		template <typename Func>
-		std::vector<std::shared_ptr<JobHandle>> SubmitParallel(Func&& func, u64 count);
+		JobHandle Submit(Func&& func, std::initializer_list<JobHandle> dependencies);
+
+		template <typename Func>
+		std::vector<JobHandle> SubmitParallel(Func&& func, u64 count);
+
+		// Blocks until the job completed, running other queued jobs in the meantime
+		void Wait(JobHandle handle);
 
 		// Wait for all jobs to complete
-		void WaitForAll(std::span<std::shared_ptr<JobHandle>> handles);
+		void WaitForAll(std::span<const JobHandle> handles);
+
+		// Blocks until the counter reaches zero, running other queued jobs in the meantime
+		void Wait(const WaitCounter& counter);
+
+		[[nodiscard]] bool IsComplete(JobHandle handle) const noexcept;
+		[[nodiscard]] inline u64 GetNumThreads() const { return m_pool.GetNumThreads(); }
+
+		// Index of the calling worker in [0, GetNumThreads()), -1 for threads outside the pool.
+		// Lets callers keep per thread state the way ParallelReduce does
+		[[nodiscard]] inline i64 GetCurrentWorkerIndex() const noexcept { return m_pool.GetCurrentWorkerIndex(); }
 
 		template <typename Iterator, typename Func>
 		void ForEach(Iterator first, Iterator last, Func&& func);
 
+		// Runs func over [begin, end) and returns once every index is done. func takes either a
+		// single index or a (begin, end) sub-range. Ranges are split lazily: a job keeps halving its
+		// range only while its own queue is empty, so splits happen where thieves can pick them up
+		// and no range smaller than minGrain is ever split off
+		template <typename Func>
+		void ParallelFor(u64 begin, u64 end, u64 minGrain, Func&& func);
+
+		// Folds [begin, end) into one value. func(begin, end, init) accumulates a sub-range onto init and
+		// reduce(a, b) combines two partial results, both have to be associative. Partial results are
+		// kept per thread, so the order they combine in (and float rounding) varies between runs
+		template <typename T, typename Func, typename Reduce>
+		[[nodiscard]] T ParallelReduce(u64 begin, u64 end, u64 minGrain, T identity, Func&& func, Reduce&& reduce);
+
 	private:
-		void ProcessReadyJobs();
+		// Successor link, owned by the predecessor's edge list until it completes
+		struct JobEdge
+		{
+			u32 Successor = 0;
+			u32 Next      = Job::NO_EDGE;
+		};
+
+		template <typename Body>
+		struct RangeContext
+		{
+			RangeContext(Body& func, u64 grain) : Func(func), Grain(grain) {}
+
+			Body&       Func;
+			u64         Grain;
+			WaitCounter Pending;
+		};
+
+		template <typename Body>
+		void SpawnRange(RangeContext<Body>& context, u64 begin, u64 end);
+
+		template <typename Body>
+		void RunRange(RangeContext<Body>& context, u64 begin, u64 end);
+
+		// Rounds with nothing to help with before a full pool gives up on a free slot
+		static constexpr u32 MAX_IDLE_ROUNDS = 64;
+
+		[[nodiscard]] u32 PopFreeSlot(IndexFreeList& freeList);
+		[[nodiscard]] Job* TryAllocateJob();
+		[[nodiscard]] JobHandle MakeHandle(const Job& job);
+		[[nodiscard]] bool AddSuccessor(JobHandle dependency, u32 successor);
+
+		void Link(Job& job, std::span<const JobHandle> dependencies);
+		void Schedule(Job& job);
+		void Run(Job& job);
+
+		static void RunTask(ThreadPool::Task* task);
 
 	private:
-		ThreadPool                       m_pool;
-		std::queue<std::unique_ptr<Job>> m_pendingJobs;
-		std::mutex                       m_mutex;
+		u32                        m_maxJobs;
+		std::unique_ptr<Job[]>     m_jobs;
+		std::unique_ptr<JobEdge[]> m_edges;
+		IndexFreeList              m_freeJobs;
+		IndexFreeList              m_freeEdges;
+		ThreadPool                 m_pool;  // Declared last so workers are joined before the pools go away
 	};
 }
 
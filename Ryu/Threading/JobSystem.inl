@@ -1,25 +1,38 @@
-#include "JobSystem.h"
+#include <algorithm>
+#include <mutex>
+
 namespace Ryu::MT
 {
 	template<typename Func>
-	inline std::shared_ptr<JobHandle> JobSystem::Submit(Func&& func, std::vector<std::shared_ptr<JobHandle>> dependencies)
+	inline JobHandle JobSystem::Submit(Func&& func, std::span<const JobHandle> dependencies)
 	{
-		std::unique_ptr<Job> job = std::make_unique<Job>(std::forward<Func>(func), std::move(dependencies));
-		std::shared_ptr<JobHandle> handle = job->GetHandle();
-
+		Job* slot = TryAllocateJob();
+		if (!slot)
 		{
-			std::lock_guard lock(m_mutex);
-			m_pendingJobs.push(std::move(job));
+			WaitForAll(dependencies);
+			std::forward<Func>(func)();
+			return {};
 		}
 
-		ProcessReadyJobs(); // Submit jobs that are ready to the thread pool
+		Job& job = *slot;
+		job.Bind(std::forward<Func>(func));
+
+		const JobHandle handle = MakeHandle(job);
+		Link(job, dependencies);
 
 		return handle;
 	}
+
+	template<typename Func>
+	inline JobHandle JobSystem::Submit(Func&& func, std::initializer_list<JobHandle> dependencies)
+	{
+		return Submit(std::forward<Func>(func), std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+	}
+
 	template<typename Func>
-	inline std::vector<std::shared_ptr<JobHandle>> JobSystem::SubmitParallel(Func&& func, u64 count)
+	inline std::vector<JobHandle> JobSystem::SubmitParallel(Func&& func, u64 count)
 	{
-		std::vector<std::shared_ptr<JobHandle>> handles;
+		std::vector<JobHandle> handles;
 		handles.reserve(count);
 
 		// Submit each job and return the cached handles
@@ -35,28 +48,169 @@ namespace Ryu::MT
 	inline void JobSystem::ForEach(Iterator first, Iterator last, Func&& func)
 	{
 		const u64 distance = std::distance(first, last);
-		const u64 threadCount = std::min(distance, m_pool.GetNumThreads());
-		const u64 chunkSize = distance / threadCount;
 
-		std::vector<std::shared_ptr<JobHandle>> handles;
-		handles.reserve(threadCount);
+		if constexpr (std::random_access_iterator<Iterator>)
+		{
+			// Aim for a handful of grains per thread, lazy splitting takes care of the balancing
+			const u64 grain = std::max<u64>(distance / ((m_pool.GetNumThreads() + 1) * 8), 1);
+			ParallelFor(0, distance, grain, [first, &func](u64 begin, u64 end)
+			{
+				std::for_each(first + begin, first + end, func);
+			});
+		}
+		else
+		{
+			const u64 threadCount = std::min(distance, std::max<u64>(m_pool.GetNumThreads(), 1));
+			if (threadCount == 0)
+			{
+				return;
+			}
+
+			const u64 chunkSize = distance / threadCount;
+
+			std::vector<JobHandle> handles;
+			handles.reserve(threadCount);
+
+			auto it = first;
+			for (u64 i = 0; i < threadCount; i++)
+			{
+				auto chunkEnd = (i == threadCount - 1) ? last : std::next(it, chunkSize);
+
+				// Submit each chunk
+				handles.push_back(Submit(
+					[it, chunkEnd, &func] ()
+					{
+						std::for_each(it, chunkEnd, func);
+					})
+				);
+
+				it = chunkEnd;
+			}
+
+			WaitForAll(handles);
+		}
+	}
+
+	template<typename Func>
+	inline void JobSystem::ParallelFor(u64 begin, u64 end, u64 minGrain, Func&& func)
+	{
+		if (begin >= end)
+		{
+			return;
+		}
+
+		auto body = [&func](u64 first, u64 last)
+		{
+			if constexpr (std::is_invocable_v<Func&, u64, u64>)
+			{
+				func(first, last);
+			}
+			else
+			{
+				for (u64 i = first; i < last; ++i)
+				{
+					func(i);
+				}
+			}
+		};
+
+		const u64 grain = std::max<u64>(minGrain, 1);
+
+		// Nothing to split, skip the job machinery
+		if (end - begin < grain * 2)
+		{
+			body(begin, end);
+			return;
+		}
+
+		// The calling thread takes the root range and helps with the rest until it drains
+		RangeContext<decltype(body)> context(body, grain);
+		context.Pending.Add();
+		RunRange(context, begin, end);
+		Wait(context.Pending);
+	}
 
-		auto it = first;
-		for (u64 i = 0; i < threadCount; i++)
+	template<typename T, typename Func, typename Reduce>
+	inline T JobSystem::ParallelReduce(u64 begin, u64 end, u64 minGrain, T identity, Func&& func, Reduce&& reduce)
+	{
+		struct alignas(64) Partial
 		{
-			auto chunkEnd = (i == threadCount - 1) ? last : std::next(it, chunkSize);
+			T Value;
+		};
+
+		// One slot per worker plus a shared one for threads outside the pool (the caller, or
+		// anyone helping from a Wait), those are the only ones that need the lock
+		std::vector<Partial> partials(m_pool.GetNumThreads() + 1, Partial{ identity });
+		std::mutex outsideMutex;
 
-			// Submit each chunk
-			handles.push_back(Submit(
-				[it, chunkEnd, func] ()
+		// Into a local first: func may help run jobs, other ranges of this reduce among them,
+		// and those fold into the same slot
+		auto accumulate = [&func, &reduce, &identity](u64 first, u64 last)
+		{
+			T value = identity;
+			if constexpr (std::is_invocable_v<Func&, u64, u64, T>)
+			{
+				value = func(first, last, std::move(value));
+			}
+			else
+			{
+				for (u64 i = first; i < last; ++i)
 				{
-					std::for_each(it, chunkEnd, func);
-				})
-			);
+					value = reduce(std::move(value), func(i));
+				}
+			}
+			return value;
+		};
+
+		ParallelFor(begin, end, minGrain, [&](u64 first, u64 last)
+		{
+			T value = accumulate(first, last);
+			if (const i64 worker = m_pool.GetCurrentWorkerIndex(); worker >= 0)
+			{
+				partials[worker].Value = reduce(std::move(partials[worker].Value), std::move(value));
+			}
+			else
+			{
+				std::lock_guard lock(outsideMutex);
+				partials.back().Value = reduce(std::move(partials.back().Value), std::move(value));
+			}
+		});
+
+		T result = std::move(identity);
+		for (Partial& partial : partials)
+		{
+			result = reduce(std::move(result), std::move(partial.Value));
+		}
+		return result;
+	}
+
+	template<typename Body>
+	inline void JobSystem::SpawnRange(RangeContext<Body>& context, u64 begin, u64 end)
+	{
+		context.Pending.Add();
+		Submit([this, &context, begin, end] { RunRange(context, begin, end); });
+	}
+
+	template<typename Body>
+	inline void JobSystem::RunRange(RangeContext<Body>& context, u64 begin, u64 end)
+	{
+		while (begin < end)
+		{
+			// Lazy binary splitting: give away half the range only when there is nothing queued
+			// here for an idle thread to steal. Both halves stay at least one grain long
+			if (end - begin >= context.Grain * 2 && m_pool.GetLocalQueueSize() == 0)
+			{
+				const u64 middle = begin + (end - begin) / 2;
+				SpawnRange(context, middle, end);
+				end = middle;
+				continue;
+			}
 
-			it = chunkEnd;
+			const u64 chunkEnd = std::min(begin + context.Grain, end);
+			context.Func(begin, chunkEnd);
+			begin = chunkEnd;
 		}
 
-		WaitForAll(handles);
+		context.Pending.Decrement();
 	}
 }
@@ -0,0 +1,111 @@
+#include "Threading/ChunkedCollector.h"
+#include <array>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::MT::Tests
+{
+	constexpr size_t TEST_WORKER_COUNT = 4;
+	constexpr u64 TEST_CHUNK_SIZE      = 16;
+
+	// Empty groups, partial chunks and exact multiples of the chunk size
+	constexpr std::array<u64, 7> GROUP_SIZES{ 0, 1, 15, 16, 17, 5000, 3 };
+
+	// Keeps about two thirds of the items, so chunks leave differently sized runs behind
+	bool Keep(u64 group, u64 index)
+	{
+		return (group * 7919 + index * 31) % 3 != 0;
+	}
+
+	u64 MakeValue(u64 group, u64 index)
+	{
+		return group * 1'000'000 + index;
+	}
+
+	// What a single pass over every group in order would give
+	std::vector<std::vector<u64>> CollectSerially()
+	{
+		std::vector<std::vector<u64>> groups(GROUP_SIZES.size());
+		for (u64 group = 0; group < GROUP_SIZES.size(); ++group)
+		{
+			for (u64 i = 0; i < GROUP_SIZES[group]; ++i)
+			{
+				if (Keep(group, i))
+				{
+					groups[group].push_back(MakeValue(group, i));
+				}
+			}
+		}
+		return groups;
+	}
+
+	template <typename Collect>
+	std::vector<std::vector<u64>> CollectChunked(JobSystem* jobSystem, Collect&& collect)
+	{
+		ChunkedCollector<u64> collector(jobSystem, GROUP_SIZES, TEST_CHUNK_SIZE);
+		collector.Run(collect);
+
+		std::vector<std::vector<u64>> groups(GROUP_SIZES.size());
+		for (u64 group = 0; group < GROUP_SIZES.size(); ++group)
+		{
+			collector.AppendTo(group, groups[group]);
+			CHECK(collector.CountItems(group) == groups[group].size());
+		}
+		return groups;
+	}
+
+	void AppendKept(u64 group, u64 first, u64 last, std::pmr::vector<u64>& items)
+	{
+		for (u64 i = first; i < last; ++i)
+		{
+			if (Keep(group, i))
+			{
+				items.push_back(MakeValue(group, i));
+			}
+		}
+	}
+
+	TEST_CASE("Chunked collector")
+	{
+		const std::vector<std::vector<u64>> expected = CollectSerially();
+
+		SUBCASE("Chunks cover every group")
+		{
+			ChunkedCollector<u64> collector(nullptr, GROUP_SIZES, TEST_CHUNK_SIZE);
+			CHECK(collector.GetChunkCount() == 0 + 1 + 1 + 1 + 2 + 313 + 1);
+		}
+
+		SUBCASE("Results come back in serial order with and without a job system")
+		{
+			CHECK(CollectChunked(nullptr, AppendKept) == expected);
+
+			JobSystem jobs(TEST_WORKER_COUNT);
+			for (u32 run = 0; run < 20; ++run)
+			{
+				CHECK(CollectChunked(&jobs, AppendKept) == expected);
+			}
+		}
+
+		SUBCASE("Chunks that help run jobs while collecting")
+		{
+			// Waiting runs other queued jobs on the waiting thread, other chunks of the same run among them
+			JobSystem jobs(TEST_WORKER_COUNT);
+			auto collectAndSubmit = [&jobs](u64 group, u64 first, u64 last, std::pmr::vector<u64>& items)
+			{
+				const u64 middle = first + (last - first) / 2;
+				AppendKept(group, first, middle, items);
+
+				jobs.Submit([] {}).Wait();
+
+				AppendKept(group, middle, last, items);
+			};
+
+			for (u32 run = 0; run < 20; ++run)
+			{
+				CHECK(CollectChunked(&jobs, collectAndSubmit) == expected);
+			}
+		}
+	}
+}
@@ -0,0 +1,229 @@
+#include "Threading/Coroutines/Awaitables.h"
+#include <stdexcept>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::MT::Tests
+{
+	constexpr size_t TEST_WORKER_COUNT = 4;
+
+	Task<i32> Add(i32 a, i32 b)
+	{
+		co_return a + b;
+	}
+
+	Task<i32> AddTwice(i32 a, i32 b)
+	{
+		const i32 first  = co_await Add(a, b);
+		const i32 second = co_await Add(first, b);
+		co_return second;
+	}
+
+	Task<i32> Throws()
+	{
+		throw std::runtime_error("Task failed");
+		co_return 0;
+	}
+
+	Task<u64> Chain(u64 depth)
+	{
+		if (depth == 0)
+		{
+			co_return 0;
+		}
+		co_return 1 + co_await Chain(depth - 1);
+	}
+
+	TEST_CASE("Coroutine tasks")
+	{
+		JobSystem jobs(TEST_WORKER_COUNT);
+
+		SUBCASE("Tasks are lazy")
+		{
+			// Captureless, the closure is a temporary and would be gone by the time the body runs
+			bool started = false;
+			auto task = [](bool& started) -> Task<>
+			{
+				started = true;
+				co_return;
+			}(started);
+
+			CHECK_FALSE(started);
+			CHECK_FALSE(task.IsDone());
+			SyncWait(jobs, std::move(task));
+			CHECK(started);
+		}
+
+		SUBCASE("Awaiting tasks passes results along")
+		{
+			CHECK(SyncWait(jobs, AddTwice(1, 2)) == 5);
+		}
+
+		SUBCASE("Deep chains finish without overflowing the stack")
+		{
+			CHECK(SyncWait(jobs, Chain(100'000)) == 100'000);
+		}
+
+		SUBCASE("Exceptions reach the awaiting coroutine")
+		{
+			auto catcher = []() -> Task<bool>
+			{
+				try
+				{
+					co_await Throws();
+				}
+				catch (const std::runtime_error&)
+				{
+					co_return true;
+				}
+				co_return false;
+			};
+
+			CHECK(SyncWait(jobs, catcher()));
+			CHECK_THROWS_AS(SyncWait(jobs, Throws()), std::runtime_error);
+		}
+	}
+
+	TEST_CASE("Coroutine awaitables")
+	{
+		JobSystem jobs(TEST_WORKER_COUNT);
+		const std::thread::id mainThread = std::this_thread::get_id();
+
+		SUBCASE("Awaiting a job handle resumes after the job ran")
+		{
+			std::atomic<bool> jobRan{ false };
+
+			auto task = [](JobSystem& jobs, std::atomic<bool>& jobRan) -> Task<bool>
+			{
+				JobHandle handle = jobs.Submit([&jobRan]
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(5));
+					jobRan.store(true);
+				});
+
+				co_await handle;
+				co_return jobRan.load();
+			};
+
+			CHECK(SyncWait(jobs, task(jobs, jobRan)));
+		}
+
+		SUBCASE("Awaiting a finished or empty handle does not suspend")
+		{
+			auto task = [](JobSystem& jobs) -> Task<std::thread::id>
+			{
+				JobHandle handle = jobs.Submit([] {});
+				handle.Wait();
+
+				co_await handle;
+				co_await JobHandle{};
+				co_return std::this_thread::get_id();
+			};
+
+			CHECK(SyncWait(jobs, task(jobs)) == mainThread);
+		}
+
+		SUBCASE("Resume on worker leaves the calling thread")
+		{
+			WaitCounter done(1);
+			std::thread::id resumedOn;
+
+			auto task = [](JobSystem& jobs, WaitCounter& done, std::thread::id& resumedOn) -> Task<>
+			{
+				co_await ResumeOnWorker(jobs);
+				resumedOn = std::this_thread::get_id();
+				done.Decrement();
+			};
+
+			// Plain wait, SyncWait would help and might run the continuation right here
+			Spawn(task(jobs, done, resumedOn));
+			done.Wait();
+
+			CHECK(resumedOn != mainThread);
+		}
+
+		SUBCASE("Resume on main thread waits for the next drain")
+		{
+			MainThreadQueue mainQueue;
+			std::atomic<i32> stage{ 0 };
+			std::thread::id resumedOn;
+
+			auto task = [](JobSystem& jobs, MainThreadQueue& mainQueue, std::atomic<i32>& stage, std::thread::id& resumedOn) -> Task<>
+			{
+				co_await ResumeOnWorker(jobs);
+				stage.store(1);
+
+				co_await ResumeOnMainThread(mainQueue);
+				resumedOn = std::this_thread::get_id();
+				stage.store(2);
+
+				// Already on the main thread, this skips exactly one frame
+				co_await ResumeOnMainThread(mainQueue);
+				stage.store(3);
+			};
+
+			Spawn(task(jobs, mainQueue, stage, resumedOn));
+
+			// Frame loop stand-in
+			u32 frames = 0;
+			while (stage.load() < 2)
+			{
+				mainQueue.Drain();
+				++frames;
+				std::this_thread::yield();
+			}
+
+			CHECK(resumedOn == mainThread);
+			CHECK(stage.load() == 2);
+			CHECK_FALSE(mainQueue.IsEmpty());
+
+			CHECK(mainQueue.Drain() == 1);
+			CHECK(stage.load() == 3);
+			CHECK(mainQueue.IsEmpty());
+			CHECK(frames > 0);
+		}
+
+		SUBCASE("Many tasks fanning out over jobs")
+		{
+			constexpr u64 taskCount = 1000;
+			std::atomic<u64> sum{ 0 };
+
+			auto worker = [](JobSystem& jobs, std::atomic<u64>& sum, u64 value) -> Task<>
+			{
+				co_await ResumeOnWorker(jobs);
+				co_await jobs.Submit([&sum, value] { sum.fetch_add(value); });
+				sum.fetch_add(value);
+			};
+
+			auto root = [&]() -> Task<>
+			{
+				for (u64 i = 0; i < taskCount; ++i)
+				{
+					co_await worker(jobs, sum, i);
+				}
+			};
+
+			SyncWait(jobs, root());
+			CHECK(sum.load() == 2 * (taskCount * (taskCount - 1) / 2));
+		}
+
+		SUBCASE("Sync waits finishing on workers back to back")
+		{
+			// The worker signals a counter on SyncWait's stack, which the next iteration reuses right away.
+			// Most useful under a sanitizer
+			auto onWorker = [](JobSystem& jobs, u64 value) -> Task<u64>
+			{
+				co_await ResumeOnWorker(jobs);
+				co_return value;
+			};
+
+			u64 sum = 0;
+			for (u64 i = 0; i < 5000; ++i)
+			{
+				sum += SyncWait(jobs, onWorker(jobs, i));
+			}
+			CHECK(sum == 5000 * 4999 / 2);
+		}
+	}
+}
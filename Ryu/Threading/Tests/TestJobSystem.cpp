@@ -0,0 +1,424 @@
+#include "Threading/JobSystem.h"
+#include "Memory/New.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::MT::Tests
+{
+	constexpr size_t TEST_WORKER_COUNT = 4;
+
+	TEST_CASE("JobSystem dependencies")
+	{
+		JobSystem jobs(TEST_WORKER_COUNT);
+
+		SUBCASE("Job without dependencies runs")
+		{
+			std::atomic<bool> ran{ false };
+			auto handle = jobs.Submit([&] { ran.store(true); });
+			handle.Wait();
+			CHECK(ran.load());
+			CHECK(handle.IsReady());
+		}
+
+		SUBCASE("Job waits for its dependency")
+		{
+			std::atomic<i32> order{ 0 };
+			i32 firstSeen = -1, secondSeen = -1;
+
+			auto first  = jobs.Submit([&] { firstSeen = order.fetch_add(1); });
+			auto second = jobs.Submit([&] { secondSeen = order.fetch_add(1); }, { first });
+
+			second.Wait();
+			CHECK(firstSeen == 0);
+			CHECK(secondSeen == 1);
+		}
+
+		SUBCASE("Dependency that already finished does not block")
+		{
+			auto first = jobs.Submit([] {});
+			first.Wait();
+
+			auto second = jobs.Submit([] {}, { first, JobHandle{} });
+			second.Wait();
+			CHECK(second.IsReady());
+		}
+
+		SUBCASE("Diamond runs join after both branches")
+		{
+			std::atomic<i32> branchesDone{ 0 };
+			i32 seenByJoin = -1;
+
+			auto root  = jobs.Submit([] {});
+			auto left  = jobs.Submit([&] { branchesDone.fetch_add(1); }, { root });
+			auto right = jobs.Submit([&] { branchesDone.fetch_add(1); }, { root });
+			auto join  = jobs.Submit([&] { seenByJoin = branchesDone.load(); }, { left, right });
+
+			join.Wait();
+			CHECK(seenByJoin == 2);
+		}
+
+		SUBCASE("Long chain keeps its order")
+		{
+			constexpr u64 chainLength = 10'000;
+			std::vector<u64> visited;
+			visited.reserve(chainLength);
+
+			JobHandle previous;
+			for (u64 i = 0; i < chainLength; ++i)
+			{
+				previous = jobs.Submit([&visited, i] { visited.push_back(i); }, { previous });
+			}
+
+			previous.Wait();
+			REQUIRE(visited.size() == chainLength);
+			CHECK(std::ranges::is_sorted(visited));
+		}
+	}
+
+	TEST_CASE("JobSystem job pool")
+	{
+		SUBCASE("Handles go stale once the slot is recycled")
+		{
+			JobSystem jobs(TEST_WORKER_COUNT, 1);  // Single slot, every job reuses it
+
+			auto first = jobs.Submit([] {});
+			first.Wait();
+			auto second = jobs.Submit([] {});
+			second.Wait();
+
+			CHECK(first.Index == second.Index);
+			CHECK(first.Generation != second.Generation);
+			CHECK(first.IsReady());
+			CHECK(second.IsReady());
+			CHECK(JobHandle{}.IsReady());
+		}
+
+		SUBCASE("Submitting more jobs than the pool holds still runs them all")
+		{
+			JobSystem jobs(TEST_WORKER_COUNT, 64);
+			std::atomic<u64> counter{ 0 };
+
+			std::vector<JobHandle> handles;
+			for (u64 i = 0; i < 10'000; ++i)
+			{
+				handles.push_back(jobs.Submit([&counter] { counter.fetch_add(1); }));
+			}
+
+			jobs.WaitForAll(handles);
+			CHECK(counter.load() == 10'000);
+		}
+
+		SUBCASE("Running jobs that submit more than the pool holds still finish")
+		{
+			// Every slot ends up held by a range waiting for a slot of its own, those submits run inline instead
+			JobSystem jobs(TEST_WORKER_COUNT, 8);
+			std::atomic<u64> innerRuns{ 0 };
+
+			jobs.ParallelFor(0, 2'000, 1, [&jobs, &innerRuns](u64)
+			{
+				jobs.Submit([&innerRuns] { innerRuns.fetch_add(1); }).Wait();
+			});
+			CHECK(innerRuns.load() == 2'000);
+		}
+
+		SUBCASE("Steady state submission does not allocate")
+		{
+			REQUIRE(Memory::IsMemoryTrackingEnabled());
+
+			JobSystem jobs(TEST_WORKER_COUNT);
+			std::atomic<u64> counter{ 0 };
+			std::array<JobHandle, 256> handles{};
+
+			auto runBatch = [&]
+			{
+				JobHandle previous;
+				for (JobHandle& handle : handles)
+				{
+					// Mix of independent jobs and short chains so the edge pool is exercised too
+					handle = jobs.Submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); }, { previous });
+					previous = (counter.load(std::memory_order_relaxed) % 4 == 0) ? JobHandle{} : handle;
+				}
+				jobs.WaitForAll(handles);
+			};
+
+			runBatch();  // Warm up thread locals and deques
+
+			const size_t allocationsBefore = Memory::GetAllocationCount();
+			for (u32 i = 0; i < 40; ++i)
+			{
+				runBatch();
+			}
+			const size_t allocationsAfter = Memory::GetAllocationCount();
+
+			CHECK(counter.load() == 41 * handles.size());
+			CHECK(allocationsAfter - allocationsBefore == 0);
+		}
+	}
+
+	TEST_CASE("JobSystem parallel for")
+	{
+		JobSystem jobs(TEST_WORKER_COUNT);
+
+		SUBCASE("Every index runs exactly once")
+		{
+			for (u64 grain : { 1ull, 7ull, 64ull, 1000ull, 1'000'000ull })
+			{
+				std::vector<std::atomic<u32>> seen(100'000);
+				jobs.ParallelFor(0, seen.size(), grain, [&](u64 i) { seen[i].fetch_add(1, std::memory_order_relaxed); });
+
+				CHECK(std::ranges::all_of(seen, [](const auto& count) { return count.load() == 1; }));
+			}
+		}
+
+		SUBCASE("Range bodies cover the range without overlap")
+		{
+			constexpr u64 begin = 1000, end = 51'000, grain = 256;
+			std::atomic<u64> covered{ 0 };
+			std::atomic<u64> outOfBounds{ 0 };
+
+			jobs.ParallelFor(begin, end, grain, [&](u64 first, u64 last)
+			{
+				if (first < begin || last > end || last - first > grain)
+				{
+					outOfBounds.fetch_add(1);
+				}
+				covered.fetch_add(last - first);
+			});
+
+			CHECK(outOfBounds.load() == 0);
+
+			CHECK(covered.load() == end - begin);
+		}
+
+		SUBCASE("Empty ranges do nothing")
+		{
+			bool ran = false;
+			jobs.ParallelFor(10, 10, 1, [&](u64) { ran = true; });
+			jobs.ParallelFor(10, 5, 1, [&](u64) { ran = true; });
+			CHECK_FALSE(ran);
+		}
+
+		SUBCASE("Nested parallel for from inside a job")
+		{
+			std::atomic<u64> counter{ 0 };
+			auto handle = jobs.Submit([&]
+			{
+				jobs.ParallelFor(0, 100, 1, [&](u64)
+				{
+					jobs.ParallelFor(0, 100, 4, [&](u64) { counter.fetch_add(1, std::memory_order_relaxed); });
+				});
+			});
+
+			handle.Wait();
+			CHECK(counter.load() == 100 * 100);
+		}
+
+		SUBCASE("Back to back calls reuse the stack the last one waited on")
+		{
+			// Each call's counter is gone as soon as it returns, the last worker must be done with it by then.
+			// Most useful under a sanitizer
+			u64 total = 0;
+			for (u32 i = 0; i < 10'000; ++i)
+			{
+				std::atomic<u64> counter{ 0 };
+				jobs.ParallelFor(0, 8, 1, [&](u64) { counter.fetch_add(1, std::memory_order_relaxed); });
+				total += counter.load();
+			}
+			CHECK(total == 10'000 * 8);
+		}
+
+		SUBCASE("ForEach visits every element")
+		{
+			std::vector<u64> values(10'000, 1);
+			jobs.ForEach(values.begin(), values.end(), [](u64& value) { value *= 3; });
+			CHECK(std::ranges::all_of(values, [](u64 value) { return value == 3; }));
+		}
+	}
+
+	TEST_CASE("JobSystem parallel reduce")
+	{
+		JobSystem jobs(TEST_WORKER_COUNT);
+		constexpr u64 count = 1'000'000;
+
+		SUBCASE("Per-index sum")
+		{
+			const u64 sum = jobs.ParallelReduce<u64>(0, count, 1024, 0,
+				[](u64 i) { return i; },
+				[](u64 a, u64 b) { return a + b; });
+
+			CHECK(sum == count * (count - 1) / 2);
+		}
+
+		SUBCASE("Range accumulation")
+		{
+			const u64 maxValue = jobs.ParallelReduce<u64>(0, count, 4096, 0,
+				[](u64 first, u64 last, u64 init)
+				{
+					for (u64 i = first; i < last; ++i)
+					{
+						init = std::max(init, (i * 7919) % count);
+					}
+					return init;
+				},
+				[](u64 a, u64 b) { return std::max(a, b); });
+
+			CHECK(maxValue == count - 1);
+		}
+
+		SUBCASE("Empty range returns the identity")
+		{
+			const i32 result = jobs.ParallelReduce<i32>(5, 5, 1, 1,
+				[](u64) { return 2; },
+				[](i32 a, i32 b) { return a * b; });
+			CHECK(result == 1);
+		}
+
+		SUBCASE("Ranges that help run jobs while accumulating")
+		{
+			// Waiting runs other queued jobs on the waiting thread, other ranges of the same reduce among them
+			constexpr u64 smallCount = 10'000;
+
+			const u64 sum = jobs.ParallelReduce<u64>(0, smallCount, 16, 0,
+				[&jobs](u64 first, u64 last, u64 init)
+				{
+					init += first;
+					jobs.Submit([] {}).Wait();
+					for (u64 i = first + 1; i < last; ++i)
+					{
+						init += i;
+					}
+					return init;
+				},
+				[](u64 a, u64 b) { return a + b; });
+
+			CHECK(sum == smallCount * (smallCount - 1) / 2);
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("JobSystem graph benchmark" * doctest::skip())
+	{
+		JobSystem jobs(std::max<size_t>(TEST_WORKER_COUNT, std::thread::hardware_concurrency() - 1));
+
+		for (u64 jobCount : { 10'000ull, 100'000ull })
+		{
+			// Deep chain: every job depends on the previous one
+			{
+				Utils::Stopwatch timer(true);
+
+				JobHandle previous;
+				for (u64 i = 0; i < jobCount; ++i)
+				{
+					previous = jobs.Submit([] {}, { previous });
+				}
+				previous.Wait();
+
+				const f64 ms = timer.Elapsed();
+				MESSAGE("Chain of " << jobCount << " jobs: " << ms << "ms (" << (ms * 1e6 / jobCount) << "ns/job)");
+			}
+
+			// Fan-out then fan-in: one root, jobCount children, one join depending on all children
+			{
+				std::atomic<u64> counter{ 0 };
+				Utils::Stopwatch timer(true);
+
+				auto root = jobs.Submit([] {});
+
+				std::vector<JobHandle> children;
+				children.reserve(jobCount);
+				for (u64 i = 0; i < jobCount; ++i)
+				{
+					children.push_back(jobs.Submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); }, { root }));
+				}
+
+				auto join = jobs.Submit([] {}, children);
+				join.Wait();
+
+				const f64 ms = timer.Elapsed();
+				CHECK(counter.load() == jobCount);
+				MESSAGE("Fan-out/fan-in of " << jobCount << " jobs: " << ms << "ms (" << (ms * 1e6 / jobCount) << "ns/job)");
+			}
+
+			// Layered graph: 100 jobs per layer, each job depends on 4 jobs of the previous layer
+			{
+				constexpr u64 layerWidth = 100;
+				const u64 layerCount = jobCount / layerWidth;
+				Utils::Stopwatch timer(true);
+
+				std::vector<JobHandle> previousLayer, currentLayer;
+				for (u64 layer = 0; layer < layerCount; ++layer)
+				{
+					currentLayer.clear();
+					for (u64 i = 0; i < layerWidth; ++i)
+					{
+						std::vector<JobHandle> dependencies;
+						if (!previousLayer.empty())
+						{
+							for (u64 d = 0; d < 4; ++d)
+							{
+								dependencies.push_back(previousLayer[(i + d * 25) % layerWidth]);
+							}
+						}
+						currentLayer.push_back(jobs.Submit([] {}, dependencies));
+					}
+					std::swap(previousLayer, currentLayer);
+				}
+				jobs.WaitForAll(previousLayer);
+
+				const f64 ms = timer.Elapsed();
+				MESSAGE("Layered graph of " << jobCount << " jobs: " << ms << "ms (" << (ms * 1e6 / jobCount) << "ns/job)");
+			}
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("JobSystem parallel for benchmark" * doctest::skip())
+	{
+		JobSystem jobs(std::max<size_t>(TEST_WORKER_COUNT, std::thread::hardware_concurrency() - 1));
+
+		constexpr u64 elementCount = 1'000'000;
+		std::vector<f32> input(elementCount), output(elementCount);
+		std::iota(input.begin(), input.end(), 0.0f);
+
+		auto transform = [&](u64 i) { output[i] = std::sqrt(input[i]) * 0.5f + 1.0f; };
+
+		f64 serialUs = 0.0;
+		{
+			Utils::Stopwatch timer(true);
+			for (u64 i = 0; i < elementCount; ++i)
+			{
+				transform(i);
+			}
+			serialUs = timer.Elapsed<std::chrono::microseconds>();
+			MESSAGE("Serial transform of " << elementCount << " elements: " << serialUs << "us");
+		}
+
+		for (u64 grain : { 16ull, 64ull, 256ull, 1'024ull, 4'096ull, 16'384ull, 65'536ull })
+		{
+			Utils::Stopwatch timer(true);
+			jobs.ParallelFor(0, elementCount, grain, transform);
+			const f64 forUs = timer.Elapsed<std::chrono::microseconds>();
+
+			timer.Restart();
+			const f64 sum = jobs.ParallelReduce<f64>(0, elementCount, grain, 0.0,
+				[&](u64 first, u64 last, f64 init)
+				{
+					for (u64 i = first; i < last; ++i)
+					{
+						init += output[i];
+					}
+					return init;
+				},
+				[](f64 a, f64 b) { return a + b; });
+			const f64 reduceUs = timer.Elapsed<std::chrono::microseconds>();
+
+			CHECK(sum > 0.0);
+			MESSAGE("Grain " << grain << ": ParallelFor " << forUs << "us (" << (serialUs / forUs) << "x serial) | ParallelReduce " << reduceUs << "us");
+		}
+	}
+}
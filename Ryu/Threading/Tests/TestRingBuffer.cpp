@@ -0,0 +1,257 @@
+#include "Threading/Containers/ThreadSafeRingBuffer.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::MT::Tests
+{
+	// What TSRingBuffer used to be: a std::mutex around every push and pop.
+	// Kept here only as a benchmark baseline
+	template <typename T, size_t capacity>
+	class MutexRingBuffer
+	{
+	public:
+		inline bool PushBack(const T& item)
+		{
+			std::scoped_lock lock(m_mutex);
+
+			const size_t next = (m_head + 1) % capacity;
+			if (next == m_tail)
+			{
+				return false;
+			}
+
+			m_data[m_head] = item;
+			m_head         = next;
+			return true;
+		}
+
+		inline bool PopFront(T& item)
+		{
+			std::scoped_lock lock(m_mutex);
+
+			if (m_tail == m_head)
+			{
+				return false;
+			}
+
+			item   = m_data[m_tail];
+			m_tail = (m_tail + 1) % capacity;
+			return true;
+		}
+
+	private:
+		std::array<T, capacity> m_data{};
+		size_t                  m_head = 0;
+		size_t                  m_tail = 0;
+		std::mutex              m_mutex;
+	};
+
+	// Every producer pushes its own slice of [0, itemsPerProducer * producers), consumers record what they see
+	template <typename Queue>
+	void RunProducersConsumers(Queue& queue, u64 producers, u64 consumers, u64 itemsPerProducer, std::vector<std::atomic<u32>>* seen)
+	{
+		const u64 total = producers * itemsPerProducer;
+		std::atomic<u64> consumed{ 0 };
+
+		std::vector<std::jthread> threads;
+		for (u64 p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&, p]
+			{
+				for (u64 i = 0; i < itemsPerProducer; ++i)
+				{
+					while (!queue.PushBack(p * itemsPerProducer + i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		for (u64 c = 0; c < consumers; ++c)
+		{
+			threads.emplace_back([&]
+			{
+				u64 item = 0;
+				while (consumed.load(std::memory_order_relaxed) < total)
+				{
+					if (queue.PopFront(item))
+					{
+						if (seen)
+						{
+							(*seen)[item].fetch_add(1, std::memory_order_relaxed);
+						}
+						consumed.fetch_add(1, std::memory_order_relaxed);
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		threads.clear();
+	}
+
+	TEST_CASE("TSRingBuffer")
+	{
+		SUBCASE("Single thread FIFO order and capacity")
+		{
+			TSRingBuffer<u64, 8> queue;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				CHECK(queue.PushBack(i));
+			}
+			CHECK_FALSE(queue.PushBack(99));  // Full
+			CHECK(queue.Size() == 8);
+
+			u64 item = 0;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				REQUIRE(queue.PopFront(item));
+				CHECK(item == i);
+			}
+			CHECK_FALSE(queue.PopFront(item));
+			CHECK(queue.IsEmpty());
+		}
+
+		SUBCASE("Wraps around many times")
+		{
+			TSRingBuffer<u64, 4> queue;
+			u64 item = 0;
+			for (u64 i = 0; i < 1000; ++i)
+			{
+				REQUIRE(queue.PushBack(i));
+				REQUIRE(queue.PopFront(item));
+				CHECK(item == i);
+			}
+		}
+
+		SUBCASE("Move-only items")
+		{
+			TSRingBuffer<std::unique_ptr<u64>, 4> queue;
+			CHECK(queue.PushBack(std::make_unique<u64>(7)));
+
+			std::unique_ptr<u64> item;
+			REQUIRE(queue.PopFront(item));
+			CHECK(*item == 7);
+		}
+
+		SUBCASE("Every item is taken exactly once under contention")
+		{
+			constexpr u64 producers = 4, consumers = 4, itemsPerProducer = 50'000;
+			TSRingBuffer<u64, 256> queue;
+			std::vector<std::atomic<u32>> seen(producers * itemsPerProducer);
+
+			RunProducersConsumers(queue, producers, consumers, itemsPerProducer, &seen);
+
+			CHECK(std::ranges::all_of(seen, [](const auto& count) { return count.load() == 1; }));
+			CHECK(queue.IsEmpty());
+		}
+	}
+
+	TEST_CASE("SPSCRingBuffer")
+	{
+		SUBCASE("Single thread FIFO order and capacity")
+		{
+			SPSCRingBuffer<u64, 8> queue;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				CHECK(queue.PushBack(i));
+			}
+			CHECK_FALSE(queue.PushBack(99));
+
+			u64 item = 0;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				REQUIRE(queue.PopFront(item));
+				CHECK(item == i);
+			}
+			CHECK_FALSE(queue.PopFront(item));
+		}
+
+		SUBCASE("Consumer sees the producer's order")
+		{
+			constexpr u64 itemCount = 500'000;
+			SPSCRingBuffer<u64, 128> queue;
+
+			std::jthread producer([&]
+			{
+				for (u64 i = 0; i < itemCount; ++i)
+				{
+					while (!queue.PushBack(i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+
+			u64 expected = 0, item = 0;
+			bool ordered = true;
+			while (expected < itemCount)
+			{
+				if (queue.PopFront(item))
+				{
+					ordered &= (item == expected);
+					++expected;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			producer.join();
+			CHECK(ordered);
+			CHECK(queue.IsEmpty());
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("Ring buffer benchmark" * doctest::skip())
+	{
+		constexpr u64 totalItems = 2'000'000;
+		constexpr size_t capacity = 1024;
+
+		auto itemsPerSecond = [](f64 us) { return static_cast<f64>(totalItems) / (us / 1e6); };
+
+		for (auto [producers, consumers] : { std::pair{ 1ull, 1ull }, { 2ull, 2ull }, { 4ull, 4ull }, { 4ull, 1ull } })
+		{
+			const u64 itemsPerProducer = totalItems / producers;
+
+			f64 mutexUs = 0.0, lockFreeUs = 0.0;
+			{
+				MutexRingBuffer<u64, capacity> queue;
+				Utils::Stopwatch timer(true);
+				RunProducersConsumers(queue, producers, consumers, itemsPerProducer, nullptr);
+				mutexUs = timer.Elapsed<std::chrono::microseconds>();
+			}
+			{
+				TSRingBuffer<u64, capacity> queue;
+				Utils::Stopwatch timer(true);
+				RunProducersConsumers(queue, producers, consumers, itemsPerProducer, nullptr);
+				lockFreeUs = timer.Elapsed<std::chrono::microseconds>();
+			}
+
+			MESSAGE(producers << "P/" << consumers << "C: mutex " << itemsPerSecond(mutexUs) / 1e6
+				<< "M items/s | MPMC " << itemsPerSecond(lockFreeUs) / 1e6 << "M items/s");
+		}
+
+		{
+			SPSCRingBuffer<u64, capacity> queue;
+			Utils::Stopwatch timer(true);
+			RunProducersConsumers(queue, 1, 1, totalItems, nullptr);
+			const f64 spscUs = timer.Elapsed<std::chrono::microseconds>();
+
+			MESSAGE("1P/1C: SPSC " << itemsPerSecond(spscUs) / 1e6 << "M items/s");
+		}
+	}
+}
@@ -0,0 +1,303 @@
+#include "Threading/ThreadPool.h"
+#include "Core/Utils/Timing/Stopwatch.h"
+#include <algorithm>
+#include <latch>
+#include <queue>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace Ryu::MT::Tests
+{
+	// The pool the work-stealing pool replaced: one queue, one mutex, one condition variable.
+	// Kept here only as a benchmark baseline
+	class SharedQueuePool
+	{
+	public:
+		explicit SharedQueuePool(u64 numThreads)
+		{
+			for (u64 i = 0; i < numThreads; i++)
+			{
+				m_workers.emplace_back([this](std::stop_token token) { WorkerLoop(token); });
+			}
+		}
+
+		~SharedQueuePool()
+		{
+			{
+				std::lock_guard lock(m_mutex);
+				m_stopRequested = true;
+			}
+
+			m_cv.notify_all();
+			m_workers.clear();
+		}
+
+		void Enqueue(std::function<void()> task)
+		{
+			{
+				std::lock_guard lock(m_mutex);
+				m_tasks.push(std::move(task));
+			}
+			m_cv.notify_one();
+		}
+
+	private:
+		void WorkerLoop(std::stop_token token)
+		{
+			while (true)
+			{
+				std::function<void()> task;
+				{
+					std::unique_lock lock(m_mutex);
+					m_cv.wait(lock, token, [this] { return !m_tasks.empty() || m_stopRequested; });
+
+					if (m_tasks.empty())
+					{
+						return;
+					}
+
+					task = std::move(m_tasks.front());
+					m_tasks.pop();
+				}
+
+				task();
+			}
+		}
+
+	private:
+		std::vector<std::jthread>         m_workers;
+		std::queue<std::function<void()>> m_tasks;
+		std::mutex                        m_mutex;
+		std::condition_variable_any       m_cv;
+		bool                              m_stopRequested = false;
+	};
+
+	template <typename Pool>
+	f64 RunTinyTasks(Pool& pool, u64 taskCount)
+	{
+		std::latch done(static_cast<std::ptrdiff_t>(taskCount));
+		std::atomic<u64> sum{ 0 };
+
+		Utils::Stopwatch timer(true);
+		for (u64 i = 0; i < taskCount; ++i)
+		{
+			pool.Enqueue([&done, &sum, i]
+			{
+				sum.fetch_add(i, std::memory_order_relaxed);
+				done.count_down();
+			});
+		}
+		done.wait();
+
+		return timer.Elapsed<std::chrono::microseconds>();
+	}
+
+	// Spawns every task from inside a single worker, which is where per-worker deques pay off
+	f64 RunTinyTasksNested(ThreadPool& pool, u64 taskCount)
+	{
+		std::latch done(static_cast<std::ptrdiff_t>(taskCount));
+
+		Utils::Stopwatch timer(true);
+		pool.Enqueue([&pool, &done, taskCount]
+		{
+			for (u64 i = 0; i < taskCount; ++i)
+			{
+				pool.Enqueue([&done] { done.count_down(); });
+			}
+		});
+		done.wait();
+
+		return timer.Elapsed<std::chrono::microseconds>();
+	}
+
+	TEST_CASE("WorkStealingDeque")
+	{
+		SUBCASE("Owner pops in LIFO order")
+		{
+			WorkStealingDeque<u64> deque(4);
+			for (u64 i = 0; i < 16; ++i)
+			{
+				deque.Push(i);  // Forces the buffer to grow twice
+			}
+
+			CHECK(deque.Size() == 16);
+			for (u64 i = 16; i > 0; --i)
+			{
+				auto item = deque.Pop();
+				REQUIRE(item.has_value());
+				CHECK(*item == i - 1);
+			}
+			CHECK_FALSE(deque.Pop().has_value());
+		}
+
+		SUBCASE("Thieves take from the FIFO end")
+		{
+			WorkStealingDeque<u64> deque(8);
+			deque.Push(1);
+			deque.Push(2);
+
+			CHECK(deque.Steal() == 1);
+			CHECK(deque.Pop() == 2);
+			CHECK_FALSE(deque.Steal().has_value());
+		}
+
+		SUBCASE("Every item is taken exactly once under contention")
+		{
+			constexpr u64 itemCount = 200'000;
+			WorkStealingDeque<u64> deque(64);
+			std::vector<std::atomic<u32>> seen(itemCount);
+			std::atomic<u64> taken{ 0 };
+			std::atomic<bool> producing{ true };
+
+			std::vector<std::jthread> thieves;
+			for (u32 t = 0; t < 3; ++t)
+			{
+				thieves.emplace_back([&]
+				{
+					while (producing.load() || !deque.IsEmpty())
+					{
+						if (auto item = deque.Steal())
+						{
+							seen[*item].fetch_add(1);
+							taken.fetch_add(1);
+						}
+					}
+				});
+			}
+
+			for (u64 i = 0; i < itemCount; ++i)
+			{
+				deque.Push(i);
+				if (i % 3 == 0)
+				{
+					if (auto item = deque.Pop())
+					{
+						seen[*item].fetch_add(1);
+						taken.fetch_add(1);
+					}
+				}
+			}
+
+			while (auto item = deque.Pop())
+			{
+				seen[*item].fetch_add(1);
+				taken.fetch_add(1);
+			}
+
+			producing.store(false);
+			thieves.clear();
+
+			CHECK(taken.load() == itemCount);
+			CHECK(std::ranges::all_of(seen, [](const auto& count) { return count.load() == 1; }));
+		}
+	}
+
+	TEST_CASE("ThreadPool")
+	{
+		SUBCASE("Submit returns the result through the future")
+		{
+			ThreadPool pool(4);
+			auto future = pool.Submit([](i32 a, i32 b) { return a + b; }, 40, 2);
+			CHECK(future.get() == 42);
+		}
+
+		SUBCASE("Runs every submitted task")
+		{
+			ThreadPool pool(4);
+			constexpr u64 taskCount = 10'000;
+			std::latch done(taskCount);
+			std::atomic<u64> counter{ 0 };
+
+			for (u64 i = 0; i < taskCount; ++i)
+			{
+				pool.Enqueue([&] { counter.fetch_add(1); done.count_down(); });
+			}
+
+			done.wait();
+			CHECK(counter.load() == taskCount);
+		}
+
+		SUBCASE("Nested submissions from workers are stolen by idle workers")
+		{
+			ThreadPool pool(4);
+			constexpr u64 taskCount = 10'000;
+			std::latch done(taskCount);
+			std::vector<std::atomic<u32>> ranOn(pool.GetNumThreads());
+
+			pool.Enqueue([&]
+			{
+				for (u64 i = 0; i < taskCount; ++i)
+				{
+					pool.Enqueue([&]
+					{
+						ranOn[pool.GetCurrentWorkerIndex()].fetch_add(1);
+						done.count_down();
+					});
+				}
+			});
+
+			done.wait();
+
+			u64 total = 0;
+			for (const auto& count : ranOn)
+			{
+				total += count.load();
+			}
+
+			CHECK(total == taskCount);
+			CHECK(pool.GetCurrentWorkerIndex() == -1);  // Not a worker thread
+		}
+
+		SUBCASE("Shutdown drains queued work")
+		{
+			std::atomic<u64> counter{ 0 };
+			{
+				ThreadPool pool(2);
+				for (u64 i = 0; i < 1000; ++i)
+				{
+					pool.Enqueue([&] { counter.fetch_add(1); });
+				}
+			}
+			CHECK(counter.load() == 1000);
+		}
+
+		SUBCASE("Submit after shutdown throws")
+		{
+			ThreadPool pool(1);
+			pool.Shutdown();
+			CHECK_THROWS_AS(pool.Enqueue([] {}), std::runtime_error);
+		}
+	}
+
+	// Run with --no-skip to include the benchmarks
+	TEST_CASE("ThreadPool benchmark" * doctest::skip())
+	{
+		const u64 hardwareThreads = std::max<u64>(4, std::thread::hardware_concurrency());
+
+		for (u64 threads : { 4ull, 8ull, 16ull, 32ull, 64ull })
+		{
+			if (threads > hardwareThreads)
+			{
+				break;
+			}
+
+			for (u64 taskCount : { 1'000ull, 100'000ull, 1'000'000ull })
+			{
+				f64 sharedUs = 0.0, stealingUs = 0.0, nestedUs = 0.0;
+				{
+					SharedQueuePool pool(threads);
+					sharedUs = RunTinyTasks(pool, taskCount);
+				}
+				{
+					ThreadPool pool(threads);
+					stealingUs = RunTinyTasks(pool, taskCount);
+					nestedUs   = RunTinyTasksNested(pool, taskCount);
+				}
+
+				MESSAGE(threads << " threads, " << taskCount << " tasks: shared queue " << sharedUs
+					<< "us | work-stealing " << stealingUs << "us | work-stealing (nested) " << nestedUs << "us");
+			}
+		}
+	}
+}
@@ -1,68 +1,339 @@
 #include "Threading/ThreadPool.h"
+#include <immintrin.h>
 
 namespace Ryu::MT
 {
-    ThreadPool::ThreadPool(u64 numThreads)
-    {
-        m_workers.reserve(numThreads);
-
-        for (u64 i = 0; i < numThreads; i++)
-        {
-            m_workers.emplace_back([this](std::stop_token token) { WorkerLoop(token); });
-        }
-    }
-
-    ThreadPool::~ThreadPool()
-    {
-        Shutdown();
-    }
-
-    void ThreadPool::Shutdown()
-    {
-        {
-            std::lock_guard lock(m_mutex);
-            m_stopRequested.store(true);
-        }
-
-        m_cv.notify_all();
-
-        for (auto& worker : m_workers)
-        {
-            worker.request_stop();
-            if (worker.joinable())
+	namespace
+	{
+		// Idle backoff tiers, a worker spins, then yields, then sleeps on m_wakeEpoch
+		constexpr u32 SPIN_ROUNDS  = 64;
+		constexpr u32 YIELD_ROUNDS = 16;
+
+		// Identifies the pool (and slot) the calling thread works for, so nested submissions stay local
+		thread_local const ThreadPool* t_currentPool = nullptr;
+		thread_local u64               t_workerIndex = 0;
+		thread_local u64               t_stealSeed   = 0;
+
+		inline void CpuRelax() noexcept
+		{
+			_mm_pause();
+		}
+
+		inline u64 NextStealVictim() noexcept
+		{
+			// Threads outside the pool get seeded on first use
+			if (t_stealSeed == 0)
+			{
+				t_stealSeed = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+			}
+
+			// xorshift64, only used to spread thieves over the victims
+			u64 x = t_stealSeed;
+			x ^= x << 13;
+			x ^= x >> 7;
+			x ^= x << 17;
+			t_stealSeed = x;
+			return x;
+		}
+
+		struct FunctionTask : ThreadPool::Task
+		{
+			std::function<void()> Func;
+
+			static void Invoke(ThreadPool::Task* task)
 			{
-				worker.join();
+				std::unique_ptr<FunctionTask> self(static_cast<FunctionTask*>(task));
+				self->Func();
 			}
-        }
+		};
+
+		inline void Execute(ThreadPool::Task* task)
+		{
+			task->Run(task);
+		}
+	}
+
+	ThreadPool::ThreadPool(u64 numThreads)
+	{
+		// Create every deque before starting any thread, workers steal from each other right away
+		m_workers.reserve(numThreads);
+		for (u64 i = 0; i < numThreads; i++)
+		{
+			m_workers.push_back(std::make_unique<Worker>());
+		}
+
+		for (u64 i = 0; i < numThreads; i++)
+		{
+			m_workers[i]->Thread = std::jthread([this, i](std::stop_token token) { WorkerLoop(token, i); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		Shutdown();
+	}
+
+	void ThreadPool::Shutdown()
+	{
+		m_stopRequested.store(true);
+
+		for (auto& worker : m_workers)
+		{
+			worker->Thread.request_stop();
+		}
+
+		// Wake every sleeper so they can drain their queues and exit
+		m_wakeEpoch.fetch_add(1);
+		m_wakeEpoch.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			if (worker->Thread.joinable())
+			{
+				worker->Thread.join();
+			}
+		}
 
 		m_workers.clear();
-    }
-
-    u64 ThreadPool::GetNumThreads() const
-    {
-        return m_workers.size();
-    }
-    
-    void ThreadPool::WorkerLoop(std::stop_token token)
-    {
-        while (!token.stop_requested())
-        {
-            std::function<void()> task;
-            
-            {
-                std::unique_lock lock(m_mutex);
-				m_cv.wait(lock, token, [this] { return !m_tasks.empty() || m_stopRequested.load(); });
-
-                if (token.stop_requested() || (m_tasks.empty() && m_stopRequested))
-                {
-                    return;
-                }
-
-				task = std::move(m_tasks.front());
-				m_tasks.pop();
-            }
-
-            task();
-        }
-    }
+
+		// Nothing should be left at this point, tasks are owned by whoever enqueued them so just unlink
+		std::lock_guard lock(m_injectedMutex);
+		m_injectedHead = m_injectedTail = nullptr;
+		m_injectedCount.store(0);
+	}
+
+	u64 ThreadPool::GetNumThreads() const
+	{
+		return m_workers.size();
+	}
+
+	void ThreadPool::Enqueue(std::function<void()> func)
+	{
+		auto task = std::make_unique<FunctionTask>();
+		task->Run  = &FunctionTask::Invoke;
+		task->Func = std::move(func);
+
+		Enqueue(task.get());
+		task.release();
+	}
+
+	void ThreadPool::Enqueue(Task* task)
+	{
+		// Workers may still spawn nested tasks while the pool drains
+		if (m_stopRequested.load(std::memory_order_relaxed) && GetCurrentWorkerIndex() < 0)
+		{
+			throw std::runtime_error("ThreadPool is shutting down");
+		}
+
+		Push(task);
+	}
+
+	bool ThreadPool::RunPendingTask()
+	{
+		Task* task = nullptr;
+		if (const i64 index = GetCurrentWorkerIndex(); index >= 0)
+		{
+			task = FindTask(static_cast<u64>(index));
+		}
+		else
+		{
+			// Not a worker, there is no local deque so steal on behalf of nobody
+			task = PopInjected();
+			if (!task)
+			{
+				task = TrySteal(m_workers.size());
+			}
+		}
+
+		if (!task)
+		{
+			return false;
+		}
+
+		Execute(task);
+		return true;
+	}
+
+	i64 ThreadPool::GetCurrentWorkerIndex() const noexcept
+	{
+		return t_currentPool == this ? static_cast<i64>(t_workerIndex) : -1;
+	}
+
+	u64 ThreadPool::GetLocalQueueSize() const noexcept
+	{
+		if (t_currentPool == this)
+		{
+			return static_cast<u64>(m_workers[t_workerIndex]->Deque.Size());
+		}
+
+		return m_injectedCount.load(std::memory_order_relaxed);
+	}
+
+	void ThreadPool::Push(Task* task)
+	{
+		if (t_currentPool == this)
+		{
+			m_workers[t_workerIndex]->Deque.Push(task);
+		}
+		else
+		{
+			std::lock_guard lock(m_injectedMutex);
+			task->Next = nullptr;
+			if (m_injectedTail)
+			{
+				m_injectedTail->Next = task;
+			}
+			else
+			{
+				m_injectedHead = task;
+			}
+			m_injectedTail = task;
+			m_injectedCount.fetch_add(1, std::memory_order_release);
+		}
+
+		WakeWorker();
+	}
+
+	void ThreadPool::WakeWorker()
+	{
+		// Pairs with the fence in Sleep(), either the sleeper sees the new task or we see the sleeper
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_sleepingCount.load(std::memory_order_relaxed) > 0)
+		{
+			m_wakeEpoch.fetch_add(1, std::memory_order_release);
+			m_wakeEpoch.notify_one();
+		}
+	}
+
+	void ThreadPool::WorkerLoop(std::stop_token token, u64 index)
+	{
+		t_currentPool = this;
+		t_workerIndex = index;
+		t_stealSeed   = 0x9E3779B97F4A7C15ull * (index + 1);
+
+		u32 idleRounds = 0;
+		while (true)
+		{
+			if (Task* task = FindTask(index))
+			{
+				idleRounds = 0;
+				Execute(task);
+				continue;
+			}
+
+			// Only exit once there is nothing left to run
+			if (token.stop_requested())
+			{
+				break;
+			}
+
+			if (idleRounds < SPIN_ROUNDS)
+			{
+				CpuRelax();
+			}
+			else if (idleRounds < SPIN_ROUNDS + YIELD_ROUNDS)
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				Sleep(token, index);
+				idleRounds = 0;
+				continue;
+			}
+
+			++idleRounds;
+		}
+
+		t_currentPool = nullptr;
+	}
+
+	void ThreadPool::Sleep(std::stop_token token, u64 index)
+	{
+		m_sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// Read the epoch before the final check, a wake that lands after the check changes it and wait() returns
+		const u32 epoch = m_wakeEpoch.load(std::memory_order_acquire);
+
+		if (Task* task = FindTask(index))
+		{
+			m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+			Execute(task);
+			return;
+		}
+
+		if (!token.stop_requested())
+		{
+			m_wakeEpoch.wait(epoch, std::memory_order_acquire);
+		}
+
+		m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	ThreadPool::Task* ThreadPool::FindTask(u64 index)
+	{
+		if (auto task = m_workers[index]->Deque.Pop())
+		{
+			return *task;
+		}
+
+		if (Task* task = PopInjected())
+		{
+			return task;
+		}
+
+		return TrySteal(index);
+	}
+
+	ThreadPool::Task* ThreadPool::PopInjected()
+	{
+		if (m_injectedCount.load(std::memory_order_acquire) == 0)
+		{
+			return nullptr;
+		}
+
+		std::lock_guard lock(m_injectedMutex);
+		Task* task = m_injectedHead;
+		if (!task)
+		{
+			return nullptr;
+		}
+
+		m_injectedHead = task->Next;
+		if (!m_injectedHead)
+		{
+			m_injectedTail = nullptr;
+		}
+
+		m_injectedCount.fetch_sub(1, std::memory_order_relaxed);
+		return task;
+	}
+
+	ThreadPool::Task* ThreadPool::TrySteal(u64 thiefIndex)
+	{
+		const u64 count = m_workers.size();
+		if (count == 0)
+		{
+			return nullptr;
+		}
+
+		// Start at a random victim so thieves don't all pile onto worker 0
+		const u64 start = NextStealVictim() % count;
+		for (u64 i = 0; i < count; ++i)
+		{
+			const u64 victim = (start + i) % count;
+			if (victim == thiefIndex)
+			{
+				continue;
+			}
+
+			if (auto task = m_workers[victim]->Deque.Steal())
+			{
+				return *task;
+			}
+		}
+
+		return nullptr;
+	}
 }
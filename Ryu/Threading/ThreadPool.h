@@ -1,13 +1,25 @@
 #pragma once
-#include "Threading/Job.h"
-#include <queue>
+#include "Threading/Containers/WorkStealingDeque.h"
+#include <functional>
 #include <future>
+#include <thread>
 
 namespace Ryu::MT
 {
+	// Work-stealing thread pool. Every worker owns a Chase-Lev deque, tasks submitted from a worker
+	// go to its own deque and tasks submitted from outside go to a shared injection queue.
+	// Idle workers steal from each other and back off spin -> yield -> sleep before blocking
 	class ThreadPool
 	{
 	public:
+		// Intrusive work item, the pool never allocates or frees these. Run is called on a worker
+		// and owns the task from then on (it may free or recycle it)
+		struct Task
+		{
+			void (*Run)(Task* self) = nullptr;
+			Task* Next = nullptr;  // Injection queue link
+		};
+
 		explicit ThreadPool(u64 numThreads = std::thread::hardware_concurrency());
 		~ThreadPool();
 
@@ -17,15 +29,45 @@ namespace Ryu::MT
 		template<typename Func, typename... Args>
 		auto Submit(Func&& func, Args&&... args) -> std::future<std::invoke_result_t<Func, Args...>>;
 
+		// Fire and forget, no future is created. Wraps the callable in a heap allocated task
+		void Enqueue(std::function<void()> func);
+
+		// Fire and forget without allocating, the caller keeps the task alive until it executes
+		void Enqueue(Task* task);
+
+		// Runs one queued task on the calling thread, if any. Lets waiting threads help instead of blocking
+		bool RunPendingTask();
+
+		// Index of the calling worker in this pool, or -1 if called from any other thread
+		[[nodiscard]] i64 GetCurrentWorkerIndex() const noexcept;
+
+		// Tasks queued where the calling thread pushes: its own deque for workers, the injection queue otherwise
+		[[nodiscard]] u64 GetLocalQueueSize() const noexcept;
+
 	private:
-		void WorkerLoop(std::stop_token token);
+		struct alignas(64) Worker
+		{
+			WorkStealingDeque<Task*> Deque;
+			std::jthread             Thread;
+		};
+
+		void WorkerLoop(std::stop_token token, u64 index);
+		[[nodiscard]] Task* FindTask(u64 index);
+		[[nodiscard]] Task* PopInjected();
+		[[nodiscard]] Task* TrySteal(u64 thiefIndex);
+		void Push(Task* task);
+		void WakeWorker();
+		void Sleep(std::stop_token token, u64 index);
 
 	private:
-		std::vector<std::jthread>         m_workers;
-		std::queue<std::function<void()>> m_tasks;
-		std::mutex                        m_mutex;
-		std::condition_variable_any       m_cv;
-		std::atomic<bool>                 m_stopRequested{ false };
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		Task*                                m_injectedHead = nullptr;
+		Task*                                m_injectedTail = nullptr;
+		std::mutex                           m_injectedMutex;
+		alignas(64) std::atomic<u64>         m_injectedCount{ 0 };
+		alignas(64) std::atomic<u32>         m_sleepingCount{ 0 };
+		std::atomic<u32>                     m_wakeEpoch{ 0 };
+		std::atomic<bool>                    m_stopRequested{ false };
 	};
 }
 
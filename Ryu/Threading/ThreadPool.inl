@@ -10,18 +10,8 @@ namespace Ryu::MT
 		);
 
 		auto future = task->get_future();
+		Enqueue([task]() { (*task)(); });
 
-		{
-			std::lock_guard lock(m_mutex);
-			if (m_stopRequested)
-			{
-				throw std::runtime_error("ThreadPool is shutting down");
-			}
-
-			m_tasks.emplace([task]() { (*task)(); });
-		}
-
-		m_cv.notify_one();
 		return future;
 	}
 }
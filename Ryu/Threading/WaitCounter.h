@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <thread>
+
+namespace Ryu::MT
+{
+	// Counts outstanding work and lets threads block until it drains, using std::atomic::wait.
+	// Waiters only return once every decrement is out of the counter, so the one that reached
+	// zero is not still inside notify_all when the counter goes away (they often live on the stack)
+	class WaitCounter
+	{
+		RYU_DISABLE_COPY_AND_MOVE(WaitCounter)
+
+	public:
+		WaitCounter() = default;
+		explicit WaitCounter(u64 initial) : m_count(initial) {}
+
+		inline void Add(u64 count = 1) noexcept
+		{
+			m_count.fetch_add(count, std::memory_order_relaxed);
+		}
+
+		// Returns true for the call that brought the counter to zero
+		inline bool Decrement() noexcept
+		{
+			m_decrementing.fetch_add(1, std::memory_order_relaxed);
+
+			const bool reachedZero = m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+			if (reachedZero)
+			{
+				m_count.notify_all();
+			}
+
+			// Last touch, a waiter may destroy the counter right after this
+			m_decrementing.fetch_sub(1, std::memory_order_release);
+			return reachedZero;
+		}
+
+		[[nodiscard]] inline u64 GetCount() const noexcept { return m_count.load(std::memory_order_acquire); }
+
+		// Zero and no decrement still running, from here on the counter can be destroyed
+		[[nodiscard]] inline bool IsZero() const noexcept
+		{
+			return GetCount() == 0 && m_decrementing.load(std::memory_order_acquire) == 0;
+		}
+
+		// Plain blocking wait, see JobSystem::Wait(WaitCounter&) for one that helps while waiting
+		inline void Wait() const noexcept
+		{
+			u64 count = m_count.load(std::memory_order_acquire);
+			while (count != 0)
+			{
+				m_count.wait(count, std::memory_order_acquire);
+				count = m_count.load(std::memory_order_acquire);
+			}
+
+			// The decrement that got it to zero may still be notifying, only a few instructions left
+			while (m_decrementing.load(std::memory_order_acquire) != 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+	private:
+		std::atomic<u64> m_count{ 0 };
+		std::atomic<u32> m_decrementing{ 0 };  // Decrements between entering and leaving Decrement()
+	};
+}
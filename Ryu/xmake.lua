@@ -66,10 +66,22 @@ target("RyuThreading")
 	set_kind('object')
 	set_group("Ryu/Objects")
 
-	add_files("Threading/**.cpp", { unity_group = "Threading" })
-	add_headerfiles("Threading/**.h", { public = true })
+	add_files("Threading/**.cpp|Tests/**.cpp", { unity_group = "Threading" })  -- Ignore tests
+	add_headerfiles("Threading/**.h", "Threading/**.inl", { public = true })
 
 	add_deps("RyuCore")
+
+	-- Tests
+	for _, testfile in ipairs(os.files("Threading/Tests/*.cpp")) do
+		 add_tests(path.basename(testfile),
+		 {
+			 kind           = "binary",
+			 group          = "threading",
+			 files          = { testfile, "Memory/New.cpp" },  -- Allocation counters
+			 languages      = "cxx23",
+			 packages       = "doctest",
+		 })
+	end
 target_end()
 
 -------------------- Memory Module --------------------
@@ -100,11 +112,24 @@ target("RyuAsset")
 	set_kind('object')
 	set_group("Ryu/Objects")
 
-	add_files("Asset/**.cpp", { unity_group = "Asset" })
+	add_files("Asset/**.cpp|Tests/**.cpp", { unity_group = "Asset" })  -- Ignore tests
 	add_headerfiles("Asset/**.h", "Asset/**.inl", { public = true })
 
 	add_deps("RyuCore", "STB", "TinyOBJ", { public = true })
 	add_packages("directx-headers", "directxshadercompiler", { public = true })
+	add_packages("xxhash")  -- Derived data cache keys
+
+	-- Tests
+	for _, testfile in ipairs(os.files("Asset/Tests/*.cpp")) do
+		 add_tests(path.basename(testfile),
+		 {
+			 kind           = "binary",
+			 group          = "asset",
+			 files          = { testfile, "Threading/**.cpp|Tests/**.cpp", "Memory/New.cpp" },  -- Loads run on the job system
+			 languages      = "cxx23",
+			 packages       = "doctest",
+		 })
+	end
 
 target_end()
 
@@ -113,6 +138,10 @@ target("RyuShaders")
 	set_kind('object')
 	set_group("Ryu/Objects")
 	add_files("Shaders/Mesh.hlsl", { rule = "RyuOfflineShader", type = { "VS", "PS" }, refl = true, rootsig = "RootSig" })
+
+	-- Vertex shaders for packed vertex layouts, Mesh.hlsl with a few defines
+	add_files("Shaders/MeshOctahedral.hlsl", "Shaders/MeshNoColor.hlsl", "Shaders/MeshOctahedralNoColor.hlsl",
+		{ rule = "RyuOfflineShader", type = { "VS" }, refl = true, rootsig = "RootSig" })
 target_end()
 
 -------------------- Graphics Module --------------------
@@ -146,6 +175,19 @@ target("RyuGame")
 
 	add_deps("RyuCore", "RyuMath")
 	add_packages("entt", "directx-headers", { public = true })
+
+	-- Tests
+	for _, testfile in ipairs(os.files("Game/Tests/*.cpp")) do
+		 add_tests(path.basename(testfile),
+		 {
+			 kind           = "binary",
+			 group          = "game",
+			 files          = { testfile, "Threading/**.cpp|Tests/**.cpp", "Memory/New.cpp", "Memory/FrameArena.cpp" },  -- Extraction runs on the job system, into a frame arena
+			 remove_files   = { "Game/*.cpp", "Game/Core/*.cpp" },  -- Runtime and input reach into the engine
+			 languages      = "cxx23",
+			 packages       = "doctest",
+		 })
+	end
 target_end()
 
 -- Engine (also the module where the final linking step takes place)
@@ -75,6 +75,7 @@ void TestbenchWorld::OnTick(const Ryu::Utils::FrameTimer& timer)
 	// Spin the object
 	Game::Transform& meshTransform = m_meshEntity.GetComponent<Game::Transform>();
 	meshTransform.Orientation = Math::Quaternion::CreateFromYawPitchRoll(Math::Vector3(t, t, t));
+	m_meshEntity.MarkTransformDirty();
 
 	// Update the camera
 	const f32 speed = 10 * timer.DeltaTimeF();
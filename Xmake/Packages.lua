@@ -8,4 +8,5 @@ add_requires("Elos")
 add_requires("toml++")
 add_requires("tracy 5d542dc09f3d9378d005092a4ad446bd405f819a")
 add_requires("doctest")
+add_requires("xxhash")
 add_requires("efsw 71e43ca3bd9b4df7b92bcfed792c028341eb8c62")